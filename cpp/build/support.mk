@@ -14,6 +14,10 @@ USE_HID ?= 0
 # use builtin tinyXML by default 
 USE_BI_TXML ?= 1
 
+# compile out log messages less severe than this level (eg Info to drop Detail and Debug).
+# Empty keeps every level
+LOG_MAX_LEVEL ?=
+
 #the System we are building on
 UNAME  := $(shell uname -s)
 # The version of macOS we might be building on
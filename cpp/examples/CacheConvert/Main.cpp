@@ -0,0 +1,256 @@
+//-----------------------------------------------------------------------------
+//
+//	Main.cpp
+//
+//	Converts a network cache between the XML and binary forms, and compares
+//	the cost of loading and saving each.
+//
+//	Usage: CacheConvert <input> <output>
+//	       CacheConvert --bench <cache> [iterations]
+//
+//	The format of the input is detected.  The output is written as XML if its
+//	name ends in .xml, and in the binary form otherwise.
+//
+//	With --bench, the cache is loaded and saved repeatedly in each form and
+//	the average times are reported, along with the growth in peak memory from
+//	a single load.  Each form is measured in its own process so the peaks do
+//	not hide each other.
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Defs.h"
+#include "BinaryCache.h"
+#include "tinyxml.h"
+
+using namespace OpenZWave;
+using namespace OpenZWave::Internal;
+
+//-----------------------------------------------------------------------------
+// <Load>
+// Load a cache in either form
+//-----------------------------------------------------------------------------
+static bool Load(std::string const& _filename, TiXmlDocument* _doc)
+{
+	if (BinaryCache::IsBinaryCache(_filename))
+	{
+		return BinaryCache::Load(_filename, _doc);
+	}
+	return _doc->LoadFile(_filename.c_str(), TIXML_ENCODING_UTF8);
+}
+
+//-----------------------------------------------------------------------------
+// <SaveXML>
+// Save a cache as XML, with the declaration Driver::WriteCache writes
+//-----------------------------------------------------------------------------
+static bool SaveXML(TiXmlDocument const& _doc, std::string const& _filename)
+{
+	TiXmlDocument out;
+	out.LinkEndChild(new TiXmlDeclaration("1.0", "utf-8", ""));
+	if (_doc.RootElement())
+	{
+		out.InsertEndChild(*_doc.RootElement());
+	}
+	return out.SaveFile(_filename.c_str());
+}
+
+//-----------------------------------------------------------------------------
+// <PeakMemory>
+// Peak resident memory of this process in kilobytes
+//-----------------------------------------------------------------------------
+static long PeakMemory()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+//-----------------------------------------------------------------------------
+// <Microseconds>
+// Microseconds since _start
+//-----------------------------------------------------------------------------
+static double Microseconds(std::chrono::steady_clock::time_point const& _start)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _start).count();
+}
+
+//-----------------------------------------------------------------------------
+// <BenchFormat>
+// Time loading and saving one form of the cache.  Runs in a child process.
+//-----------------------------------------------------------------------------
+static int BenchFormat(char const* _label, std::string const& _filename, bool const _binary, int const _iterations)
+{
+	struct stat st;
+	if (stat(_filename.c_str(), &st) != 0)
+	{
+		fprintf(stderr, "Cannot read %s\n", _filename.c_str());
+		return 1;
+	}
+
+	// Peak memory growth from a single load, taken first while the peak is still our baseline
+	long baseline = PeakMemory();
+	{
+		TiXmlDocument doc;
+		if (!Load(_filename, &doc))
+		{
+			fprintf(stderr, "Cannot load %s\n", _filename.c_str());
+			return 1;
+		}
+	}
+	long peak = PeakMemory() - baseline;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < _iterations; ++i)
+	{
+		TiXmlDocument doc;
+		Load(_filename, &doc);
+	}
+	double loadTime = Microseconds(start) / _iterations;
+
+	TiXmlDocument doc;
+	Load(_filename, &doc);
+	std::string saveName = _filename + ".save";
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < _iterations; ++i)
+	{
+		if (_binary)
+		{
+			BinaryCache::Save(doc, saveName);
+		}
+		else
+		{
+			SaveXML(doc, saveName);
+		}
+	}
+	double saveTime = Microseconds(start) / _iterations;
+	unlink(saveName.c_str());
+
+	printf("%-8s %10lld bytes  load %10.1f us  save %10.1f us  peak +%ld kB\n", _label, (long long) st.st_size, loadTime, saveTime, peak);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// <RunChild>
+// Run a BenchFormat in a fresh child process
+//-----------------------------------------------------------------------------
+static bool RunChild(char const* _label, std::string const& _filename, bool const _binary, int const _iterations)
+{
+	fflush(stdout);
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		int result = BenchFormat(_label, _filename, _binary, _iterations);
+		fflush(stdout);
+		_exit(result);
+	}
+	int status = 0;
+	if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+	{
+		return false;
+	}
+	return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+//-----------------------------------------------------------------------------
+// <Bench>
+// Write the cache in both forms next to the original and measure each
+//-----------------------------------------------------------------------------
+static int Bench(std::string const& _filename, int const _iterations)
+{
+	std::string xmlName = _filename + ".bench.xml";
+	std::string binName = _filename + ".bench.bin";
+
+	// Convert in a child too, so the parent stays small and the children start from the same baseline
+	fflush(stdout);
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		TiXmlDocument doc;
+		if (!Load(_filename, &doc))
+		{
+			fprintf(stderr, "Cannot load %s\n", _filename.c_str());
+			_exit(1);
+		}
+		_exit((SaveXML(doc, xmlName) && BinaryCache::Save(doc, binName)) ? 0 : 1);
+	}
+	int status = 0;
+	if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+	{
+		return 1;
+	}
+
+	printf("%d iterations of %s\n", _iterations, _filename.c_str());
+	bool ok = RunChild("xml", xmlName, false, _iterations) && RunChild("binary", binName, true, _iterations);
+
+	unlink(xmlName.c_str());
+	unlink(binName.c_str());
+	return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	if ((argc >= 3) && (strcmp(argv[1], "--bench") == 0))
+	{
+		int iterations = 20;
+		if (argc > 3)
+		{
+			iterations = atoi(argv[3]);
+		}
+		if (iterations < 1)
+		{
+			iterations = 1;
+		}
+		return Bench(argv[2], iterations);
+	}
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <input> <output>\n", argv[0]);
+		fprintf(stderr, "       %s --bench <cache> [iterations]\n", argv[0]);
+		return 1;
+	}
+
+	TiXmlDocument doc;
+	if (!Load(argv[1], &doc))
+	{
+		fprintf(stderr, "Cannot load %s\n", argv[1]);
+		return 1;
+	}
+
+	std::string output = argv[2];
+	bool const toXML = (output.size() >= 4) && (output.compare(output.size() - 4, 4, ".xml") == 0);
+	if (!(toXML ? SaveXML(doc, output) : BinaryCache::Save(doc, output)))
+	{
+		fprintf(stderr, "Cannot write %s\n", output.c_str());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+//
+//	Main.cpp
+//
+//	Compiles the XML files in a config directory into the ozwconfig.bin image
+//	that the library maps at startup in place of parsing them.
+//
+//	Usage: ConfigCompile <config directory> [image]
+//
+//	The image is written to ozwconfig.bin in the config directory unless
+//	another name is given.  Run it again whenever the config files are
+//	installed or updated; files that have changed since the image was built
+//	are read from their XML.
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "Defs.h"
+#include "ConfigImage.h"
+#include "platform/Log.h"
+
+using namespace OpenZWave;
+using namespace OpenZWave::Internal;
+
+//-----------------------------------------------------------------------------
+// <FindFiles>
+// Collect the paths, relative to the config directory, of every XML file
+//-----------------------------------------------------------------------------
+static void FindFiles(std::string const& _configPath, std::string const& _relative, std::vector<std::string>* o_files)
+{
+	std::string dirname = _configPath + _relative;
+	DIR* dir = opendir(dirname.c_str());
+	if (!dir)
+	{
+		fprintf(stderr, "Cannot read %s\n", dirname.c_str());
+		return;
+	}
+	while (struct dirent* ent = readdir(dir))
+	{
+		if (ent->d_name[0] == '.')
+		{
+			continue;
+		}
+		std::string relative = _relative + ent->d_name;
+		struct stat st;
+		if (stat((_configPath + relative).c_str(), &st) != 0)
+		{
+			continue;
+		}
+		if (S_ISDIR(st.st_mode))
+		{
+			FindFiles(_configPath, relative + "/", o_files);
+		}
+		else if ((relative.size() > 4) && (relative.compare(relative.size() - 4, 4, ".xml") == 0))
+		{
+			o_files->push_back(relative);
+		}
+	}
+	closedir(dir);
+}
+
+int main(int argc, char* argv[])
+{
+	if ((argc < 2) || (argc > 3))
+	{
+		fprintf(stderr, "Usage: %s <config directory> [image]\n", argv[0]);
+		return 1;
+	}
+
+	std::string configPath = argv[1];
+	if (configPath[configPath.size() - 1] != '/')
+	{
+		configPath += "/";
+	}
+	std::string image = (argc > 2) ? argv[2] : configPath + "ozwconfig.bin";
+
+	// Problems with individual files are reported through the log
+	Log::Create("", false, true, LogLevel_Warning, LogLevel_None, LogLevel_None);
+
+	std::vector<std::string> files;
+	FindFiles(configPath, "", &files);
+	if (files.empty())
+	{
+		fprintf(stderr, "No config files found in %s\n", configPath.c_str());
+		Log::Destroy();
+		return 1;
+	}
+
+	bool ok = ConfigImage::Build(configPath, files, image);
+	Log::Destroy();
+
+	struct stat st;
+	if (stat(image.c_str(), &st) == 0)
+	{
+		printf("Compiled %d files into %s (%lld bytes)\n", (int) files.size(), image.c_str(), (long long) st.st_size);
+	}
+	if (!ok)
+	{
+		fprintf(stderr, "Some files could not be compiled, and will be read from their XML\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,215 @@
+//-----------------------------------------------------------------------------
+//
+//	Main.cpp
+//
+//	Turns a binary log written with the BinaryLogFile option back into text.
+//
+//	Usage: LogDecode <binary log> [max level]
+//
+//	The output has the same layout as the text log.  If a max level is given
+//	(using the numbers from the LogLevel enum), less severe messages are left
+//	out.
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Defs.h"
+#include "platform/Log.h"
+#include "platform/LogFormatter.h"
+
+using namespace OpenZWave;
+using namespace OpenZWave::Internal::Platform;
+
+//-----------------------------------------------------------------------------
+// <Read>
+// Read exactly _size bytes, returning false at the end of the file
+//-----------------------------------------------------------------------------
+static bool Read(FILE* _file, void* _data, size_t _size)
+{
+	return (_size == 0) || (fread(_data, _size, 1, _file) == 1);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <binary log> [max level]\n", argv[0]);
+		return 1;
+	}
+
+	int maxLevel = LogLevel_Internal;
+	if (argc > 2)
+	{
+		maxLevel = atoi(argv[2]);
+	}
+
+	FILE* file = fopen(argv[1], "rb");
+	if (!file)
+	{
+		fprintf(stderr, "Cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	char magic[sizeof(BinaryLog::c_magic)];
+	uint32 byteOrder = 0;
+	uint32 version = 0;
+	if (!Read(file, magic, sizeof(magic)) || (memcmp(magic, BinaryLog::c_magic, sizeof(magic)) != 0) || !Read(file, &byteOrder, sizeof(byteOrder)) || !Read(file, &version, sizeof(version)))
+	{
+		fprintf(stderr, "%s is not an OpenZWave binary log\n", argv[1]);
+		fclose(file);
+		return 1;
+	}
+	if (byteOrder != BinaryLog::c_byteOrder)
+	{
+		fprintf(stderr, "%s was written on a machine with a different byte order\n", argv[1]);
+		fclose(file);
+		return 1;
+	}
+	if (version != BinaryLog::c_version)
+	{
+		fprintf(stderr, "%s is version %d, but only version %d is supported\n", argv[1], version, BinaryLog::c_version);
+		fclose(file);
+		return 1;
+	}
+
+	std::map<uint32, std::string> formats;
+	std::vector<char> data;
+	bool truncated = false;
+	int type;
+	while ((type = fgetc(file)) != EOF)
+	{
+		switch (type)
+		{
+			case BinaryLog::Record_Session:
+			{
+				uint64 time;
+				if (!Read(file, &time, sizeof(time)))
+				{
+					truncated = true;
+					break;
+				}
+				formats.clear();
+				break;
+			}
+			case BinaryLog::Record_Format:
+			{
+				uint32 id;
+				uint16 length;
+				if (!Read(file, &id, sizeof(id)) || !Read(file, &length, sizeof(length)))
+				{
+					truncated = true;
+					break;
+				}
+				data.resize(length + 1);
+				if (!Read(file, &data[0], length))
+				{
+					truncated = true;
+					break;
+				}
+				formats[id] = std::string(&data[0], length);
+				break;
+			}
+			case BinaryLog::Record_Message:
+			{
+				uint64 sequence;
+				uint64 time;
+				uint64 threadId;
+				uint32 formatId;
+				uint8 level;
+				uint8 nodeId;
+				uint8 flags;
+				uint16 length;
+				if (!Read(file, &sequence, sizeof(sequence)) || !Read(file, &time, sizeof(time)) || !Read(file, &threadId, sizeof(threadId)) || !Read(file, &formatId, sizeof(formatId)) || !Read(file, &level, sizeof(level)) || !Read(file, &nodeId, sizeof(nodeId)) || !Read(file, &flags, sizeof(flags)) || !Read(file, &length, sizeof(length)))
+				{
+					truncated = true;
+					break;
+				}
+				data.resize(length + 1);
+				if (!Read(file, &data[0], length))
+				{
+					truncated = true;
+					break;
+				}
+
+				bool queued = ((flags & BinaryLog::c_flagQueued) != 0);
+				if ((level > maxLevel) && !queued)
+				{
+					break;
+				}
+
+				std::string message;
+				if (formatId == BinaryLog::c_textFormat)
+				{
+					message.assign(&data[0], length);
+				}
+				else
+				{
+					std::map<uint32, std::string>::iterator it = formats.find(formatId);
+					if (it == formats.end())
+					{
+						fprintf(stderr, "Message %llu uses unknown format %d\n", (unsigned long long) sequence, formatId);
+						break;
+					}
+					LogFormatter::FormatArgs(it->second.c_str(), (uint8 const*) &data[0], length, &message);
+				}
+				fputs(LogFormatter::GetLine(time, threadId, (LogLevel) level, nodeId, message, queued).c_str(), stdout);
+				break;
+			}
+			case BinaryLog::Record_Dropped:
+			{
+				uint64 time;
+				uint32 count;
+				if (!Read(file, &time, sizeof(time)) || !Read(file, &count, sizeof(count)))
+				{
+					truncated = true;
+					break;
+				}
+				char buf[100];
+				snprintf(buf, sizeof(buf), "Log could not keep up.  %d messages were dropped", count);
+				fputs(LogFormatter::GetLine(time, 0, LogLevel_Warning, 0, buf, false).c_str(), stdout);
+				break;
+			}
+			default:
+			{
+				fprintf(stderr, "Unknown record type %d.  The log is corrupt\n", type);
+				fclose(file);
+				return 1;
+			}
+		}
+
+		if (truncated)
+		{
+			// The application probably stopped while writing the log
+			fprintf(stderr, "The log ends part way through a record\n");
+			break;
+		}
+	}
+
+	fclose(file);
+	return 0;
+}
@@ -0,0 +1,227 @@
+//-----------------------------------------------------------------------------
+//
+//	AesModes.cpp
+//
+//	The AES block operations used by the Security command class
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "AesModes.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define OZW_AES_NI
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AES_NI_TARGET
+#else
+#include <cpuid.h>
+// Compile just these functions for the AES instructions, so the rest of the
+// library still runs on processors without them
+#define AES_NI_TARGET __attribute__((target("aes,sse2")))
+#endif
+#endif
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace
+		{
+#ifdef OZW_AES_NI
+			bool DetectHardware()
+			{
+#if defined(_MSC_VER)
+				int info[4];
+				__cpuid(info, 1);
+				return (info[2] & (1 << 25)) != 0;
+#else
+				unsigned int eax, ebx, ecx, edx;
+				if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+				{
+					return false;
+				}
+				return (ecx & bit_AES) != 0;
+#endif
+			}
+
+			// The bundled AES code keeps its key schedule as 32 bit words loaded little
+			// endian, which on x86 is the byte order of the round keys, so the
+			// instructions can use the schedule as it is.
+			AES_NI_TARGET inline __m128i EncryptNi(aes_encrypt_ctx const* _ctx, __m128i _block)
+			{
+				__m128i const* keys = reinterpret_cast<__m128i const*>(_ctx->ks);
+				int const rounds = _ctx->inf.b[0] >> 4;
+				_block = _mm_xor_si128(_block, _mm_loadu_si128(&keys[0]));
+				for (int i = 1; i < rounds; ++i)
+				{
+					_block = _mm_aesenc_si128(_block, _mm_loadu_si128(&keys[i]));
+				}
+				return _mm_aesenclast_si128(_block, _mm_loadu_si128(&keys[rounds]));
+			}
+
+			AES_NI_TARGET void OfbNi(aes_encrypt_ctx const* _ctx, uint8 const _iv[16], uint8 const* _in, uint8* _out, uint32 _length)
+			{
+				__m128i stream = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_iv));
+				while (_length >= 16)
+				{
+					stream = EncryptNi(_ctx, stream);
+					__m128i data = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_in));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(_out), _mm_xor_si128(data, stream));
+					_in += 16;
+					_out += 16;
+					_length -= 16;
+				}
+				if (_length)
+				{
+					uint8 block[16];
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(block), EncryptNi(_ctx, stream));
+					for (uint32 i = 0; i < _length; ++i)
+					{
+						_out[i] = _in[i] ^ block[i];
+					}
+				}
+			}
+
+			AES_NI_TARGET void CbcMacNi(aes_encrypt_ctx const* _ctx, uint8 const _iv[16], uint8 const* _data, uint32 _length, uint8 o_mac[16])
+			{
+				__m128i mac = EncryptNi(_ctx, _mm_loadu_si128(reinterpret_cast<__m128i const*>(_iv)));
+				while (_length >= 16)
+				{
+					mac = EncryptNi(_ctx, _mm_xor_si128(mac, _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data))));
+					_data += 16;
+					_length -= 16;
+				}
+				if (_length)
+				{
+					uint8 block[16];
+					memset(block, 0, 16);
+					memcpy(block, _data, _length);
+					mac = EncryptNi(_ctx, _mm_xor_si128(mac, _mm_loadu_si128(reinterpret_cast<__m128i const*>(block))));
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(o_mac), mac);
+			}
+
+			AES_NI_TARGET void EncryptBlockNi(aes_encrypt_ctx const* _ctx, uint8 const* _in, uint8* _out)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(_out), EncryptNi(_ctx, _mm_loadu_si128(reinterpret_cast<__m128i const*>(_in))));
+			}
+
+			bool s_hardware = DetectHardware();
+#else
+			bool s_hardware = false;
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <AesHardwareAvailable>
+// Does the processor have the AES instructions
+//-----------------------------------------------------------------------------
+		bool AesHardwareAvailable()
+		{
+#ifdef OZW_AES_NI
+			static bool available = DetectHardware();
+			return available;
+#else
+			return false;
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <AesUseHardware>
+// Choose between the hardware and the portable code
+//-----------------------------------------------------------------------------
+		bool AesUseHardware(bool _use)
+		{
+			s_hardware = _use && AesHardwareAvailable();
+			return s_hardware;
+		}
+
+//-----------------------------------------------------------------------------
+// <AesEncryptBlock>
+// Encrypt one block
+//-----------------------------------------------------------------------------
+		void AesEncryptBlock(aes_encrypt_ctx const* _ctx, uint8 const* _in, uint8* _out)
+		{
+#ifdef OZW_AES_NI
+			if (s_hardware)
+			{
+				EncryptBlockNi(_ctx, _in, _out);
+				return;
+			}
+#endif
+			aes_encrypt(_in, _out, _ctx);
+		}
+
+//-----------------------------------------------------------------------------
+// <AesOfb>
+// Encrypt or decrypt in output feedback mode
+//-----------------------------------------------------------------------------
+		void AesOfb(aes_encrypt_ctx const* _ctx, uint8 const _iv[16], uint8 const* _in, uint8* _out, uint32 _length)
+		{
+#ifdef OZW_AES_NI
+			if (s_hardware)
+			{
+				OfbNi(_ctx, _iv, _in, _out, _length);
+				return;
+			}
+#endif
+			uint8 stream[16];
+			memcpy(stream, _iv, 16);
+			for (uint32 i = 0; i < _length; ++i)
+			{
+				if ((i & 15) == 0)
+				{
+					aes_encrypt(stream, stream, _ctx);
+				}
+				_out[i] = _in[i] ^ stream[i & 15];
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <AesCbcMac>
+// The Security CC message authentication code
+//-----------------------------------------------------------------------------
+		void AesCbcMac(aes_encrypt_ctx const* _ctx, uint8 const _iv[16], uint8 const* _data, uint32 _length, uint8 o_mac[16])
+		{
+#ifdef OZW_AES_NI
+			if (s_hardware)
+			{
+				CbcMacNi(_ctx, _iv, _data, _length, o_mac);
+				return;
+			}
+#endif
+			aes_encrypt(_iv, o_mac, _ctx);
+			for (uint32 i = 0; i < _length; i += 16)
+			{
+				for (uint32 j = 0; (j < 16) && (i + j < _length); ++j)
+				{
+					o_mac[j] ^= _data[i + j];
+				}
+				aes_encrypt(o_mac, o_mac, _ctx);
+			}
+		}
+	} // namespace Internal
+} // namespace OpenZWave
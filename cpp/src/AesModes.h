@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+//
+//	AesModes.h
+//
+//	The AES block operations used by the Security command class
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _AesModes_H
+#define _AesModes_H
+
+#include "Defs.h"
+#include "aes/aes.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \file AesModes.h
+		 * OFB encryption and the CBC-MAC used by Security (S0), on an AES-128 key
+		 * schedule from aes_encrypt_key128.  On x86 processors with the AES
+		 * instructions these run on the hardware; anywhere else they use the bundled
+		 * AES code one block at a time.  Neither keeps any state between calls.
+		 */
+
+		/**
+		 * Encrypt one 16 byte block.  _in and _out may be the same.
+		 */
+		void AesEncryptBlock(aes_encrypt_ctx const* _ctx, uint8 const* _in, uint8* _out);
+
+		/**
+		 * Encrypt or decrypt (they are the same in OFB) _length bytes, starting from a
+		 * fresh 16 byte initialization vector.
+		 */
+		void AesOfb(aes_encrypt_ctx const* _ctx, uint8 const _iv[16], uint8 const* _in, uint8* _out, uint32 _length);
+
+		/**
+		 * The Security CC message authentication code: the IV is encrypted, then
+		 * each 16 byte block of the data, the last padded with zeros, is XORed in
+		 * and the result encrypted again.
+		 * \param o_mac The full 16 byte result; Security sends the first 8.
+		 */
+		void AesCbcMac(aes_encrypt_ctx const* _ctx, uint8 const _iv[16], uint8 const* _data, uint32 _length, uint8 o_mac[16]);
+
+		/**
+		 * True if the processor has the AES instructions.
+		 */
+		bool AesHardwareAvailable();
+
+		/**
+		 * Choose between the hardware and the portable code (for testing).  The
+		 * hardware is used by default when it is available.
+		 * \return true if the hardware will be used.
+		 */
+		bool AesUseHardware(bool _use);
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_AesModes_H
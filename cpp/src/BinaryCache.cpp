@@ -0,0 +1,702 @@
+//-----------------------------------------------------------------------------
+//
+//	BinaryCache.cpp
+//
+//	Compact binary form of the network cache (ozwcache) documents
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "BinaryCache.h"
+#include "platform/Log.h"
+#include "tinyxml.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace
+		{
+			char const c_magic[8] =
+			{ 'O', 'Z', 'W', 'C', 'A', 'C', 'H', 'E' };
+			size_t const c_headerSize = 28;
+			uint32 const c_maxDepth = 64;			// Far deeper than any real cache
+
+			uint8 const c_tagElement = 'E';
+			uint8 const c_tagText = 'T';
+
+			void PutUInt32(uint8* _buffer, uint32 const _value)
+			{
+				_buffer[0] = (uint8) (_value & 0xff);
+				_buffer[1] = (uint8) ((_value >> 8) & 0xff);
+				_buffer[2] = (uint8) ((_value >> 16) & 0xff);
+				_buffer[3] = (uint8) ((_value >> 24) & 0xff);
+			}
+
+			uint32 GetUInt32(uint8 const* _buffer)
+			{
+				return ((uint32) _buffer[0]) | (((uint32) _buffer[1]) << 8) | (((uint32) _buffer[2]) << 16) | (((uint32) _buffer[3]) << 24);
+			}
+
+			//-----------------------------------------------------------------------------
+			// Check the header, checksum and string table of a loaded file, and find the
+			// start of every string and of the tree
+			//-----------------------------------------------------------------------------
+			bool CheckFile(uint8 const* _data, size_t const _size, string const& _name, std::vector<char const*>* o_strings, uint8 const** o_tree, size_t* o_treeSize)
+			{
+				if ((_size < c_headerSize) || (memcmp(_data, c_magic, sizeof(c_magic)) != 0))
+				{
+					Log::Write(LogLevel_Warning, "%s is not a binary cache file", _name.c_str());
+					return false;
+				}
+				uint32 version = GetUInt32(&_data[8]);
+				uint32 stringCount = GetUInt32(&_data[12]);
+				uint32 stringsSize = GetUInt32(&_data[16]);
+				uint32 treeSize = GetUInt32(&_data[20]);
+				uint32 crc = GetUInt32(&_data[24]);
+				if (version != BinaryCache::c_version)
+				{
+					Log::Write(LogLevel_Warning, "%s is binary cache version %d, but only version %d is supported", _name.c_str(), version, BinaryCache::c_version);
+					return false;
+				}
+				if (((uint64) stringsSize + treeSize) != (_size - c_headerSize))
+				{
+					Log::Write(LogLevel_Warning, "%s is truncated", _name.c_str());
+					return false;
+				}
+				if (BinaryCache::Crc32(0, &_data[c_headerSize], _size - c_headerSize) != crc)
+				{
+					Log::Write(LogLevel_Warning, "%s failed its checksum", _name.c_str());
+					return false;
+				}
+
+				o_strings->clear();
+				o_strings->reserve(stringCount);
+				uint8 const* pos = &_data[c_headerSize];
+				uint8 const* end = pos + stringsSize;
+				while ((pos < end) && (o_strings->size() < stringCount))
+				{
+					uint8 const* nul = (uint8 const*) memchr(pos, 0, end - pos);
+					if (!nul)
+					{
+						break;
+					}
+					o_strings->push_back((char const*) pos);
+					pos = nul + 1;
+				}
+				if ((o_strings->size() != stringCount) || (pos != end) || (treeSize == 0) || (*end != c_tagElement))
+				{
+					Log::Write(LogLevel_Warning, "%s is corrupt", _name.c_str());
+					return false;
+				}
+				*o_tree = end;
+				*o_treeSize = treeSize;
+				return true;
+			}
+
+			//-----------------------------------------------------------------------------
+			// Rebuilds elements from the tree of a loaded file
+			//-----------------------------------------------------------------------------
+			class Reader
+			{
+				public:
+					Reader(uint8 const* _pos, uint8 const* _end, std::vector<char const*> const& _strings) :
+							m_pos(_pos), m_end(_end), m_strings(_strings)
+					{
+					}
+
+					// Read an element's name, attributes and child count, leaving its children unread
+					TiXmlElement* ReadHead(uint32 const _depth, uint32* o_childCount)
+					{
+						uint32 name;
+						uint32 count;
+						if ((_depth > c_maxDepth) || !GetString(&name) || !GetVarint(&count))
+						{
+							return NULL;
+						}
+
+						TiXmlElement* element = new TiXmlElement(m_strings[name]);
+						for (uint32 i = 0; i < count; ++i)
+						{
+							uint32 attributeName;
+							uint32 attributeValue;
+							if (!GetString(&attributeName) || !GetString(&attributeValue))
+							{
+								delete element;
+								return NULL;
+							}
+							element->SetAttribute(m_strings[attributeName], m_strings[attributeValue]);
+						}
+
+						if (!GetVarint(o_childCount))
+						{
+							delete element;
+							return NULL;
+						}
+						return element;
+					}
+
+					TiXmlElement* ReadElement(uint32 const _depth)
+					{
+						uint32 count;
+						TiXmlElement* element = ReadHead(_depth, &count);
+						if (!element)
+						{
+							return NULL;
+						}
+						for (uint32 i = 0; i < count; ++i)
+						{
+							TiXmlNode* child = ReadChild(_depth + 1);
+							if (!child)
+							{
+								delete element;
+								return NULL;
+							}
+							element->LinkEndChild(child);
+						}
+						return element;
+					}
+
+					// Read a tag and the element or text that follows it
+					TiXmlNode* ReadChild(uint32 const _depth)
+					{
+						if (m_pos >= m_end)
+						{
+							return NULL;
+						}
+						uint8 tag = *m_pos++;
+						if (tag == c_tagElement)
+						{
+							return ReadElement(_depth);
+						}
+						if (tag == c_tagText)
+						{
+							uint32 text;
+							if (GetString(&text))
+							{
+								return new TiXmlText(m_strings[text]);
+							}
+						}
+						return NULL;
+					}
+
+					uint8 const* GetPosition() const
+					{
+						return m_pos;
+					}
+
+				private:
+					bool GetVarint(uint32* o_value)
+					{
+						uint32 value = 0;
+						for (uint32 shift = 0; shift < 35; shift += 7)
+						{
+							if (m_pos >= m_end)
+							{
+								return false;
+							}
+							uint8 byte = *m_pos++;
+							value |= ((uint32) (byte & 0x7f)) << shift;
+							if (!(byte & 0x80))
+							{
+								*o_value = value;
+								return true;
+							}
+						}
+						return false;
+					}
+
+					bool GetString(uint32* o_index)
+					{
+						return GetVarint(o_index) && (*o_index < m_strings.size());
+					}
+
+					uint8 const* m_pos;
+					uint8 const* m_end;
+					std::vector<char const*> const& m_strings;
+			};
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::Builder>
+// Constructor
+//-----------------------------------------------------------------------------
+		BinaryCache::Builder::Builder() :
+				m_count(0), m_children(0)
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::AddChild>
+// Encode one child of the root
+//-----------------------------------------------------------------------------
+		void BinaryCache::Builder::AddChild(TiXmlNode const* _child)
+		{
+			if (_child->ToElement() || _child->ToText())
+			{
+				WriteNode(_child, &m_tree);
+				++m_children;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::Finish>
+// Build the whole file in memory
+//-----------------------------------------------------------------------------
+		void BinaryCache::Builder::Finish(TiXmlElement const* _root, std::vector<uint8>* o_data)
+		{
+			std::vector<uint8> head;
+			WriteHead(_root, m_children, &head);
+
+			o_data->resize(c_headerSize + m_strings.size() + head.size() + m_tree.size());
+			uint8* header = &(*o_data)[0];
+			memcpy(header, c_magic, sizeof(c_magic));
+			PutUInt32(&header[8], c_version);
+			PutUInt32(&header[12], m_count);
+			PutUInt32(&header[16], (uint32) m_strings.size());
+			PutUInt32(&header[20], (uint32) (head.size() + m_tree.size()));
+			uint8* pos = &header[c_headerSize];
+			if (!m_strings.empty())
+			{
+				memcpy(pos, &m_strings[0], m_strings.size());
+				pos += m_strings.size();
+			}
+			memcpy(pos, &head[0], head.size());
+			pos += head.size();
+			if (!m_tree.empty())
+			{
+				memcpy(pos, &m_tree[0], m_tree.size());
+			}
+			PutUInt32(&header[24], Crc32(0, &header[c_headerSize], o_data->size() - c_headerSize));
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::Save>
+// Write the file, without first gathering it into one buffer
+//-----------------------------------------------------------------------------
+		bool BinaryCache::Builder::Save(TiXmlElement const* _root, string const& _filename)
+		{
+			std::vector<uint8> head;
+			WriteHead(_root, m_children, &head);
+
+			uint8 header[c_headerSize];
+			memcpy(header, c_magic, sizeof(c_magic));
+			PutUInt32(&header[8], c_version);
+			PutUInt32(&header[12], m_count);
+			PutUInt32(&header[16], (uint32) m_strings.size());
+			PutUInt32(&header[20], (uint32) (head.size() + m_tree.size()));
+			uint32 crc = m_strings.empty() ? 0 : Crc32(0, &m_strings[0], m_strings.size());
+			crc = Crc32(crc, &head[0], head.size());
+			if (!m_tree.empty())
+			{
+				crc = Crc32(crc, &m_tree[0], m_tree.size());
+			}
+			PutUInt32(&header[24], crc);
+
+			string tempname = _filename + ".tmp";
+			FILE* file = fopen(tempname.c_str(), "wb");
+			if (!file)
+			{
+				Log::Write(LogLevel_Warning, "Unable to create %s", tempname.c_str());
+				return false;
+			}
+			bool ok = (fwrite(header, sizeof(header), 1, file) == 1);
+			ok = ok && (m_strings.empty() || (fwrite(&m_strings[0], m_strings.size(), 1, file) == 1));
+			ok = ok && (fwrite(&head[0], head.size(), 1, file) == 1);
+			ok = ok && (m_tree.empty() || (fwrite(&m_tree[0], m_tree.size(), 1, file) == 1));
+			ok = (fclose(file) == 0) && ok;
+#ifdef _WIN32
+			// rename will not replace an existing file
+			if (ok)
+			{
+				remove(_filename.c_str());
+			}
+#endif
+			if (!ok || (rename(tempname.c_str(), _filename.c_str()) != 0))
+			{
+				Log::Write(LogLevel_Warning, "Unable to write %s", _filename.c_str());
+				remove(tempname.c_str());
+				return false;
+			}
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::WriteHead>
+// Encode an element's name, attributes and child count
+//-----------------------------------------------------------------------------
+		void BinaryCache::Builder::WriteHead(TiXmlElement const* _element, uint32 const _childCount, std::vector<uint8>* o_tree)
+		{
+			o_tree->push_back(c_tagElement);
+			PutVarint(Intern(_element->Value()), o_tree);
+
+			uint32 count = 0;
+			for (TiXmlAttribute const* attribute = _element->FirstAttribute(); attribute; attribute = attribute->Next())
+			{
+				++count;
+			}
+			PutVarint(count, o_tree);
+			for (TiXmlAttribute const* attribute = _element->FirstAttribute(); attribute; attribute = attribute->Next())
+			{
+				PutVarint(Intern(attribute->Name()), o_tree);
+				PutVarint(Intern(attribute->Value()), o_tree);
+			}
+			PutVarint(_childCount, o_tree);
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::WriteNode>
+// Encode an element and everything below it, or a text node
+//-----------------------------------------------------------------------------
+		void BinaryCache::Builder::WriteNode(TiXmlNode const* _node, std::vector<uint8>* o_tree)
+		{
+			if (TiXmlText const* text = _node->ToText())
+			{
+				o_tree->push_back(c_tagText);
+				PutVarint(Intern(text->Value()), o_tree);
+				return;
+			}
+
+			TiXmlElement const* element = _node->ToElement();
+			uint32 count = 0;
+			for (TiXmlNode const* child = element->FirstChild(); child; child = child->NextSibling())
+			{
+				if (child->ToElement() || child->ToText())
+				{
+					++count;
+				}
+			}
+			WriteHead(element, count, o_tree);
+			for (TiXmlNode const* child = element->FirstChild(); child; child = child->NextSibling())
+			{
+				if (child->ToElement() || child->ToText())
+				{
+					WriteNode(child, o_tree);
+				}
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::Intern>
+// Index of a string in the string table, adding it if it is new
+//-----------------------------------------------------------------------------
+		uint32 BinaryCache::Builder::Intern(char const* _str)
+		{
+			std::pair<std::unordered_map<string, uint32>::iterator, bool> result = m_index.insert(std::make_pair(string(_str), m_count));
+			if (result.second)
+			{
+				m_strings.insert(m_strings.end(), _str, _str + strlen(_str) + 1);
+				++m_count;
+			}
+			return result.first->second;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Builder::PutVarint>
+//-----------------------------------------------------------------------------
+		void BinaryCache::Builder::PutVarint(uint32 _value, std::vector<uint8>* o_tree)
+		{
+			while (_value >= 0x80)
+			{
+				o_tree->push_back((uint8) ((_value & 0x7f) | 0x80));
+				_value >>= 7;
+			}
+			o_tree->push_back((uint8) _value);
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Loader::Loader>
+// Constructor
+//-----------------------------------------------------------------------------
+		BinaryCache::Loader::Loader() :
+				m_data(NULL), m_size(0), m_pos(NULL), m_end(NULL), m_remaining(0), m_failed(false)
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Loader::~Loader>
+// Destructor
+//-----------------------------------------------------------------------------
+		BinaryCache::Loader::~Loader()
+		{
+#ifndef _WIN32
+			if (m_data && m_buffer.empty())
+			{
+				munmap((void*) m_data, m_size);
+			}
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Loader::Open>
+// Map a file and check it
+//-----------------------------------------------------------------------------
+		bool BinaryCache::Loader::Open(string const& _filename)
+		{
+			m_filename = _filename;
+#ifdef _WIN32
+			FILE* file = fopen(_filename.c_str(), "rb");
+			if (!file)
+			{
+				return false;
+			}
+			if (fseek(file, 0, SEEK_END) == 0)
+			{
+				long size = ftell(file);
+				if ((size > 0) && (fseek(file, 0, SEEK_SET) == 0))
+				{
+					m_buffer.resize(size);
+					if (fread(&m_buffer[0], size, 1, file) != 1)
+					{
+						m_buffer.clear();
+					}
+				}
+			}
+			fclose(file);
+			if (m_buffer.empty())
+			{
+				Log::Write(LogLevel_Warning, "%s is not a binary cache file", _filename.c_str());
+				return false;
+			}
+			m_data = &m_buffer[0];
+			m_size = m_buffer.size();
+#else
+			int fd = open(_filename.c_str(), O_RDONLY);
+			if (fd < 0)
+			{
+				return false;
+			}
+			struct stat st;
+			void* data = MAP_FAILED;
+			if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+			{
+				data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			}
+			close(fd);
+			if (data == MAP_FAILED)
+			{
+				Log::Write(LogLevel_Warning, "Unable to map %s", _filename.c_str());
+				return false;
+			}
+			m_data = (uint8 const*) data;
+			m_size = st.st_size;
+#endif
+
+			size_t treeSize;
+			if (!CheckFile(m_data, m_size, _filename, &m_strings, &m_pos, &treeSize))
+			{
+				return false;
+			}
+			m_end = m_pos + treeSize;
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Loader::ReadRoot>
+// Decode the root element without its children
+//-----------------------------------------------------------------------------
+		TiXmlElement* BinaryCache::Loader::ReadRoot()
+		{
+			// Open has checked that the tree starts with an element
+			Reader reader(m_pos + 1, m_end, m_strings);
+			TiXmlElement* root = reader.ReadHead(0, &m_remaining);
+			if (!root)
+			{
+				Log::Write(LogLevel_Warning, "%s is corrupt", m_filename.c_str());
+				m_failed = true;
+				m_remaining = 0;
+				return NULL;
+			}
+			m_pos = reader.GetPosition();
+			return root;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Loader::ReadChild>
+// Decode the next child element of the root
+//-----------------------------------------------------------------------------
+		TiXmlElement* BinaryCache::Loader::ReadChild()
+		{
+			while (m_remaining > 0)
+			{
+				--m_remaining;
+				Reader reader(m_pos, m_end, m_strings);
+				TiXmlNode* child = reader.ReadChild(1);
+				m_pos = reader.GetPosition();
+				if (!child)
+				{
+					Log::Write(LogLevel_Warning, "%s is corrupt", m_filename.c_str());
+					m_failed = true;
+					m_remaining = 0;
+					return NULL;
+				}
+				if (TiXmlElement* element = child->ToElement())
+				{
+					return element;
+				}
+				delete child;
+			}
+			if (!m_failed && (m_pos != m_end))
+			{
+				Log::Write(LogLevel_Warning, "%s is corrupt", m_filename.c_str());
+				m_failed = true;
+			}
+			return NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Crc32>
+// Standard CRC-32 (as used by zip), a nibble at a time.  Pass the result
+// of one call as _crc to continue it over another block
+//-----------------------------------------------------------------------------
+		uint32 BinaryCache::Crc32(uint32 const _crc, uint8 const* _data, size_t _length)
+		{
+			static uint32 const table[16] =
+			{ 0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c };
+
+			uint32 crc = ~_crc;
+			for (size_t i = 0; i < _length; ++i)
+			{
+				crc ^= _data[i];
+				crc = (crc >> 4) ^ table[crc & 0x0f];
+				crc = (crc >> 4) ^ table[crc & 0x0f];
+			}
+			return ~crc;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::IsBinaryCache>
+// Check the magic at the start of a file
+//-----------------------------------------------------------------------------
+		bool BinaryCache::IsBinaryCache(string const& _filename)
+		{
+			FILE* file = fopen(_filename.c_str(), "rb");
+			if (!file)
+			{
+				return false;
+			}
+			char magic[sizeof(c_magic)];
+			bool result = (fread(magic, sizeof(magic), 1, file) == 1) && (memcmp(magic, c_magic, sizeof(magic)) == 0);
+			fclose(file);
+			return result;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Load>
+// Read a whole binary cache file into a document
+//-----------------------------------------------------------------------------
+		bool BinaryCache::Load(string const& _filename, TiXmlDocument* _doc)
+		{
+			Loader loader;
+			if (!loader.Open(_filename))
+			{
+				return false;
+			}
+			TiXmlElement* root = loader.ReadRoot();
+			if (!root)
+			{
+				return false;
+			}
+			while (TiXmlElement* child = loader.ReadChild())
+			{
+				root->LinkEndChild(child);
+			}
+			if (loader.Failed())
+			{
+				delete root;
+				return false;
+			}
+			_doc->LinkEndChild(root);
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Decode>
+// Rebuild a document from binary cache data held in memory
+//-----------------------------------------------------------------------------
+		bool BinaryCache::Decode(uint8 const* _data, size_t const _size, string const& _name, TiXmlDocument* _doc)
+		{
+			std::vector<char const*> strings;
+			uint8 const* tree;
+			size_t treeSize;
+			if (!CheckFile(_data, _size, _name, &strings, &tree, &treeSize))
+			{
+				return false;
+			}
+
+			Reader reader(tree + 1, tree + treeSize, strings);
+			TiXmlElement* root = reader.ReadElement(0);
+			if (!root || (reader.GetPosition() != tree + treeSize))
+			{
+				delete root;
+				Log::Write(LogLevel_Warning, "%s is corrupt", _name.c_str());
+				return false;
+			}
+			_doc->LinkEndChild(root);
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Encode>
+// Build the binary form of an element and everything below it
+//-----------------------------------------------------------------------------
+		void BinaryCache::Encode(TiXmlElement const* _root, std::vector<uint8>* o_data)
+		{
+			Builder builder;
+			for (TiXmlNode const* child = _root->FirstChild(); child; child = child->NextSibling())
+			{
+				builder.AddChild(child);
+			}
+			builder.Finish(_root, o_data);
+		}
+
+//-----------------------------------------------------------------------------
+// <BinaryCache::Save>
+// Write a document to a binary cache file
+//-----------------------------------------------------------------------------
+		bool BinaryCache::Save(TiXmlDocument const& _doc, string const& _filename)
+		{
+			TiXmlElement const* root = _doc.RootElement();
+			if (!root)
+			{
+				return false;
+			}
+
+			Builder builder;
+			for (TiXmlNode const* child = root->FirstChild(); child; child = child->NextSibling())
+			{
+				builder.AddChild(child);
+			}
+			return builder.Save(root, _filename);
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,201 @@
+//-----------------------------------------------------------------------------
+//
+//	BinaryCache.h
+//
+//	Compact binary form of the network cache (ozwcache) documents
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _BinaryCache_H
+#define _BinaryCache_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Defs.h"
+
+class TiXmlDocument;
+class TiXmlElement;
+class TiXmlNode;
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \brief Reads and writes the network cache in a compact binary form.
+		 *
+		 * The binary form holds the same tree of elements, attributes and text as the XML
+		 * cache, so the code that reads and writes nodes, command classes and values is
+		 * shared by both formats.  What it saves is the cost of the text: every distinct
+		 * name and value is stored once in a string table, the tree refers to them by index,
+		 * and loading needs no tokenizing, entity decoding or whitespace handling.
+		 *
+		 * The driver does not build a document for the whole network from it.  Loader maps
+		 * the file and hands out the children of the root (the nodes) one at a time, and
+		 * Builder encodes them one at a time as they are written, so only one node is ever
+		 * held as TinyXML elements.
+		 *
+		 * Layout (all header fields little endian):
+		 * - char[8] magic "OZWCACHE", uint32 version, uint32 string count, uint32 string
+		 *   table size, uint32 tree size, uint32 CRC-32 of the string table and tree.
+		 * - String table: NUL terminated strings, so a loaded or mapped file can be used
+		 *   in place.
+		 * - Tree: one node, the root element.  An element is the byte 'E', then varint
+		 *   name index, varint attribute count, a varint name and value index for each
+		 *   attribute, varint child count, then the children.  Text is the byte 'T' and a
+		 *   varint string index.  Varints are unsigned LEB128.
+		 *
+		 * Comments and the XML declaration are not stored.
+		 */
+		class OPENZWAVE_EXPORT BinaryCache
+		{
+			public:
+				/** \brief Encodes a document one child of the root at a time.
+				 */
+				class Builder
+				{
+					public:
+						Builder();
+
+						/**
+						 * Encode an element or text that belongs under the root.  The caller
+						 * may delete it as soon as this returns.
+						 */
+						void AddChild(TiXmlNode const* _child);
+
+						/**
+						 * Build the file, with _root's name and attributes and the children
+						 * added so far.  Any children _root has itself are ignored.
+						 */
+						void Finish(TiXmlElement const* _root, std::vector<uint8>* o_data);
+
+						/**
+						 * Write the file, as Finish would build it, to a temporary name and
+						 * then rename it, so a crash part way through leaves the previous
+						 * cache in place.
+						 */
+						bool Save(TiXmlElement const* _root, string const& _filename);
+
+					private:
+						void WriteHead(TiXmlElement const* _element, uint32 const _childCount, std::vector<uint8>* o_tree);
+						void WriteNode(TiXmlNode const* _node, std::vector<uint8>* o_tree);
+						uint32 Intern(char const* _str);
+						static void PutVarint(uint32 _value, std::vector<uint8>* o_tree);
+
+						std::vector<uint8> m_strings;
+						std::vector<uint8> m_tree;			// The encoded children of the root
+						uint32 m_count;						// Strings in m_strings
+						uint32 m_children;					// Children in m_tree
+						std::unordered_map<string, uint32> m_index;
+				};
+
+				/** \brief Maps a binary cache file and decodes it one child of the root at a time.
+				 */
+				class Loader
+				{
+					public:
+						Loader();
+						~Loader();
+
+						/**
+						 * Map the file and check its header, checksum and string table.
+						 * \return false if the file is missing, is not a binary cache, has
+						 * an unsupported version or fails its checksum.
+						 */
+						bool Open(string const& _filename);
+
+						/**
+						 * Decode the root element's name and attributes.  Call once, after
+						 * Open.  The caller owns the element, which has no children.
+						 */
+						TiXmlElement* ReadRoot();
+
+						/**
+						 * Decode the next child element of the root, with everything below
+						 * it.  The caller owns the element.
+						 * \return NULL once every child has been read, or if the tree is
+						 * corrupt (see Failed).
+						 */
+						TiXmlElement* ReadChild();
+
+						bool Failed() const
+						{
+							return m_failed;
+						}
+
+					private:
+						Loader(Loader const&);					// prevent copy
+						Loader& operator =(Loader const&);		// prevent assignment
+
+						string m_filename;
+						uint8 const* m_data;				// The whole file
+						size_t m_size;
+						std::vector<uint8> m_buffer;		// Holds the file on platforms where it is read rather than mapped
+						std::vector<char const*> m_strings;
+						uint8 const* m_pos;					// Next unread byte of the tree
+						uint8 const* m_end;
+						uint32 m_remaining;					// Children of the root not yet read
+						bool m_failed;
+				};
+
+				/**
+				 * Test whether a file starts with the binary cache magic.
+				 */
+				static bool IsBinaryCache(string const& _filename);
+
+				/**
+				 * Load a whole binary cache file into _doc, which should be empty.
+				 * \return false if the file is missing, is not a binary cache, has an
+				 * unsupported version or fails its checksum.
+				 */
+				static bool Load(string const& _filename, TiXmlDocument* _doc);
+
+				/**
+				 * Write the root element of _doc to a binary cache file, as Builder::Save does.
+				 */
+				static bool Save(TiXmlDocument const& _doc, string const& _filename);
+
+				/**
+				 * Build the binary form of _root and everything below it, as it would
+				 * be written to a file.
+				 */
+				static void Encode(TiXmlElement const* _root, std::vector<uint8>* o_data);
+
+				/**
+				 * Rebuild a document from binary data held in memory, such as a file
+				 * that has been read or mapped.  _name is only used in log messages.
+				 */
+				static bool Decode(uint8 const* _data, size_t const _size, string const& _name, TiXmlDocument* _doc);
+
+				/**
+				 * Standard CRC-32, as used by zip.  Pass the result of one call as _crc
+				 * to continue it over another block, or 0 to start.
+				 */
+				static uint32 Crc32(uint32 const _crc, uint8 const* _data, size_t _length);
+
+				static uint32 const c_version = 1;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_BinaryCache_H
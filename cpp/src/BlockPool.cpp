@@ -0,0 +1,154 @@
+//-----------------------------------------------------------------------------
+//
+//	BlockPool.cpp
+//
+//	Free lists of fixed-size blocks for objects created and destroyed at a high rate
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "BlockPool.h"
+#include "platform/Mutex.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		BlockPool* BlockPool::s_pools = NULL;
+
+		namespace
+		{
+			// Guards s_pools.  Never freed, like the pools themselves.
+			Platform::Mutex& PoolsMutex()
+			{
+				static Platform::Mutex* mutex = new Platform::Mutex();
+				return *mutex;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <BlockPool::BlockPool>
+// Constructor
+//-----------------------------------------------------------------------------
+		BlockPool::BlockPool(size_t _blockSize, uint32 _maxFree) :
+				m_blockSize(_blockSize < sizeof(Block) ? sizeof(Block) : _blockSize), m_maxFree(_maxFree), m_free(NULL), m_mutex(new Platform::Mutex()), m_nextPool(NULL)
+		{
+			memset(&m_stats, 0, sizeof(m_stats));
+
+			Platform::Mutex& mutex = PoolsMutex();
+			mutex.Lock();
+			m_nextPool = s_pools;
+			s_pools = this;
+			mutex.Unlock();
+		}
+
+//-----------------------------------------------------------------------------
+// <BlockPool::~BlockPool>
+// Destructor
+//-----------------------------------------------------------------------------
+		BlockPool::~BlockPool()
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <BlockPool::Alloc>
+// Take a block from the free list, or from the heap if it is empty
+//-----------------------------------------------------------------------------
+		void* BlockPool::Alloc()
+		{
+			m_mutex->Lock();
+			m_stats.m_allocs++;
+			m_stats.m_inUse++;
+			Block* block = m_free;
+			if (block)
+			{
+				m_free = block->m_next;
+				m_stats.m_free--;
+				m_mutex->Unlock();
+				return block;
+			}
+			m_stats.m_heapAllocs++;
+			m_mutex->Unlock();
+			return ::operator new(m_blockSize);
+		}
+
+//-----------------------------------------------------------------------------
+// <BlockPool::Free>
+// Put a block back on the free list, or back on the heap if the list is full
+//-----------------------------------------------------------------------------
+		void BlockPool::Free(void* _block)
+		{
+			if (!_block)
+			{
+				return;
+			}
+			m_mutex->Lock();
+			m_stats.m_inUse--;
+			if (m_stats.m_free < m_maxFree)
+			{
+				Block* block = static_cast<Block*>(_block);
+				block->m_next = m_free;
+				m_free = block;
+				m_stats.m_free++;
+				m_mutex->Unlock();
+				return;
+			}
+			m_mutex->Unlock();
+			::operator delete(_block);
+		}
+
+//-----------------------------------------------------------------------------
+// <BlockPool::GetStatistics>
+// Counters for this pool
+//-----------------------------------------------------------------------------
+		void BlockPool::GetStatistics(Statistics* o_stats)
+		{
+			m_mutex->Lock();
+			*o_stats = m_stats;
+			m_mutex->Unlock();
+		}
+
+//-----------------------------------------------------------------------------
+// <BlockPool::GetTotals>
+// Counters summed over every pool
+//-----------------------------------------------------------------------------
+		void BlockPool::GetTotals(Statistics* o_stats)
+		{
+			memset(o_stats, 0, sizeof(*o_stats));
+
+			Platform::Mutex& mutex = PoolsMutex();
+			mutex.Lock();
+			for (BlockPool* pool = s_pools; pool; pool = pool->m_nextPool)
+			{
+				Statistics stats;
+				pool->GetStatistics(&stats);
+				o_stats->m_allocs += stats.m_allocs;
+				o_stats->m_heapAllocs += stats.m_heapAllocs;
+				o_stats->m_inUse += stats.m_inUse;
+				o_stats->m_free += stats.m_free;
+			}
+			mutex.Unlock();
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------------------
+//
+//	BlockPool.h
+//
+//	Free lists of fixed-size blocks for objects created and destroyed at a high rate
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _BlockPool_H
+#define _BlockPool_H
+
+#include <cstddef>
+#include <new>
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+
+		/** \brief A free list of blocks of one size.
+		 *
+		 * Freed blocks are kept for reuse rather than returned to the heap, up to a
+		 * limit, so once the number of objects in use has reached its usual peak, creating
+		 * and destroying them no longer allocates.  Pools are never destroyed, so objects
+		 * may be freed at any time, even during shutdown.
+		 */
+		class OPENZWAVE_EXPORT BlockPool
+		{
+			public:
+				struct Statistics
+				{
+						uint32 m_allocs;		// Number of blocks handed out
+						uint32 m_heapAllocs;	// Number of those that had to come from the heap
+						uint32 m_inUse;			// Number of blocks handed out and not yet freed
+						uint32 m_free;			// Number of blocks held for reuse
+				};
+
+				/**
+				 * \param _blockSize Size of each block.
+				 * \param _maxFree Number of freed blocks to keep; any more are returned to the heap.
+				 */
+				BlockPool(size_t _blockSize, uint32 _maxFree);
+
+				void* Alloc();
+				void Free(void* _block);
+
+				size_t GetBlockSize() const
+				{
+					return m_blockSize;
+				}
+				void GetStatistics(Statistics* o_stats);
+
+				/**
+				 * Sum the statistics of every pool in the process.
+				 */
+				static void GetTotals(Statistics* o_stats);
+
+			private:
+				~BlockPool();						// Pools live for the life of the process
+				BlockPool(BlockPool const&);		// prevent copy
+				BlockPool& operator =(BlockPool const&);	// prevent assignment
+
+				struct Block
+				{
+						Block* m_next;
+				};
+
+				size_t m_blockSize;
+				uint32 m_maxFree;
+				Block* m_free;
+				Platform::Mutex* m_mutex;
+				Statistics m_stats;
+				BlockPool* m_nextPool;				// Every pool, for GetTotals
+
+				static BlockPool* s_pools;
+		};
+
+		/** \brief Standard allocator drawing single objects from a BlockPool.
+		 *
+		 * For the nodes of node-based containers such as list, so that inserting and
+		 * removing entries reuses the same memory.  There is one pool for each type the
+		 * allocator is rebound to; allocations of more than one object go to the heap.
+		 */
+		template<class T> class PoolAllocator
+		{
+			public:
+				typedef T value_type;
+				typedef T* pointer;
+				typedef T const* const_pointer;
+				typedef T& reference;
+				typedef T const& const_reference;
+				typedef size_t size_type;
+				typedef ptrdiff_t difference_type;
+
+				template<class U> struct rebind
+				{
+						typedef PoolAllocator<U> other;
+				};
+
+				PoolAllocator()
+				{
+				}
+				template<class U> PoolAllocator(PoolAllocator<U> const&)
+				{
+				}
+
+				T* allocate(size_t _count, void const* = 0)
+				{
+					if (_count == 1)
+					{
+						return static_cast<T*>(GetPool().Alloc());
+					}
+					return static_cast<T*>(::operator new(_count * sizeof(T)));
+				}
+				void deallocate(T* _p, size_t _count)
+				{
+					if (_count == 1)
+					{
+						GetPool().Free(_p);
+					}
+					else
+					{
+						::operator delete(_p);
+					}
+				}
+
+				template<class U> void construct(U* _p, U const& _value)
+				{
+					new (_p) U(_value);
+				}
+				template<class U> void destroy(U* _p)
+				{
+					_p->~U();
+				}
+
+				T* address(T& _r) const
+				{
+					return &_r;
+				}
+				T const* address(T const& _r) const
+				{
+					return &_r;
+				}
+				size_t max_size() const
+				{
+					return ((size_t) -1) / sizeof(T);
+				}
+
+				bool operator ==(PoolAllocator const&) const
+				{
+					return true;
+				}
+				bool operator !=(PoolAllocator const&) const
+				{
+					return false;
+				}
+
+				static BlockPool& GetPool()
+				{
+					static BlockPool* pool = new BlockPool(sizeof(T), 256);
+					return *pool;
+				}
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_BlockPool_H
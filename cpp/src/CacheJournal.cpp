@@ -0,0 +1,295 @@
+//-----------------------------------------------------------------------------
+//
+//	CacheJournal.cpp
+//
+//	Journal of node changes appended to the network cache between full saves
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "CacheJournal.h"
+#include "BinaryCache.h"
+#include "platform/Log.h"
+#include "tinyxml.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace
+		{
+			char const c_magic[8] =
+			{ 'O', 'Z', 'W', 'J', 'R', 'N', 'L', 0 };
+			size_t const c_headerSize = 16;
+			size_t const c_recordHeaderSize = 12;
+
+			uint8 const c_kindNode = 'N';
+			uint8 const c_kindRemoved = 'R';
+
+			void PutUInt32(uint8* _buffer, uint32 const _value)
+			{
+				_buffer[0] = (uint8) (_value & 0xff);
+				_buffer[1] = (uint8) ((_value >> 8) & 0xff);
+				_buffer[2] = (uint8) ((_value >> 16) & 0xff);
+				_buffer[3] = (uint8) ((_value >> 24) & 0xff);
+			}
+
+			uint32 GetUInt32(uint8 const* _buffer)
+			{
+				return ((uint32) _buffer[0]) | (((uint32) _buffer[1]) << 8) | (((uint32) _buffer[2]) << 16) | (((uint32) _buffer[3]) << 24);
+			}
+
+			//-----------------------------------------------------------------------------
+			// <FindNode>
+			// Find the Node element for a node id among the children of the Driver element
+			//-----------------------------------------------------------------------------
+			TiXmlElement* FindNode(TiXmlElement* _driverElement, uint8 const _nodeId)
+			{
+				for (TiXmlElement* element = _driverElement->FirstChildElement("Node"); element; element = element->NextSiblingElement("Node"))
+				{
+					int id;
+					if ((TIXML_SUCCESS == element->QueryIntAttribute("id", &id)) && (id == _nodeId))
+					{
+						return element;
+					}
+				}
+				return NULL;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <CacheJournal::CacheJournal>
+// Constructor
+//-----------------------------------------------------------------------------
+		CacheJournal::CacheJournal(string const& _filename, uint32 const _generation) :
+				m_filename(_filename), m_generation(_generation), m_count(0)
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <CacheJournal::AddNode>
+// Add a record holding a node, or noting that it has gone
+//-----------------------------------------------------------------------------
+		void CacheJournal::AddNode(uint8 const _nodeId, TiXmlElement const* _nodeElement)
+		{
+			TiXmlPrinter printer;
+			if (_nodeElement)
+			{
+				printer.SetStreamPrinting();
+				_nodeElement->Accept(&printer);
+			}
+
+			size_t start = m_records.size();
+			m_records.resize(start + c_recordHeaderSize + printer.Size());
+			uint8* record = &m_records[start];
+			PutUInt32(record, (uint32) printer.Size());
+			record[4] = _nodeId;
+			record[5] = _nodeElement ? c_kindNode : c_kindRemoved;
+			record[6] = 0;
+			record[7] = 0;
+			if (printer.Size())
+			{
+				memcpy(&record[c_recordHeaderSize], printer.CStr(), printer.Size());
+			}
+			uint32 crc = BinaryCache::Crc32(0, &record[4], 4);
+			PutUInt32(&record[8], BinaryCache::Crc32(crc, &record[c_recordHeaderSize], printer.Size()));
+			++m_count;
+		}
+
+//-----------------------------------------------------------------------------
+// <CacheJournal::Commit>
+// Append the records to the journal file
+//-----------------------------------------------------------------------------
+		bool CacheJournal::Commit(uint32* io_size)
+		{
+			if (m_records.empty())
+			{
+				return true;
+			}
+
+			bool const start = (*io_size == 0);
+			FILE* file = fopen(m_filename.c_str(), start ? "wb" : "ab");
+			if (!file)
+			{
+				Log::Write(LogLevel_Warning, "Unable to open %s", m_filename.c_str());
+				return false;
+			}
+
+			bool ok = true;
+			if (start)
+			{
+				uint8 header[c_headerSize];
+				memcpy(header, c_magic, sizeof(c_magic));
+				PutUInt32(&header[8], c_version);
+				PutUInt32(&header[12], m_generation);
+				ok = (fwrite(header, sizeof(header), 1, file) == 1);
+			}
+			ok = ok && (fwrite(&m_records[0], m_records.size(), 1, file) == 1) && (fflush(file) == 0);
+			// The point of the journal is to survive a crash, so wait for the data to reach the disk
+#ifdef _WIN32
+			ok = ok && (_commit(_fileno(file)) == 0);
+#else
+			ok = ok && (fsync(fileno(file)) == 0);
+#endif
+			ok = (fclose(file) == 0) && ok;
+			if (!ok)
+			{
+				Log::Write(LogLevel_Warning, "Unable to write %s", m_filename.c_str());
+				return false;
+			}
+
+			*io_size = (start ? (uint32) c_headerSize : *io_size) + (uint32) m_records.size();
+			m_records.clear();
+			m_count = 0;
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <CacheJournal::Apply>
+// Apply the records in a journal to the Driver element of a loaded cache
+//-----------------------------------------------------------------------------
+		bool CacheJournal::Apply(string const& _filename, uint32 const _generation, TiXmlElement* _driverElement, uint32* o_size, bool* o_nodes)
+		{
+			*o_size = 0;
+			FILE* file = fopen(_filename.c_str(), "rb");
+			if (!file)
+			{
+				// No changes since the cache was saved
+				return true;
+			}
+
+			std::vector<uint8> data;
+			if (fseek(file, 0, SEEK_END) == 0)
+			{
+				long size = ftell(file);
+				if ((size > 0) && (fseek(file, 0, SEEK_SET) == 0))
+				{
+					data.resize(size);
+					if (fread(&data[0], size, 1, file) != 1)
+					{
+						data.clear();
+					}
+				}
+			}
+			fclose(file);
+
+			if ((data.size() < c_headerSize) || (memcmp(&data[0], c_magic, sizeof(c_magic)) != 0) || (GetUInt32(&data[8]) != c_version))
+			{
+				Log::Write(LogLevel_Warning, "Ignoring %s as it is not a cache journal this version can read", _filename.c_str());
+				return true;
+			}
+			if (GetUInt32(&data[12]) != _generation)
+			{
+				// Left over from before the cache was last saved
+				Log::Write(LogLevel_Info, "Ignoring %s as it belongs to an earlier cache", _filename.c_str());
+				return true;
+			}
+
+			uint32 count = 0;
+			size_t pos = c_headerSize;
+			bool damaged = false;
+			while (pos < data.size())
+			{
+				uint8 const* record = &data[pos];
+				if ((data.size() - pos) < c_recordHeaderSize)
+				{
+					damaged = true;
+					break;
+				}
+				uint32 length = GetUInt32(record);
+				if ((data.size() - pos - c_recordHeaderSize) < length)
+				{
+					damaged = true;
+					break;
+				}
+				uint32 crc = BinaryCache::Crc32(0, &record[4], 4);
+				if (BinaryCache::Crc32(crc, &record[c_recordHeaderSize], length) != GetUInt32(&record[8]))
+				{
+					damaged = true;
+					break;
+				}
+
+				uint8 nodeId = record[4];
+				TiXmlElement* existing = FindNode(_driverElement, nodeId);
+				if (record[5] == c_kindNode)
+				{
+					TiXmlDocument doc;
+					string text((char const*) &record[c_recordHeaderSize], length);
+					doc.Parse(text.c_str(), NULL, TIXML_ENCODING_UTF8);
+					TiXmlElement const* nodeElement = doc.RootElement();
+					if (doc.Error() || !nodeElement)
+					{
+						damaged = true;
+						break;
+					}
+					if (existing)
+					{
+						_driverElement->ReplaceChild(existing, *nodeElement);
+					}
+					else
+					{
+						_driverElement->InsertEndChild(*nodeElement);
+					}
+				}
+				else if (existing)
+				{
+					_driverElement->RemoveChild(existing);
+				}
+
+				if (o_nodes)
+				{
+					o_nodes[nodeId] = true;
+				}
+				++count;
+				pos += c_recordHeaderSize + length;
+			}
+
+			if (damaged)
+			{
+				Log::Write(LogLevel_Warning, "%s ends in a damaged record.  Using the %d records before it", _filename.c_str(), count);
+			}
+			else
+			{
+				Log::Write(LogLevel_Info, "Applied %d records from %s", count, _filename.c_str());
+			}
+			*o_size = (uint32) pos;
+			return !damaged;
+		}
+
+//-----------------------------------------------------------------------------
+// <CacheJournal::Discard>
+// Remove a journal file
+//-----------------------------------------------------------------------------
+		void CacheJournal::Discard(string const& _filename)
+		{
+			remove(_filename.c_str());
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------------------
+//
+//	CacheJournal.h
+//
+//	Journal of node changes appended to the network cache between full saves
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _CacheJournal_H
+#define _CacheJournal_H
+
+#include <string>
+#include <vector>
+#include "Defs.h"
+
+class TiXmlElement;
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \brief Appends changed nodes to the network cache without rewriting it.
+		 *
+		 * Each record holds the complete Node element of one node, or notes that the node
+		 * is no longer in the cache.  When the cache is loaded, the records are applied to
+		 * it in order, so the last record for a node wins.  The driver folds the journal
+		 * back into the cache by saving the whole cache again, which starts a new journal.
+		 *
+		 * The journal header carries the generation of the cache file it applies to, and a
+		 * full save gives the cache a new generation, so a journal left behind by a crash
+		 * between saving the cache and removing the journal is ignored.  Every record has a
+		 * CRC-32, and a record cut short by a crash ends the journal.
+		 *
+		 * Layout (little endian): char[8] magic "OZWJRNL", uint32 version, uint32
+		 * generation, then records of uint32 payload length, uint8 node id, uint8 kind
+		 * ('N' node, 'R' removed), uint16 zero, uint32 CRC-32 of the node id to the end of
+		 * the payload, and the payload, which is the Node element as XML.
+		 */
+		class OPENZWAVE_EXPORT CacheJournal
+		{
+			public:
+				CacheJournal(string const& _filename, uint32 const _generation);
+
+				/**
+				 * Add a record for a node.
+				 * \param _nodeElement The node as written by Node::WriteXML, or NULL if the
+				 * node should no longer be in the cache.
+				 */
+				void AddNode(uint8 const _nodeId, TiXmlElement const* _nodeElement);
+
+				uint32 GetCount() const
+				{
+					return m_count;
+				}
+
+				/**
+				 * Append the records to the journal file and flush them to disk.
+				 * \param io_size Size of the valid journal on disk.  If it is 0, a new
+				 * journal is started.  Updated to the new size.
+				 * \return false if the records could not be written.  The file may then
+				 * end in a partial record, so the caller should save the whole cache.
+				 */
+				bool Commit(uint32* io_size);
+
+				/**
+				 * Apply a journal to a loaded cache.
+				 * \param _generation Generation of the loaded cache.  A journal for another
+				 * generation is ignored.
+				 * \param o_size Set to the size of the journal that was applied, or 0 if
+				 * there is none to append to.
+				 * \param o_nodes If not NULL, 256 flags, set for each node that has a
+				 * record in the journal.
+				 * \return false if the journal ends in a damaged record.  The records
+				 * before it are still applied.
+				 */
+				static bool Apply(string const& _filename, uint32 const _generation, TiXmlElement* _driverElement, uint32* o_size, bool* o_nodes = NULL);
+
+				/**
+				 * Remove a journal once the cache it applies to has been replaced.
+				 */
+				static void Discard(string const& _filename);
+
+				static uint32 const c_version = 1;
+
+			private:
+				string m_filename;
+				uint32 m_generation;
+				uint32 m_count;
+				std::vector<uint8> m_records;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_CacheJournal_H
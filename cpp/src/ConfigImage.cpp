@@ -0,0 +1,455 @@
+//-----------------------------------------------------------------------------
+//
+//	ConfigImage.cpp
+//
+//	Precompiled image of the config directory
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "ConfigImage.h"
+#include "BinaryCache.h"
+#include "Options.h"
+#include "platform/Log.h"
+#include "tinyxml.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace
+		{
+			char const c_magic[8] =
+			{ 'O', 'Z', 'W', 'C', 'F', 'G', 'I', 'M' };
+			size_t const c_headerSize = 32;
+			size_t const c_entrySize = 40;
+
+			uint32 const c_flagRevision = 0x01;		// The revision field holds the file's Revision attribute
+
+			void PutUInt32(uint8* _buffer, uint32 const _value)
+			{
+				_buffer[0] = (uint8) (_value & 0xff);
+				_buffer[1] = (uint8) ((_value >> 8) & 0xff);
+				_buffer[2] = (uint8) ((_value >> 16) & 0xff);
+				_buffer[3] = (uint8) ((_value >> 24) & 0xff);
+			}
+
+			uint32 GetUInt32(uint8 const* _buffer)
+			{
+				return ((uint32) _buffer[0]) | (((uint32) _buffer[1]) << 8) | (((uint32) _buffer[2]) << 16) | (((uint32) _buffer[3]) << 24);
+			}
+
+			void PutInt64(uint8* _buffer, int64 const _value)
+			{
+				PutUInt32(_buffer, (uint32) (((uint64) _value) & 0xffffffff));
+				PutUInt32(&_buffer[4], (uint32) (((uint64) _value) >> 32));
+			}
+
+			int64 GetInt64(uint8 const* _buffer)
+			{
+				return (int64) (((uint64) GetUInt32(_buffer)) | (((uint64) GetUInt32(&_buffer[4])) << 32));
+			}
+
+			//-----------------------------------------------------------------------------
+			// <GetSource>
+			// Size and modification time of a config file
+			//-----------------------------------------------------------------------------
+			bool GetSource(string const& _filename, uint32* o_size, int64* o_time)
+			{
+				struct stat st;
+				if (stat(_filename.c_str(), &st) != 0)
+				{
+					return false;
+				}
+				*o_size = (uint32) st.st_size;
+				*o_time = (int64) st.st_mtime;
+				return true;
+			}
+
+			// A file being compiled into the image
+			struct Source
+			{
+					string m_path;
+					std::vector<uint8> m_data;
+					uint32 m_size;
+					int64 m_time;
+					uint32 m_revision;
+					uint32 m_flags;
+
+					bool operator <(Source const& _other) const
+					{
+						return m_path < _other.m_path;
+					}
+			};
+		}
+
+		ConfigImage* ConfigImage::s_instance = NULL;
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::ConfigImage>
+// Constructor
+//-----------------------------------------------------------------------------
+		ConfigImage::ConfigImage() :
+				m_data(NULL), m_size(0), m_count(0)
+		{
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::~ConfigImage>
+// Destructor
+//-----------------------------------------------------------------------------
+		ConfigImage::~ConfigImage()
+		{
+#ifndef _WIN32
+			if (m_data && m_buffer.empty())
+			{
+				munmap((void*) m_data, m_size);
+			}
+#endif
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::Create>
+// Map the image, if there is one
+//-----------------------------------------------------------------------------
+		void ConfigImage::Create()
+		{
+			if (s_instance)
+			{
+				return;
+			}
+			bool useImage = true;
+			Options::Get()->GetOptionAsBool("ConfigImage", &useImage);
+			if (!useImage)
+			{
+				return;
+			}
+
+			ConfigImage* image = new ConfigImage();
+			Options::Get()->GetOptionAsString("ConfigPath", &image->m_configPath);
+			string filename = image->m_configPath + "ozwconfig.bin";
+			if (!image->Open(filename))
+			{
+				delete image;
+				return;
+			}
+			Log::Write(LogLevel_Info, "Using config image %s holding %d files", filename.c_str(), image->m_count);
+			s_instance = image;
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::Destroy>
+// Unmap the image
+//-----------------------------------------------------------------------------
+		void ConfigImage::Destroy()
+		{
+			delete s_instance;
+			s_instance = NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::Open>
+// Map an image and check its header and index
+//-----------------------------------------------------------------------------
+		bool ConfigImage::Open(string const& _filename)
+		{
+#ifdef _WIN32
+			FILE* file = fopen(_filename.c_str(), "rb");
+			if (!file)
+			{
+				return false;
+			}
+			if (fseek(file, 0, SEEK_END) == 0)
+			{
+				long size = ftell(file);
+				if ((size > 0) && (fseek(file, 0, SEEK_SET) == 0))
+				{
+					m_buffer.resize(size);
+					if (fread(&m_buffer[0], size, 1, file) != 1)
+					{
+						m_buffer.clear();
+					}
+				}
+			}
+			fclose(file);
+			if (m_buffer.empty())
+			{
+				Log::Write(LogLevel_Warning, "Unable to read config image %s", _filename.c_str());
+				return false;
+			}
+			m_data = &m_buffer[0];
+			m_size = m_buffer.size();
+#else
+			int fd = open(_filename.c_str(), O_RDONLY);
+			if (fd < 0)
+			{
+				return false;
+			}
+			struct stat st;
+			void* data = MAP_FAILED;
+			if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+			{
+				data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			}
+			close(fd);
+			if (data == MAP_FAILED)
+			{
+				Log::Write(LogLevel_Warning, "Unable to map config image %s", _filename.c_str());
+				return false;
+			}
+			m_data = (uint8 const*) data;
+			m_size = st.st_size;
+#endif
+
+			if ((m_size < c_headerSize) || (memcmp(m_data, c_magic, sizeof(c_magic)) != 0))
+			{
+				Log::Write(LogLevel_Warning, "%s is not a config image", _filename.c_str());
+				return false;
+			}
+			if (GetUInt32(&m_data[8]) != c_version)
+			{
+				Log::Write(LogLevel_Warning, "%s is config image version %d, but only version %d is supported.  Using the XML config files", _filename.c_str(), GetUInt32(&m_data[8]), c_version);
+				return false;
+			}
+			m_count = GetUInt32(&m_data[12]);
+			uint64 indexEnd = c_headerSize + ((uint64) m_count * c_entrySize) + GetUInt32(&m_data[16]);
+			if ((indexEnd > m_size) || (BinaryCache::Crc32(0, &m_data[c_headerSize], (size_t) (indexEnd - c_headerSize)) != GetUInt32(&m_data[20])))
+			{
+				Log::Write(LogLevel_Warning, "%s is corrupt", _filename.c_str());
+				return false;
+			}
+
+			// Check every entry now, so lookups can trust the offsets
+			uint64 paths = c_headerSize + ((uint64) m_count * c_entrySize);
+			for (uint32 i = 0; i < m_count; ++i)
+			{
+				uint8 const* entry = &m_data[c_headerSize + (i * c_entrySize)];
+				if (((paths + GetUInt32(entry) + GetUInt32(&entry[4])) > indexEnd) || (((uint64) GetUInt32(&entry[8]) + GetUInt32(&entry[12])) > m_size))
+				{
+					Log::Write(LogLevel_Warning, "%s is corrupt", _filename.c_str());
+					return false;
+				}
+			}
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::Find>
+// Find the entry for a config file, if the image holds a current copy of it
+//-----------------------------------------------------------------------------
+		uint8 const* ConfigImage::Find(string const& _filename) const
+		{
+			if (_filename.compare(0, m_configPath.size(), m_configPath) != 0)
+			{
+				return NULL;
+			}
+			string path = _filename.substr(m_configPath.size());
+			std::replace(path.begin(), path.end(), '\\', '/');
+
+			char const* paths = (char const*) &m_data[c_headerSize + (m_count * c_entrySize)];
+			uint32 low = 0;
+			uint32 high = m_count;
+			while (low < high)
+			{
+				uint32 mid = low + ((high - low) / 2);
+				uint8 const* entry = &m_data[c_headerSize + (mid * c_entrySize)];
+				int cmp = path.compare(0, string::npos, &paths[GetUInt32(entry)], GetUInt32(&entry[4]));
+				if (cmp == 0)
+				{
+					// Only use it if the file has not changed since the image was built
+					uint32 size;
+					int64 time;
+					if (!GetSource(_filename, &size, &time) || (size != GetUInt32(&entry[16])) || (time != GetInt64(&entry[32])))
+					{
+						Log::Write(LogLevel_Detail, "%s has changed since the config image was built", _filename.c_str());
+						return NULL;
+					}
+					return entry;
+				}
+				if (cmp < 0)
+				{
+					high = mid;
+				}
+				else
+				{
+					low = mid + 1;
+				}
+			}
+			return NULL;
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::LoadFile>
+// Load a config file from the image, or from its XML
+//-----------------------------------------------------------------------------
+		bool ConfigImage::LoadFile(string const& _filename, TiXmlDocument* _doc)
+		{
+			if (s_instance)
+			{
+				if (uint8 const* entry = s_instance->Find(_filename))
+				{
+					if (BinaryCache::Decode(&s_instance->m_data[GetUInt32(&entry[8])], GetUInt32(&entry[12]), _filename, _doc))
+					{
+						return true;
+					}
+					_doc->Clear();
+				}
+			}
+			return _doc->LoadFile(_filename.c_str(), TIXML_ENCODING_UTF8);
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::GetRevision>
+// Look up the revision of a device config file
+//-----------------------------------------------------------------------------
+		bool ConfigImage::GetRevision(string const& _filename, uint32* o_revision)
+		{
+			if (s_instance)
+			{
+				uint8 const* entry = s_instance->Find(_filename);
+				if (entry && (GetUInt32(&entry[24]) & c_flagRevision))
+				{
+					*o_revision = GetUInt32(&entry[20]);
+					return true;
+				}
+			}
+			return false;
+		}
+
+//-----------------------------------------------------------------------------
+// <ConfigImage::Build>
+// Compile config files into an image
+//-----------------------------------------------------------------------------
+		bool ConfigImage::Build(string const& _configPath, std::vector<string> const& _files, string const& _imageFile)
+		{
+			bool ok = true;
+			std::vector<Source> sources;
+			sources.reserve(_files.size());
+			for (std::vector<string>::const_iterator it = _files.begin(); it != _files.end(); ++it)
+			{
+				string filename = _configPath + *it;
+				Source source;
+				source.m_path = *it;
+				std::replace(source.m_path.begin(), source.m_path.end(), '\\', '/');
+				source.m_revision = 0;
+				source.m_flags = 0;
+
+				TiXmlDocument doc;
+				if (!GetSource(filename, &source.m_size, &source.m_time) || !doc.LoadFile(filename.c_str(), TIXML_ENCODING_UTF8) || !doc.RootElement())
+				{
+					Log::Write(LogLevel_Warning, "Unable to load %s: %s", filename.c_str(), doc.ErrorDesc());
+					ok = false;
+					continue;
+				}
+				TiXmlElement const* root = doc.RootElement();
+				BinaryCache::Encode(root, &source.m_data);
+
+				// The same test as ManufacturerSpecificDB::LoadConfigFileRevision
+				char const* str = root->Value();
+				if (str && !strcmp(str, "Product"))
+				{
+					str = root->Attribute("xmlns");
+					char const* revision = root->Attribute("Revision");
+					if ((!str || !strcmp(str, "https://github.com/OpenZWave/open-zwave")) && revision)
+					{
+						source.m_revision = (uint32) atol(revision);
+						source.m_flags |= c_flagRevision;
+					}
+				}
+				sources.push_back(source);
+			}
+			std::sort(sources.begin(), sources.end());
+
+			// Lay out the index, then the paths, then the data
+			std::vector<uint8> index(c_headerSize + (sources.size() * c_entrySize));
+			string paths;
+			for (std::vector<Source>::const_iterator it = sources.begin(); it != sources.end(); ++it)
+			{
+				paths += it->m_path;
+			}
+			uint32 pathOffset = 0;
+			uint32 dataOffset = (uint32) (index.size() + paths.size());
+			for (size_t i = 0; i < sources.size(); ++i)
+			{
+				Source const& source = sources[i];
+				uint8* entry = &index[c_headerSize + (i * c_entrySize)];
+				PutUInt32(entry, pathOffset);
+				PutUInt32(&entry[4], (uint32) source.m_path.size());
+				PutUInt32(&entry[8], dataOffset);
+				PutUInt32(&entry[12], (uint32) source.m_data.size());
+				PutUInt32(&entry[16], source.m_size);
+				PutUInt32(&entry[20], source.m_revision);
+				PutUInt32(&entry[24], source.m_flags);
+				PutInt64(&entry[32], source.m_time);
+				pathOffset += (uint32) source.m_path.size();
+				dataOffset += (uint32) source.m_data.size();
+			}
+			index.insert(index.end(), paths.begin(), paths.end());
+
+			memcpy(&index[0], c_magic, sizeof(c_magic));
+			PutUInt32(&index[8], c_version);
+			PutUInt32(&index[12], (uint32) sources.size());
+			PutUInt32(&index[16], (uint32) paths.size());
+			PutUInt32(&index[20], BinaryCache::Crc32(0, &index[c_headerSize], index.size() - c_headerSize));
+
+			string tempname = _imageFile + ".tmp";
+			FILE* file = fopen(tempname.c_str(), "wb");
+			if (!file)
+			{
+				Log::Write(LogLevel_Warning, "Unable to create %s", tempname.c_str());
+				return false;
+			}
+			bool written = (fwrite(&index[0], index.size(), 1, file) == 1);
+			for (std::vector<Source>::const_iterator it = sources.begin(); written && (it != sources.end()); ++it)
+			{
+				written = (fwrite(&it->m_data[0], it->m_data.size(), 1, file) == 1);
+			}
+			written = (fclose(file) == 0) && written;
+#ifdef _WIN32
+			// rename will not replace an existing file
+			if (written)
+			{
+				remove(_imageFile.c_str());
+			}
+#endif
+			if (!written || (rename(tempname.c_str(), _imageFile.c_str()) != 0))
+			{
+				Log::Write(LogLevel_Warning, "Unable to write %s", _imageFile.c_str());
+				remove(tempname.c_str());
+				return false;
+			}
+			return ok;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
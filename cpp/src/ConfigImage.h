@@ -0,0 +1,117 @@
+//-----------------------------------------------------------------------------
+//
+//	ConfigImage.h
+//
+//	Precompiled image of the config directory
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ConfigImage_H
+#define _ConfigImage_H
+
+#include <string>
+#include <vector>
+#include "Defs.h"
+
+class TiXmlDocument;
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \brief All the XML files in the config directory, compiled into one file.
+		 *
+		 * The image (ozwconfig.bin in the config directory, built by the ConfigCompile tool)
+		 * holds every config file already parsed, in the form written by BinaryCache, and
+		 * an index sorted by path.  It is mapped read-only when the Manager is created, so
+		 * loading a config file needs no XML parsing, and the revision of each device
+		 * config file can be looked up without loading it at all.
+		 *
+		 * Every entry records the size and modification time of the file it was built
+		 * from.  A file that has since changed (for instance by a config download) or that
+		 * is not in the image is read from the XML as before, as is everything when there
+		 * is no image or it is for another version.
+		 *
+		 * Layout (little endian): char[8] magic "OZWCFGIM", uint32 version, uint32 entry
+		 * count, uint32 size of the path strings, uint32 CRC-32 of the index and paths,
+		 * uint32[2] zero.  Then the index entries, sorted by path: uint32 path offset,
+		 * uint32 path length, uint32 data offset, uint32 data size, uint32 source size,
+		 * uint32 revision, uint32 flags, uint32 zero, int64 source modification time.
+		 * Then the paths (relative to the config directory, '/' separated), then the data
+		 * of each file.  Offsets are from the start of the image.
+		 */
+		class OPENZWAVE_EXPORT ConfigImage
+		{
+			public:
+				/**
+				 * Map the image in the ConfigPath directory, if there is one and the
+				 * ConfigImage option is set.
+				 */
+				static void Create();
+				static void Destroy();
+
+				/**
+				 * Load a config file, from the image if it holds a current copy,
+				 * otherwise by parsing the XML.
+				 * \param _filename Full path of the file, starting with ConfigPath.
+				 */
+				static bool LoadFile(string const& _filename, TiXmlDocument* _doc);
+
+				/**
+				 * Look up the Revision attribute of a device config file.
+				 * \return false if the image does not hold a current copy of the file, or
+				 * the file has no valid revision.
+				 */
+				static bool GetRevision(string const& _filename, uint32* o_revision);
+
+				/**
+				 * Compile config files into an image.
+				 * \param _configPath The config directory, ending in a separator.
+				 * \param _files Paths of the files relative to _configPath.
+				 * \param _imageFile Where to write the image.
+				 * \return false if any file could not be read or the image could not be
+				 * written.
+				 */
+				static bool Build(string const& _configPath, std::vector<string> const& _files, string const& _imageFile);
+
+				static uint32 const c_version = 1;
+
+			private:
+				ConfigImage();
+				~ConfigImage();
+
+				bool Open(string const& _filename);
+				uint8 const* Find(string const& _filename) const;
+
+				string m_configPath;
+				uint8 const* m_data;				// The whole image
+				size_t m_size;
+				uint32 m_count;
+				std::vector<uint8> m_buffer;		// Holds the image on platforms where it is read rather than mapped
+
+				static ConfigImage* s_instance;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_ConfigImage_H
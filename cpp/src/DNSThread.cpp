@@ -28,6 +28,7 @@
 #include "DNSThread.h"
 #include "Utils.h"
 #include "Driver.h"
+#include "platform/WaitSet.h"
 
 namespace OpenZWave
 {
@@ -57,21 +58,17 @@ namespace OpenZWave
 		void DNSThread::DNSThreadProc(Internal::Platform::Event* _exitEvent)
 		{
 			Log::Write(LogLevel_Info, "Starting DNSThread");
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);				// Thread must exit.
+			waitObjects.Add(m_dnsRequestEvent);			// DNS Request
 			while (true)
 			{
 				// DNSThread has been initialized
-				const uint32 count = 2;
-
-				Internal::Platform::Wait* waitObjects[count];
-
 				int32 timeout = Internal::Platform::Wait::Timeout_Infinite;
 //		timeout = 5000;
 
-				waitObjects[0] = _exitEvent;				// Thread must exit.
-				waitObjects[1] = m_dnsRequestEvent;			// DNS Request
 				// Wait for something to do
-
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, timeout);
+				int32 res = waitObjects.Multiple(waitObjects.Size(), timeout);
 
 				switch (res)
 				{
@@ -227,6 +227,7 @@ namespace OpenZWave
 #define BYTE_TIMEOUT	150
 //#define RETRY_TIMEOUT	40000		// Retry send after 40 seconds
 #define RETRY_TIMEOUT	10000		// Retry send after 10 seconds (we might need to keep this below 10 for Security CC to function correctly)
+#define RETRY_TIMEOUT_MIN	500		// Never retry sooner than this, however quickly a node usually replies
 
 #define SOF												0x01
 #define ACK												0x06
@@ -27,6 +27,8 @@
 #include "Defs.h"
 #include "Driver.h"
 #include "Options.h"
+#include "BinaryCache.h"
+#include "CacheJournal.h"
 #include "Manager.h"
 #include "Node.h"
 #include "Msg.h"
@@ -37,6 +39,7 @@
 #include "TimerThread.h"
 #include "Http.h"
 #include "ManufacturerSpecificDB.h"
+#include "PollScheduler.h"
 
 #include "platform/Event.h"
 #include "platform/Mutex.h"
@@ -49,6 +52,7 @@
 #endif
 #endif
 #include "platform/Thread.h"
+#include "platform/WaitSet.h"
 #include "platform/Log.h"
 #include "platform/TimeStamp.h"
 
@@ -64,6 +68,7 @@
 #include "value_classes/ValueID.h"
 #include "value_classes/Value.h"
 #include "value_classes/ValueStore.h"
+#include "value_classes/ValueSnapshotTable.h"
 
 #include "tinyxml.h"
 
@@ -92,6 +97,59 @@ using namespace OpenZWave;
 // 05: 10-07-2020 - Duration ValueID's changed from Byte to Int. Invalidate Any previous caches. 
 uint32 const c_configVersion = 5;
 
+static OptionHandle<int32> s_retryTimeout("RetryTimeout", RETRY_TIMEOUT);
+static OptionHandle<int32> s_retryTimeoutMin("RetryTimeoutMin", RETRY_TIMEOUT_MIN);
+static OptionHandle<bool> s_binaryCache("BinaryCache", false);
+static OptionHandle<bool> s_cacheJournal("CacheJournal", false);
+static OptionHandle<int32> s_cacheJournalInterval("CacheJournalInterval", 60);
+
+//-----------------------------------------------------------------------------
+// <UpdateRTTEstimate>
+// Fold a round trip time into a smoothed estimate and its mean deviation
+//-----------------------------------------------------------------------------
+static void UpdateRTTEstimate(int32 _rtt, int32* io_srtt, int32* io_rttVar)
+{
+	// A zero estimate means there have been no samples yet
+	if (_rtt < 1)
+	{
+		_rtt = 1;
+	}
+	if (*io_srtt == 0)
+	{
+		*io_srtt = _rtt;
+		*io_rttVar = _rtt / 2;
+	}
+	else
+	{
+		// The gains of 1/8 and 1/4 are those TCP uses (RFC 6298)
+		int32 err = _rtt - *io_srtt;
+		*io_rttVar += ((err < 0 ? -err : err) - *io_rttVar) / 4;
+		*io_srtt += err / 8;
+		if (*io_srtt < 1)
+		{
+			*io_srtt = 1;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <GetFileSize>
+// Size of a file, or 0 if it cannot be read
+//-----------------------------------------------------------------------------
+static uint32 GetFileSize(string const& _filename)
+{
+	long size = 0;
+	if (FILE* file = fopen(_filename.c_str(), "rb"))
+	{
+		if (fseek(file, 0, SEEK_END) == 0)
+		{
+			size = ftell(file);
+		}
+		fclose(file);
+	}
+	return (size > 0) ? (uint32) size : 0;
+}
+
 static char const* c_libraryTypeNames[] =
 { "Unknown",			// library type 0
 		"Static Controller",		// library type 1
@@ -115,23 +173,35 @@ static char const* c_sendQueueNames[] =
 // Constructor
 //-----------------------------------------------------------------------------
 Driver::Driver(string const& _controllerPath, ControllerInterface const& _interface) :
-		m_driverThread(new Internal::Platform::Thread("driver")), m_dns(new Internal::DNSThread(this)), m_dnsThread(new Internal::Platform::Thread("dns")), m_initMutex(new Internal::Platform::Mutex()), m_exit(false), m_init(false), m_awakeNodesQueried(false), m_allNodesQueried(false), m_notifytransactions(false), m_timer(new Internal::TimerThread(this)), m_timerThread(new Internal::Platform::Thread("timer")), m_controllerInterfaceType(_interface), m_controllerPath(_controllerPath), m_controller(
+		m_driverThread(new Internal::Platform::Thread("driver")), m_dns(new Internal::DNSThread(this)), m_dnsThread(new Internal::Platform::Thread("dns")), m_initMutex(new Internal::Platform::Mutex()), m_exit(false), m_init(false), m_awakeNodesQueried(false), m_allNodesQueried(false), m_notifytransactions(false), m_cacheMutex(new Internal::Platform::Mutex()), m_cacheGeneration(0), m_cacheSize(0), m_cacheJournalSize(0), m_cacheCompact(false), m_cacheTimer(NULL), m_timer(new Internal::TimerThread(this)), m_timerThread(new Internal::Platform::Thread("timer")), m_controllerInterfaceType(_interface), m_controllerPath(_controllerPath), m_controller(
 				NULL), m_homeId(0), m_libraryVersion(""), m_libraryTypeName(""), m_libraryType(0), m_manufacturerId(0), m_productType(0), m_productId(0), m_initVersion(0), m_initCaps(0), m_controllerCaps(0), m_Controller_nodeId(0), m_nodeMutex(new Internal::Platform::Mutex()), m_controllerReplication( NULL), m_transmitOptions( TRANSMIT_OPTION_ACK | TRANSMIT_OPTION_AUTO_ROUTE | TRANSMIT_OPTION_EXPLORE), m_waitingForAck(false), m_expectedCallbackId(0), m_expectedReply(0), m_expectedCommandClassId(
-				0), m_expectedNodeId(0), m_pollThread(new Internal::Platform::Thread("poll")), m_pollMutex(new Internal::Platform::Mutex()), m_pollInterval(0), m_bIntervalBetweenPolls(false),				// if set to true (via SetPollInterval), the pollInterval will be interspersed between each poll (so a much smaller m_pollInterval like 100, 500, or 1,000 may be appropriate)
+				0), m_expectedNodeId(0), m_pollThread(new Internal::Platform::Thread("poll")), m_pollScheduler(new Internal::PollScheduler()), m_pollMutex(new Internal::Platform::Mutex()), m_pollInterval(0), m_bIntervalBetweenPolls(false),				// if set to true (via SetPollInterval), the pollInterval will be interspersed between each poll (so a much smaller m_pollInterval like 100, 500, or 1,000 may be appropriate)
 		m_currentControllerCommand( NULL), m_SUCNodeId(0), m_controllerResetEvent( NULL), m_sendMutex(new Internal::Platform::Mutex()), m_currentMsg( NULL), m_virtualNeighborsReceived(false), m_notificationsEvent(new Internal::Platform::Event()), m_SOFCnt(0), m_ACKWaiting(0), m_readAborts(0), m_badChecksum(0), m_readCnt(0), m_writeCnt(0), m_CANCnt(0), m_NAKCnt(0), m_ACKCnt(0), m_OOFCnt(0), m_dropped(0), m_retries(0), m_callbacks(0), m_badroutes(0), m_noack(0), m_netbusy(0), m_notidle(0), m_txverified(
-				0), m_nondelivery(0), m_routedbusy(0), m_broadcastReadCnt(0), m_broadcastWriteCnt(0), AuthKey(0), EncryptKey(0), m_nonceReportSent(0), m_nonceReportSentAttempt(0), m_queueMsgEvent(new Internal::Platform::Event()), m_eventMutex(new Internal::Platform::Mutex())
+				0), m_nondelivery(0), m_routedbusy(0), m_broadcastReadCnt(0), m_broadcastWriteCnt(0), m_coalescedSets(0), m_mergedGets(0), AuthKey(0), EncryptKey(0), m_nonceReportSent(0), m_nonceReportSentAttempt(0), m_nonceGetSent(0), m_noncePrefetch(false), m_queueMsgEvent(new Internal::Platform::Event()), m_eventMutex(new Internal::Platform::Mutex())
 {
 	// set a timestamp to indicate when this driver started
 	Internal::Platform::TimeStamp m_startTime;
 
+	for (int32 i = 0; i < 8; ++i)
+	{
+		m_dirtyNodes[i] = 0;
+	}
+	m_cacheTimer = new Internal::Timer(this);
+
 	// Create the message queue events
 	for (int32 i = 0; i < MsgQueue_Count; ++i)
 	{
 		m_queueEvent[i] = new Internal::Platform::Event();
+		m_lastSentNodeId[i] = 0;
 	}
 
-	// Clear the nodes array
+	// Clear the nodes array, and create the per node locks
 	memset(m_nodes, 0, sizeof(Node*) * 256);
+	for (int32 i = 0; i < 256; ++i)
+	{
+		m_nodeLocks[i] = new Internal::Platform::SharedMutex();
+	}
+	m_valueSnapshots = new Internal::VC::ValueSnapshotTable();
 
 	// Clear the virtual neighbors array
 	memset(m_virtualNeighbors, 0, NUM_NODE_BITFIELD_BYTES);
@@ -153,6 +223,7 @@ Driver::Driver(string const& _controllerPath, ControllerInterface const& _interf
 	m_controller->SetSignalThreshold(1);
 
 	Options::Get()->GetOptionAsBool("NotifyTransactions", &m_notifytransactions);
+	Options::Get()->GetOptionAsBool("SecurityNoncePrefetch", &m_noncePrefetch);
 	Options::Get()->GetOptionAsInt("PollInterval", &m_pollInterval);
 	Options::Get()->GetOptionAsBool("IntervalBetweenPolls", &m_bIntervalBetweenPolls);
 
@@ -208,6 +279,7 @@ Driver::~Driver()
 
 	m_timerThread->Stop();
 	m_timerThread->Release();
+	delete m_cacheTimer;
 
 	m_sendMutex->Release();
 
@@ -228,8 +300,7 @@ Driver::~Driver()
 		{
 			if (GetNodeUnsafe(i))
 			{
-				delete m_nodes[i];
-				m_nodes[i] = NULL;
+				DeleteNode(i);
 				Notification* notification = new Notification(Notification::Type_NodeRemoved);
 				notification->SetHomeAndNodeIds(m_homeId, i);
 				QueueNotification(notification);
@@ -237,6 +308,7 @@ Driver::~Driver()
 		}
 	}
 	// Don't release until all nodes have removed their poll values
+	delete m_pollScheduler;
 	m_pollMutex->Release();
 
 	// Clear the send Queue
@@ -275,13 +347,11 @@ Driver::~Driver()
 		}
 	}
 
-	list<Notification*>::iterator nit = m_notifications.begin();
-	while (nit != m_notifications.end())
+	while (!m_notifications.empty())
 	{
 		Notification* notification = m_notifications.front();
 		m_notifications.pop_front();
 		delete notification;
-		nit = m_notifications.begin();
 	}
 
 	if (m_controllerReplication)
@@ -289,6 +359,12 @@ Driver::~Driver()
 
 	m_notificationsEvent->Release();
 	m_nodeMutex->Release();
+	m_cacheMutex->Release();
+	for (int32 i = 0; i < 256; ++i)
+	{
+		delete m_nodeLocks[i];
+	}
+	delete m_valueSnapshots;
 	m_queueMsgEvent->Release();
 	m_eventMutex->Release();
 	delete this->AuthKey;
@@ -340,24 +416,21 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 		if (Init(attempts))
 		{
 			// Driver has been initialised
-			Internal::Platform::Wait* waitObjects[WAITOBJECTCOUNT];
-			waitObjects[0] = _exitEvent;						// Thread must exit.
-			waitObjects[1] = m_notificationsEvent;				// Notifications waiting to be sent.
-			waitObjects[2] = m_queueMsgEvent;
-			;					// a DNS and HTTP Event
-			waitObjects[3] = m_controller;					    // Controller has received data.
-			waitObjects[4] = m_queueEvent[MsgQueue_Command];	// A controller command is in progress.
-			waitObjects[5] = m_queueEvent[MsgQueue_NoOp];		// Send device probes and diagnostics messages
-			waitObjects[6] = m_queueEvent[MsgQueue_Controller];	// A multi-part controller command is in progress
-			waitObjects[7] = m_queueEvent[MsgQueue_WakeUp];		// A node has woken. Pending messages should be sent.
-			waitObjects[8] = m_queueEvent[MsgQueue_Send];		// Ordinary requests to be sent.
-			waitObjects[9] = m_queueEvent[MsgQueue_Query];		// Node queries are pending.
-			waitObjects[10] = m_queueEvent[MsgQueue_Poll];		// Poll request is waiting.
-
-			Internal::Platform::TimeStamp retryTimeStamp;
-			int retryTimeout = RETRY_TIMEOUT;
-			Options::Get()->GetOptionAsInt("RetryTimeout", &retryTimeout);
-			//retryTimeout = RETRY_TIMEOUT * 10;
+			// The wait objects are registered once for as long as the driver is
+			// initialised, rather than on every pass through the loop.
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);						// Thread must exit.
+			waitObjects.Add(m_notificationsEvent);				// Notifications waiting to be sent.
+			waitObjects.Add(m_queueMsgEvent);					// a DNS and HTTP Event
+			waitObjects.Add(m_controller);						// Controller has received data.
+			waitObjects.Add(m_queueEvent[MsgQueue_Command]);	// A controller command is in progress.
+			waitObjects.Add(m_queueEvent[MsgQueue_NoOp]);		// Send device probes and diagnostics messages
+			waitObjects.Add(m_queueEvent[MsgQueue_Controller]);	// A multi-part controller command is in progress
+			waitObjects.Add(m_queueEvent[MsgQueue_WakeUp]);		// A node has woken. Pending messages should be sent.
+			waitObjects.Add(m_queueEvent[MsgQueue_Send]);		// Ordinary requests to be sent.
+			waitObjects.Add(m_queueEvent[MsgQueue_Query]);		// Node queries are pending.
+			waitObjects.Add(m_queueEvent[MsgQueue_Poll]);		// Poll request is waiting.
+
 			while (true)
 			{
 				Log::Write(LogLevel_StreamDetail, "      Top of DriverThreadProc loop.");
@@ -375,7 +448,7 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 				else if (m_waitingForAck || m_expectedCallbackId || m_expectedReply)
 				{
 					count = 4;
-					timeout = m_waitingForAck ? ACK_TIMEOUT : retryTimeStamp.TimeRemaining();
+					timeout = m_waitingForAck ? ACK_TIMEOUT : m_retryTimeStamp.TimeRemaining();
 					if (timeout < 0)
 					{
 						timeout = 0;
@@ -391,7 +464,7 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 				}
 
 				// Wait for something to do
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, timeout);
+				int32 res = waitObjects.Multiple(count, timeout);
 
 				switch (res)
 				{
@@ -405,10 +478,12 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 							notification->SetNotification(Notification::Code_Timeout);
 							QueueNotification(notification);
 						}
-						if (WriteMsg("Wait Timeout"))
+						if ((m_currentMsg != NULL) && !m_waitingForAck)
 						{
-							retryTimeStamp.SetTime(retryTimeout);
+							NodeSendFailed(m_currentMsg->GetTargetNodeId());
 						}
+						BackOffRetryTimeout();
+						WriteMsg("Wait Timeout");
 						break;
 					}
 					case 0:
@@ -446,10 +521,7 @@ void Driver::DriverThreadProc(Internal::Platform::Event* _exitEvent)
 					default:
 					{
 						// All the other events are sending message queue items
-						if (WriteNextMsg((MsgQueue) (res - 4)))
-						{
-							retryTimeStamp.SetTime(retryTimeout);
-						}
+						WriteNextMsg((MsgQueue) (res - 4));
 						break;
 					}
 				}
@@ -561,7 +633,7 @@ void Driver::RemoveQueues(uint8 const _nodeId)
 	// Clear the send Queue
 	for (int32 i = 0; i < MsgQueue_Count; ++i)
 	{
-		list<MsgQueueItem>::iterator it = m_msgQueue[i].begin();
+		MsgQueueList::iterator it = m_msgQueue[i].begin();
 		while (it != m_msgQueue[i].end())
 		{
 			bool remove = false;
@@ -610,18 +682,20 @@ void Driver::RemoveQueues(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 bool Driver::ReadCache()
 {
-	char str[32];
 	int32 intVal;
 
-	// Load the XML document that contains the driver configuration
-	string userPath;
-	Options::Get()->GetOptionAsString("UserPath", &userPath);
-
-	snprintf(str, sizeof(str), "ozwcache_0x%08x.xml", m_homeId);
-	string filename = userPath + string(str);
-
+	// Load the XML document that contains the driver configuration.  A binary cache
+	// only gives us the Driver element and the nodes from the journal here, and the
+	// rest of its nodes are read one at a time from the loader below.
+	string filename;
 	TiXmlDocument doc;
-	if (!doc.LoadFile(filename.c_str(), TIXML_ENCODING_UTF8))
+	Internal::BinaryCache::Loader loader;
+	bool journaled[256] =
+	{ false };
+	m_cacheMutex->Lock();
+	bool loaded = LoadCacheDocument(&doc, &filename, &loader, journaled);
+	m_cacheMutex->Unlock();
+	if (!loaded)
 	{
 		return false;
 	}
@@ -708,29 +782,25 @@ bool Driver::ReadCache()
 
 	// Read the nodes
 	Internal::LockGuard LG(m_nodeMutex);
-	TiXmlElement const* nodeElement = driverElement->FirstChildElement();
-	while (nodeElement)
+	for (TiXmlElement const* nodeElement = driverElement->FirstChildElement(); nodeElement; nodeElement = nodeElement->NextSiblingElement())
 	{
-		char const* str = nodeElement->Value();
-		if (str && !strcmp(str, "Node"))
+		ReadCacheNode(nodeElement);
+	}
+	while (TiXmlElement* nodeElement = loader.ReadChild())
+	{
+		// A node in the journal is newer than its entry in the cache, and was read above
+		if (TIXML_SUCCESS != nodeElement->QueryIntAttribute("id", &intVal) || !journaled[(uint8) intVal])
 		{
-			// Get the node Id from the XML
-			if (TIXML_SUCCESS == nodeElement->QueryIntAttribute("id", &intVal))
-			{
-				uint8 nodeId = (uint8) intVal;
-				Node* node = new Node(m_homeId, nodeId);
-				m_nodes[nodeId] = node;
-
-				Notification* notification = new Notification(Notification::Type_NodeAdded);
-				notification->SetHomeAndNodeIds(m_homeId, nodeId);
-				QueueNotification(notification);
-
-				// Read the rest of the node configuration from the XML
-				node->ReadXML(nodeElement);
-			}
+			ReadCacheNode(nodeElement);
 		}
-
-		nodeElement = nodeElement->NextSiblingElement();
+		delete nodeElement;
+	}
+	if (loader.Failed())
+	{
+		// The nodes after the damage will be queried again, so write a whole new cache next time
+		m_cacheMutex->Lock();
+		m_cacheCompact = true;
+		m_cacheMutex->Unlock();
 	}
 
 	LG.Unlock();
@@ -753,14 +823,37 @@ bool Driver::ReadCache()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::ReadCacheNode>
+// Create a node from its element in the cache
+//-----------------------------------------------------------------------------
+void Driver::ReadCacheNode(TiXmlElement const* _nodeElement)
+{
+	char const* str = _nodeElement->Value();
+	int32 intVal;
+	if (str && !strcmp(str, "Node") && (TIXML_SUCCESS == _nodeElement->QueryIntAttribute("id", &intVal)))
+	{
+		uint8 nodeId = (uint8) intVal;
+		Node* node = new Node(m_homeId, nodeId);
+		// Keep readers of this node out until its configuration has been read
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
+		m_nodes[nodeId] = node;
+
+		Notification* notification = new Notification(Notification::Type_NodeAdded);
+		notification->SetHomeAndNodeIds(m_homeId, nodeId);
+		QueueNotification(notification);
+
+		// Read the rest of the node configuration from the XML
+		node->ReadXML(_nodeElement);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::WriteCache>
 // Write ourselves to an XML document
 //-----------------------------------------------------------------------------
 void Driver::WriteCache()
 {
-	char str[32];
-
 	if (!m_homeId)
 	{
 		Log::Write(LogLevel_Warning, "WARNING: Tried to write driver config with no home ID set");
@@ -772,12 +865,32 @@ void Driver::WriteCache()
 	}
 
 	Log::Write(LogLevel_Info, "Saving Cache");
-	// Create a new XML document to contain the driver configuration
+	// Create a new XML document to contain the driver configuration.  A binary cache
+	// is encoded node by node instead, and the document only holds the Driver element.
+	bool binary = s_binaryCache.Get();
 	TiXmlDocument doc;
+	Internal::BinaryCache::Builder builder;
+	m_nodeMutex->Lock();
+	m_cacheMutex->Lock();
+	BuildCacheDocument(&doc, binary ? &builder : NULL);
+	m_nodeMutex->Unlock();
+	SaveCacheDocument(doc, binary ? &builder : NULL);
+	m_cacheMutex->Unlock();
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::BuildCacheDocument>
+// Write the driver and its nodes to a new document.  With a builder, each node
+// is encoded into it and dropped, and only the Driver element is left in _doc.
+//-----------------------------------------------------------------------------
+void Driver::BuildCacheDocument(TiXmlDocument* _doc, Internal::BinaryCache::Builder* _builder)
+{
+	char str[32];
+
 	TiXmlDeclaration* decl = new TiXmlDeclaration("1.0", "utf-8", "");
 	TiXmlElement* driverElement = new TiXmlElement("Driver");
-	doc.LinkEndChild(decl);
-	doc.LinkEndChild(driverElement);
+	_doc->LinkEndChild(decl);
+	_doc->LinkEndChild(driverElement);
 
 	driverElement->SetAttribute("xmlns", "https://github.com/OpenZWave/open-zwave");
 
@@ -805,32 +918,258 @@ void Driver::WriteCache()
 	snprintf(str, sizeof(str), "%s", m_bIntervalBetweenPolls ? "true" : "false");
 	driverElement->SetAttribute("poll_interval_between", str);
 
+	// Every node is written here, so none are left for the journal
+	for (int32 i = 0; i < 8; ++i)
 	{
-		Internal::LockGuard LG(m_nodeMutex);
+		m_dirtyNodes[i] = 0;
+	}
 
-		for (int i = 0; i < 256; ++i)
+	for (int i = 0; i < 256; ++i)
+	{
+		if (m_nodes[i])
 		{
-			if (m_nodes[i])
+			if (m_nodes[i]->GetCurrentQueryStage() >= Node::QueryStage_CacheLoad)
 			{
-				if (m_nodes[i]->GetCurrentQueryStage() >= Node::QueryStage_CacheLoad)
+				if (_builder)
 				{
-					m_nodes[i]->WriteXML(driverElement);
-					Log::Write(LogLevel_Info, i, "Cache Save for Node %d as its QueryStage_CacheLoad", i);
+					TiXmlElement nodeParent("Driver");
+					m_nodes[i]->WriteXML(&nodeParent);
+					_builder->AddChild(nodeParent.FirstChildElement());
 				}
 				else
 				{
-					Log::Write(LogLevel_Info, i, "Skipping Cache Save for Node %d as its not past QueryStage_CacheLoad", i);
+					m_nodes[i]->WriteXML(driverElement);
 				}
+				Log::Write(LogLevel_Info, i, "Cache Save for Node %d as its QueryStage_CacheLoad", i);
+			}
+			else
+			{
+				Log::Write(LogLevel_Info, i, "Skipping Cache Save for Node %d as its not past QueryStage_CacheLoad", i);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::MarkNodeDirty>
+// Note that a node needs saving.  Safe to call from any thread with any lock held.
+//-----------------------------------------------------------------------------
+void Driver::MarkNodeDirty(uint8 const _nodeId)
+{
+	m_dirtyNodes[_nodeId >> 5].fetch_or(1u << (_nodeId & 0x1f));
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::WriteCacheChanges>
+// Save the nodes marked by MarkNodeDirty.  With the CacheJournal option they are
+// appended to the journal, otherwise the whole cache is saved.
+//-----------------------------------------------------------------------------
+void Driver::WriteCacheChanges()
+{
+	bool useJournal = s_cacheJournal.Get();
+	if (!useJournal)
+	{
+		WriteCache();
+		return;
+	}
+	if (!m_homeId || m_exit)
+	{
+		return;
+	}
+
+	m_nodeMutex->Lock();
+	m_cacheMutex->Lock();
+
+	// Fold the journal back into the cache once it is half the size of the cache.  The
+	// cache must also exist before there is anything to journal against.
+	if (m_cacheCompact || (m_cacheSize == 0) || (m_cacheJournalSize > (m_cacheSize / 2)))
+	{
+		Log::Write(LogLevel_Info, "Saving Cache to fold in the journal");
+		bool binary = s_binaryCache.Get();
+		TiXmlDocument doc;
+		Internal::BinaryCache::Builder builder;
+		BuildCacheDocument(&doc, binary ? &builder : NULL);
+		m_nodeMutex->Unlock();
+		SaveCacheDocument(doc, binary ? &builder : NULL);
+		m_cacheMutex->Unlock();
+		return;
+	}
+
+	Internal::CacheJournal journal(GetCacheFilename(Cache_Journal), m_cacheGeneration);
+	for (int32 i = 0; i < 8; ++i)
+	{
+		uint32 dirty = m_dirtyNodes[i].exchange(0);
+		for (int32 j = 0; dirty != 0; ++j, dirty >>= 1)
+		{
+			if (!(dirty & 1))
+			{
+				continue;
+			}
+			uint8 nodeId = (uint8) ((i << 5) + j);
+			Node* node = m_nodes[nodeId];
+			if (node && (node->GetCurrentQueryStage() >= Node::QueryStage_CacheLoad))
+			{
+				TiXmlElement driverElement("Driver");
+				node->WriteXML(&driverElement);
+				journal.AddNode(nodeId, driverElement.FirstChildElement());
+			}
+			else
+			{
+				// Removed, or not far enough along to be cached, just as WriteCache would leave it out
+				journal.AddNode(nodeId, NULL);
 			}
 		}
 	}
+	m_nodeMutex->Unlock();
+
+	uint32 count = journal.GetCount();
+	bool saved = journal.Commit(&m_cacheJournalSize);
+	if (!saved)
+	{
+		// The journal may now end in a partial record, so start again from a full save
+		m_cacheCompact = true;
+	}
+	m_cacheMutex->Unlock();
+
+	if (!saved)
+	{
+		WriteCache();
+	}
+	else if (count > 0)
+	{
+		Log::Write(LogLevel_Info, "Saved %d changed nodes to the cache journal", count);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::CacheJournalTimer>
+// Save the changed nodes every CacheJournalInterval seconds
+//-----------------------------------------------------------------------------
+void Driver::CacheJournalTimer(uint32 _id)
+{
+	WriteCacheChanges();
+
+	int32 interval = s_cacheJournalInterval.Get();
+	if (interval > 0)
+	{
+		m_cacheTimer->TimerSetEvent(interval * 1000, bind(&Driver::CacheJournalTimer, this, _id), _id);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::GetCacheFilename>
+// Path of the cache file in the binary or XML format, or of its journal
+//-----------------------------------------------------------------------------
+string Driver::GetCacheFilename(CacheFile const _file)
+{
+	static char const* const extensions[] =
+	{ "xml", "bin", "journal" };
+
+	char str[32];
 	string userPath;
 	Options::Get()->GetOptionAsString("UserPath", &userPath);
 
-	snprintf(str, sizeof(str), "ozwcache_0x%08x.xml", m_homeId);
-	string filename = userPath + string(str);
+	snprintf(str, sizeof(str), "ozwcache_0x%08x.%s", m_homeId, extensions[_file]);
+	return userPath + string(str);
+}
 
-	doc.SaveFile(filename.c_str());
+//-----------------------------------------------------------------------------
+// <Driver::LoadCacheDocument>
+// Load the cache file into a document, with the journal applied.  The caller
+// holds m_cacheMutex.  With a loader, a binary cache only has its Driver element
+// decoded into _doc, and the caller reads its nodes from the loader, skipping
+// those marked in o_journaled (256 entries) as their journal records are in _doc.
+//-----------------------------------------------------------------------------
+bool Driver::LoadCacheDocument(TiXmlDocument* _doc, string* o_filename, Internal::BinaryCache::Loader* o_loader, bool* o_journaled)
+{
+	bool loaded = false;
+	bool binary = s_binaryCache.Get();
+	if (binary)
+	{
+		*o_filename = GetCacheFilename(Cache_Binary);
+		if (o_loader)
+		{
+			TiXmlElement* driverElement = o_loader->Open(*o_filename) ? o_loader->ReadRoot() : NULL;
+			if (driverElement)
+			{
+				_doc->LinkEndChild(driverElement);
+				loaded = true;
+			}
+		}
+		else
+		{
+			loaded = Internal::BinaryCache::Load(*o_filename, _doc);
+		}
+		if (!loaded)
+		{
+			// Use the XML cache if there is one.  It will be saved in the binary form next time.
+			_doc->Clear();
+		}
+	}
+	if (!loaded)
+	{
+		*o_filename = GetCacheFilename(Cache_XML);
+		loaded = _doc->LoadFile(o_filename->c_str(), TIXML_ENCODING_UTF8);
+	}
+
+	m_cacheGeneration = 0;
+	m_cacheSize = 0;
+	m_cacheJournalSize = 0;
+	m_cacheCompact = false;
+	TiXmlElement* driverElement = _doc->RootElement();
+	if (!loaded || !driverElement)
+	{
+		return false;
+	}
+
+	int32 intVal;
+	if (TIXML_SUCCESS == driverElement->QueryIntAttribute("generation", &intVal))
+	{
+		m_cacheGeneration = (uint32) intVal;
+	}
+	m_cacheSize = GetFileSize(*o_filename);
+	m_cacheCompact = !Internal::CacheJournal::Apply(GetCacheFilename(Cache_Journal), m_cacheGeneration, driverElement, &m_cacheJournalSize, o_journaled);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::SaveCacheDocument>
+// Save a document as the cache file, giving it a new generation so that the
+// old journal no longer applies.  A builder from BuildCacheDocument holds the
+// nodes of a binary cache.  The caller holds m_cacheMutex.
+//-----------------------------------------------------------------------------
+void Driver::SaveCacheDocument(TiXmlDocument& _doc, Internal::BinaryCache::Builder* _builder)
+{
+	uint32 generation = m_cacheGeneration + 1;
+	if (TiXmlElement* driverElement = _doc.RootElement())
+	{
+		driverElement->SetAttribute("generation", (int) generation);
+	}
+
+	bool binary = s_binaryCache.Get();
+	string filename = GetCacheFilename(binary ? Cache_Binary : Cache_XML);
+	bool saved;
+	if (binary)
+	{
+		saved = _builder ? _builder->Save(_doc.RootElement(), filename) : Internal::BinaryCache::Save(_doc, filename);
+	}
+	else
+	{
+		saved = _doc.SaveFile(filename.c_str());
+	}
+	if (!saved)
+	{
+		// The previous cache and its journal are still good, but are missing these changes
+		Log::Write(LogLevel_Warning, "Unable to save the cache to %s", filename.c_str());
+		m_cacheCompact = true;
+		return;
+	}
+
+	m_cacheGeneration = generation;
+	m_cacheSize = GetFileSize(filename);
+	m_cacheJournalSize = 0;
+	m_cacheCompact = false;
+	Internal::CacheJournal::Discard(GetCacheFilename(Cache_Journal));
 }
 
 //-----------------------------------------------------------------------------
@@ -897,7 +1236,10 @@ void Driver::SendQueryStageComplete(uint8 const _nodeId, Node::QueryStage const
 				{
 					// If the message is for a sleeping node, we queue it in the node itself.
 					Log::Write(LogLevel_Info, "");
-					Log::Write(LogLevel_Detail, node->GetNodeId(), "Queuing (%s) Query Stage Complete (%s)", c_sendQueueNames[MsgQueue_WakeUp], node->GetQueryStageName(_stage).c_str());
+					if (Log::IsLevelEnabled(LogLevel_Detail))
+					{
+						Log::Write(LogLevel_Detail, node->GetNodeId(), "Queuing (%s) Query Stage Complete (%s)", c_sendQueueNames[MsgQueue_WakeUp], node->GetQueryStageName(_stage).c_str());
+					}
 					wakeUp->QueueMsg(item);
 					return;
 				}
@@ -905,7 +1247,10 @@ void Driver::SendQueryStageComplete(uint8 const _nodeId, Node::QueryStage const
 		}
 
 		// Non-sleeping node
-		Log::Write(LogLevel_Detail, node->GetNodeId(), "Queuing (%s) Query Stage Complete (%s)", c_sendQueueNames[MsgQueue_Query], node->GetQueryStageName(_stage).c_str());
+		if (Log::IsLevelEnabled(LogLevel_Detail))
+		{
+			Log::Write(LogLevel_Detail, node->GetNodeId(), "Queuing (%s) Query Stage Complete (%s)", c_sendQueueNames[MsgQueue_Query], node->GetQueryStageName(_stage).c_str());
+		}
 		m_sendMutex->Lock();
 		m_msgQueue[MsgQueue_Query].push_back(item);
 		m_queueEvent[MsgQueue_Query]->Set();
@@ -927,7 +1272,7 @@ void Driver::RetryQueryStageComplete(uint8 const _nodeId, Node::QueryStage const
 
 	m_sendMutex->Lock();
 
-	for (list<MsgQueueItem>::iterator it = m_msgQueue[MsgQueue_Query].begin(); it != m_msgQueue[MsgQueue_Query].end(); ++it)
+	for (MsgQueueList::iterator it = m_msgQueue[MsgQueue_Query].begin(); it != m_msgQueue[MsgQueue_Query].end(); ++it)
 	{
 		if (*it == item)
 		{
@@ -948,6 +1293,7 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 
 	item.m_command = MsgQueueCmd_SendMsg;
 	item.m_msg = _msg;
+	item.m_queuedAt = (uint32) -m_startTime.TimeRemaining();
 	/* make sure the HomeId is Set on this message */
 	_msg->SetHomeId(m_homeId);
 	_msg->Finalize();
@@ -961,7 +1307,10 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 				Internal::CC::CommandClass *cc = node->GetCommandClass(_msg->GetSendingCommandClass());
 				if ((cc) && (cc->IsSecured()))
 				{
-					Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Setting Encryption Flag on Message For Command Class %s", cc->GetCommandClassName().c_str());
+					if (Log::IsLevelEnabled(LogLevel_Detail))
+					{
+						Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Setting Encryption Flag on Message For Command Class %s", cc->GetCommandClassName().c_str());
+					}
 					item.m_msg->setEncrypted();
 				}
 			}
@@ -984,7 +1333,7 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 							item.m_msg = NULL;
 							UpdateControllerState(ControllerState_Sleeping);
 						}
-						else
+						else if (Log::IsLevelEnabled(LogLevel_Detail))
 						{
 							Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Queuing (%s) %s", c_sendQueueNames[MsgQueue_WakeUp], _msg->GetAsString().c_str());
 						}
@@ -995,13 +1344,272 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 			}
 		}
 	}
-	Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Queuing (%s) %s", c_sendQueueNames[_queue], _msg->GetAsString().c_str());
+	if (Log::IsLevelEnabled(LogLevel_Detail))
+	{
+		Log::Write(LogLevel_Detail, GetNodeNumber(_msg), "Queuing (%s) %s", c_sendQueueNames[_queue], _msg->GetAsString().c_str());
+	}
 	m_sendMutex->Lock();
-	m_msgQueue[_queue].push_back(item);
-	m_queueEvent[_queue]->Set();
+	if (!CoalesceMsg(item, _queue))
+	{
+		m_msgQueue[_queue].push_back(item);
+		m_queueEvent[_queue]->Set();
+	}
 	m_sendMutex->Unlock();
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::CoalesceMsg>
+// Merge a message that is about to be queued with one already in the queues.
+// A Set of a value replaces an older Set of the same value (keeping its place
+// in the queue) if nothing else has been queued for the node since, and a Get
+// that is identical to one already waiting in the Send, Query or Poll queue is
+// dropped.  Must be called with m_sendMutex held.
+// Returns true if the message was merged and must not be queued.
+//-----------------------------------------------------------------------------
+bool Driver::CoalesceMsg(MsgQueueItem const& _item, MsgQueue const _queue)
+{
+	Internal::Msg* msg = _item.m_msg;
+
+	// Only the lower priority queues are considered.  The Command, NoOp, Controller
+	// and WakeUp queues carry messages whose order and count matter.
+	if ((MsgQueueCmd_SendMsg != _item.m_command) || (_queue < MsgQueue_Send))
+	{
+		return false;
+	}
+
+	if (ReplaceQueuedSet(m_msgQueue[_queue], msg))
+	{
+		if (Log::IsLevelEnabled(LogLevel_Detail))
+		{
+			Log::Write(LogLevel_Detail, GetNodeNumber(msg), "Replaced queued (%s) Set with %s", c_sendQueueNames[_queue], msg->GetAsString().c_str());
+		}
+		m_coalescedSets++;
+		return true;
+	}
+
+	if (msg->GetExpectedReply() != FUNC_ID_APPLICATION_COMMAND_HANDLER)
+	{
+		// Not a Get
+		return false;
+	}
+
+	uint8 nodeId = msg->GetTargetNodeId();
+	for (int32 q = MsgQueue_Send; q <= MsgQueue_Poll; ++q)
+	{
+		// The new Get can only be merged with the last message queued for this
+		// node, otherwise it might be answered before something that was queued
+		// ahead of it (such as a Set) has been sent.
+		MsgQueueList::reverse_iterator rit = FindLastQueueItem(m_msgQueue[q], nodeId);
+		if ((rit == m_msgQueue[q].rend()) || (MsgQueueCmd_SendMsg != rit->m_command) || !(*rit->m_msg == *msg))
+		{
+			continue;
+		}
+
+		m_mergedGets++;
+		if (q <= _queue)
+		{
+			// The queued Get will be sent no later than this one would have been
+			if (Log::IsLevelEnabled(LogLevel_Detail))
+			{
+				Log::Write(LogLevel_Detail, GetNodeNumber(msg), "Merged with queued (%s) %s", c_sendQueueNames[q], msg->GetAsString().c_str());
+			}
+			delete msg;
+			return true;
+		}
+
+		// The queued Get is in a lower priority queue.  Drop it, and let the
+		// new one be queued at the higher priority instead.
+		if (Log::IsLevelEnabled(LogLevel_Detail))
+		{
+			Log::Write(LogLevel_Detail, GetNodeNumber(msg), "Promoting queued (%s) to (%s) %s", c_sendQueueNames[q], c_sendQueueNames[_queue], msg->GetAsString().c_str());
+		}
+		delete rit->m_msg;
+		m_msgQueue[q].erase(--rit.base());
+		if (m_msgQueue[q].empty())
+		{
+			m_queueEvent[q]->Reset();
+		}
+		return false;
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::FindLastQueueItem>
+// Find the last item in a queue that is for a node
+//-----------------------------------------------------------------------------
+Driver::MsgQueueList::reverse_iterator Driver::FindLastQueueItem(MsgQueueList& _queue, uint8 const _nodeId)
+{
+	MsgQueueList::reverse_iterator rit = _queue.rbegin();
+	while (rit != _queue.rend())
+	{
+		if (((MsgQueueCmd_SendMsg == rit->m_command) && (rit->m_msg->GetTargetNodeId() == _nodeId)) || ((MsgQueueCmd_SendMsg != rit->m_command) && (rit->m_nodeId == _nodeId)))
+		{
+			break;
+		}
+		++rit;
+	}
+	return rit;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::ReplaceQueuedSet>
+// Put a new Set in place of a queued Set of the same value
+//-----------------------------------------------------------------------------
+bool Driver::ReplaceQueuedSet(MsgQueueList& _queue, Internal::Msg* _msg)
+{
+	// Only the node's last item can be replaced.  Sending the new value in the
+	// place of an earlier one would move it ahead of whatever was queued for the
+	// node in between, such as a StartLevelChange.
+	MsgQueueList::reverse_iterator rit = FindLastQueueItem(_queue, _msg->GetTargetNodeId());
+	if ((rit == _queue.rend()) || (MsgQueueCmd_SendMsg != rit->m_command) || !rit->m_msg->IsSameValueSet(*_msg))
+	{
+		return false;
+	}
+	delete rit->m_msg;
+	rit->m_msg = _msg;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::GetQueueItemNodeId>
+// The node a queue item is for
+//-----------------------------------------------------------------------------
+uint8 Driver::GetQueueItemNodeId(MsgQueueItem const& _item)
+{
+	return (_item.m_msg != NULL) ? _item.m_msg->GetTargetNodeId() : _item.m_nodeId;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::SelectNextMsg>
+// Move the item to send next to the front of its queue (m_sendMutex is held)
+//-----------------------------------------------------------------------------
+Driver::MsgQueue Driver::SelectNextMsg(MsgQueue const _queue)
+{
+	if (_queue < MsgQueue_Send)
+	{
+		// Commands, controller and wake-up messages go strictly in order
+		return _queue;
+	}
+
+	// Look for a node that is not backed off, in this queue or a lower priority one
+	MsgQueueList::iterator it;
+	MsgQueue queue = _queue;
+	if (!FindNextFairMsg(queue, false, &it))
+	{
+		for (queue = (MsgQueue) (_queue + 1); queue < MsgQueue_Count; queue = (MsgQueue) (queue + 1))
+		{
+			if (FindNextFairMsg(queue, false, &it))
+			{
+				if (Log::IsLevelEnabled(LogLevel_Detail))
+				{
+					Log::Write(LogLevel_Detail, GetQueueItemNodeId(*it), "Sending (%s) message ahead of (%s) messages to backed off nodes", c_sendQueueNames[queue], c_sendQueueNames[_queue]);
+				}
+				break;
+			}
+		}
+		if (queue == MsgQueue_Count)
+		{
+			// Every node with anything to send is backed off, so don't keep them waiting
+			queue = _queue;
+			if (!FindNextFairMsg(queue, true, &it))
+			{
+				return queue;
+			}
+		}
+	}
+
+	m_lastSentNodeId[queue] = GetQueueItemNodeId(*it);
+	if (it != m_msgQueue[queue].begin())
+	{
+		m_msgQueue[queue].splice(m_msgQueue[queue].begin(), m_msgQueue[queue], it);
+	}
+	return queue;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::FindNextFairMsg>
+// Find the first item for the node after the one a queue last sent to
+//-----------------------------------------------------------------------------
+bool Driver::FindNextFairMsg(MsgQueue const _queue, bool const _backedOff, MsgQueueList::iterator* o_it)
+{
+	MsgQueueList& queue = m_msgQueue[_queue];
+	uint8 const last = m_lastSentNodeId[_queue];
+	uint32 deferred[8] = { 0 };				// Backed off nodes passed over
+	int32 best = 256;
+	for (MsgQueueList::iterator it = queue.begin(); it != queue.end(); ++it)
+	{
+		uint8 nodeId = GetQueueItemNodeId(*it);
+		int32 order = (uint8) (nodeId - last - 1);
+		if (order >= best)
+		{
+			continue;
+		}
+		if (!_backedOff)
+		{
+			Node* node = GetNodeUnsafe(nodeId);
+			if ((node != NULL) && node->m_sendFailures && (node->m_sendBackoffTS.TimeRemaining() > 0))
+			{
+				deferred[nodeId >> 5] |= 1u << (nodeId & 31);
+				continue;
+			}
+		}
+		best = order;
+		*o_it = it;
+		if (order == 0)
+		{
+			break;
+		}
+	}
+	if (best == 256)
+	{
+		return false;
+	}
+	for (int32 i = 0; i < 256; ++i)
+	{
+		if (deferred[i >> 5] & (1u << (i & 31)))
+		{
+			if (Node* node = GetNodeUnsafe((uint8) i))
+			{
+				node->m_deferredCnt++;
+			}
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::NodeSendFailed>
+// A node did not answer, so let messages to other nodes go first for a while
+//-----------------------------------------------------------------------------
+void Driver::NodeSendFailed(uint8 const _nodeId)
+{
+	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+	Node* node = GetNodeUnsafe(_nodeId);
+	if ((node == NULL) || (_nodeId == m_Controller_nodeId))
+	{
+		return;
+	}
+	if (node->m_sendFailures < 255)
+	{
+		node->m_sendFailures++;
+	}
+	int32 backoff = c_sendBackoffMin;
+	for (uint8 i = 1; (i < node->m_sendFailures) && (backoff < c_sendBackoffMax); ++i)
+	{
+		backoff *= 2;
+	}
+	if (backoff > c_sendBackoffMax)
+	{
+		backoff = c_sendBackoffMax;
+	}
+	node->m_sendBackoffTS.SetTime(backoff);
+	node->m_backoffCnt++;
+	Log::Write(LogLevel_Info, _nodeId, "Node is not answering, sending to other nodes first for %d ms", backoff);
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::WriteNextMsg>
 // Transmit a queued message to the Z-Wave controller
@@ -1009,19 +1617,33 @@ void Driver::SendMsg(Internal::Msg* _msg, MsgQueue const _queue)
 bool Driver::WriteNextMsg(MsgQueue const _queue)
 {
 
-	// There are messages to send, so get the one at the front of the queue
+	// There are messages to send, so get the one to go next
 	m_sendMutex->Lock();
-	MsgQueueItem item = m_msgQueue[_queue].front();
+	MsgQueue queue = SelectNextMsg(_queue);
+	MsgQueueItem item = m_msgQueue[queue].front();
 
 	if (MsgQueueCmd_SendMsg == item.m_command)
 	{
 		// Send a message
 		m_currentMsg = item.m_msg;
-		m_currentMsgQueueSource = _queue;
-		m_msgQueue[_queue].pop_front();
-		if (m_msgQueue[_queue].empty())
+		m_currentMsgQueueSource = queue;
+		if ((queue >= MsgQueue_Send) && (m_currentMsg->GetSendAttempts() == 0) && (item.m_queuedAt != 0))
 		{
-			m_queueEvent[_queue]->Reset();
+			if (Node* node = GetNodeUnsafe(m_currentMsg->GetTargetNodeId()))
+			{
+				uint32 queueTime = (uint32) -m_startTime.TimeRemaining() - item.m_queuedAt;
+				uint32 averageQueueTime = node->m_averageQueueTime;
+				node->m_averageQueueTime = averageQueueTime ? (averageQueueTime + queueTime) >> 1 : queueTime;
+				if (queueTime > node->m_maxQueueTime)
+				{
+					node->m_maxQueueTime = queueTime;
+				}
+			}
+		}
+		m_msgQueue[queue].pop_front();
+		if (m_msgQueue[queue].empty())
+		{
+			m_queueEvent[queue]->Reset();
 		}
 		if (m_nonceReportSent > 0)
 		{
@@ -1029,9 +1651,10 @@ bool Driver::WriteNextMsg(MsgQueue const _queue)
 			item_new.m_command = MsgQueueCmd_SendMsg;
 			item_new.m_nodeId = item.m_msg->GetTargetNodeId();
 			item_new.m_retry = item.m_retry;
+			item_new.m_queuedAt = item.m_queuedAt;
 			item_new.m_msg = new Internal::Msg(*item.m_msg);
-			m_msgQueue[_queue].push_front(item_new);
-			m_queueEvent[_queue]->Set();
+			m_msgQueue[queue].push_front(item_new);
+			m_queueEvent[queue]->Set();
 		}
 		m_sendMutex->Unlock();
 		return WriteMsg("WriteNextMsg");
@@ -1041,17 +1664,22 @@ bool Driver::WriteNextMsg(MsgQueue const _queue)
 		// Move to the next query stage
 		m_currentMsg = NULL;
 		Node::QueryStage stage = item.m_queryStage;
-		m_msgQueue[_queue].pop_front();
-		if (m_msgQueue[_queue].empty())
+		m_msgQueue[queue].pop_front();
+		if (m_msgQueue[queue].empty())
 		{
-			m_queueEvent[_queue]->Reset();
+			m_queueEvent[queue]->Reset();
 		}
 		m_sendMutex->Unlock();
 
+		Internal::LockGuard LG(m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[item.m_nodeId]);
 		Node* node = GetNodeUnsafe(item.m_nodeId);
 		if (node != NULL)
 		{
-			Log::Write(LogLevel_Detail, node->GetNodeId(), "Query Stage Complete (%s)", node->GetQueryStageName(stage).c_str());
+			if (Log::IsLevelEnabled(LogLevel_Detail))
+			{
+				Log::Write(LogLevel_Detail, node->GetNodeId(), "Query Stage Complete (%s)", node->GetQueryStageName(stage).c_str());
+			}
 			if (!item.m_retry)
 			{
 				node->QueryStageComplete(stage);
@@ -1069,10 +1697,10 @@ bool Driver::WriteNextMsg(MsgQueue const _queue)
 		if (m_currentControllerCommand->m_controllerCommandDone)
 		{
 			m_sendMutex->Lock();
-			m_msgQueue[_queue].pop_front();
-			if (m_msgQueue[_queue].empty())
+			m_msgQueue[queue].pop_front();
+			if (m_msgQueue[queue].empty())
 			{
-				m_queueEvent[_queue]->Reset();
+				m_queueEvent[queue]->Reset();
 			}
 			m_sendMutex->Unlock();
 			if (m_currentControllerCommand->m_controllerCallback)
@@ -1100,17 +1728,17 @@ bool Driver::WriteNextMsg(MsgQueue const _queue)
 		{
 			Log::Write(LogLevel_Info, "WriteNextMsg Controller nothing to do");
 			m_sendMutex->Lock();
-			m_queueEvent[_queue]->Reset();
+			m_queueEvent[queue]->Reset();
 			m_sendMutex->Unlock();
 		}
 		return true;
 	}
 	else if (MsgQueueCmd_ReloadNode == item.m_command)
 	{
-		m_msgQueue[_queue].pop_front();
-		if (m_msgQueue[_queue].empty())
+		m_msgQueue[queue].pop_front();
+		if (m_msgQueue[queue].empty())
 		{
-			m_queueEvent[_queue]->Reset();
+			m_queueEvent[queue]->Reset();
 		}
 		m_sendMutex->Unlock();
 
@@ -1232,6 +1860,15 @@ bool Driver::WriteMsg(string const &msg)
 	}
 	else if (m_currentMsg->isEncrypted())
 	{
+		/* On the first attempt, a nonce the node sent along with our last message saves
+		 * the Nonce_Get round trip.  Retries always fetch a fresh one, in case the
+		 * node rejected it. */
+		uint8 nonce[8];
+		if (m_noncePrefetch && (attempts == 1) && (node != NULL) && !m_currentMsg->isNonceRecieved() && node->TakePrefetchedNonce(nonce))
+		{
+			Log::Write(LogLevel_Detail, nodeId, "Using prefetched nonce");
+			m_currentMsg->setNonce(nonce);
+		}
 		if (m_currentMsg->isNonceRecieved())
 		{
 			Log::Write(LogLevel_Info, nodeId, "Processing (%s) Encrypted message (%sCallback ID=0x%.2x, Expected Reply=0x%.2x) - %s", c_sendQueueNames[m_currentMsgQueueSource], attemptsstr.c_str(), m_expectedCallbackId, m_expectedReply, m_currentMsg->GetAsString().c_str());
@@ -1284,9 +1921,101 @@ bool Driver::WriteMsg(string const &msg)
 			}
 		}
 	}
+	m_retryTimeStamp.SetTime(GetRetryTimeout(node, attempts));
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::GetRTTEstimate>
+// The round trip times that time out the current message
+//-----------------------------------------------------------------------------
+bool Driver::GetRTTEstimate(Node* _node, int32** o_srtt, int32** o_rttVar)
+{
+	if ((_node == NULL) || (m_currentMsg == NULL) || (m_nonceReportSent > 0) || (_node->GetNodeId() == m_Controller_nodeId))
+	{
+		return false;
+	}
+
+	// Use the round trip times of whatever we are waiting for.  Waiting for a
+	// nonce before sending an encrypted message is waiting for a reply too.
+	if ((m_expectedReply == FUNC_ID_APPLICATION_COMMAND_HANDLER) || (m_currentMsg->isEncrypted() && !m_currentMsg->isNonceRecieved()))
+	{
+		*o_srtt = &_node->m_responseSRTT;
+		*o_rttVar = &_node->m_responseRTTVar;
+		return true;
+	}
+	if (m_expectedReply == FUNC_ID_ZW_SEND_DATA)
+	{
+		*o_srtt = &_node->m_requestSRTT;
+		*o_rttVar = &_node->m_requestRTTVar;
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::GetRetryTimeout>
+// How long to wait for the current message's callback or reply
+//-----------------------------------------------------------------------------
+int32 Driver::GetRetryTimeout(Node* _node, uint8 const _attempts)
+{
+	int32 timeout = s_retryTimeout.Get();
+	int32 timeoutMin = s_retryTimeoutMin.Get();
+	int32* srtt;
+	int32* rttVar;
+	if ((timeoutMin >= timeout) || !GetRTTEstimate(_node, &srtt, &rttVar) || (*srtt == 0))
+	{
+		// Nothing to go on, so wait the full time
+		return timeout;
+	}
+
+	// Double the wait for each resend, as TCP does
+	int32 rto = *srtt + 4 * *rttVar;
+	for (uint8 i = 1; (i < _attempts) && (rto < timeout); ++i)
+	{
+		rto *= 2;
+	}
+	if (rto < timeoutMin)
+	{
+		rto = timeoutMin;
+	}
+	return (rto < timeout) ? rto : timeout;
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::BackOffRetryTimeout>
+// The current message timed out, so wait longer for the node next time
+//-----------------------------------------------------------------------------
+void Driver::BackOffRetryTimeout()
+{
+	// Resends of this message already double the wait (see GetRetryTimeout), so
+	// only change the estimate once the last of them has timed out too
+	if ((m_currentMsg == NULL) || m_waitingForAck || (m_currentMsg->GetSendAttempts() < m_currentMsg->GetMaxSendAttempts()))
+	{
+		return;
+	}
+	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[m_currentMsg->GetTargetNodeId()]);
+	Node* node = GetNode(m_currentMsg->GetTargetNodeId());
+	int32* srtt;
+	int32* rttVar;
+	if (!GetRTTEstimate(node, &srtt, &rttVar) || (*srtt == 0))
+	{
+		return;
+	}
+
+	// A reply that comes after we have given up is never timed, so without this a
+	// node that has slowed down would keep timing out.  Raise the deviation until
+	// the first attempt's timeout is doubled; replies that come in time bring it
+	// back down.
+	int32 timeout = GetRetryTimeout(node, 1);
+	if (timeout < s_retryTimeout.Get())
+	{
+		*rttVar = (2 * timeout - *srtt) / 4;
+		Log::Write(LogLevel_Detail, node->GetNodeId(), "Timeout for node raised to %d ms", GetRetryTimeout(node, 1));
+	}
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::RemoveCurrentMsg>
 // Delete the current message
@@ -1307,6 +2036,7 @@ void Driver::RemoveCurrentMsg()
 	m_waitingForAck = false;
 	m_nonceReportSent = 0;
 	m_nonceReportSentAttempt = 0;
+	m_nonceGetSent = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1375,7 +2105,7 @@ bool Driver::MoveMessagesToWakeUpQueue(uint8 const _targetNodeId, bool const _mo
 					// Now the message queues
 					for (int i = 0; i < MsgQueue_Count; ++i)
 					{
-						list<MsgQueueItem>::iterator it = m_msgQueue[i].begin();
+						MsgQueueList::iterator it = m_msgQueue[i].begin();
 						while (it != m_msgQueue[i].end())
 						{
 							bool remove = false;
@@ -1510,6 +2240,8 @@ bool Driver::HandleErrorResponse(uint8 const _error, uint8 const _nodeId, char c
 		m_txverified++;
 		Log::Write(LogLevel_Info, _nodeId, "ERROR: %s failed. Transmit Verified.", _funcStr);
 	}
+	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
 	if (Node* node = GetNodeUnsafe(_nodeId))
 	{
 		if (++node->m_errors >= 3)
@@ -1629,17 +2361,38 @@ bool Driver::IsExpectedReply(const uint8 _nodeId)
 //-----------------------------------------------------------------------------
 bool Driver::ReadMsg()
 {
-	uint8 buffer[1024];
+	// Large enough for a SOF, a length byte of up to 0xff and the frame that follows.
+	// Each frame is read in full before it is used, so the buffer is not cleared.
+	uint8 buffer[258];
 
-	memset(buffer, 0, sizeof(uint8) * 1024);
+	// Handle every frame and ACK/NAK/CAN byte that is already in the stream, so a
+	// burst of reports is drained in one wakeup rather than one per frame.
+	uint32 count = 0;
+	while (ReadFrame(buffer))
+	{
+		++count;
+	}
 
-	if (!m_controller->Read(buffer, 1))
+	if (count > 1)
+	{
+		Log::Write(LogLevel_StreamDetail, "      Handled %d frames in one read", count);
+	}
+	return (count > 0);
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::ReadFrame>
+// Read and handle a single frame or control byte from the serial port
+//-----------------------------------------------------------------------------
+bool Driver::ReadFrame(uint8* _buffer)
+{
+	if (!m_controller->GetDataSize() || !m_controller->Read(_buffer, 1))
 	{
 		// Nothing to read
 		return false;
 	}
 
-	switch (buffer[0])
+	switch (_buffer[0])
 	{
 		case SOF:
 		{
@@ -1653,59 +2406,70 @@ bool Driver::ReadMsg()
 				m_ACKWaiting++;
 			}
 
-			// Read the length byte.  Keep trying until we get it.
-			m_controller->SetSignalThreshold(1);
-			int32 response = Internal::Platform::Wait::Single(m_controller, 50);
-			if (response < 0)
+			// Read the length byte.  Normally it arrived with the SOF, and we only
+			// have to wait for it when the frame has been split across reads.
+			if (m_controller->GetDataSize() < 1)
 			{
-				Log::Write(LogLevel_Warning, "WARNING: 50ms passed without finding the length byte...aborting frame read");
-				m_readAborts++;
-				break;
+				m_controller->SetSignalThreshold(1);
+				int32 response = Internal::Platform::Wait::Single(m_controller, 50);
+				if (response < 0)
+				{
+					Log::Write(LogLevel_Warning, "WARNING: 50ms passed without finding the length byte...aborting frame read");
+					m_readAborts++;
+					break;
+				}
 			}
 			/* this is the size of the packet */
-			m_controller->Read(&buffer[1], 1);
-			m_controller->SetSignalThreshold(buffer[1]);
-			if (Internal::Platform::Wait::Single(m_controller, 500) < 0)
+			m_controller->Read(&_buffer[1], 1);
+			if (m_controller->GetDataSize() < _buffer[1])
 			{
-				Log::Write(LogLevel_Warning, "WARNING: 500ms passed without reading the rest of the frame...aborting frame read");
-				m_readAborts++;
+				m_controller->SetSignalThreshold(_buffer[1]);
+				if (Internal::Platform::Wait::Single(m_controller, 500) < 0)
+				{
+					Log::Write(LogLevel_Warning, "WARNING: 500ms passed without reading the rest of the frame...aborting frame read");
+					m_readAborts++;
+					m_controller->SetSignalThreshold(1);
+					break;
+				}
 				m_controller->SetSignalThreshold(1);
-				break;
 			}
 
-			m_controller->Read(&buffer[2], buffer[1]);
-			m_controller->SetSignalThreshold(1);
+			m_controller->Read(&_buffer[2], _buffer[1]);
+
+			uint32 length = _buffer[1] + 2;
 
-			uint32 length = buffer[1] + 2;
+			uint8 nodeId = NodeFromMessage(_buffer);
+			if (nodeId == 0)
+			{
+				nodeId = GetNodeNumber(m_currentMsg);
+			}
 
 			// Log the data
-			string str = "";
-			for (uint32 i = 0; i < length; ++i)
+			if (Log::IsLevelEnabled(LogLevel_Detail))
 			{
-				if (i)
+				string str = "";
+				for (uint32 i = 0; i < length; ++i)
 				{
-					str += ", ";
-				}
+					if (i)
+					{
+						str += ", ";
+					}
 
-				char byteStr[8];
-				snprintf(byteStr, sizeof(byteStr), "0x%.2x", buffer[i]);
-				str += byteStr;
-			}
-			uint8 nodeId = NodeFromMessage(buffer);
-			if (nodeId == 0)
-			{
-				nodeId = GetNodeNumber(m_currentMsg);
+					char byteStr[8];
+					snprintf(byteStr, sizeof(byteStr), "0x%.2x", _buffer[i]);
+					str += byteStr;
+				}
+				Log::Write(LogLevel_Detail, nodeId, "  Received: %s", str.c_str());
 			}
-			Log::Write(LogLevel_Detail, nodeId, "  Received: %s", str.c_str());
 
 			// Verify checksum
 			uint8 checksum = 0xff;
 			for (uint32 i = 1; i < (length - 1); ++i)
 			{
-				checksum ^= buffer[i];
+				checksum ^= _buffer[i];
 			}
 
-			if (buffer[length - 1] == checksum)
+			if (_buffer[length - 1] == checksum)
 			{
 				// Checksum correct - send ACK
 				uint8 ack = ACK;
@@ -1713,7 +2477,7 @@ bool Driver::ReadMsg()
 				m_readCnt++;
 
 				// Process the received message
-				ProcessMsg(&buffer[2], length - 2);
+				ProcessMsg(&_buffer[2], length - 2);
 			}
 			else
 			{
@@ -1782,7 +2546,7 @@ bool Driver::ReadMsg()
 
 		default:
 		{
-			Log::Write(LogLevel_Warning, "WARNING: Out of frame flow! (0x%.2x).  Sending NAK.", buffer[0]);
+			Log::Write(LogLevel_Warning, "WARNING: Out of frame flow! (0x%.2x).  Sending NAK.", _buffer[0]);
 			m_OOFCnt++;
 			uint8 nak = NAK;
 			m_controller->Write(&nak, 1);
@@ -1811,6 +2575,19 @@ void Driver::ProcessMsg(uint8* _data, uint8 _length)
 		{
 			Log::Write(LogLevel_Info, _data[3], "Received SecurityCmd_NonceReport from node %d", _data[3]);
 
+			/* a report we did not ask for with a Nonce_Get may answer a MessageEncapNonceGet,
+			 * so the node keeps it for the next message if one is outstanding */
+			if (m_noncePrefetch && (m_nonceGetSent != _data[3]))
+			{
+				Internal::LockGuard LG(m_nodeMutex);
+				if (Node* node = GetNode(_data[3]))
+				{
+					node->SetPrefetchedNonce(&_data[7], c_prefetchedNonceLifetime);
+				}
+				return;
+			}
+			m_nonceGetSent = 0;
+
 			/* handle possible resends of NONCE_REPORT messages.... See Issue #931 */
 			if (!m_currentMsg)
 			{
@@ -1821,6 +2598,16 @@ void Driver::ProcessMsg(uint8* _data, uint8 _length)
 			// No Need to triger a WriteMsg here - It should be handled automatically
 			m_currentMsg->setNonce(&_data[7]);
 			this->SendEncryptedMessage();
+			{
+				// Now wait for the reply to the message itself
+				Internal::LockGuard LG(m_nodeMutex);
+				Node* node = GetNode(_data[3]);
+				if (node)
+				{
+					node->SetUsedNonce(&_data[7]);
+				}
+				m_retryTimeStamp.SetTime(GetRetryTimeout(node, m_currentMsg->GetSendAttempts()));
+			}
 			return;
 
 			/* if this is a NONCE Get - Then call to the CC directly, process it, and then bail out. */
@@ -2742,6 +3529,11 @@ void Driver::HandleSerialAPIGetInitDataResponse(uint8* _data)
 
 		// Read the config file first, to get the last known state
 		ReadCache();
+
+		if (s_cacheJournal.Get() && (s_cacheJournalInterval.Get() > 0))
+		{
+			m_cacheTimer->TimerSetEvent(s_cacheJournalInterval.Get() * 1000, bind(&Driver::CacheJournalTimer, this, 1), 1);
+		}
 	}
 	else
 	{
@@ -2780,6 +3572,7 @@ void Driver::HandleSerialAPIGetInitDataResponse(uint8* _data)
 							{
 								// The node was read in from the config, so we
 								// only need to get its current state
+								Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 								node->SetQueryStage(Node::QueryStage_CacheLoad);
 							}
 
@@ -2804,8 +3597,7 @@ void Driver::HandleSerialAPIGetInitDataResponse(uint8* _data)
 					{
 						// This node no longer exists in the Z-Wave network
 						Log::Write(LogLevel_Info, GetNodeNumber(m_currentMsg), "    Node %.3d - Removed", nodeId);
-						delete m_nodes[nodeId];
-						m_nodes[nodeId] = NULL;
+						DeleteNode(nodeId);
 						Notification* notification = new Notification(Notification::Type_NodeRemoved);
 						notification->SetHomeAndNodeIds(m_homeId, nodeId);
 						QueueNotification(notification);
@@ -2837,6 +3629,8 @@ void Driver::HandleGetNodeProtocolInfoResponse(uint8* _data)
 	Log::Write(LogLevel_Info, nodeId, "Received reply to FUNC_ID_ZW_GET_NODE_PROTOCOL_INFO");
 
 	// Update the node with the protocol info
+	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 	if (Node* node = GetNodeUnsafe(nodeId))
 	{
 		node->UpdateProtocolInfo(&_data[2]);
@@ -2976,6 +3770,8 @@ void Driver::HandleIsFailedNodeResponse(uint8* _data)
 			}
 			else
 			{
+				Internal::LockGuard LG(m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 				node->SetNodeAlive(false);
 			}
 		}
@@ -2983,6 +3779,8 @@ void Driver::HandleIsFailedNodeResponse(uint8* _data)
 	else
 	{
 		Log::Write(LogLevel_Warning, nodeId, "Received reply to FUNC_ID_ZW_IS_FAILED_NODE_ID - node %d has not failed", nodeId);
+		Internal::LockGuard LG(m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 		if (Node* node = GetNodeUnsafe(nodeId))
 		{
 			node->SetNodeAlive(true);
@@ -3046,6 +3844,7 @@ void Driver::HandleGetRoutingInfoResponse(uint8* _data)
 	Log::Write(LogLevel_Info, GetNodeNumber(m_currentMsg), "Received reply to FUNC_ID_ZW_GET_ROUTING_INFO");
 
 	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[GetNodeNumber(m_currentMsg)]);
 	if (Node* node = GetNode(GetNodeNumber(m_currentMsg)))
 	{
 		// copy the 29-byte bitmap received (29*8=232 possible nodes) into this node's neighbors member variable
@@ -3088,15 +3887,19 @@ void Driver::HandleSendDataRequest(uint8* _data, uint8 _length, bool _replicatio
 	}
 	else
 	{
+		Internal::LockGuard LG(m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 		Node* node = GetNodeUnsafe(nodeId);
 		if (node != NULL)
 		{
 			if (_data[3] != TRANSMIT_COMPLETE_OK)
 			{
 				node->m_sentFailed++;
+				NodeSendFailed(nodeId);
 			}
 			else
 			{
+				node->m_sendFailures = 0;
 				node->m_lastRequestRTT = -node->m_sentTS.TimeRemaining();
 
 				if (node->m_averageRequestRTT)
@@ -3109,6 +3912,12 @@ void Driver::HandleSendDataRequest(uint8* _data, uint8 _length, bool _replicatio
 					// if this is the first observed RTT, set the average to this value
 					node->m_averageRequestRTT = node->m_lastRequestRTT;
 				}
+				// Only time messages that have been sent once, as a late reply to an
+				// earlier attempt would look like a short round trip
+				if ((m_currentMsg != NULL) && (m_currentMsg->GetSendAttempts() <= 1))
+				{
+					UpdateRTTEstimate(node->m_lastRequestRTT, &node->m_requestSRTT, &node->m_requestRTTVar);
+				}
 				Log::Write(LogLevel_Info, nodeId, "Request RTT %d Average Request RTT %d", node->m_lastRequestRTT, node->m_averageRequestRTT);
 			}
 			/* if the frame has txStatus message, then extract it */
@@ -3143,8 +3952,11 @@ void Driver::HandleSendDataRequest(uint8* _data, uint8 _length, bool _replicatio
 				Node::NodeData nd;
 				node->GetNodeStatistics(&nd);
 				// petergebruers: changed "ChannelAck" to "AckChannel", to be consistent with docs and "TxChannel"
-				Log::Write(LogLevel_Detail, nodeId, "Extended TxStatus: Time: %d, Hops: %d, Rssi: %s %s %s %s %s, AckChannel: %d, TxChannel: %d, RouteScheme: %s, Route: %d %d %d %d, RouteSpeed: %s, RouteTries: %d, FailedLinkFrom: %d, FailedLinkTo: %d", nd.m_txTime, nd.m_hops, nd.m_rssi_1, nd.m_rssi_2, nd.m_rssi_3, nd.m_rssi_4, nd.m_rssi_4, nd.m_ackChannel, nd.m_lastTxChannel, Manager::GetNodeRouteScheme(&nd).c_str(), nd.m_routeUsed[0], nd.m_routeUsed[1], nd.m_routeUsed[2], nd.m_routeUsed[3],
-						Manager::GetNodeRouteSpeed(&nd).c_str(), nd.m_routeTries, nd.m_lastFailedLinkFrom, nd.m_lastFailedLinkTo);
+				if (Log::IsLevelEnabled(LogLevel_Detail))
+				{
+					Log::Write(LogLevel_Detail, nodeId, "Extended TxStatus: Time: %d, Hops: %d, Rssi: %s %s %s %s %s, AckChannel: %d, TxChannel: %d, RouteScheme: %s, Route: %d %d %d %d, RouteSpeed: %s, RouteTries: %d, FailedLinkFrom: %d, FailedLinkTo: %d", nd.m_txTime, nd.m_hops, nd.m_rssi_1, nd.m_rssi_2, nd.m_rssi_3, nd.m_rssi_4, nd.m_rssi_4, nd.m_ackChannel, nd.m_lastTxChannel, Manager::GetNodeRouteScheme(&nd).c_str(), nd.m_routeUsed[0], nd.m_routeUsed[1], nd.m_routeUsed[2], nd.m_routeUsed[3],
+							Manager::GetNodeRouteSpeed(&nd).c_str(), nd.m_routeTries, nd.m_lastFailedLinkFrom, nd.m_lastFailedLinkTo);
+				}
 			}
 
 		}
@@ -3339,7 +4151,7 @@ void Driver::HandleRemoveNodeFromNetworkRequest(uint8* _data)
 			{
 				m_currentControllerCommand->m_controllerCommandNode = _data[4];
 			}
-			WriteCache();
+			WriteCacheChanges();
 			Log::Write(LogLevel_Info, "Removing controller ID %d", m_currentControllerCommand->m_controllerCommandNode);
 			break;
 		}
@@ -3365,10 +4177,10 @@ void Driver::HandleRemoveNodeFromNetworkRequest(uint8* _data)
 				{
 					{
 						Internal::LockGuard LG(m_nodeMutex);
-						delete m_nodes[m_currentControllerCommand->m_controllerCommandNode];
-						m_nodes[m_currentControllerCommand->m_controllerCommandNode] = NULL;
+						DeleteNode(m_currentControllerCommand->m_controllerCommandNode);
 					}
-					WriteCache();
+					MarkNodeDirty(m_currentControllerCommand->m_controllerCommandNode);
+					WriteCacheChanges();
 					Notification* notification = new Notification(Notification::Type_NodeRemoved);
 					notification->SetHomeAndNodeIds(m_homeId, m_currentControllerCommand->m_controllerCommandNode);
 					QueueNotification(notification);
@@ -3502,10 +4314,10 @@ void Driver::HandleRemoveFailedNodeRequest(uint8* _data)
 			state = ControllerState_Completed;
 			{
 				Internal::LockGuard LG(m_nodeMutex);
-				delete m_nodes[m_currentControllerCommand->m_controllerCommandNode];
-				m_nodes[m_currentControllerCommand->m_controllerCommandNode] = NULL;
+				DeleteNode(m_currentControllerCommand->m_controllerCommandNode);
 			}
-			WriteCache();
+			MarkNodeDirty(m_currentControllerCommand->m_controllerCommandNode);
+			WriteCacheChanges();
 			Notification* notification = new Notification(Notification::Type_NodeRemoved);
 			notification->SetHomeAndNodeIds(m_homeId, m_currentControllerCommand->m_controllerCommandNode);
 			QueueNotification(notification);
@@ -3555,7 +4367,7 @@ void Driver::HandleReplaceFailedNodeRequest(uint8* _data)
 			{
 				InitNode(m_currentControllerCommand->m_controllerCommandNode, true);
 			}
-			WriteCache();
+			WriteCacheChanges();
 			break;
 		}
 		case FAILED_NODE_REPLACE_FAILED:
@@ -3579,6 +4391,10 @@ void Driver::HandleApplicationCommandHandlerRequest(uint8* _data, bool encrypted
 	uint8 status = _data[2];
 	uint8 nodeId = _data[3];
 	uint8 classId = _data[5];
+
+	// Keep readers of this node out while it, its command classes and its values are updated
+	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 	Node* node = GetNodeUnsafe(nodeId);
 
 	if ((status & RECEIVE_STATUS_ROUTED_BUSY) != 0)
@@ -3593,6 +4409,7 @@ void Driver::HandleApplicationCommandHandlerRequest(uint8* _data, bool encrypted
 	{
 		node->m_receivedCnt++;
 		node->m_errors = 0;
+		node->m_sendFailures = 0;
 		int cmp = memcmp(_data, node->m_lastReceivedMessage, sizeof(node->m_lastReceivedMessage));
 		if (cmp == 0 && node->m_receivedTS.TimeRemaining() > -500)
 		{
@@ -3620,6 +4437,10 @@ void Driver::HandleApplicationCommandHandlerRequest(uint8* _data, bool encrypted
 				// if this is the first observed RTT, set the average to this value
 				node->m_averageResponseRTT = node->m_lastResponseRTT;
 			}
+			if ((m_currentMsg != NULL) && (m_currentMsg->GetSendAttempts() <= 1))
+			{
+				UpdateRTTEstimate(node->m_lastResponseRTT, &node->m_responseSRTT, &node->m_responseRTTVar);
+			}
 			Log::Write(LogLevel_Info, nodeId, "Response RTT %d Average Response RTT %d", node->m_lastResponseRTT, node->m_averageResponseRTT);
 		}
 		else
@@ -3807,6 +4628,8 @@ bool Driver::HandleApplicationUpdateRequest(uint8* _data)
 	// If node is not alive, mark it alive now
 	if (node != NULL && !node->IsNodeAlive())
 	{
+		Internal::LockGuard LG(m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 		node->SetNodeAlive(true);
 	}
 
@@ -3823,8 +4646,7 @@ bool Driver::HandleApplicationUpdateRequest(uint8* _data)
 			Log::Write(LogLevel_Info, nodeId, "** Network change **: Z-Wave node %d was removed", nodeId);
 			{
 				Internal::LockGuard LG(m_nodeMutex);
-				delete m_nodes[nodeId];
-				m_nodes[nodeId] = NULL;
+				DeleteNode(nodeId);
 			}
 			Notification* notification = new Notification(Notification::Type_NodeRemoved);
 			notification->SetHomeAndNodeIds(m_homeId, nodeId);
@@ -3860,6 +4682,8 @@ bool Driver::HandleApplicationUpdateRequest(uint8* _data)
 			// assume the message came from the last node to which we sent a request.
 			if (m_currentMsg)
 			{
+				Internal::LockGuard LG(m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(m_nodeLocks[m_currentMsg->GetTargetNodeId()]);
 				Node* tnode = GetNodeUnsafe(m_currentMsg->GetTargetNodeId());
 				if (tnode)
 				{
@@ -3887,6 +4711,8 @@ bool Driver::HandleApplicationUpdateRequest(uint8* _data)
 			Log::Write(LogLevel_Info, nodeId, "UPDATE_STATE_NODE_INFO_RECEIVED from node %d", nodeId);
 			if (node)
 			{
+				Internal::LockGuard LG(m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
 				node->UpdateNodeInfo(&_data[8], _data[4] - 3);
 			}
 			break;
@@ -4062,27 +4888,22 @@ bool Driver::EnablePoll(ValueID const &_valueId, uint8 const _intensity)
 		if (Internal::VC::Value* value = node->GetValue(_valueId))
 		{
 			// update the value's pollIntensity
-			value->SetPollIntensity(_intensity);
-
-			// Add the valueid to the polling list
-			// See if the node is already in the poll list.
-			for (list<PollEntry>::iterator it = m_pollList.begin(); it != m_pollList.end(); ++it)
 			{
-				if ((*it).m_id == _valueId)
-				{
-					// It is already in the poll list, so we have nothing to do.
-					Log::Write(LogLevel_Detail, "EnablePoll not required to do anything (value is already in the poll list)");
-					value->Release();
-					m_pollMutex->Unlock();
-					return true;
-				}
+				Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
+				value->SetPollIntensity(_intensity);
 			}
 
-			// Not in the list, so we add it
-			PollEntry pe;
-			pe.m_id = _valueId;
-			pe.m_pollCounter = value->GetPollIntensity();
-			m_pollList.push_back(pe);
+			// Add the valueid to the poll schedule.  If it is already there, this just
+			// updates its intensity and interval.
+			if (!m_pollScheduler->Add(_valueId, value->GetPollIntensity(), value->GetPollInterval(), Internal::GetMonotonicTime()))
+			{
+				// It is already in the poll list, so we have nothing to do.
+				Log::Write(LogLevel_Detail, "EnablePoll not required to do anything (value is already in the poll list)");
+				value->Release();
+				m_pollMutex->Unlock();
+				return true;
+			}
+			size_t pollCount = m_pollScheduler->Size();
 			value->Release();
 			m_pollMutex->Unlock();
 
@@ -4091,8 +4912,9 @@ bool Driver::EnablePoll(ValueID const &_valueId, uint8 const _intensity)
 			notification->SetHomeAndNodeIds(m_homeId, _valueId.GetNodeId());
 			notification->SetValueId(_valueId);
 			QueueNotification(notification);
-			Log::Write(LogLevel_Info, nodeId, "EnablePoll for HomeID 0x%.8x, value(cc=0x%02x,in=0x%02x,id=0x%02x)--poll list has %d items", _valueId.GetHomeId(), _valueId.GetCommandClassId(), _valueId.GetIndex(), _valueId.GetInstance(), m_pollList.size());
-			WriteCache();
+			Log::Write(LogLevel_Info, nodeId, "EnablePoll for HomeID 0x%.8x, value(cc=0x%02x,in=0x%02x,id=0x%02x)--poll list has %d items", _valueId.GetHomeId(), _valueId.GetCommandClassId(), _valueId.GetIndex(), _valueId.GetInstance(), pollCount);
+			MarkNodeDirty(nodeId);
+			WriteCacheChanges();
 			return true;
 		}
 
@@ -4125,32 +4947,29 @@ bool Driver::DisablePoll(ValueID const &_valueId)
 	Node* node = GetNode(nodeId);
 	if (node != NULL)
 	{
-		// See if the value is already in the poll list.
-		for (list<PollEntry>::iterator it = m_pollList.begin(); it != m_pollList.end(); ++it)
+		// remove it from the poll schedule
+		if (m_pollScheduler->Remove(_valueId))
 		{
-			if ((*it).m_id == _valueId)
-			{
-				// Found it
-				// remove it from the poll list
-				m_pollList.erase(it);
+			size_t pollCount = m_pollScheduler->Size();
 
-				// get the value object and reset pollIntensity to zero (indicating no polling)
-				Internal::VC::Value* value = GetValue(_valueId);
-				if (!value)
-					continue;
-				value->SetPollIntensity(0);
-				value->Release();
-				m_pollMutex->Unlock();
-
-				// send notification to indicate polling is disabled
-				Notification* notification = new Notification(Notification::Type_PollingDisabled);
-				notification->SetHomeAndNodeIds(m_homeId, _valueId.GetNodeId());
-				notification->SetValueId(_valueId);
-				QueueNotification(notification);
-				Log::Write(LogLevel_Info, nodeId, "DisablePoll for HomeID 0x%.8x, value(cc=0x%02x,in=0x%02x,id=0x%02x)--poll list has %d items", _valueId.GetHomeId(), _valueId.GetCommandClassId(), _valueId.GetIndex(), _valueId.GetInstance(), m_pollList.size());
-				WriteCache();
-				return true;
+			// get the value object and reset pollIntensity to zero (indicating no polling)
+			if (Internal::VC::Value* value = GetValue(_valueId))
+			{
+				Internal::ExclusiveLockGuard ELG(m_nodeLocks[nodeId]);
+				value->SetPollIntensity(0);
+				value->Release();
 			}
+			m_pollMutex->Unlock();
+
+			// send notification to indicate polling is disabled
+			Notification* notification = new Notification(Notification::Type_PollingDisabled);
+			notification->SetHomeAndNodeIds(m_homeId, _valueId.GetNodeId());
+			notification->SetValueId(_valueId);
+			QueueNotification(notification);
+			Log::Write(LogLevel_Info, nodeId, "DisablePoll for HomeID 0x%.8x, value(cc=0x%02x,in=0x%02x,id=0x%02x)--poll list has %d items", _valueId.GetHomeId(), _valueId.GetCommandClassId(), _valueId.GetIndex(), _valueId.GetInstance(), pollCount);
+			MarkNodeDirty(nodeId);
+			WriteCacheChanges();
+			return true;
 		}
 
 		// Not in the list
@@ -4192,7 +5011,7 @@ bool Driver::isPolled(ValueID const &_valueId)
 
 	/*
 	 * This code is retained for the moment as a belt-and-suspenders test to confirm that
-	 * the pollIntensity member of each value and the pollList contents do not get out
+	 * the pollIntensity member of each value and the poll schedule contents do not get out
 	 * of sync.
 	 */
 	// confirm that this node exists
@@ -4201,36 +5020,13 @@ bool Driver::isPolled(ValueID const &_valueId)
 	Node* node = GetNode(nodeId);
 	if (node != NULL)
 	{
-
-		// See if the value is already in the poll list.
-		for (list<PollEntry>::iterator it = m_pollList.begin(); it != m_pollList.end(); ++it)
-		{
-			if ((*it).m_id == _valueId)
-			{
-				// Found it
-				if (bPolled)
-				{
-					m_pollMutex->Unlock();
-					return true;
-				}
-				else
-				{
-					Log::Write(LogLevel_Error, nodeId, "IsPolled setting for valueId 0x%016x is not consistent with the poll list", _valueId.GetId());
-				}
-			}
-		}
-
-		// Not in the list
-
-		if (!bPolled)
+		if (m_pollScheduler->Contains(_valueId) == bPolled)
 		{
 			m_pollMutex->Unlock();
-			return false;
-		}
-		else
-		{
-			Log::Write(LogLevel_Error, nodeId, "IsPolled setting for valueId 0x%016x is not consistent with the poll list", _valueId.GetId());
+			return bPolled;
 		}
+
+		Log::Write(LogLevel_Error, nodeId, "IsPolled setting for valueId 0x%016x is not consistent with the poll list", _valueId.GetId());
 	}
 
 	// allow the poll thread to continue
@@ -4251,12 +5047,57 @@ void Driver::SetPollIntensity(ValueID const &_valueId, uint8 const _intensity)
 
 	Internal::VC::Value* value = GetValue(_valueId);
 	if (!value)
+	{
+		m_pollMutex->Unlock();
+		return;
+	}
+	{
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_valueId.GetNodeId()]);
+		value->SetPollIntensity(_intensity);
+	}
+	m_pollScheduler->SetIntensity(_valueId, _intensity);
+
+	value->Release();
+	m_pollMutex->Unlock();
+	MarkNodeDirty(_valueId.GetNodeId());
+	WriteCacheChanges();
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::SetValuePollInterval>
+// Set the time between polls of a single value
+//-----------------------------------------------------------------------------
+void Driver::SetValuePollInterval(ValueID const &_valueId, int32 const _milliseconds)
+{
+	// make sure the polling thread doesn't lock the value while we're in this function
+	m_pollMutex->Lock();
+
+	Internal::VC::Value* value = GetValue(_valueId);
+	if (!value)
+	{
+		m_pollMutex->Unlock();
 		return;
-	value->SetPollIntensity(_intensity);
+	}
+	{
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_valueId.GetNodeId()]);
+		value->SetPollInterval(_milliseconds > 0 ? _milliseconds : 0);
+	}
+	m_pollScheduler->SetInterval(_valueId, value->GetPollInterval(), Internal::GetMonotonicTime());
 
 	value->Release();
 	m_pollMutex->Unlock();
-	WriteCache();
+	MarkNodeDirty(_valueId.GetNodeId());
+	WriteCacheChanges();
+}
+
+//-----------------------------------------------------------------------------
+// <Driver::SetNodeAsleepForPolling>
+// Tell the poll scheduler whether a node is asleep
+//-----------------------------------------------------------------------------
+void Driver::SetNodeAsleepForPolling(uint8 const _nodeId, bool const _asleep)
+{
+	// Only touches atomic flags, so it is safe to call with the node mutex held
+	m_pollScheduler->SetNodeAsleep(_nodeId, _asleep);
 }
 
 //-----------------------------------------------------------------------------
@@ -4278,69 +5119,83 @@ void Driver::PollThreadEntryPoint(Internal::Platform::Event* _exitEvent, void* _
 //-----------------------------------------------------------------------------
 void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 {
+	// The legacy interval that was last logged, so the conversion is only logged
+	// when the setting changes rather than every time round the loop
+	int32 loggedLegacyInterval = -1;
 	while (1)
 	{
 		int32 pollInterval = m_pollInterval;
+		int32 waitTime = 500;
 
-		if (m_awakeNodesQueried && !m_pollList.empty())
+		if (m_awakeNodesQueried)
 		{
-			// We only bother getting the lock if the pollList is not empty
-			m_pollMutex->Lock();
-
-			// Get the next value to be polled
-			PollEntry pe = m_pollList.front();
-			m_pollList.pop_front();
-			ValueID valueId = pe.m_id;
-
-			// only execute this poll if pe.m_pollCounter == 1; otherwise decrement the counter and process the next polled value
-			if (pe.m_pollCounter != 1)
+			if (!m_bIntervalBetweenPolls && pollInterval < 100)
 			{
-				pe.m_pollCounter--;
-				m_pollList.push_back(pe);
-				m_pollMutex->Unlock();
-				continue;
+				if (pollInterval != loggedLegacyInterval)
+				{
+					Log::Write(LogLevel_Info, "The pollInterval setting is only %d, which appears to be a legacy setting.  Multiplying by 1000 to convert to ms.", pollInterval);
+					loggedLegacyInterval = pollInterval;
+				}
+				pollInterval *= 1000;
 			}
 
-			// reset the poll counter to the full pollIntensity value and push it at the end of the list
-			// release the value object referenced; call GetNode to ensure the node objects are locked during this period
-			{
-				Internal::LockGuard LG(m_nodeMutex);
-				(void) GetNode(valueId.GetNodeId());
-				Internal::VC::Value* value = GetValue(valueId);
-				if (!value)
-					continue;
-				pe.m_pollCounter = value->GetPollIntensity();
-				m_pollList.push_back(pe);
-				value->Release();
-			}
-			// If the polling interval is for the whole poll list, calculate the time before the next poll,
-			// so that all polls can take place within the user-specified interval.
-			if (!m_bIntervalBetweenPolls)
+			ValueID valueId;
+			bool asleep = false;
+			bool due;
+			int32 spacing = pollInterval;
 			{
-				if (pollInterval < 100)
+				Internal::LockGuard LG(m_pollMutex);
+				uint64 now = Internal::GetMonotonicTime();
+				int32 pollCount = (int32) m_pollScheduler->Size();
+
+				// The poll interval is either the time to get through every polled value (the
+				// period of an intensity 1 value), or the gap between two consecutive polls.
+				int32 period = pollInterval;
+				if (pollCount > 0)
 				{
-					Log::Write(LogLevel_Info, "The pollInterval setting is only %d, which appears to be a legacy setting.  Multiplying by 1000 to convert to ms.", pollInterval);
-					pollInterval *= 1000;
+					if (m_bIntervalBetweenPolls)
+					{
+						period = pollInterval * pollCount;
+					}
+					else
+					{
+						spacing = pollInterval / pollCount;
+					}
+				}
+
+				due = m_pollScheduler->PopDue(now, period, &valueId, &asleep);
+				if (!due)
+				{
+					int32 untilDue = m_pollScheduler->TimeUntilNextDue(now);
+					if (untilDue >= 0 && untilDue < waitTime)
+					{
+						waitTime = untilDue;
+					}
 				}
-				pollInterval /= (int32) m_pollList.size();
 			}
 
+			if (due)
 			{
 				Internal::LockGuard LG(m_nodeMutex);
 				// Request the state of the value from the node to which it belongs
 				if (Node* node = GetNode(valueId.GetNodeId()))
 				{
-					bool requestState = true;
+					bool requestState = !asleep;
 					if (!node->IsListeningDevice())
 					{
 						// The device is not awake all the time.  If it is not awake, we mark it
 						// as requiring a poll.  The poll will be done next time the node wakes up.
+						// The scheduler will not hand out any more of this node's values until then.
 						if (Internal::CC::WakeUp* wakeUp = static_cast<Internal::CC::WakeUp*>(node->GetCommandClass(Internal::CC::WakeUp::StaticGetCommandClassId())))
 						{
-							if (!wakeUp->IsAwake())
+							if (asleep || !wakeUp->IsAwake())
 							{
 								wakeUp->SetPollRequired();
 								requestState = false;
+								if (!asleep)
+								{
+									m_pollScheduler->SetNodeAsleep(valueId.GetNodeId(), true);
+								}
 							}
 						}
 					}
@@ -4353,57 +5208,64 @@ void Driver::PollThreadProc(Internal::Platform::Event* _exitEvent)
 						{
 							uint16_t index = valueId.GetIndex();
 							uint8_t instance = valueId.GetInstance();
-							Log::Write(LogLevel_Detail, node->m_nodeId, "Polling: %s index = %d instance = %d (poll queue has %d messages)", cc->GetCommandClassName().c_str(), index, instance, m_msgQueue[MsgQueue_Poll].size());
+							if (Log::IsLevelEnabled(LogLevel_Detail))
+							{
+								Log::Write(LogLevel_Detail, node->m_nodeId, "Polling: %s index = %d instance = %d (poll queue has %d messages)", cc->GetCommandClassName().c_str(), index, instance, m_msgQueue[MsgQueue_Poll].size());
+							}
 							cc->RequestValue(0, index, instance, MsgQueue_Poll);
 						}
 					}
-
-				}
-			}
-
-			m_pollMutex->Unlock();
-
-			// Polling messages are only sent when there are no other messages waiting to be sent
-			// While this makes the polls much more variable and uncertain if some other activity dominates
-			// a send queue, that may be appropriate
-			// TODO we can have a debate about whether to test all four queues or just the Poll queue
-			// Wait until the library isn't actively sending messages (or in the midst of a transaction)
-			int i32;
-			int loopCount = 0;
-			while (!m_msgQueue[MsgQueue_Poll].empty() || !m_msgQueue[MsgQueue_Send].empty() || !m_msgQueue[MsgQueue_Command].empty() || !m_msgQueue[MsgQueue_Query].empty() || m_currentMsg != NULL)
-			{
-				i32 = Internal::Platform::Wait::Single(_exitEvent, 10);		// test conditions every 10ms
-				if (i32 == 0)
-				{
-					// Exit has been called
-					return;
+					else
+					{
+						// Nothing was sent, so there is no need to pace the next poll
+						continue;
+					}
 				}
-				loopCount++;
-				if (loopCount == 3000 * 10)		// 300 seconds worth of delay?  Something unusual is going on
+				else
 				{
-					Log::Write(LogLevel_Warning, "Poll queue hasn't been able to execute for 300 secs or more");
-					Log::QueueDump();
-					//					assert( 0 );
+					continue;
 				}
 			}
 
-			// ready for next poll...insert the pollInterval delay
-			i32 = Internal::Platform::Wait::Single(_exitEvent, pollInterval);
-			if (i32 == 0)
+			if (due)
 			{
-				// Exit has been called
-				return;
+				// Polling messages are only sent when there are no other messages waiting to be sent
+				// While this makes the polls much more variable and uncertain if some other activity dominates
+				// a send queue, that may be appropriate
+				// TODO we can have a debate about whether to test all four queues or just the Poll queue
+				// Wait until the library isn't actively sending messages (or in the midst of a transaction)
+				int i32;
+				int loopCount = 0;
+				while (!m_msgQueue[MsgQueue_Poll].empty() || !m_msgQueue[MsgQueue_Send].empty() || !m_msgQueue[MsgQueue_Command].empty() || !m_msgQueue[MsgQueue_Query].empty() || m_currentMsg != NULL)
+				{
+					i32 = Internal::Platform::Wait::Single(_exitEvent, 10);		// test conditions every 10ms
+					if (i32 == 0)
+					{
+						// Exit has been called
+						return;
+					}
+					loopCount++;
+					if (loopCount == 3000 * 10)		// 300 seconds worth of delay?  Something unusual is going on
+					{
+						Log::Write(LogLevel_Warning, "Poll queue hasn't been able to execute for 300 secs or more");
+						Log::QueueDump();
+						//					assert( 0 );
+					}
+				}
+
+				// ready for next poll...insert the delay between polls
+				waitTime = spacing;
 			}
 		}
-		else		// poll list is empty or awake nodes haven't been fully queried yet
+
+		// Either wait out the gap between polls, or (if nothing is due or the awake nodes
+		// haven't been fully queried yet) sleep until the next value is due, re-checking
+		// at least every 500ms so that newly enabled values are picked up.
+		int32 i32 = Internal::Platform::Wait::Single(_exitEvent, waitTime);
+		if (i32 == 0)
 		{
-			// don't poll just yet, wait for the pollInterval or exit before re-checking to see if the pollList has elements
-			int32 i32 = Internal::Platform::Wait::Single(_exitEvent, 500);
-			if (i32 == 0)
-			{
-				// Exit has been called
-				return;
-			}
+			// Exit has been called
+			return;
 		}
 	}
 }
@@ -4425,8 +5287,7 @@ void Driver::InitAllNodes()
 		{
 			if (m_nodes[i])
 			{
-				delete m_nodes[i];
-				m_nodes[i] = NULL;
+				DeleteNode(i);
 			}
 		}
 	}
@@ -4434,6 +5295,24 @@ void Driver::InitAllNodes()
 	SendMsg(new Internal::Msg("FUNC_ID_ZW_GET_VERSION", 0xff, REQUEST, FUNC_ID_ZW_GET_VERSION, false), Driver::MsgQueue_Command);
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::DeleteNode>
+// Delete a node object and anything left in the poll schedule for it
+//-----------------------------------------------------------------------------
+void Driver::DeleteNode(uint8 const _nodeId)
+{
+	{
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+		delete m_nodes[_nodeId];
+		m_nodes[_nodeId] = NULL;
+	}
+
+	// The node's destructor disables polling of its values, but drop anything that got out
+	// of step, and forget whether the node was asleep in case its id is reused.
+	Internal::LockGuard LG(m_pollMutex);
+	m_pollScheduler->RemoveNode(_nodeId);
+}
+
 //-----------------------------------------------------------------------------
 // <Driver::InitNode>
 // Queue a node to be interrogated for its setup details
@@ -4446,16 +5325,18 @@ void Driver::InitNode(uint8 const _nodeId, bool newNode, bool secure, uint8 cons
 		if (m_nodes[_nodeId])
 		{
 			// Remove the original node
-			delete m_nodes[_nodeId];
-			m_nodes[_nodeId] = NULL;
-			WriteCache();
+			DeleteNode(_nodeId);
+			MarkNodeDirty(_nodeId);
+			WriteCacheChanges();
 			Notification* notification = new Notification(Notification::Type_NodeRemoved);
 			notification->SetHomeAndNodeIds(m_homeId, _nodeId);
 			QueueNotification(notification);
 		}
 
 		// Add the new node
-		m_nodes[_nodeId] = new Node(m_homeId, _nodeId);
+		Node* node = new Node(m_homeId, _nodeId);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+		m_nodes[_nodeId] = node;
 		if (newNode == true)
 			static_cast<Node *>(m_nodes[_nodeId])->SetAddingNode();
 	}
@@ -4464,6 +5345,8 @@ void Driver::InitNode(uint8 const _nodeId, bool newNode, bool secure, uint8 cons
 	notification->SetHomeAndNodeIds(m_homeId, _nodeId);
 	QueueNotification(notification);
 
+	Internal::LockGuard LG(m_nodeMutex);
+	Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
 	if (_length == 0)
 	{
 		// Request the node info
@@ -4487,8 +5370,8 @@ void Driver::InitNode(uint8 const _nodeId, bool newNode, bool secure, uint8 cons
 bool Driver::IsNodeListeningDevice(uint8 const _nodeId)
 {
 	bool res = false;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		res = node->IsListeningDevice();
 	}
@@ -4503,8 +5386,8 @@ bool Driver::IsNodeListeningDevice(uint8 const _nodeId)
 bool Driver::IsNodeFrequentListeningDevice(uint8 const _nodeId)
 {
 	bool res = false;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		res = node->IsFrequentListeningDevice();
 	}
@@ -4519,8 +5402,8 @@ bool Driver::IsNodeFrequentListeningDevice(uint8 const _nodeId)
 bool Driver::IsNodeBeamingDevice(uint8 const _nodeId)
 {
 	bool res = false;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		res = node->IsBeamingDevice();
 	}
@@ -4535,8 +5418,8 @@ bool Driver::IsNodeBeamingDevice(uint8 const _nodeId)
 bool Driver::IsNodeRoutingDevice(uint8 const _nodeId)
 {
 	bool res = false;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		res = node->IsRoutingDevice();
 	}
@@ -4551,8 +5434,8 @@ bool Driver::IsNodeRoutingDevice(uint8 const _nodeId)
 bool Driver::IsNodeSecurityDevice(uint8 const _nodeId)
 {
 	bool security = false;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		security = node->IsSecurityDevice();
 	}
@@ -4567,8 +5450,8 @@ bool Driver::IsNodeSecurityDevice(uint8 const _nodeId)
 uint32 Driver::GetNodeMaxBaudRate(uint8 const _nodeId)
 {
 	uint32 baud = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		baud = node->GetMaxBaudRate();
 	}
@@ -4583,8 +5466,8 @@ uint32 Driver::GetNodeMaxBaudRate(uint8 const _nodeId)
 uint8 Driver::GetNodeVersion(uint8 const _nodeId)
 {
 	uint8 version = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		version = node->GetVersion();
 	}
@@ -4599,8 +5482,8 @@ uint8 Driver::GetNodeVersion(uint8 const _nodeId)
 uint8 Driver::GetNodeSecurity(uint8 const _nodeId)
 {
 	uint8 security = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		security = node->GetSecurity();
 	}
@@ -4615,8 +5498,8 @@ uint8 Driver::GetNodeSecurity(uint8 const _nodeId)
 uint8 Driver::GetNodeBasic(uint8 const _nodeId)
 {
 	uint8 basic = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		basic = node->GetBasic();
 	}
@@ -4630,8 +5513,8 @@ uint8 Driver::GetNodeBasic(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeBasicString(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetBasicString();
 	}
@@ -4649,8 +5532,8 @@ string Driver::GetNodeBasicString(uint8 const _nodeId)
 uint8 Driver::GetNodeGeneric(uint8 const _nodeId, uint8 const _instance)
 {
 	uint8 genericType = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		genericType = node->GetGeneric(_instance);
 	}
@@ -4664,8 +5547,8 @@ uint8 Driver::GetNodeGeneric(uint8 const _nodeId, uint8 const _instance)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeGenericString(uint8 const _nodeId, uint8 const _instance)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetGenericString(_instance);
 	}
@@ -4681,8 +5564,8 @@ string Driver::GetNodeGenericString(uint8 const _nodeId, uint8 const _instance)
 uint8 Driver::GetNodeSpecific(uint8 const _nodeId, uint8 const _instance)
 {
 	uint8 specific = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		specific = node->GetSpecific(_instance);
 	}
@@ -4696,8 +5579,8 @@ uint8 Driver::GetNodeSpecific(uint8 const _nodeId, uint8 const _instance)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeSpecificString(uint8 const _nodeId, uint8 const _instance)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetSpecificString(_instance);
 	}
@@ -4712,8 +5595,8 @@ string Driver::GetNodeSpecificString(uint8 const _nodeId, uint8 const _instance)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeType(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetType();
 	}
@@ -4723,8 +5606,8 @@ string Driver::GetNodeType(uint8 const _nodeId)
 
 bool Driver::IsNodeZWavePlus(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->IsNodeZWavePlus();
 	}
@@ -4738,8 +5621,8 @@ bool Driver::IsNodeZWavePlus(uint8 const _nodeId)
 uint32 Driver::GetNodeNeighbors(uint8 const _nodeId, uint8** o_neighbors)
 {
 	uint32 numNeighbors = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		numNeighbors = node->GetNeighbors(o_neighbors);
 	}
@@ -4754,8 +5637,8 @@ uint32 Driver::GetNodeNeighbors(uint8 const _nodeId, uint8** o_neighbors)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeManufacturerName(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetManufacturerName();
 	}
@@ -4770,8 +5653,8 @@ string Driver::GetNodeManufacturerName(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeProductName(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetProductName();
 	}
@@ -4786,8 +5669,8 @@ string Driver::GetNodeProductName(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeName(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetNodeName();
 	}
@@ -4802,8 +5685,8 @@ string Driver::GetNodeName(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeLocation(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetLocation();
 	}
@@ -4818,8 +5701,8 @@ string Driver::GetNodeLocation(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 uint16 Driver::GetNodeManufacturerId(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetManufacturerId();
 	}
@@ -4834,8 +5717,8 @@ uint16 Driver::GetNodeManufacturerId(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 uint16 Driver::GetNodeProductType(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetProductType();
 	}
@@ -4850,8 +5733,8 @@ uint16 Driver::GetNodeProductType(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 uint16 Driver::GetNodeProductId(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetProductId();
 	}
@@ -4865,8 +5748,8 @@ uint16 Driver::GetNodeProductId(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 uint16 Driver::GetNodeDeviceType(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetDeviceType();
 	}
@@ -4882,8 +5765,8 @@ uint16 Driver::GetNodeDeviceType(uint8 const _nodeId)
 string Driver::GetNodeDeviceTypeString(uint8 const _nodeId)
 {
 
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetDeviceTypeString();
 	}
@@ -4897,8 +5780,8 @@ string Driver::GetNodeDeviceTypeString(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 uint8 Driver::GetNodeRole(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetRoleType();
 	}
@@ -4912,8 +5795,8 @@ uint8 Driver::GetNodeRole(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 string Driver::GetNodeRoleString(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetRoleTypeString();
 	}
@@ -4927,8 +5810,8 @@ string Driver::GetNodeRoleString(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 uint8 Driver::GetNodePlusType(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetNodeType();
 	}
@@ -4941,8 +5824,8 @@ uint8 Driver::GetNodePlusType(uint8 const _nodeId)
 //-----------------------------------------------------------------------------
 string Driver::GetNodePlusTypeString(uint8 const _nodeId)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		return node->GetNodeTypeString();
 	}
@@ -4956,11 +5839,15 @@ string Driver::GetNodePlusTypeString(uint8 const _nodeId)
 void Driver::SetNodeManufacturerName(uint8 const _nodeId, string const& _manufacturerName)
 {
 	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
 	{
-		node->SetManufacturerName(_manufacturerName);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+		if (Node* node = GetNode(_nodeId))
+		{
+			node->SetManufacturerName(_manufacturerName);
+		}
 	}
-	WriteCache();
+	MarkNodeDirty(_nodeId);
+	WriteCacheChanges();
 }
 
 //-----------------------------------------------------------------------------
@@ -4970,11 +5857,15 @@ void Driver::SetNodeManufacturerName(uint8 const _nodeId, string const& _manufac
 void Driver::SetNodeProductName(uint8 const _nodeId, string const& _productName)
 {
 	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
 	{
-		node->SetProductName(_productName);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+		if (Node* node = GetNode(_nodeId))
+		{
+			node->SetProductName(_productName);
+		}
 	}
-	WriteCache();
+	MarkNodeDirty(_nodeId);
+	WriteCacheChanges();
 }
 
 //-----------------------------------------------------------------------------
@@ -4984,11 +5875,15 @@ void Driver::SetNodeProductName(uint8 const _nodeId, string const& _productName)
 void Driver::SetNodeName(uint8 const _nodeId, string const& _nodeName)
 {
 	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
 	{
-		node->SetNodeName(_nodeName);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+		if (Node* node = GetNode(_nodeId))
+		{
+			node->SetNodeName(_nodeName);
+		}
 	}
-	WriteCache();
+	MarkNodeDirty(_nodeId);
+	WriteCacheChanges();
 }
 
 //-----------------------------------------------------------------------------
@@ -4998,11 +5893,15 @@ void Driver::SetNodeName(uint8 const _nodeId, string const& _nodeName)
 void Driver::SetNodeLocation(uint8 const _nodeId, string const& _location)
 {
 	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
 	{
-		node->SetLocation(_location);
+		Internal::ExclusiveLockGuard ELG(m_nodeLocks[_nodeId]);
+		if (Node* node = GetNode(_nodeId))
+		{
+			node->SetLocation(_location);
+		}
 	}
-	WriteCache();
+	MarkNodeDirty(_nodeId);
+	WriteCacheChanges();
 }
 
 //-----------------------------------------------------------------------------
@@ -5765,8 +6664,8 @@ void Driver::RequestConfigParam(uint8 const _nodeId, uint8 const _param)
 uint8 Driver::GetNumGroups(uint8 const _nodeId)
 {
 	uint8 numGroups = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		numGroups = node->GetNumGroups();
 	}
@@ -5781,8 +6680,8 @@ uint8 Driver::GetNumGroups(uint8 const _nodeId)
 uint32 Driver::GetAssociations(uint8 const _nodeId, uint8 const _groupIdx, uint8** o_associations)
 {
 	uint32 numAssociations = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		numAssociations = node->GetAssociations(_groupIdx, o_associations);
 	}
@@ -5797,8 +6696,8 @@ uint32 Driver::GetAssociations(uint8 const _nodeId, uint8 const _groupIdx, uint8
 uint32 Driver::GetAssociations(uint8 const _nodeId, uint8 const _groupIdx, InstanceAssociation** o_associations)
 {
 	uint32 numAssociations = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		numAssociations = node->GetAssociations(_groupIdx, o_associations);
 	}
@@ -5813,8 +6712,8 @@ uint32 Driver::GetAssociations(uint8 const _nodeId, uint8 const _groupIdx, Insta
 uint8 Driver::GetMaxAssociations(uint8 const _nodeId, uint8 const _groupIdx)
 {
 	uint8 maxAssociations = 0;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		maxAssociations = node->GetMaxAssociations(_groupIdx);
 	}
@@ -5829,8 +6728,8 @@ uint8 Driver::GetMaxAssociations(uint8 const _nodeId, uint8 const _groupIdx)
 bool Driver::IsMultiInstance(uint8 const _nodeId, uint8 const _groupIdx)
 {
 	bool multiInstance = false;
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		multiInstance = node->IsMultiInstance(_groupIdx);
 	}
@@ -5844,8 +6743,8 @@ bool Driver::IsMultiInstance(uint8 const _nodeId, uint8 const _groupIdx)
 string Driver::GetGroupLabel(uint8 const _nodeId, uint8 const _groupIdx)
 {
 	string label = "";
-	Internal::LockGuard LG(m_nodeMutex);
-	if (Node* node = GetNode(_nodeId))
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	if (Node* node = GetNodeShared(_nodeId))
 	{
 		label = node->GetGroupLabel(_groupIdx);
 	}
@@ -5885,6 +6784,31 @@ void Driver::RemoveAssociation(uint8 const _nodeId, uint8 const _groupIdx, uint8
 //-----------------------------------------------------------------------------
 void Driver::QueueNotification(Notification* _notification)
 {
+	// Note the nodes whose cached state this changes, for WriteCacheChanges
+	switch (_notification->GetType())
+	{
+		case Notification::Type_ValueAdded:
+		case Notification::Type_ValueRemoved:
+		case Notification::Type_ValueChanged:
+		case Notification::Type_Group:
+		case Notification::Type_NodeAdded:
+		case Notification::Type_NodeRemoved:
+		case Notification::Type_NodeProtocolInfo:
+		case Notification::Type_NodeNaming:
+		case Notification::Type_PollingDisabled:
+		case Notification::Type_PollingEnabled:
+		case Notification::Type_EssentialNodeQueriesComplete:
+		case Notification::Type_NodeQueriesComplete:
+		case Notification::Type_NodeReset:
+		{
+			MarkNodeDirty(_notification->GetNodeId());
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
 	m_notifications.push_back(_notification);
 	m_notificationsEvent->Set();
 }
@@ -5895,8 +6819,7 @@ void Driver::QueueNotification(Notification* _notification)
 //-----------------------------------------------------------------------------
 void Driver::NotifyWatchers()
 {
-	list<Notification*>::iterator nit = m_notifications.begin();
-	while (nit != m_notifications.end())
+	while (!m_notifications.empty())
 	{
 		Notification* notification = m_notifications.front();
 		m_notifications.pop_front();
@@ -5912,7 +6835,6 @@ void Driver::NotifyWatchers()
 				if (!val)
 				{
 					Log::Write(LogLevel_Info, notification->GetNodeId(), "Dropping Notification as ValueID does not exist");
-					nit = m_notifications.begin();
 					delete notification;
 					continue;
 				}
@@ -5922,12 +6844,14 @@ void Driver::NotifyWatchers()
 			default:
 				break;
 		}
-		Log::Write(LogLevel_Detail, notification->GetNodeId(), "Notification: %s", notification->GetAsString().c_str());
+		// Only build the description if it is going to be logged
+		if (Log::IsLevelEnabled(LogLevel_Detail))
+		{
+			Log::Write(LogLevel_Detail, notification->GetNodeId(), "Notification: %s", notification->GetAsString().c_str());
+		}
 
+		// The Manager takes ownership of the notification
 		Manager::Get()->NotifyWatchers(notification);
-
-		delete notification;
-		nit = m_notifications.begin();
 	}
 	m_notificationsEvent->Reset();
 }
@@ -6072,7 +6996,7 @@ void Driver::SendVirtualNodeInfo(uint8 const _FromNodeId, uint8 const _ToNodeId)
 	char str[80];
 
 	snprintf(str, sizeof(str), "Send Virtual Node Info from %d to %d", _FromNodeId, _ToNodeId);
-	Internal::Msg* msg = new Internal::Msg(str, 0xff, REQUEST, FUNC_ID_ZW_SEND_SLAVE_NODE_INFO, true);
+	Internal::Msg* msg = new Internal::Msg(string(str), 0xff, REQUEST, FUNC_ID_ZW_SEND_SLAVE_NODE_INFO, true);
 	msg->Append(_FromNodeId);		// from the virtual node
 	msg->Append(_ToNodeId);		// to the handheld controller
 	msg->Append( TRANSMIT_OPTION_ACK);
@@ -6553,6 +7477,16 @@ void Driver::GetDriverStatistics(DriverData* _data)
 	_data->m_routedbusy = m_routedbusy;
 	_data->m_broadcastReadCnt = m_broadcastReadCnt;
 	_data->m_broadcastWriteCnt = m_broadcastWriteCnt;
+	_data->m_coalescedSets = m_coalescedSets;
+	_data->m_mergedGets = m_mergedGets;
+
+	// The only pools are the one for messages and those for queue entries
+	Internal::BlockPool::Statistics msgStats;
+	Internal::Msg::GetPool().GetStatistics(&msgStats);
+	Internal::BlockPool::Statistics totals;
+	Internal::BlockPool::GetTotals(&totals);
+	_data->m_msgAllocs = msgStats.m_allocs;
+	_data->m_msgHeapAllocs = totals.m_heapAllocs;
 }
 
 //-----------------------------------------------------------------------------
@@ -6561,8 +7495,8 @@ void Driver::GetDriverStatistics(DriverData* _data)
 //-----------------------------------------------------------------------------
 void Driver::GetNodeStatistics(uint8 const _nodeId, Node::NodeData* _data)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	Node* node = GetNode(_nodeId);
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	Node* node = GetNodeShared(_nodeId);
 	if (node != NULL)
 	{
 		node->GetNodeStatistics(_data);
@@ -6595,6 +7529,10 @@ void Driver::LogDriverStatistics()
 	Log::Write(LogLevel_Always, "Total messages successfully received: . . . . . . . . . . %ld", data.m_readCnt);
 	Log::Write(LogLevel_Always, "Total Messages successfully sent: . . . . . . . . . . . . %ld", data.m_writeCnt);
 	Log::Write(LogLevel_Always, "ACKs received from controller:  . . . . . . . . . . . . . %ld", data.m_ACKCnt);
+	Log::Write(LogLevel_Always, "Set messages replaced by a newer Set: . . . . . . . . . . %ld", data.m_coalescedSets);
+	Log::Write(LogLevel_Always, "Get messages merged with a queued Get:  . . . . . . . . . %ld", data.m_mergedGets);
+	Log::Write(LogLevel_Always, "Messages created (all drivers): . . . . . . . . . . . . . %ld", data.m_msgAllocs);
+	Log::Write(LogLevel_Always, "Message and queue heap allocations (all drivers): . . . . %ld", data.m_msgHeapAllocs);
 	// Consider tracking and adding:
 	//		Initialization messages
 	//		Ad-hoc command messages
@@ -6665,6 +7603,18 @@ uint8 *Driver::GetNetworkKey()
 bool Driver::SendEncryptedMessage()
 {
 
+	if (m_noncePrefetch)
+	{
+		/* if more encrypted messages are waiting for this node, ask it for the next nonce now */
+		bool requestNonce = HasQueuedEncryptedMsg(m_currentMsg->GetTargetNodeId());
+		m_currentMsg->setRequestNonce(requestNonce);
+		Internal::LockGuard LG(m_nodeMutex);
+		if (Node* node = GetNode(m_currentMsg->GetTargetNodeId()))
+		{
+			node->SetNonceRequested(requestNonce);
+		}
+	}
+
 	uint8 *buffer = m_currentMsg->GetBuffer();
 	uint8 length = m_currentMsg->GetLength();
 	m_expectedCallbackId = m_currentMsg->GetCallbackId();
@@ -6704,10 +7654,34 @@ bool Driver::SendNonceRequest(string logmsg)
 	Log::Write(LogLevel_Info, m_currentMsg->GetTargetNodeId(), "Sending (%s) message (Callback ID=0x%.2x, Expected Reply=0x%.2x) - Nonce_Get(%s) - %s:", c_sendQueueNames[m_currentMsgQueueSource], 2, m_expectedReply, logmsg.c_str(), Internal::PktToString(m_buffer, 10).c_str());
 
 	m_controller->Write(m_buffer, 11);
+	m_nonceGetSent = m_currentMsg->GetTargetNodeId();
 
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// <Driver::HasQueuedEncryptedMsg>
+// Is there an encrypted message waiting to be sent to a node
+//-----------------------------------------------------------------------------
+bool Driver::HasQueuedEncryptedMsg(uint8 const _nodeId)
+{
+	bool found = false;
+	m_sendMutex->Lock();
+	for (int32 i = 0; (i < MsgQueue_Count) && !found; ++i)
+	{
+		for (MsgQueueList::iterator it = m_msgQueue[i].begin(); it != m_msgQueue[i].end(); ++it)
+		{
+			if ((it->m_command == MsgQueueCmd_SendMsg) && (it->m_msg->GetTargetNodeId() == _nodeId) && it->m_msg->isEncrypted())
+			{
+				found = true;
+				break;
+			}
+		}
+	}
+	m_sendMutex->Unlock();
+	return found;
+}
+
 bool Driver::initNetworkKeys(bool newnode)
 {
 
@@ -7076,20 +8050,26 @@ bool Driver::refreshNodeConfig(uint8 _nodeId)
 //-----------------------------------------------------------------------------
 void Driver::ReloadNode(uint8 const _nodeId)
 {
+	bool useJournal = s_cacheJournal.Get();
+	if (useJournal)
+	{
+		Log::Write(LogLevel_Detail, _nodeId, "Reloading Node");
+		// The new node has not been queried, so the journal records it as gone from the cache
+		InitNode(_nodeId);
+		MarkNodeDirty(_nodeId);
+		WriteCacheChanges();
+		return;
+	}
+
 	Internal::LockGuard LG(m_nodeMutex);
 	Log::Write(LogLevel_Detail, _nodeId, "Reloading Node");
 	/* delete any cached information about this node so we start from fresh */
-	char str[32];
 	int32 intVal;
 
-	string userPath;
-	Options::Get()->GetOptionAsString("UserPath", &userPath);
-
-	snprintf(str, sizeof(str), "ozwcache_0x%08x.xml", m_homeId);
-	string filename = userPath + string(str);
-
+	string filename;
 	TiXmlDocument doc;
-	if (doc.LoadFile(filename.c_str(), TIXML_ENCODING_UTF8))
+	m_cacheMutex->Lock();
+	if (LoadCacheDocument(&doc, &filename))
 	{
 		doc.SetUserData((void *) filename.c_str());
 		TiXmlElement * driverElement = doc.RootElement();
@@ -7115,8 +8095,12 @@ void Driver::ReloadNode(uint8 const _nodeId)
 			}
 			nodeElement = nodeElement->NextSibling();
 		}
+		SaveCacheDocument(doc);
 	}
-	doc.SaveFile(filename.c_str());
+	// Nothing is saved when the cache could not be loaded.  Saving the empty document
+	// would replace a damaged cache with an empty one and discard the journal, where
+	// leaving both lets the next full save rewrite them from the running nodes.
+	m_cacheMutex->Unlock();
 	LG.Unlock();
 
 	InitNode(_nodeId);
@@ -7246,8 +8230,8 @@ void Driver::ProcessEventMsg()
 //-----------------------------------------------------------------------------
 string const Driver::GetMetaData(uint8 const _nodeId, Node::MetaDataFields _metadata)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	Node* node = GetNode(_nodeId);
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	Node* node = GetNodeShared(_nodeId);
 	if (node != NULL)
 	{
 		return node->GetMetaData(_metadata);
@@ -7261,8 +8245,8 @@ string const Driver::GetMetaData(uint8 const _nodeId, Node::MetaDataFields _meta
 //-----------------------------------------------------------------------------
 Node::ChangeLogEntry const Driver::GetChangeLog(uint8 const _nodeId, uint32_t revision)
 {
-	Internal::LockGuard LG(m_nodeMutex);
-	Node* node = GetNode(_nodeId);
+	Internal::SharedLockGuard SLG(m_nodeLocks[_nodeId]);
+	Node* node = GetNodeShared(_nodeId);
 	if (node != NULL)
 	{
 		return node->GetChangeLog(revision);
@@ -31,8 +31,11 @@
 #include <string>
 #include <map>
 #include <list>
+#include <deque>
+#include <atomic>
 
 #include "Defs.h"
+#include "BlockPool.h"
 #include "Group.h"
 #include "value_classes/ValueID.h"
 #include "Node.h"
@@ -41,10 +44,18 @@
 #include "platform/Thread.h"
 #include "platform/TimeStamp.h"
 #include "aes/aescpp.h"
+#include "BinaryCache.h"
+
+class TiXmlDocument;
+class TiXmlElement;
 
 namespace OpenZWave
 {
 	class Notification;
+	namespace Testing
+	{
+		class SendQueueTest;
+	}
 	namespace Internal
 	{
 		namespace CC
@@ -64,10 +75,12 @@ namespace OpenZWave
 		{
 			class Value;
 			class ValueStore;
+			class ValueSnapshotTable;
 		}
 		namespace Platform
 		{
 			class Controller;
+			class SharedMutex;
 		}
 		class DNSThread;
 		struct DNSLookup;
@@ -75,7 +88,9 @@ namespace OpenZWave
 		struct HttpDownload;
 		class ManufacturerSpecificDB;
 		class Msg;
+		class PollScheduler;
 		class TimerThread;
+		class Timer;
 	}
 
 	/** \brief The Driver class handles communication between OpenZWave
@@ -103,6 +118,7 @@ namespace OpenZWave
 			friend class Internal::Msg;
 			friend class Internal::ManufacturerSpecificDB;
 			friend class TimerThread;
+			friend class Testing::SendQueueTest;	// Exercises the send queue rules without a controller
 
 			//-----------------------------------------------------------------------------
 			//	Controller Interfaces
@@ -195,6 +211,28 @@ namespace OpenZWave
 			void RequestConfig();							// Get the network configuration from the Z-Wave network
 			bool ReadCache();								// Read the configuration from a file
 			void WriteCache();								// Save the configuration to a file
+			enum CacheFile
+			{
+				Cache_XML = 0,
+				Cache_Binary,
+				Cache_Journal
+			};
+			string GetCacheFilename(CacheFile const _file);
+			bool LoadCacheDocument(TiXmlDocument* _doc, string* o_filename, Internal::BinaryCache::Loader* o_loader = NULL, bool* o_journaled = NULL);	// Load the cache file, in the binary or XML format
+			void SaveCacheDocument(TiXmlDocument& _doc, Internal::BinaryCache::Builder* _builder = NULL);	// Save the cache file in the format chosen by the BinaryCache option
+			void BuildCacheDocument(TiXmlDocument* _doc, Internal::BinaryCache::Builder* _builder = NULL);	// Write the driver and nodes to a document.  The caller holds m_nodeMutex.
+			void ReadCacheNode(TiXmlElement const* _nodeElement);			// Create a node from its cache element.  The caller holds m_nodeMutex.
+			void MarkNodeDirty(uint8 const _nodeId);						// Note that a node has changed since it was last saved
+			void WriteCacheChanges();										// Save the nodes that have changed, to the journal if CacheJournal is set
+			void CacheJournalTimer(uint32 _id);
+
+			Internal::Platform::Mutex* m_cacheMutex;						// Serializes writing the cache files.  Taken after m_nodeMutex.
+			std::atomic<uint32> m_dirtyNodes[8];							// Bitmap of nodes changed since they were saved
+			uint32 m_cacheGeneration;										// Generation of the cache file on disk
+			uint32 m_cacheSize;												// Size of the cache file on disk, 0 if there is none
+			uint32 m_cacheJournalSize;										// Size of the valid journal on disk, 0 if there is none
+			bool m_cacheCompact;											// The journal is damaged, so the next save must be a full one
+			Internal::Timer* m_cacheTimer;									// Flushes the journal every CacheJournalInterval seconds
 
 			//-----------------------------------------------------------------------------
 			//	Timer
@@ -323,6 +361,33 @@ namespace OpenZWave
 			 *  A pointer to the specified node (if it exists) or NULL if not.
 			 */
 			Node* GetNode(uint8 _nodeId);
+			/**
+			 *  Returns the specified node (if it exists) to a caller that holds the node's own lock
+			 *  (see GetNodeLock) rather than m_nodeMutex.
+			 *  \param _nodeId The nodeId (index into the node array) identifying the node to be returned
+			 *  \return
+			 *  A pointer to the specified node (if it exists) or NULL if not.
+			 */
+			Node* GetNodeShared(uint8 _nodeId)
+			{
+				return m_nodes[_nodeId];
+			}
+			/**
+			 *  Returns the reader/writer lock that guards a single node.  Read-only API calls hold it in
+			 *  shared mode instead of taking m_nodeMutex, so they do not block each other, or the
+			 *  driver and poll threads, unless they are working on the same node.  Anything that
+			 *  changes data those calls read (including adding or deleting the node itself, and the
+			 *  driver thread handling the node's messages and query stages) holds it in exclusive
+			 *  mode, after taking m_nodeMutex.  The node's ValueStore also takes it exclusively while
+			 *  adding or removing values, which is why that is the one place it may be taken without
+			 *  m_nodeMutex.  A thread holding a node lock must never wait for m_nodeMutex, and must
+			 *  not take it again unless it holds it exclusively.
+			 *  \param _nodeId The nodeId (index into the node array) identifying the lock to be returned
+			 */
+			Internal::Platform::SharedMutex* GetNodeLock(uint8 _nodeId)
+			{
+				return m_nodeLocks[_nodeId];
+			}
 
 			ControllerInterface m_controllerInterfaceType;				// Specifies the controller's hardware interface
 			string m_controllerPath;							// name or path used to open the controller hardware.
@@ -345,6 +410,7 @@ namespace OpenZWave
 			uint8 m_Controller_nodeId;						// Z-Wave Controller's own node ID.
 			Node* m_nodes[256];								// Array containing all the node objects.
 			Internal::Platform::Mutex* m_nodeMutex;								// Serializes access to node data
+			Internal::Platform::SharedMutex* m_nodeLocks[256];					// Per node reader/writer locks, see GetNodeLock
 
 			Internal::CC::ControllerReplication* m_controllerReplication;					// Controller replication is handled separately from the other command classes, due to older hand-held controllers using invalid node IDs.
 
@@ -355,6 +421,7 @@ namespace OpenZWave
 			//-----------------------------------------------------------------------------
 		private:
 			bool ReadMsg();
+			bool ReadFrame(uint8* _buffer);
 			void ProcessMsg(uint8* _data, uint8 _length);
 
 			void HandleGetVersionResponse(uint8* _data);
@@ -443,16 +510,13 @@ namespace OpenZWave
 			bool DisablePoll(const ValueID &_valueId);
 			bool isPolled(const ValueID &_valueId);
 			void SetPollIntensity(const ValueID &_valueId, uint8 _intensity);
+			void SetValuePollInterval(const ValueID &_valueId, int32 _milliseconds);
+			void SetNodeAsleepForPolling(uint8 _nodeId, bool _asleep);
 			static void PollThreadEntryPoint(Internal::Platform::Event* _exitEvent, void* _context);
 			void PollThreadProc(Internal::Platform::Event* _exitEvent);
 
 			Internal::Platform::Thread* m_pollThread;								// Thread for polling devices on the Z-Wave network
-			struct PollEntry
-			{
-					ValueID m_id;
-					uint8 m_pollCounter;
-			};
-			list<PollEntry> m_pollList;									// List of nodes that need to be polled
+			Internal::PollScheduler* m_pollScheduler;					// Values that need to be polled, ordered by when they are next due
 			Internal::Platform::Mutex* m_pollMutex;								// Serialize access to the polling list
 			int32 m_pollInterval;								// Time interval during which all nodes must be polled
 			bool m_bIntervalBetweenPolls;					// if true, the library intersperses m_pollInterval between polls; if false, the library attempts to complete all polls within m_pollInterval
@@ -481,6 +545,7 @@ namespace OpenZWave
 			void InitNode(uint8 const _nodeId, bool newNode = false, bool secure = false, uint8 const *_protocolInfo = NULL, uint8 const _length = 0);
 
 			void InitAllNodes();												// Delete all nodes and fetch the data from the Z-Wave network again.
+			void DeleteNode(uint8 const _nodeId);								// Delete a node and its poll schedule entries.  The caller must hold m_nodeMutex.
 
 			bool IsNodeListeningDevice(uint8 const _nodeId);
 			bool IsNodeFrequentListeningDevice(uint8 const _nodeId);
@@ -523,6 +588,12 @@ namespace OpenZWave
 			void SetNodeOff(uint8 const _nodeId);
 
 			Internal::VC::Value* GetValue(ValueID const& _id);
+			Internal::VC::ValueSnapshotTable* GetValueSnapshots()
+			{
+				return m_valueSnapshots;
+			}
+
+			Internal::VC::ValueSnapshotTable* m_valueSnapshots;		// Lock free copy of the current state of every primitive value
 
 			bool IsAPICallSupported(uint8 const _apinum) const
 			{
@@ -699,6 +770,9 @@ namespace OpenZWave
 			bool WriteNextMsg(MsgQueue const _queue);							// Extracts the first message from the queue, and makes it the current one.
 			bool WriteMsg(string const &str);									// Sends the current message to the Z-Wave network
 			void RemoveCurrentMsg();											// Deletes the current message and cleans up the callback etc states
+			int32 GetRetryTimeout(Node* _node, uint8 const _attempts);			// How long to wait for the current message's callback or reply
+			void BackOffRetryTimeout();											// The current message timed out on its last attempt, so wait longer for the node next time
+			bool GetRTTEstimate(Node* _node, int32** o_srtt, int32** o_rttVar);	// The round trip times that time out the current message
 			bool MoveMessagesToWakeUpQueue(uint8 const _targetNodeId, bool const _move);		// If a node does not respond, and is of a type that can sleep, this method is used to move all its pending messages to another queue ready for when it wakes up next.
 			bool HandleErrorResponse(uint8 const _error, uint8 const _nodeId, char const* _funcStr, bool _sleepCheck = false);									    // Handle data errors and process consistently. If message is moved to wake-up queue, return true.
 			bool IsExpectedReply(uint8 const _nodeId);						// Determine if reply message is the one we are expecting
@@ -752,7 +826,7 @@ namespace OpenZWave
 			{
 				public:
 					MsgQueueItem() :
-							m_msg(NULL), m_nodeId(0), m_queryStage(Node::QueryStage_None), m_retry(false), m_cci(NULL)
+							m_msg(NULL), m_nodeId(0), m_queryStage(Node::QueryStage_None), m_retry(false), m_cci(NULL), m_queuedAt(0)
 					{
 					}
 
@@ -788,14 +862,37 @@ namespace OpenZWave
 					Node::QueryStage m_queryStage;
 					bool m_retry;
 					ControllerCommandItem* m_cci;
+					uint32 m_queuedAt;			// When a message was queued, in ms since the driver started, or 0 if it was not timed
 			};
 
-			list<MsgQueueItem> m_msgQueue[MsgQueue_Count];
+			// Queue entries come from a pool, so queueing a message does not allocate
+			typedef list<MsgQueueItem, Internal::PoolAllocator<MsgQueueItem> > MsgQueueList;
+
+			bool CoalesceMsg(MsgQueueItem const& _item, MsgQueue const _queue);	// Merge a new message with a queued one that it duplicates or supersedes
+			static MsgQueueList::reverse_iterator FindLastQueueItem(MsgQueueList& _queue, uint8 const _nodeId);	// The last item in a queue for a node, or rend()
+			static bool ReplaceQueuedSet(MsgQueueList& _queue, Internal::Msg* _msg);	// Put a Set in place of the node's last item, if that is a Set of the same value
+
+			// The Send, Query and Poll queues are shared fairly between nodes: the next
+			// item is the first one for the node after the one last sent to, so one busy
+			// or unresponsive node cannot hold up the rest.  A node that fails to answer is
+			// backed off for a while, during which messages to any other node (even from a
+			// lower priority queue) go first.
+			MsgQueue SelectNextMsg(MsgQueue const _queue);						// Move the item to send next to the front of its queue
+			bool FindNextFairMsg(MsgQueue const _queue, bool const _backedOff, MsgQueueList::iterator* o_it);
+			void NodeSendFailed(uint8 const _nodeId);							// A node did not answer, so back it off
+			static uint8 GetQueueItemNodeId(MsgQueueItem const& _item);
+			uint8 m_lastSentNodeId[MsgQueue_Count];						// The node each queue last sent to
+
+			static int32 const c_sendBackoffMin = 1000;					// How long a node is first backed off for (ms), doubling for each further failure
+			static int32 const c_sendBackoffMax = 60000;
+
+			MsgQueueList m_msgQueue[MsgQueue_Count];
 			Internal::Platform::Event* m_queueEvent[MsgQueue_Count];		// Events for each queue, which are signaled when the queue is not empty
 			Internal::Platform::Mutex* m_sendMutex;						// Serialize access to the queues
 			Internal::Msg* m_currentMsg;
 			MsgQueue m_currentMsgQueueSource;			// identifies which queue held m_currentMsg
 			Internal::Platform::TimeStamp m_resendTimeStamp;
+			Internal::Platform::TimeStamp m_retryTimeStamp;		// When to stop waiting for the current message's callback or reply
 
 			//-----------------------------------------------------------------------------
 			// Network functions
@@ -862,7 +959,7 @@ namespace OpenZWave
 		private:
 			void QueueNotification(Notification* _notification);				// Adds a notification to the list.  Notifications are queued until a point in the thread where we know we do not have any nodes locked.
 			void NotifyWatchers();												// Passes the notifications to all the registered watcher callbacks in turn.
-			list<Notification*> m_notifications;
+			deque<Notification*> m_notifications;
 			Internal::Platform::Event* m_notificationsEvent;
 
 			//-----------------------------------------------------------------------------
@@ -893,6 +990,10 @@ namespace OpenZWave
 					uint32 m_routedbusy;		// Number of messages received with routed busy status
 					uint32 m_broadcastReadCnt;	// Number of broadcasts read
 					uint32 m_broadcastWriteCnt;	// Number of broadcasts sent
+					uint32 m_coalescedSets;		// Number of queued Set messages replaced by a newer Set of the same value
+					uint32 m_mergedGets;		// Number of Get messages merged with an identical queued Get
+					uint32 m_msgAllocs;			// Number of messages created (by all drivers)
+					uint32 m_msgHeapAllocs;		// Number of those messages, and of send queue entries, that needed new memory from the heap
 			};
 			void LogDriverStatistics();
 
@@ -922,6 +1023,8 @@ namespace OpenZWave
 			uint32 m_routedbusy;		// Number of messages received with routed busy status
 			uint32 m_broadcastReadCnt;	// Number of broadcasts read
 			uint32 m_broadcastWriteCnt;	// Number of broadcasts sent
+			std::atomic<uint32> m_coalescedSets;	// Number of queued Set messages replaced by a newer Set of the same value.  Also counted by WakeUp, under its own lock.
+			std::atomic<uint32> m_mergedGets;		// Number of Get messages merged with an identical queued Get
 			//time_t m_commandStart;	// Start time of last command
 			//time_t m_timeoutLost;		// Cumulative time lost to timeouts
 
@@ -939,10 +1042,17 @@ namespace OpenZWave
 			bool SendEncryptedMessage();
 			bool SendNonceRequest(string logmsg);
 			void SendNonceKey(uint8 nodeId, uint8 *nonce);
+			bool HasQueuedEncryptedMsg(uint8 const _nodeId);
 			aes_encrypt_ctx *AuthKey;
 			aes_encrypt_ctx *EncryptKey;
 			uint8 m_nonceReportSent;
 			uint8 m_nonceReportSentAttempt;
+			uint8 m_nonceGetSent;				// Node we have sent a Nonce_Get to and had no report from yet
+			bool m_noncePrefetch;				// Ask for the next nonce along with each encrypted message, when more are queued
+
+			// How long a prefetched nonce is used for.  Devices must keep a nonce for at
+			// least three seconds, and some of that has gone by the time it reaches us.
+			static int32 const c_prefetchedNonceLifetime = 2500;
 			bool m_inclusionkeySet;
 
 			//-----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include "Http.h"
 #include "platform/HttpClient.h"
 #include "platform/FileOps.h"
+#include "platform/WaitSet.h"
 #include "Utils.h"
 
 namespace OpenZWave
@@ -139,21 +140,17 @@ namespace OpenZWave
 			client->m_httpThreadRunning = true;
 
 			Internal::Platform::InitNetwork();
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(client->m_exitEvent);					// Thread must exit.
+			waitObjects.Add(client->m_httpDownloadEvent);			// Http Request
 			bool keepgoing = true;
 			while (keepgoing)
 			{
-				const uint32 count = 2;
-
-				Internal::Platform::Wait* waitObjects[count];
-
 				int32 timeout = Internal::Platform::Wait::Timeout_Infinite;
 				timeout = 10000;
 
-				waitObjects[0] = client->m_exitEvent;					// Thread must exit.
-				waitObjects[1] = client->m_httpDownloadEvent;			// Http Request
 				// Wait for something to do
-
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, timeout);
+				int32 res = waitObjects.Multiple(waitObjects.Size(), timeout);
 
 				switch (res)
 				{
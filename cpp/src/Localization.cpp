@@ -24,12 +24,14 @@
 //	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
 //
 //-----------------------------------------------------------------------------
+#include <algorithm>
 #include <bitset>
 #include <string.h>
 
 #include "Localization.h"
 #include "tinyxml.h"
 #include "Options.h"
+#include "ConfigImage.h"
 #include "platform/Log.h"
 #include "value_classes/ValueBitSet.h"
 #include "command_classes/Configuration.h"
@@ -44,12 +46,44 @@ namespace OpenZWave
 	{
 
 		Localization *Localization::m_instance = NULL;
-		std::map<uint64, std::shared_ptr<ValueLocalizationEntry> > Localization::m_valueLocalizationMap;
+		Localization::ValueLocalizationMap Localization::m_valueLocalizationMap;
 		std::map<uint8, std::shared_ptr<LabelLocalizationEntry> > Localization::m_commandClassLocalizationMap;
 		std::map<std::string, std::shared_ptr<LabelLocalizationEntry> > Localization::m_globalLabelLocalizationMap;
 		std::string Localization::m_selectedLang = "";
 		uint32 Localization::m_revision = 0;
 
+		namespace
+		{
+			// The item tables are sorted by item index
+			bool ItemBefore(ItemTable::value_type const& _item, int32 _itemIndex)
+			{
+				return _item.first < _itemIndex;
+			}
+
+			InternedString const* FindItem(ItemTable const& _table, int32 _itemIndex)
+			{
+				ItemTable::const_iterator it = std::lower_bound(_table.begin(), _table.end(), _itemIndex, ItemBefore);
+				if ((it != _table.end()) && (it->first == _itemIndex))
+				{
+					return &it->second;
+				}
+				return NULL;
+			}
+
+			void SetItem(ItemTable& _table, int32 _itemIndex, InternedString const& _text)
+			{
+				ItemTable::iterator it = std::lower_bound(_table.begin(), _table.end(), _itemIndex, ItemBefore);
+				if ((it != _table.end()) && (it->first == _itemIndex))
+				{
+					it->second = _text;
+				}
+				else
+				{
+					_table.insert(it, std::make_pair(_itemIndex, _text));
+				}
+			}
+		}
+
 		LabelLocalizationEntry::LabelLocalizationEntry(uint16 _index, uint32 _pos) :
 				m_index(_index), m_pos(_pos)
 		{
@@ -58,9 +92,17 @@ namespace OpenZWave
 		void LabelLocalizationEntry::AddLabel(string label, string lang)
 		{
 			if (lang.empty())
+			{
 				m_defaultLabel = label;
+				if (!HasLabel(Localization::GetSelectedLang()))
+					m_selectedLabel = m_defaultLabel;
+			}
 			else
+			{
 				m_Label[lang] = label;
+				if (lang == Localization::GetSelectedLang())
+					m_selectedLabel = m_Label[lang];
+			}
 		}
 		uint64 LabelLocalizationEntry::GetIdx()
 		{
@@ -68,13 +110,9 @@ namespace OpenZWave
 			return key;
 
 		}
-		std::string LabelLocalizationEntry::GetLabel(string lang)
+		std::string const& LabelLocalizationEntry::GetLabel() const
 		{
-			if (lang.empty() || (m_Label.find(lang) == m_Label.end()))
-				return m_defaultLabel;
-			else
-				return m_Label[lang];
-
+			return m_selectedLabel;
 		}
 
 		bool LabelLocalizationEntry::HasLabel(string lang)
@@ -96,13 +134,9 @@ namespace OpenZWave
 			uint64 key = ((uint64) m_commandClass << 48) | ((uint64) m_index << 32) | ((uint64) m_pos);
 			return key;
 		}
-		std::string ValueLocalizationEntry::GetHelp(string lang)
-
+		std::string const& ValueLocalizationEntry::GetHelp() const
 		{
-			if (lang.empty() || (m_HelpText.find(lang) == m_HelpText.end()))
-				return m_DefaultHelpText;
-			else
-				return m_HelpText[lang];
+			return m_selectedHelp;
 		}
 
 		bool ValueLocalizationEntry::HasHelp(string lang)
@@ -117,17 +151,22 @@ namespace OpenZWave
 		void ValueLocalizationEntry::AddHelp(string HelpText, string lang)
 		{
 			if (lang.empty())
+			{
 				m_DefaultHelpText = HelpText;
+				if (!HasHelp(Localization::GetSelectedLang()))
+					m_selectedHelp = m_DefaultHelpText;
+			}
 			else
+			{
 				m_HelpText[lang] = HelpText;
+				if (lang == Localization::GetSelectedLang())
+					m_selectedHelp = m_HelpText[lang];
+			}
 
 		}
-		std::string ValueLocalizationEntry::GetLabel(string lang)
+		std::string const& ValueLocalizationEntry::GetLabel() const
 		{
-			if (lang.empty() || (m_LabelText.find(lang) == m_LabelText.end()))
-				return m_DefaultLabelText;
-			else
-				return m_LabelText[lang];
+			return m_selectedLabel;
 		}
 		bool ValueLocalizationEntry::HasLabel(string lang)
 
@@ -141,9 +180,17 @@ namespace OpenZWave
 		void ValueLocalizationEntry::AddLabel(string Label, string lang)
 		{
 			if (lang.empty())
+			{
 				m_DefaultLabelText = Label;
+				if (!HasLabel(Localization::GetSelectedLang()))
+					m_selectedLabel = m_DefaultLabelText;
+			}
 			else
+			{
 				m_LabelText[lang] = Label;
+				if (lang == Localization::GetSelectedLang())
+					m_selectedLabel = m_LabelText[lang];
+			}
 		}
 
 		void ValueLocalizationEntry::AddItemLabel(string label, int32 itemindex, string lang)
@@ -151,28 +198,26 @@ namespace OpenZWave
 			if (lang.empty())
 			{
 				m_DefaultItemLabelText[itemindex] = label;
+				if (!HasItemLabel(itemindex, Localization::GetSelectedLang()))
+					SetItem(m_selectedItemLabel, itemindex, m_DefaultItemLabelText[itemindex]);
 			}
 			else
 			{
 				m_ItemLabelText[lang][itemindex] = label;
+				if (lang == Localization::GetSelectedLang())
+					SetItem(m_selectedItemLabel, itemindex, m_ItemLabelText[lang][itemindex]);
 			}
 
 		}
-		std::string ValueLocalizationEntry::GetItemLabel(string lang, int32 itemindex)
+		std::string const& ValueLocalizationEntry::GetItemLabel(int32 itemindex) const
 		{
-			if (lang.empty() || (m_ItemLabelText.find(lang) == m_ItemLabelText.end()) || m_ItemLabelText[lang].find(itemindex) == m_ItemLabelText[lang].end())
+			InternedString const* label = FindItem(m_selectedItemLabel, itemindex);
+			if (!label)
 			{
-				if (m_DefaultItemLabelText.find(itemindex) == m_DefaultItemLabelText.end())
-				{
-					Log::Write(LogLevel_Warning, "ValueLocalizationEntry::GetItemLabel: Unable to find Default Item Label Text for Index Item %d (%s)", itemindex, m_DefaultLabelText.c_str());
-					return "undefined";
-				}
-				return m_DefaultItemLabelText[itemindex];
-			}
-			else
-			{
-				return m_ItemLabelText[lang][itemindex];
+				Log::Write(LogLevel_Warning, "ValueLocalizationEntry::GetItemLabel: Unable to find Default Item Label Text for Index Item %d (%s)", itemindex, m_DefaultLabelText.c_str());
+				return *StringPool::Intern("undefined");
 			}
+			return *label;
 		}
 
 		bool ValueLocalizationEntry::HasItemLabel(int32 itemIndex, string lang)
@@ -188,33 +233,27 @@ namespace OpenZWave
 			if (lang.empty())
 			{
 				m_DefaultItemHelpText[itemindex] = label;
+				string const& selectedLang = Localization::GetSelectedLang();
+				if (selectedLang.empty() || !HasItemHelp(itemindex, selectedLang))
+					SetItem(m_selectedItemHelp, itemindex, m_DefaultItemHelpText[itemindex]);
 			}
 			else
 			{
 				m_ItemHelpText[lang][itemindex] = label;
+				if (lang == Localization::GetSelectedLang())
+					SetItem(m_selectedItemHelp, itemindex, m_ItemHelpText[lang][itemindex]);
 			}
 
 		}
-		std::string ValueLocalizationEntry::GetItemHelp(string lang, int32 itemindex)
+		std::string const& ValueLocalizationEntry::GetItemHelp(int32 itemindex) const
 		{
-			if (lang.empty() && (m_DefaultItemHelpText.find(itemindex) != m_DefaultItemHelpText.end()))
+			InternedString const* help = FindItem(m_selectedItemHelp, itemindex);
+			if (!help)
 			{
-				return m_DefaultItemHelpText[itemindex];
+				Log::Write(LogLevel_Warning, "No ItemHelp Entry for Language %s (Index %d)", Localization::GetSelectedLang().c_str(), itemindex);
+				return *StringPool::Intern("Undefined");
 			}
-
-			if ((m_ItemHelpText.find(lang) != m_ItemHelpText.end()))
-			{
-				if ((m_ItemHelpText.at(lang).find(itemindex) != m_ItemHelpText.at(lang).end()))
-				{
-					return m_ItemHelpText.at(lang)[itemindex];
-				}
-			}
-			if (m_DefaultItemHelpText.find(itemindex) != m_DefaultItemHelpText.end())
-			{
-				return m_DefaultItemHelpText[itemindex];
-			}
-			Log::Write(LogLevel_Warning, "No ItemHelp Entry for Language %s (Index %d)", lang.c_str(), itemindex);
-			return "Undefined";
+			return *help;
 		}
 
 		bool ValueLocalizationEntry::HasItemHelp(int32 itemIndex, string lang)
@@ -247,7 +286,7 @@ namespace OpenZWave
 
 			string path = configPath + "Localization.xml";
 			TiXmlDocument* pDoc = new TiXmlDocument();
-			if (!pDoc->LoadFile(path.c_str(), TIXML_ENCODING_UTF8))
+			if (!ConfigImage::LoadFile(path, pDoc))
 			{
 				Log::Write(LogLevel_Warning, "Unable to load Localization file %s: %s", path.c_str(), pDoc->ErrorDesc());
 				delete pDoc;
@@ -566,7 +605,7 @@ namespace OpenZWave
 			uint8 ccID = cc->GetCommandClassId();
 			if (m_commandClassLocalizationMap.find(ccID) != m_commandClassLocalizationMap.end())
 			{
-				cc->SetCommandClassLabel(m_commandClassLocalizationMap[ccID]->GetLabel(m_selectedLang));
+				cc->SetCommandClassLabel(m_commandClassLocalizationMap[ccID]->GetLabel());
 			}
 			else
 			{
@@ -620,29 +659,31 @@ namespace OpenZWave
 			return true;
 		}
 
-		std::string const Localization::GetValueHelp(uint8 node, uint8 ccID, uint16 indexId, uint32 pos)
+		std::string const& Localization::GetValueHelp(uint8 node, uint8 ccID, uint16 indexId, uint32 pos)
 		{
 			uint64 key = GetValueKey(node, ccID, indexId, pos);
-			if (m_valueLocalizationMap.find(key) == m_valueLocalizationMap.end())
+			ValueLocalizationMap::const_iterator it = m_valueLocalizationMap.find(key);
+			if (it == m_valueLocalizationMap.end())
 			{
 				Log::Write(LogLevel_Warning, "Localization::GetValueHelp: No Help for CommandClass %xd, ValueID: %d (%d)", ccID, indexId, pos);
-				return "";
+				return *StringPool::Empty();
 			}
-			return m_valueLocalizationMap[key]->GetHelp(m_selectedLang);
+			return it->second->GetHelp();
 		}
 
-		std::string const Localization::GetValueLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos) const
+		std::string const& Localization::GetValueLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos) const
 		{
 			uint64 key = GetValueKey(node, ccID, indexId, pos);
-			if (m_valueLocalizationMap.find(key) == m_valueLocalizationMap.end())
+			ValueLocalizationMap::const_iterator it = m_valueLocalizationMap.find(key);
+			if (it == m_valueLocalizationMap.end())
 			{
 				Log::Write(LogLevel_Warning, "Localization::GetValueLabel: No Label for CommandClass %xd, ValueID: %d (%d)", ccID, indexId, pos);
-				return "";
+				return *StringPool::Empty();
 			}
-			return m_valueLocalizationMap[key]->GetLabel(m_selectedLang);
+			return it->second->GetLabel();
 		}
 
-		std::string const Localization::GetValueItemLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const
+		std::string const& Localization::GetValueItemLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const
 		{
 			bool unique = false;
 			if ((ccID == Internal::CC::SoundSwitch::StaticGetCommandClassId()) && (indexId == 1 || indexId == 3))
@@ -654,12 +695,13 @@ namespace OpenZWave
 				unique = true;
 			}
 			uint64 key = GetValueKey(node, ccID, indexId, pos, unique);
-			if (m_valueLocalizationMap.find(key) == m_valueLocalizationMap.end())
+			ValueLocalizationMap::const_iterator it = m_valueLocalizationMap.find(key);
+			if (it == m_valueLocalizationMap.end())
 			{
 				Log::Write(LogLevel_Warning, "Localization::GetValueItemLabel: No ValueLocalizationMap for CommandClass %xd, ValueID: %d (%d) ItemIndex %d", ccID, indexId, pos, itemIndex);
-				return "";
+				return *StringPool::Empty();
 			}
-			return m_valueLocalizationMap[key]->GetItemLabel(m_selectedLang, itemIndex);
+			return it->second->GetItemLabel(itemIndex);
 		}
 
 		bool Localization::SetValueItemLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex, string label, string lang)
@@ -687,7 +729,7 @@ namespace OpenZWave
 			return true;
 		}
 
-		std::string const Localization::GetValueItemHelp(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const
+		std::string const& Localization::GetValueItemHelp(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const
 		{
 			bool unique = false;
 			if ((ccID == Internal::CC::SoundSwitch::StaticGetCommandClassId()) && (indexId == 1 || indexId == 3))
@@ -700,12 +742,13 @@ namespace OpenZWave
 			}
 
 			uint64 key = GetValueKey(node, ccID, indexId, pos, unique);
-			if (m_valueLocalizationMap.find(key) == m_valueLocalizationMap.end())
+			ValueLocalizationMap::const_iterator it = m_valueLocalizationMap.find(key);
+			if (it == m_valueLocalizationMap.end())
 			{
 				Log::Write(LogLevel_Warning, "Localization::GetValueItemHelp: No ValueLocalizationMap for CommandClass %xd, ValueID: %d (%d) ItemIndex %d", ccID, indexId, pos, itemIndex);
-				return "";
+				return *StringPool::Empty();
 			}
-			return m_valueLocalizationMap[key]->GetItemHelp(m_selectedLang, itemIndex);
+			return it->second->GetItemHelp(itemIndex);
 		}
 
 		bool Localization::SetValueItemHelp(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex, string label, string lang)
@@ -740,7 +783,7 @@ namespace OpenZWave
 				Log::Write(LogLevel_Warning, "Localization::GetGlobalLabel: No globalLabelLocalizationMap for Index %s", index.c_str());
 				return index;
 			}
-			return m_globalLabelLocalizationMap[index]->GetLabel(m_selectedLang);
+			return m_globalLabelLocalizationMap[index]->GetLabel();
 
 		}
 		bool Localization::SetGlobalLabel(string index, string text, string lang)
@@ -770,7 +813,8 @@ namespace OpenZWave
 		bool Localization::WriteXMLVIDHelp(uint8 node, uint8 ccID, uint16 indexId, uint32 pos, TiXmlElement *valueElement)
 		{
 			uint64 key = GetValueKey(node, ccID, indexId, pos);
-			if (m_valueLocalizationMap.find(key) == m_valueLocalizationMap.end())
+			ValueLocalizationMap::const_iterator it = m_valueLocalizationMap.find(key);
+			if (it == m_valueLocalizationMap.end())
 			{
 				Log::Write(LogLevel_Warning, "Localization::WriteXMLVIDHelp: No Help for CommandClass %d, ValueID: %d (%d)", ccID, indexId, pos);
 				return false;
@@ -778,7 +822,7 @@ namespace OpenZWave
 			TiXmlElement* helpElement = new TiXmlElement("Help");
 			valueElement->LinkEndChild(helpElement);
 
-			TiXmlText* textElement = new TiXmlText(m_valueLocalizationMap[key]->GetHelp(m_selectedLang).c_str());
+			TiXmlText* textElement = new TiXmlText(it->second->GetHelp().c_str());
 			helpElement->LinkEndChild(textElement);
 			return true;
 		}
@@ -790,10 +834,12 @@ namespace OpenZWave
 				return m_instance;
 			}
 			m_instance = new Localization();
+			// The language is fixed for the life of the library, so each entry can
+			// resolve its text for it as the text is added
+			Options::Get()->GetOptionAsString("Language", &m_selectedLang);
 			if (!ReadXML()) {
 				OZW_ERROR(OZWException::OZWEXCEPTION_CONFIG, "Cannot Create Localization Class! - Missing/Invalid Config File?");
 			}
-			Options::Get()->GetOptionAsString("Language", &m_selectedLang);
 			return m_instance;
 		}
 	} // namespace Internal
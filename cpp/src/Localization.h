@@ -31,8 +31,11 @@
 #include <cstdio>
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include "Defs.h"
 #include "Driver.h"
+#include "StringPool.h"
 #include "command_classes/CommandClass.h"
 
 namespace OpenZWave
@@ -40,6 +43,9 @@ namespace OpenZWave
 	namespace Internal
 	{
 
+		// Item index and text, sorted by item index
+		typedef std::vector<std::pair<int32, InternedString> > ItemTable;
+
 		class LabelLocalizationEntry: public Internal::Platform::Ref
 		{
 			public:
@@ -48,15 +54,16 @@ namespace OpenZWave
 				{
 				}
 				void AddLabel(string label, string lang = "");
-				string GetLabel(string lang);
+				string const& GetLabel() const;
 				uint64 GetIdx();
 				bool HasLabel(string lang);
 
 			private:
 				uint16 m_index;
 				uint32 m_pos;
-				map<string, string> m_Label;
-				string m_defaultLabel;
+				map<string, InternedString> m_Label;
+				InternedString m_defaultLabel;
+				InternedString m_selectedLabel;		// The label in the selected language, or the default
 		};
 
 		class ValueLocalizationEntry: public Internal::Platform::Ref
@@ -68,31 +75,41 @@ namespace OpenZWave
 
 				}
 				uint64 GetIdx();
-				string GetHelp(string lang);
+				string const& GetHelp() const;
 				void AddHelp(string HelpText, string lang = "");
 				bool HasHelp(string lang);
-				string GetLabel(string lang);
+				string const& GetLabel() const;
 				void AddLabel(string Label, string lang = "");
 				bool HasLabel(string lang);
 				void AddItemLabel(string label, int32 itemIndex, string lang = "");
-				string GetItemLabel(string lang, int32 itemIndex);
+				string const& GetItemLabel(int32 itemIndex) const;
 				bool HasItemLabel(int32 itemIndex, string lang);
 				void AddItemHelp(string label, int32 itemIndex, string lang = "");
-				string GetItemHelp(string lang, int32 itemIndex);
+				string const& GetItemHelp(int32 itemIndex) const;
 				bool HasItemHelp(int32 itemIndex, string lang);
 
 			private:
 				uint8 m_commandClass;
 				uint16 m_index;
 				uint32 m_pos;
-				map<string, string> m_HelpText;
-				map<string, string> m_LabelText;
-				map<string, map<int32, string> > m_ItemLabelText;
-				map<string, map<int32, string> > m_ItemHelpText;
-				string m_DefaultHelpText;
-				string m_DefaultLabelText;
-				map<int32, string> m_DefaultItemLabelText;
-				map<int32, string> m_DefaultItemHelpText;
+				// Entries are kept per node, so the same text recurs for every node
+				// of a model; it is held in the StringPool.
+				map<string, InternedString> m_HelpText;
+				map<string, InternedString> m_LabelText;
+				map<string, map<int32, InternedString> > m_ItemLabelText;
+				map<string, map<int32, InternedString> > m_ItemHelpText;
+				InternedString m_DefaultHelpText;
+				InternedString m_DefaultLabelText;
+				map<int32, InternedString> m_DefaultItemLabelText;
+				map<int32, InternedString> m_DefaultItemHelpText;
+
+				// The text in the selected language, falling back to the default, kept
+				// up to date by the Add methods so the Get methods need no searching
+				// by language.
+				InternedString m_selectedHelp;
+				InternedString m_selectedLabel;
+				ItemTable m_selectedItemLabel;
+				ItemTable m_selectedItemHelp;
 		};
 
 		class Localization
@@ -113,18 +130,18 @@ namespace OpenZWave
 			public:
 				static Localization* Get();
 				void SetupCommandClass(Internal::CC::CommandClass *cc);
-				string GetSelectedLang()
+				static string const& GetSelectedLang()
 				{
 					return Localization::m_selectedLang;
 				}
 				;
 				bool SetValueHelp(uint8 node, uint8 ccID, uint16 indexID, uint32 pos, string help, string lang = "");
-				string const GetValueHelp(uint8 node, uint8 ccID, uint16 indexId, uint32 pos);
+				string const& GetValueHelp(uint8 node, uint8 ccID, uint16 indexId, uint32 pos);
 				bool SetValueLabel(uint8 node, uint8 ccID, uint16 indexID, uint32 pos, string label, string lang = "");
-				string const GetValueLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos) const;
-				string const GetValueItemLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const;
+				string const& GetValueLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos) const;
+				string const& GetValueItemLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const;
 				bool SetValueItemLabel(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex, string label, string lang = "");
-				string const GetValueItemHelp(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const;
+				string const& GetValueItemHelp(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex) const;
 				bool SetValueItemHelp(uint8 node, uint8 ccID, uint16 indexId, int32 pos, int32 itemIndex, string label, string lang = "");
 				string const GetGlobalLabel(string text);
 				bool SetGlobalLabel(string index, string text, string lang);
@@ -136,7 +153,8 @@ namespace OpenZWave
 				//-----------------------------------------------------------------------------
 			private:
 				static Localization* m_instance;
-				static map<uint64, std::shared_ptr<ValueLocalizationEntry> > m_valueLocalizationMap;
+				typedef std::unordered_map<uint64, std::shared_ptr<ValueLocalizationEntry> > ValueLocalizationMap;
+				static ValueLocalizationMap m_valueLocalizationMap;
 				static map<uint8, std::shared_ptr<LabelLocalizationEntry> > m_commandClassLocalizationMap;
 				static map<string, std::shared_ptr<LabelLocalizationEntry> > m_globalLabelLocalizationMap;
 				static string m_selectedLang;
@@ -32,11 +32,13 @@
 
 #include "Defs.h"
 #include "CompatOptionManager.h"
+#include "ConfigImage.h"
 #include "Manager.h"
 #include "Driver.h"
 #include "Localization.h"
 #include "Node.h"
 #include "Notification.h"
+#include "NotificationDispatcher.h"
 #include "NotificationCCTypes.h"
 #include "Options.h"
 #include "Scene.h"
@@ -61,6 +63,7 @@
 #include "value_classes/ValueRaw.h"
 #include "value_classes/ValueSchedule.h"
 #include "value_classes/ValueShort.h"
+#include "value_classes/ValueSnapshotTable.h"
 #include "value_classes/ValueString.h"
 #include "value_classes/ValueBitSet.h"
 
@@ -143,7 +146,7 @@ ozwversion Manager::getVersion()
 // Constructor
 //-----------------------------------------------------------------------------
 Manager::Manager() :
-		m_notificationMutex(new Internal::Platform::Mutex())
+		m_notificationMutex(new Internal::Platform::Mutex()), m_notificationDispatcher(NULL)
 {
 	// Ensure the singleton instance is set
 	s_instance = this;
@@ -184,10 +187,19 @@ Manager::Manager() :
 	int nDumpTrigger = (int) LogLevel_Warning;
 	Options::Get()->GetOptionAsInt("DumpTriggerLevel", &nDumpTrigger);
 
+	bool bAsync = false;
+	Options::Get()->GetOptionAsBool("AsyncLogging", &bAsync);
+
+	bool bBinary = false;
+	Options::Get()->GetOptionAsBool("BinaryLogFile", &bBinary);
+
 	string logFilename = userPath + logFileNameBase;
-	Log::Create(logFilename, bAppend, bConsoleOutput, (LogLevel) nSaveLogLevel, (LogLevel) nQueueLogLevel, (LogLevel) nDumpTrigger);
+	Log::Create(logFilename, bAppend, bConsoleOutput, (LogLevel) nSaveLogLevel, (LogLevel) nQueueLogLevel, (LogLevel) nDumpTrigger, bAsync, bBinary);
 	Log::SetLoggingState(logging);
 
+	// Map the precompiled config files before anything reads them
+	Internal::ConfigImage::Create();
+
 	Internal::CC::CommandClasses::RegisterCommandClasses();
 	Internal::Scene::ReadScenes();
 	// petergebruers replace getVersionAsString() with getVersionLongAsString() because
@@ -202,6 +214,27 @@ Manager::Manager() :
 		Log::Write(LogLevel_Error, "mgr,     Cannot Create SensorMultiLevelCCTypes!");
 	}
 
+	bool notificationThread = false;
+	Options::Get()->GetOptionAsBool("NotificationThread", &notificationThread);
+	if (notificationThread)
+	{
+		int32 queueSize = 10000;
+		Options::Get()->GetOptionAsInt("NotificationQueueSize", &queueSize);
+		int32 batchSize = 64;
+		Options::Get()->GetOptionAsInt("NotificationBatchSize", &batchSize);
+		if (queueSize <= 0)
+		{
+			Log::Write(LogLevel_Warning, "Invalid NotificationQueueSize Specified in Options.xml");
+			queueSize = 10000;
+		}
+		if (batchSize <= 0)
+		{
+			Log::Write(LogLevel_Warning, "Invalid NotificationBatchSize Specified in Options.xml");
+			batchSize = 64;
+		}
+		m_notificationDispatcher = new Internal::NotificationDispatcher((uint32) queueSize, (uint32) batchSize);
+	}
+
 }
 
 //-----------------------------------------------------------------------------
@@ -228,6 +261,10 @@ Manager::~Manager()
 	}
 	m_readyDrivers.clear();
 
+	// Deliver any notifications the drivers sent while shutting down
+	delete m_notificationDispatcher;
+	m_notificationDispatcher = NULL;
+
 	m_notificationMutex->Release();
 
 	// Clear the watchers list
@@ -280,7 +317,8 @@ Manager::~Manager()
 	Node::s_nodeTypes.clear();
 
 	Node::s_deviceClassesLoaded = false;
-	
+
+	Internal::ConfigImage::Destroy();
 	Log::Destroy();
 }
 
@@ -296,7 +334,7 @@ void Manager::WriteConfig(uint32 const _homeId)
 {
 	if (Driver* driver = GetDriver(_homeId))
 	{
-		driver->WriteCache();
+		driver->WriteCacheChanges();
 		Log::Write(LogLevel_Info, "mgr,     Manager::WriteConfig completed for driver with home ID of 0x%.8x", _homeId);
 	}
 	else
@@ -735,7 +773,7 @@ uint8 Manager::GetPollIntensity(ValueID const &_valueId)
 	uint8 intensity = 0;
 	if (Driver* driver = GetDriver(_valueId.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_valueId.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_valueId))
 		{
 			intensity = value->GetPollIntensity();
@@ -750,6 +788,44 @@ uint8 Manager::GetPollIntensity(ValueID const &_valueId)
 	return intensity;
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::SetValuePollInterval>
+// Change the time between polls of a single value
+//-----------------------------------------------------------------------------
+void Manager::SetValuePollInterval(ValueID const &_valueId, int32 const _milliseconds)
+{
+	if (Driver* driver = GetDriver(_valueId.GetHomeId()))
+	{
+		return (driver->SetValuePollInterval(_valueId, _milliseconds));
+	}
+
+	Log::Write(LogLevel_Error, "mgr,     SetValuePollInterval failed - Driver with Home ID 0x%.8x is not available", _valueId.GetHomeId());
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetValuePollInterval>
+// Get the time between polls of a single value
+//-----------------------------------------------------------------------------
+int32 Manager::GetValuePollInterval(ValueID const &_valueId)
+{
+	int32 interval = 0;
+	if (Driver* driver = GetDriver(_valueId.GetHomeId()))
+	{
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_valueId.GetNodeId()));
+		if (Internal::VC::Value* value = driver->GetValue(_valueId))
+		{
+			interval = value->GetPollInterval();
+			value->Release();
+		}
+		else
+		{
+			OZW_ERROR(OZWException::OZWEXCEPTION_INVALID_VALUEID, "Invalid ValueID passed to GetValuePollInterval");
+		}
+	}
+
+	return interval;
+}
+
 //-----------------------------------------------------------------------------
 //	Retrieving Node information
 //-----------------------------------------------------------------------------
@@ -785,6 +861,7 @@ bool Manager::RequestNodeState(uint32 const _homeId, uint8 const _nodeId)
 		Node* node = driver->GetNode(_nodeId);
 		if (node)
 		{
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_nodeId));
 			node->SetQueryStage(Node::QueryStage_Associations);
 			return true;
 		}
@@ -805,6 +882,7 @@ bool Manager::RequestNodeDynamic(uint32 const _homeId, uint8 const _nodeId)
 		Node* node = driver->GetNode(_nodeId);
 		if (node)
 		{
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_nodeId));
 			node->SetQueryStage(Node::QueryStage_Dynamic);
 			return true;
 		}
@@ -1353,9 +1431,9 @@ bool Manager::IsNodeInfoReceived(uint32 const _homeId, uint8 const _nodeId)
 		Node *node;
 
 		// Need to lock and unlock nodes to check this information
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_nodeId));
 
-		if ((node = driver->GetNode(_nodeId)) != NULL)
+		if ((node = driver->GetNodeShared(_nodeId)) != NULL)
 		{
 			result = node->NodeInfoReceived();
 		}
@@ -1377,9 +1455,9 @@ bool Manager::GetNodeClassInformation(uint32 const _homeId, uint8 const _nodeId,
 		Node *node;
 
 		// Need to lock and unlock nodes to check this information
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_nodeId));
 
-		if ((node = driver->GetNode(_nodeId)) != NULL)
+		if ((node = driver->GetNodeShared(_nodeId)) != NULL)
 		{
 			Internal::CC::CommandClass *cc;
 			if (node->NodeInfoReceived() && ((cc = node->GetCommandClass(_commandClassId)) != NULL))
@@ -1424,9 +1502,9 @@ bool Manager::IsNodeAwake(uint32 const _homeId, uint8 const _nodeId)
 	if (Driver* driver = GetDriver(_homeId))
 	{
 		// Need to lock and unlock nodes to check this information
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_nodeId));
 
-		if (Node* node = driver->GetNode(_nodeId))
+		if (Node* node = driver->GetNodeShared(_nodeId))
 		{
 			if (Internal::CC::WakeUp* wcc = static_cast<Internal::CC::WakeUp*>(node->GetCommandClass(Internal::CC::WakeUp::StaticGetCommandClassId())))
 			{
@@ -1446,8 +1524,8 @@ bool Manager::IsNodeFailed(uint32 const _homeId, uint8 const _nodeId)
 	bool result = false;
 	if (Driver* driver = GetDriver(_homeId))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
-		if (Node* node = driver->GetNode(_nodeId))
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_nodeId));
+		if (Node* node = driver->GetNodeShared(_nodeId))
 		{
 			result = !node->IsNodeAlive();
 		}
@@ -1464,8 +1542,8 @@ string Manager::GetNodeQueryStage(uint32 const _homeId, uint8 const _nodeId)
 	string result = "Unknown";
 	if (Driver* driver = GetDriver(_homeId))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
-		if (Node* node = driver->GetNode(_nodeId))
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_nodeId));
+		if (Node* node = driver->GetNodeShared(_nodeId))
 		{
 			result = node->GetQueryStageName(node->GetCurrentQueryStage());
 		}
@@ -1506,8 +1584,8 @@ string Manager::GetInstanceLabel(uint32 const _homeId, uint8 const _node, uint8
 	string label;
 	if (Driver* driver = GetDriver(_homeId))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
-		if (Node* node = driver->GetNode(_node))
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_node));
+		if (Node* node = driver->GetNodeShared(_node))
 		{
 			label = node->GetInstanceLabel(_cc, _instance);
 			return label;
@@ -1534,7 +1612,7 @@ string Manager::GetValueLabel(ValueID const& _id, int32 _pos)
 	string label;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (_pos != -1)
 		{
 			if (_id.GetType() != ValueID::ValueType_BitSet)
@@ -1551,12 +1629,12 @@ string Manager::GetValueLabel(ValueID const& _id, int32 _pos)
 		{
 			bool useinstancelabels = true;
 			Options::Get()->GetOptionAsBool("IncludeInstanceLabel", &useinstancelabels);
-			Node* node = driver->GetNode(_id.GetNodeId());
+			Node* node = driver->GetNodeShared(_id.GetNodeId());
 			if ((useinstancelabels) && (node))
 			{
 				if (node->GetNumInstances(_id.GetCommandClassId()) > 1)
 				{
-					label = GetInstanceLabel(_id).append(" ");
+					label = node->GetInstanceLabel(_id.GetCommandClassId(), _id.GetInstance()).append(" ");
 				}
 			}
 			if (Internal::VC::Value* value = driver->GetValue(_id))
@@ -1581,6 +1659,7 @@ void Manager::SetValueLabel(ValueID const& _id, string const& _value, int32 _pos
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
 		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 		if (_pos != -1)
 		{
 			if (_id.GetType() != ValueID::ValueType_BitSet)
@@ -1615,7 +1694,7 @@ string Manager::GetValueUnits(ValueID const& _id)
 	string units;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			units = value->GetUnits();
@@ -1639,6 +1718,7 @@ void Manager::SetValueUnits(ValueID const& _id, string const& _value)
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
 		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			value->SetUnits(_value);
@@ -1660,7 +1740,7 @@ string Manager::GetValueHelp(ValueID const& _id, int32 _pos)
 	string help;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (_pos != -1)
 		{
 			if (_id.GetType() != ValueID::ValueType_BitSet)
@@ -1696,6 +1776,7 @@ void Manager::SetValueHelp(ValueID const& _id, string const& _value, int32 _pos)
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
 		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 		if (_pos != -1)
 		{
 			if (_id.GetType() != ValueID::ValueType_BitSet)
@@ -1730,7 +1811,7 @@ int32 Manager::GetValueMin(ValueID const& _id)
 	int32 limit = 0;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			limit = value->GetMin();
@@ -1754,7 +1835,7 @@ int32 Manager::GetValueMax(ValueID const& _id)
 	int32 limit = 0;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			limit = value->GetMax();
@@ -1778,7 +1859,7 @@ bool Manager::IsValueReadOnly(ValueID const& _id)
 	bool res = false;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			res = value->IsReadOnly();
@@ -1802,7 +1883,7 @@ bool Manager::IsValueWriteOnly(ValueID const& _id)
 	bool res = false;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			res = value->IsWriteOnly();
@@ -1826,7 +1907,7 @@ bool Manager::IsValueSet(ValueID const& _id)
 	bool res = false;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			res = value->IsSet();
@@ -1850,7 +1931,7 @@ bool Manager::IsValuePolled(ValueID const& _id)
 	bool res = false;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			res = value->IsPolled();
@@ -1873,7 +1954,7 @@ bool Manager::IsValueValid(ValueID const& _id)
 {
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			value->Release();
@@ -1897,7 +1978,7 @@ bool Manager::GetValueAsBitSet(ValueID const& _id, uint8 _pos, bool* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					*o_value = value->GetBit(_pos);
@@ -1932,7 +2013,7 @@ bool Manager::GetValueAsBool(ValueID const& _id, bool* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBool* value = static_cast<Internal::VC::ValueBool*>(driver->GetValue(_id)))
 				{
 					*o_value = value->GetValue();
@@ -1949,7 +2030,7 @@ bool Manager::GetValueAsBool(ValueID const& _id, bool* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueButton* value = static_cast<Internal::VC::ValueButton*>(driver->GetValue(_id)))
 				{
 					*o_value = value->IsPressed();
@@ -1985,7 +2066,7 @@ bool Manager::GetValueAsByte(ValueID const& _id, uint8* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueByte* value = static_cast<Internal::VC::ValueByte*>(driver->GetValue(_id)))
 				{
 					*o_value = value->GetValue();
@@ -2021,7 +2102,7 @@ bool Manager::GetValueAsFloat(ValueID const& _id, float* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueDecimal* value = static_cast<Internal::VC::ValueDecimal*>(driver->GetValue(_id)))
 				{
 					string str = value->GetValue();
@@ -2056,7 +2137,7 @@ bool Manager::GetValueAsInt(ValueID const& _id, int32* o_value)
 	{
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
-			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 
 			if (ValueID::ValueType_Int == _id.GetType())
 			{
@@ -2108,7 +2189,7 @@ bool Manager::GetValueAsRaw(ValueID const& _id, uint8** o_value, uint8* o_length
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueRaw* value = static_cast<Internal::VC::ValueRaw*>(driver->GetValue(_id)))
 				{
 					*o_length = value->GetLength();
@@ -2146,7 +2227,7 @@ bool Manager::GetValueAsShort(ValueID const& _id, int16* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueShort* value = static_cast<Internal::VC::ValueShort*>(driver->GetValue(_id)))
 				{
 					*o_value = value->GetValue();
@@ -2182,7 +2263,7 @@ bool Manager::GetValueAsString(ValueID const& _id, string* o_value)
 	{
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
-			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 
 			switch (_id.GetType())
 			{
@@ -2375,7 +2456,7 @@ bool Manager::GetValueListSelection(ValueID const& _id, string* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueList* value = static_cast<Internal::VC::ValueList*>(driver->GetValue(_id)))
 				{
 					Internal::VC::ValueList::Item const *item = value->GetItem();
@@ -2420,7 +2501,7 @@ bool Manager::GetValueListSelection(ValueID const& _id, int32* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueList* value = static_cast<Internal::VC::ValueList*>(driver->GetValue(_id)))
 				{
 					Internal::VC::ValueList::Item const *item = value->GetItem();
@@ -2465,7 +2546,7 @@ bool Manager::GetValueListItems(ValueID const& _id, vector<string>* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueList* value = static_cast<Internal::VC::ValueList*>(driver->GetValue(_id)))
 				{
 					o_value->clear();
@@ -2501,7 +2582,7 @@ bool Manager::GetValueListValues(ValueID const& _id, vector<int32>* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueList* value = static_cast<Internal::VC::ValueList*>(driver->GetValue(_id)))
 				{
 					o_value->clear();
@@ -2537,7 +2618,7 @@ bool Manager::GetValueFloatPrecision(ValueID const& _id, uint8* o_value)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueDecimal* value = static_cast<Internal::VC::ValueDecimal*>(driver->GetValue(_id)))
 				{
 					*o_value = value->GetPrecision();
@@ -2559,6 +2640,58 @@ bool Manager::GetValueFloatPrecision(ValueID const& _id, uint8* o_value)
 	return res;
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::GetValueSnapshot>
+// Gets a copy of the current state of a value without locking the driver
+//-----------------------------------------------------------------------------
+bool Manager::GetValueSnapshot(ValueID const& _id, ValueSnapshot* o_snapshot)
+{
+	if (o_snapshot)
+	{
+		if (Driver* driver = GetDriver(_id.GetHomeId()))
+		{
+			return driver->GetValueSnapshots()->Read(_id, o_snapshot);
+		}
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetValueSnapshots>
+// Gets a copy of the current state of many values without locking the driver
+//-----------------------------------------------------------------------------
+uint32 Manager::GetValueSnapshots(ValueID const* _ids, uint32 _count, ValueSnapshot* o_snapshots)
+{
+	uint32 found = 0;
+	if (!_ids || !o_snapshots)
+	{
+		return found;
+	}
+
+	// The ids will almost always belong to one network, so only look the driver
+	// up again when the home id changes
+	Driver* driver = NULL;
+	uint32 homeId = 0;
+	for (uint32 i = 0; i < _count; ++i)
+	{
+		if (!driver || (_ids[i].GetHomeId() != homeId))
+		{
+			homeId = _ids[i].GetHomeId();
+			driver = GetDriver(homeId);
+		}
+
+		if (driver && driver->GetValueSnapshots()->Read(_ids[i], &o_snapshots[i]))
+		{
+			++found;
+		}
+		else
+		{
+			o_snapshots[i].m_version = 0;
+		}
+	}
+	return found;
+}
+
 //-----------------------------------------------------------------------------
 // <Manager::SetValue>
 // Sets a bit in a BitSet Value
@@ -2574,6 +2707,7 @@ bool Manager::SetValue(ValueID const& _id, uint8 _pos, bool const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					if (_value)
@@ -2612,6 +2746,7 @@ bool Manager::SetValue(ValueID const& _id, bool const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBool* value = static_cast<Internal::VC::ValueBool*>(driver->GetValue(_id)))
 				{
 					res = value->Set(_value);
@@ -2647,6 +2782,7 @@ bool Manager::SetValue(ValueID const& _id, uint8 const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueByte* value = static_cast<Internal::VC::ValueByte*>(driver->GetValue(_id)))
 				{
 					res = value->Set(_value);
@@ -2666,6 +2802,7 @@ bool Manager::SetValue(ValueID const& _id, uint8 const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					if (value->GetSize() == 1)
@@ -2708,6 +2845,7 @@ bool Manager::SetValue(ValueID const& _id, float const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueDecimal* value = static_cast<Internal::VC::ValueDecimal*>(driver->GetValue(_id)))
 				{
 					char str[256];
@@ -2763,6 +2901,7 @@ bool Manager::SetValue(ValueID const& _id, int32 const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueInt* value = static_cast<Internal::VC::ValueInt*>(driver->GetValue(_id)))
 				{
 					res = value->Set(_value);
@@ -2782,6 +2921,7 @@ bool Manager::SetValue(ValueID const& _id, int32 const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					if (value->GetSize() == 4)
@@ -2824,6 +2964,7 @@ bool Manager::SetValue(ValueID const& _id, uint8 const* _value, uint8 const _len
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueRaw* value = static_cast<Internal::VC::ValueRaw*>(driver->GetValue(_id)))
 				{
 					res = value->Set(_value, _length);
@@ -2859,6 +3000,7 @@ bool Manager::SetValue(ValueID const& _id, int16 const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueShort* value = static_cast<Internal::VC::ValueShort*>(driver->GetValue(_id)))
 				{
 					res = value->Set(_value);
@@ -2878,6 +3020,7 @@ bool Manager::SetValue(ValueID const& _id, int16 const _value)
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					if (value->GetSize() == 2)
@@ -2920,6 +3063,7 @@ bool Manager::SetValueListSelection(ValueID const& _id, string const& _selectedI
 			if (_id.GetNodeId() != driver->GetControllerNodeId())
 			{
 				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueList* value = static_cast<Internal::VC::ValueList*>(driver->GetValue(_id)))
 				{
 					res = value->SetByLabel(_selectedItem);
@@ -2954,6 +3098,7 @@ bool Manager::SetValue(ValueID const& _id, string const& _value)
 		if (_id.GetNodeId() != driver->GetControllerNodeId())
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 
 			switch (_id.GetType())
 			{
@@ -3148,6 +3293,7 @@ void Manager::SetChangeVerified(ValueID const& _id, bool _verify)
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
 		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			value->SetChangeVerified(_verify);
@@ -3169,7 +3315,7 @@ bool Manager::GetChangeVerified(ValueID const& _id)
 	bool res = false;
 	if (Driver* driver = GetDriver(_id.GetHomeId()))
 	{
-		Internal::LockGuard LG(driver->m_nodeMutex);
+		Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 		if (Internal::VC::Value* value = driver->GetValue(_id))
 		{
 			res = value->GetChangeVerified();
@@ -3196,6 +3342,7 @@ bool Manager::PressButton(ValueID const& _id)
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueButton* value = static_cast<Internal::VC::ValueButton*>(driver->GetValue(_id)))
 			{
 				res = value->PressButton();
@@ -3228,6 +3375,7 @@ bool Manager::ReleaseButton(ValueID const& _id)
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueButton* value = static_cast<Internal::VC::ValueButton*>(driver->GetValue(_id)))
 			{
 				res = value->ReleaseButton();
@@ -3260,6 +3408,7 @@ bool Manager::SetBitMask(ValueID const& _id, uint32 _mask)
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 			{
 				res = value->SetBitMask(_mask);
@@ -3294,7 +3443,7 @@ bool Manager::GetBitMask(ValueID const& _id, int32* o_mask)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					*o_mask = value->GetBitMask();
@@ -3330,7 +3479,7 @@ bool Manager::GetBitSetSize(ValueID const& _id, uint8* o_size)
 		{
 			if (Driver* driver = GetDriver(_id.GetHomeId()))
 			{
-				Internal::LockGuard LG(driver->m_nodeMutex);
+				Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 				if (Internal::VC::ValueBitSet* value = static_cast<Internal::VC::ValueBitSet*>(driver->GetValue(_id)))
 				{
 					*o_size = value->GetSize();
@@ -3369,7 +3518,7 @@ uint8 Manager::GetNumSwitchPoints(ValueID const& _id)
 	{
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
-			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueSchedule* value = static_cast<Internal::VC::ValueSchedule*>(driver->GetValue(_id)))
 			{
 				numSwitchPoints = value->GetNumSwitchPoints();
@@ -3402,6 +3551,7 @@ bool Manager::SetSwitchPoint(ValueID const& _id, uint8 const _hours, uint8 const
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueSchedule* value = static_cast<Internal::VC::ValueSchedule*>(driver->GetValue(_id)))
 			{
 				res = value->SetSwitchPoint(_hours, _minutes, _setback);
@@ -3434,6 +3584,7 @@ bool Manager::RemoveSwitchPoint(ValueID const& _id, uint8 const _hours, uint8 co
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueSchedule* value = static_cast<Internal::VC::ValueSchedule*>(driver->GetValue(_id)))
 			{
 				uint8 idx;
@@ -3470,6 +3621,7 @@ void Manager::ClearSwitchPoints(ValueID const& _id)
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
 			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueSchedule* value = static_cast<Internal::VC::ValueSchedule*>(driver->GetValue(_id)))
 			{
 				value->ClearSwitchPoints();
@@ -3499,7 +3651,7 @@ bool Manager::GetSwitchPoint(ValueID const& _id, uint8 const _idx, uint8* o_hour
 	{
 		if (Driver* driver = GetDriver(_id.GetHomeId()))
 		{
-			Internal::LockGuard LG(driver->m_nodeMutex);
+			Internal::SharedLockGuard SLG(driver->GetNodeLock(_id.GetNodeId()));
 			if (Internal::VC::ValueSchedule* value = static_cast<Internal::VC::ValueSchedule*>(driver->GetValue(_id)))
 			{
 				res = value->GetSwitchPoint(_idx, o_hours, o_minutes, o_setback);
@@ -3589,6 +3741,7 @@ void Manager::RequestAllConfigParams(uint32 const _homeId, uint8 const _nodeId)
 		Node* node = driver->GetNode(_nodeId);
 		if (node)
 		{
+			Internal::ExclusiveLockGuard ELG(driver->GetNodeLock(_nodeId));
 			node->SetQueryStage(Node::QueryStage_Configuration);
 		}
 	}
@@ -3716,12 +3869,39 @@ void Manager::RemoveAssociation(uint32 const _homeId, uint8 const _nodeId, uint8
 // Add a watcher to the list
 //-----------------------------------------------------------------------------
 bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context)
+{
+	return AddWatcher(_watcher, NULL, _context, 0xffffffffffffffffULL, 0);
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::AddWatcher>
+// Add a watcher that only receives some notifications to the list
+//-----------------------------------------------------------------------------
+bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context, uint64 _typeMask, uint8 _nodeId)
+{
+	return AddWatcher(_watcher, NULL, _context, _typeMask, _nodeId);
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::AddBatchWatcher>
+// Add a watcher that receives notifications in batches to the list
+//-----------------------------------------------------------------------------
+bool Manager::AddBatchWatcher(pfnOnNotifications_t _watcher, void* _context, uint64 _typeMask, uint8 _nodeId)
+{
+	return AddWatcher(NULL, _watcher, _context, _typeMask, _nodeId);
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::AddWatcher>
+// Add either kind of watcher to the list
+//-----------------------------------------------------------------------------
+bool Manager::AddWatcher(pfnOnNotification_t _watcher, pfnOnNotifications_t _batchWatcher, void* _context, uint64 _typeMask, uint8 _nodeId)
 {
 	// Ensure this watcher is not already on the list
 	m_notificationMutex->Lock();
 	for (list<Watcher*>::iterator it = m_watchers.begin(); it != m_watchers.end(); ++it)
 	{
-		if (((*it)->m_callback == _watcher) && ((*it)->m_context == _context))
+		if (((*it)->m_callback == _watcher) && ((*it)->m_batchCallback == _batchWatcher) && ((*it)->m_context == _context))
 		{
 			// Already in the list
 			m_notificationMutex->Unlock();
@@ -3729,7 +3909,7 @@ bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context)
 		}
 	}
 
-	m_watchers.push_back(new Watcher(_watcher, _context));
+	m_watchers.push_back(new Watcher(_watcher, _batchWatcher, _context, _typeMask, _nodeId));
 	m_notificationMutex->Unlock();
 	return true;
 }
@@ -3739,12 +3919,30 @@ bool Manager::AddWatcher(pfnOnNotification_t _watcher, void* _context)
 // Remove a watcher from the list
 //-----------------------------------------------------------------------------
 bool Manager::RemoveWatcher(pfnOnNotification_t _watcher, void* _context)
+{
+	return RemoveWatcher(_watcher, NULL, _context);
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::RemoveBatchWatcher>
+// Remove a batch watcher from the list
+//-----------------------------------------------------------------------------
+bool Manager::RemoveBatchWatcher(pfnOnNotifications_t _watcher, void* _context)
+{
+	return RemoveWatcher(NULL, _watcher, _context);
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::RemoveWatcher>
+// Remove either kind of watcher from the list
+//-----------------------------------------------------------------------------
+bool Manager::RemoveWatcher(pfnOnNotification_t _watcher, pfnOnNotifications_t _batchWatcher, void* _context)
 {
 	m_notificationMutex->Lock();
 	list<Watcher*>::iterator it = m_watchers.begin();
 	while (it != m_watchers.end())
 	{
-		if (((*it)->m_callback == _watcher) && ((*it)->m_context == _context))
+		if (((*it)->m_callback == _watcher) && ((*it)->m_batchCallback == _batchWatcher) && ((*it)->m_context == _context))
 		{
 			delete (*it);
 			list<Watcher*>::iterator next = m_watchers.erase(it);
@@ -3770,6 +3968,24 @@ bool Manager::RemoveWatcher(pfnOnNotification_t _watcher, void* _context)
 // Notify any watching objects of a value change
 //-----------------------------------------------------------------------------
 void Manager::NotifyWatchers(Notification* _notification)
+{
+	if (m_notificationDispatcher)
+	{
+		// The dispatcher thread delivers and deletes it
+		m_notificationDispatcher->Queue(_notification);
+		return;
+	}
+
+	Notification const* notification = _notification;
+	DeliverNotifications(&notification, 1);
+	delete _notification;
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::DeliverNotifications>
+// Pass a batch of notifications to every watcher that wants them
+//-----------------------------------------------------------------------------
+void Manager::DeliverNotifications(Notification const* const* _notifications, uint32 _count)
 {
 	m_notificationMutex->Lock();
 	list<Watcher*>::iterator it = m_watchers.begin();
@@ -3777,12 +3993,66 @@ void Manager::NotifyWatchers(Notification* _notification)
 	while (it != m_watchers.end())
 	{
 		Watcher* pWatcher = *(it++);
-		pWatcher->m_callback(_notification, pWatcher->m_context);
+
+		if (pWatcher->m_batchCallback)
+		{
+			// A local batch, since the callback may cause another delivery on this thread
+			vector<Notification const*> batch;
+			batch.reserve(_count);
+			for (uint32 i = 0; i < _count; ++i)
+			{
+				if (pWatcher->Wants(_notifications[i]))
+				{
+					batch.push_back(_notifications[i]);
+				}
+			}
+			if (!batch.empty())
+			{
+				pWatcher->m_batchCallback(&batch[0], (uint32) batch.size(), pWatcher->m_context);
+			}
+		}
+		else
+		{
+			for (uint32 i = 0; i < _count; ++i)
+			{
+				if (pWatcher->Wants(_notifications[i]))
+				{
+					pWatcher->m_callback(_notifications[i], pWatcher->m_context);
+				}
+			}
+		}
 	}
 	m_watcherIterators.pop_back();
 	m_notificationMutex->Unlock();
 }
 
+//-----------------------------------------------------------------------------
+// <Manager::Watcher::Wants>
+// Check a notification against the watcher's filter
+//-----------------------------------------------------------------------------
+bool Manager::Watcher::Wants(Notification const* _notification) const
+{
+	if (!((m_typeMask >> _notification->GetType()) & 1))
+	{
+		return false;
+	}
+	return ((m_nodeId == 0) || (m_nodeId == _notification->GetNodeId()));
+}
+
+//-----------------------------------------------------------------------------
+// <Manager::GetNotificationStatistics>
+// Retrieve the notification dispatcher counters
+//-----------------------------------------------------------------------------
+void Manager::GetNotificationStatistics(NotificationStatistics* _data)
+{
+	if (m_notificationDispatcher)
+	{
+		m_notificationDispatcher->GetStatistics(_data);
+		return;
+	}
+	memset(_data, 0, sizeof(NotificationStatistics));
+}
+
 //-----------------------------------------------------------------------------
 //	Controller commands
 //-----------------------------------------------------------------------------
@@ -39,6 +39,7 @@
 #include "Driver.h"
 #include "Group.h"
 #include "value_classes/ValueID.h"
+#include "value_classes/ValueSnapshot.h"
 
 namespace OpenZWave
 {
@@ -54,6 +55,7 @@ namespace OpenZWave
 			class ValueStore;
 		}
 		class Msg;
+		class NotificationDispatcher;
 	}
 	class Options;
 	class Node;
@@ -114,9 +116,11 @@ namespace OpenZWave
 			friend class Internal::VC::Value;
 			friend class Internal::VC::ValueStore;
 			friend class Internal::Msg;
+			friend class Internal::NotificationDispatcher;
 
 		public:
 			typedef void (*pfnOnNotification_t)(Notification const* _pNotification, void* _context);
+			typedef void (*pfnOnNotifications_t)(Notification const* const* _pNotifications, uint32 _count, void* _context);
 
 			//-----------------------------------------------------------------------------
 			// Construction
@@ -199,6 +203,7 @@ namespace OpenZWave
 			 * consists of the 8 digit hexadecimal version of the controller's Home ID, prefixed with the string 'ozwcache_'.
 			 * This convention allows OpenZWave to find the correct configuration file for a controller, even if it is
 			 * attached to a different serial port, USB device path, etc.
+			 * With the CacheJournal option set, only the nodes that have changed are saved, to the journal.
 			 * \deprecated OZW handles writing out the cache automatically. This does not need to be called anymore.
 			 * \param _homeId The Home ID of the Z-Wave controller to save.
 			 */
@@ -434,6 +439,24 @@ namespace OpenZWave
 			 */
 			uint8 GetPollIntensity(ValueID const &_valueId);
 
+			/**
+			 * \brief Set the time between polls of a single value, in milliseconds.
+			 * A value with its own poll interval is polled on that schedule, regardless of the global
+			 * poll interval and of its poll intensity.  Polling still has to be enabled with EnablePoll.
+			 * \param _valueId The ID of the value whose poll interval should be set.
+			 * \param _milliseconds The time between polls, or zero to go back to polling by intensity.
+			 */
+			void SetValuePollInterval(ValueID const &_valueId, int32 const _milliseconds);
+
+			/**
+			 * \brief Get the time between polls of a single value.
+			 * \param _valueId The ID of the value to check.
+			 * \return The time between polls in milliseconds, or zero if the value is polled by intensity.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_VALUEID if the ValueID is invalid
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 */
+			int32 GetValuePollInterval(ValueID const &_valueId);
+
 			/*@}*/
 
 			//-----------------------------------------------------------------------------
@@ -1272,6 +1295,31 @@ namespace OpenZWave
 			 */
 			bool GetValueFloatPrecision(ValueID const& _id, uint8* o_value);
 
+			/**
+			 * \brief Gets a copy of the current state of a primitive value without taking any driver locks.
+			 * The snapshot is updated by the driver whenever the value changes, so it is always as
+			 * fresh as what GetValueAsBool and friends would return.  Use this instead of those
+			 * methods when reading many values, for example to refresh a UI.
+			 * \param _id The unique identifier of the value.
+			 * \param o_snapshot Pointer to a ValueSnapshot that will be filled with the value.
+			 * \return true if the value was obtained.  Returns false if the value does not exist, or its type has no snapshot (String, Raw, Schedule and Button).
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \see ValueSnapshot, GetValueSnapshots
+			 */
+			bool GetValueSnapshot(ValueID const& _id, ValueSnapshot* o_snapshot);
+
+			/**
+			 * \brief Gets a copy of the current state of many primitive values without taking any driver locks.
+			 * \param _ids Array of the unique identifiers of the values.
+			 * \param _count The number of entries in _ids.
+			 * \param o_snapshots Array of at least _count ValueSnapshots that will be filled with the values.  The
+			 * m_version of any entry that could not be read is set to zero.
+			 * \return the number of values that were obtained.
+			 * \throws OZWException with Type OZWException::OZWEXCEPTION_INVALID_HOMEID if the Driver cannot be found
+			 * \see ValueSnapshot, GetValueSnapshot
+			 */
+			uint32 GetValueSnapshots(ValueID const* _ids, uint32 _count, ValueSnapshot* o_snapshots);
+
 			/**
 			 * \brief Sets the state of a bit in a BitSet ValueID.
 			 * Due to the possibility of a device being asleep, the command is assumed to succeed, and the value
@@ -1804,6 +1852,17 @@ namespace OpenZWave
 			 */
 			bool AddWatcher(pfnOnNotification_t _watcher, void* _context);
 
+			/**
+			 * \brief Add a notification watcher that only receives some notifications.
+			 * \param _watcher pointer to a function that will be called by the notification system.
+			 * \param _context pointer to user defined data that will be passed to the watcher function with each notification.
+			 * \param _typeMask the notification types to deliver.  Bit n is set to receive Notification::NotificationType n.
+			 * \param _nodeId only deliver notifications for this node, or 0 for notifications from any node.
+			 * \return true if the watcher was successfully added.
+			 * \see RemoveWatcher, AddBatchWatcher, Notification
+			 */
+			bool AddWatcher(pfnOnNotification_t _watcher, void* _context, uint64 _typeMask, uint8 _nodeId = 0);
+
 			/**
 			 * \brief Remove a notification watcher.
 			 * \param _watcher pointer to a function that must match that passed to a previous call to AddWatcher
@@ -1812,25 +1871,78 @@ namespace OpenZWave
 			 * \see AddWatcher, Notification
 			 */
 			bool RemoveWatcher(pfnOnNotification_t _watcher, void* _context);
+
+			/**
+			 * \brief Add a watcher that receives notifications in batches.
+			 * When the NotificationThread option is enabled, notifications are queued and
+			 * delivered from a dispatcher thread, and a batch watcher is called once for each
+			 * batch rather than once per notification.  Without the option, each batch holds
+			 * a single notification.  The notifications are only valid for the duration of the call.
+			 * \param _watcher pointer to a function that will be called by the notification system.
+			 * \param _context pointer to user defined data that will be passed to the watcher function with each batch.
+			 * \param _typeMask the notification types to deliver.  Bit n is set to receive Notification::NotificationType n.
+			 * \param _nodeId only deliver notifications for this node, or 0 for notifications from any node.
+			 * \return true if the watcher was successfully added.
+			 * \see RemoveBatchWatcher, AddWatcher, Notification
+			 */
+			bool AddBatchWatcher(pfnOnNotifications_t _watcher, void* _context, uint64 _typeMask = 0xffffffffffffffffULL, uint8 _nodeId = 0);
+
+			/**
+			 * \brief Remove a batch notification watcher.
+			 * \param _watcher pointer to a function that must match that passed to a previous call to AddBatchWatcher
+			 * \param _context pointer to user defined data that must match the one passed in that same previous call to AddBatchWatcher.
+			 * \return true if the watcher was successfully removed.
+			 * \see AddBatchWatcher
+			 */
+			bool RemoveBatchWatcher(pfnOnNotifications_t _watcher, void* _context);
+
+			/**
+			 * \brief Counters for the notification dispatcher.
+			 * All counters stay at zero unless the NotificationThread option is enabled.
+			 */
+			struct NotificationStatistics
+			{
+					uint32 m_queued;			// Notifications accepted into the queue
+					uint32 m_delivered;			// Notifications passed to the watchers
+					uint32 m_dropped;			// Notifications discarded because the queue was full
+					uint32 m_removed;			// Value notifications discarded because the driver removed the value while they were queued
+					uint32 m_batches;			// Number of batches delivered
+					uint32 m_maxDepth;			// Largest number of notifications waiting in the queue
+			};
+
+			/**
+			 * \brief Retrieve the notification dispatcher counters.
+			 * \param _data Pointer to a structure that will be filled in.
+			 */
+			void GetNotificationStatistics(NotificationStatistics* _data);
 			/*@}*/
 
 		private:
-			void NotifyWatchers(Notification* _notification);					// Passes the notifications to all the registered watcher callbacks in turn.
+			void NotifyWatchers(Notification* _notification);					// Passes the notification to the watchers, or queues it for the dispatcher thread.  Takes ownership of the notification.
+			void DeliverNotifications(Notification const* const* _notifications, uint32 _count);	// Calls every matching watcher callback for a batch of notifications
+			bool AddWatcher(pfnOnNotification_t _watcher, pfnOnNotifications_t _batchWatcher, void* _context, uint64 _typeMask, uint8 _nodeId);
+			bool RemoveWatcher(pfnOnNotification_t _watcher, pfnOnNotifications_t _batchWatcher, void* _context);
 
 			struct Watcher
 			{
 					pfnOnNotification_t m_callback;
+					pfnOnNotifications_t m_batchCallback;
 					void* m_context;
+					uint64 m_typeMask;				// Bit n set to receive Notification::NotificationType n
+					uint8 m_nodeId;					// Only receive notifications for this node, or 0 for all nodes
 
-					Watcher(pfnOnNotification_t _callback, void* _context) :
-							m_callback(_callback), m_context(_context)
+					Watcher(pfnOnNotification_t _callback, pfnOnNotifications_t _batchCallback, void* _context, uint64 _typeMask, uint8 _nodeId) :
+							m_callback(_callback), m_batchCallback(_batchCallback), m_context(_context), m_typeMask(_typeMask), m_nodeId(_nodeId)
 					{
 					}
+
+					bool Wants(Notification const* _notification) const;
 			};
 
 			list<Watcher*> m_watchers;							// List of all the registered watchers.
 			list<list<Watcher*>::iterator*> m_watcherIterators;					// Iterators currently operating on the list of watchers
 			Internal::Platform::Mutex* m_notificationMutex;
+			Internal::NotificationDispatcher* m_notificationDispatcher;	// Delivers notifications from its own thread, or NULL to deliver from the driver threads
 
 			//-----------------------------------------------------------------------------
 			// Controller commands
@@ -27,6 +27,7 @@
 
 #include "ManufacturerSpecificDB.h"
 #include "tinyxml.h"
+#include "ConfigImage.h"
 
 #include "Options.h"
 #include "Driver.h"
@@ -64,7 +65,7 @@ namespace OpenZWave
 		}
 
 		ManufacturerSpecificDB::ManufacturerSpecificDB() :
-				m_MfsMutex(new Internal::Platform::Mutex()), m_revision(0), m_latestRevision(0), m_initializing(true)
+				m_MfsMutex(new Internal::Platform::Mutex()), m_revision(0), m_latestRevision(0), m_initializing(true), m_deviceConfigMutex(new Internal::Platform::Mutex())
 		{
 			// Ensure the singleton instance is set
 			s_instance = this;
@@ -83,6 +84,8 @@ namespace OpenZWave
 			if (!s_bXmlLoaded)
 				UnloadProductXML();
 
+			FlushDeviceConfigs();
+			m_deviceConfigMutex->Release();
 		}
 
 //-----------------------------------------------------------------------------
@@ -100,6 +103,14 @@ namespace OpenZWave
 			{
 				string path = configPath + product->GetConfigPath();
 
+				// The config image holds the revision of every file it was built from
+				uint32 revision;
+				if (ConfigImage::GetRevision(path, &revision))
+				{
+					product->SetConfigRevision(revision);
+					return;
+				}
+
 				TiXmlDocument* pDoc = new TiXmlDocument();
 				if (!pDoc->LoadFile(path.c_str(), TIXML_ENCODING_UTF8))
 				{
@@ -148,7 +159,7 @@ namespace OpenZWave
 			string filename = configPath + "manufacturer_specific.xml";
 
 			TiXmlDocument* pDoc = new TiXmlDocument();
-			if (!pDoc->LoadFile(filename.c_str(), TIXML_ENCODING_UTF8))
+			if (!ConfigImage::LoadFile(filename, pDoc))
 			{
 				delete pDoc;
 				Log::Write(LogLevel_Info, "Unable to load %s", filename.c_str());
@@ -295,6 +306,7 @@ namespace OpenZWave
 
 				s_bXmlLoaded = false;
 			}
+			FlushDeviceConfigs();
 		}
 
 		void ManufacturerSpecificDB::checkConfigFiles(Driver *driver)
@@ -357,6 +369,10 @@ namespace OpenZWave
 			if (iter != m_downloading.end())
 			{
 				m_downloading.erase(iter);
+				if (success)
+				{
+					FlushDeviceConfig(file);
+				}
 				if ((node > 0) && success)
 				{
 					driver->refreshNodeConfig(node);
@@ -541,5 +557,121 @@ namespace OpenZWave
 			checkInitialized();
 			return ret;
 		}
+
+//-----------------------------------------------------------------------------
+// <ManufacturerSpecificDB::GetDeviceConfig>
+// Get a device config file, from the cache if it has already been parsed
+//-----------------------------------------------------------------------------
+		DeviceConfig* ManufacturerSpecificDB::GetDeviceConfig(string const& _configPath)
+		{
+			string configPath;
+			Options::Get()->GetOptionAsString("ConfigPath", &configPath);
+			string filename = configPath + _configPath;
+
+			// The lock is held while parsing, so two nodes of a new product
+			// do not both parse its file
+			LockGuard LG(m_deviceConfigMutex);
+			map<string, DeviceConfig*>::iterator it = m_deviceConfigs.find(filename);
+			if (it != m_deviceConfigs.end())
+			{
+				it->second->AddRef();
+				return it->second;
+			}
+
+			TiXmlDocument* doc = new TiXmlDocument();
+			if (!ConfigImage::LoadFile(filename, doc))
+			{
+				delete doc;
+				Log::Write(LogLevel_Info, "Unable to find or load Config Param file %s", filename.c_str());
+				return NULL;
+			}
+			/* make sure it has the right xmlns */
+			char const *xmlns = doc->RootElement()->Attribute("xmlns");
+			if (xmlns && strcmp(xmlns, "https://github.com/OpenZWave/open-zwave"))
+			{
+				delete doc;
+				Log::Write(LogLevel_Warning, "Invalid XML Namespace in %s - Ignoring", filename.c_str());
+				return NULL;
+			}
+
+			DeviceConfig* config = new DeviceConfig(filename, doc);
+			m_deviceConfigs[filename] = config;
+			config->AddRef();
+			return config;
+		}
+
+//-----------------------------------------------------------------------------
+// <ManufacturerSpecificDB::ReleaseDeviceConfig>
+// Hand back a device config returned by GetDeviceConfig
+//-----------------------------------------------------------------------------
+		void ManufacturerSpecificDB::ReleaseDeviceConfig(DeviceConfig* _config)
+		{
+			LockGuard LG(m_deviceConfigMutex);
+			_config->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <ManufacturerSpecificDB::FlushDeviceConfig>
+// Drop a device config file from the cache, as it has been replaced
+//-----------------------------------------------------------------------------
+		void ManufacturerSpecificDB::FlushDeviceConfig(string const& _filename)
+		{
+			LockGuard LG(m_deviceConfigMutex);
+			map<string, DeviceConfig*>::iterator it = m_deviceConfigs.find(_filename);
+			if (it != m_deviceConfigs.end())
+			{
+				// Nodes still applying it keep it alive until they release it
+				it->second->Release();
+				m_deviceConfigs.erase(it);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <ManufacturerSpecificDB::FlushDeviceConfigs>
+// Drop every device config file from the cache
+//-----------------------------------------------------------------------------
+		void ManufacturerSpecificDB::FlushDeviceConfigs()
+		{
+			LockGuard LG(m_deviceConfigMutex);
+			for (map<string, DeviceConfig*>::iterator it = m_deviceConfigs.begin(); it != m_deviceConfigs.end(); ++it)
+			{
+				it->second->Release();
+			}
+			m_deviceConfigs.clear();
+		}
+
+//-----------------------------------------------------------------------------
+// <DeviceConfig::DeviceConfig>
+// Constructor
+//-----------------------------------------------------------------------------
+		DeviceConfig::DeviceConfig(string const& _filename, TiXmlDocument* _doc) :
+				m_filename(_filename), m_doc(_doc), m_revision(0)
+		{
+			// Error messages from the readers of the document name the file
+			m_doc->SetUserData((void *) m_filename.c_str());
+			char const* str = m_doc->RootElement()->Attribute("Revision");
+			if (str)
+			{
+				m_revision = atol(str);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <DeviceConfig::~DeviceConfig>
+// Destructor
+//-----------------------------------------------------------------------------
+		DeviceConfig::~DeviceConfig()
+		{
+			delete m_doc;
+		}
+
+//-----------------------------------------------------------------------------
+// <DeviceConfig::GetRoot>
+// Get the root element of the document
+//-----------------------------------------------------------------------------
+		TiXmlElement const* DeviceConfig::GetRoot() const
+		{
+			return m_doc->RootElement();
+		}
 	} // namespace Internal
 } // namespace OpenZWave
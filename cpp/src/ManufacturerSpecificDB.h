@@ -36,6 +36,9 @@
 #include "platform/Ref.h"
 #include "Defs.h"
 
+class TiXmlDocument;
+class TiXmlElement;
+
 namespace OpenZWave
 {
 	class Driver;
@@ -110,6 +113,38 @@ namespace OpenZWave
 				uint32 m_configrevision;
 		};
 
+		/** \brief A device configuration file, parsed once and shared by every node that uses it.
+		 *
+		 * Nodes only read the document, so one copy serves all the nodes of a product.  Get
+		 * one with ManufacturerSpecificDB::GetDeviceConfig, and hand it back with
+		 * ManufacturerSpecificDB::ReleaseDeviceConfig when the node has applied it.
+		 */
+		class DeviceConfig: public Internal::Platform::Ref
+		{
+				friend class ManufacturerSpecificDB;
+
+			public:
+				TiXmlElement const* GetRoot() const;
+				string const& GetFilename() const
+				{
+					return m_filename;
+				}
+				uint32 GetRevision() const
+				{
+					return m_revision;
+				}
+
+			protected:
+				virtual ~DeviceConfig();
+
+			private:
+				DeviceConfig(string const& _filename, TiXmlDocument* _doc);
+
+				string m_filename;
+				TiXmlDocument* m_doc;
+				uint32 m_revision;
+		};
+
 		/** \brief The _ManufacturerSpecificDB class handles the Config File Database
 		 * that we use to configure devices.
 		 */
@@ -148,11 +183,23 @@ namespace OpenZWave
 				bool updateMFSConfigFile(Driver *);
 				void checkInitialized();
 
+				/**
+				 * Get the parsed contents of a device configuration file, parsing it only if
+				 * no other node has asked for it since it last changed.
+				 * \param _configPath path of the file, relative to the ConfigPath option.
+				 * \return the configuration, or NULL if the file cannot be loaded.  It must be
+				 * handed back with ReleaseDeviceConfig.
+				 */
+				DeviceConfig* GetDeviceConfig(string const& _configPath);
+				void ReleaseDeviceConfig(DeviceConfig* _config);
+
 			private:
 				void LoadConfigFileRevision(ProductDescriptor *product);
 				ManufacturerSpecificDB();
 				~ManufacturerSpecificDB();
 				void checkConfigFileContents(Driver *driver, string file);
+				void FlushDeviceConfig(string const& _filename);
+				void FlushDeviceConfigs();
 
 				Internal::Platform::Mutex* m_MfsMutex; /**< Mutex to ensure its accessed by a single thread at a time */
 
@@ -170,6 +217,9 @@ namespace OpenZWave
 				uint32 m_latestRevision;
 				bool m_initializing;
 
+				map<string, DeviceConfig*> m_deviceConfigs;			// Parsed device config files, keyed by full path
+				Internal::Platform::Mutex* m_deviceConfigMutex;		// Guards m_deviceConfigs and the reference counts of its entries
+
 		};
 
 	} // namespace Internal
@@ -27,6 +27,7 @@
 
 #include "Defs.h"
 #include "Msg.h"
+#include "BlockPool.h"
 #include "Node.h"
 #include "Manager.h"
 #include "Utils.h"
@@ -48,11 +49,11 @@ namespace OpenZWave
 // <Msg::Msg>
 // Constructor
 //-----------------------------------------------------------------------------
-		Msg::Msg(string const& _logText, uint8 _targetNodeId, uint8 const _msgType, uint8 const _function, bool const _bCallbackRequired, bool const _bReplyRequired,			// = true
+		Msg::Msg(char const* _logText, uint8 _targetNodeId, uint8 const _msgType, uint8 const _function, bool const _bCallbackRequired, bool const _bReplyRequired,			// = true
 				uint8 const _expectedReply,			// = 0
 				uint8 const _expectedCommandClassId	// = 0
 				) :
-				m_logText(_logText), m_bFinal(false), m_bCallbackRequired(_bCallbackRequired), m_callbackId(0), m_expectedReply(0), m_expectedCommandClassId(_expectedCommandClassId), m_length(4), m_targetNodeId(_targetNodeId), m_sendAttempts(0), m_maxSendAttempts( MAX_TRIES), m_instance(1), m_endPoint(0), m_flags(0), m_encrypted(false), m_noncerecvd(false), m_homeId(0), m_resendDuetoCANorNAK(false)
+				m_logText(_logText), m_encapsulated(false), m_bFinal(false), m_bCallbackRequired(_bCallbackRequired), m_callbackId(0), m_expectedReply(0), m_expectedCommandClassId(_expectedCommandClassId), m_length(4), m_targetNodeId(_targetNodeId), m_sendAttempts(0), m_maxSendAttempts( MAX_TRIES), m_instance(1), m_endPoint(0), m_flags(0), m_coalesceCommandClassId(0), m_coalesceIndex(0), m_encrypted(false), m_requestNonce(false), m_noncerecvd(false), m_homeId(0), m_resendDuetoCANorNAK(false)
 		{
 			if (_bReplyRequired)
 			{
@@ -69,6 +70,55 @@ namespace OpenZWave
 			m_buffer[3] = _function;
 		}
 
+//-----------------------------------------------------------------------------
+// <Msg::Msg>
+// Constructor for log text that should not be interned
+//-----------------------------------------------------------------------------
+		Msg::Msg(string const& _logText, uint8 _targetNodeId, uint8 const _msgType, uint8 const _function, bool const _bCallbackRequired, bool const _bReplyRequired, uint8 const _expectedReply, uint8 const _expectedCommandClassId) :
+				Msg("", _targetNodeId, _msgType, _function, _bCallbackRequired, _bReplyRequired, _expectedReply, _expectedCommandClassId)
+		{
+			m_builtLogText = _logText;
+		}
+
+//-----------------------------------------------------------------------------
+// <Msg::operator new>
+// Take the memory for a message from the pool
+//-----------------------------------------------------------------------------
+		void* Msg::operator new(size_t _size)
+		{
+			if (_size != sizeof(Msg))
+			{
+				return ::operator new(_size);
+			}
+			return GetPool().Alloc();
+		}
+
+//-----------------------------------------------------------------------------
+// <Msg::operator delete>
+// Return the memory for a message to the pool, unless operator new took it
+// from the heap
+//-----------------------------------------------------------------------------
+		void Msg::operator delete(void* _p, size_t _size)
+		{
+			if (_size != sizeof(Msg))
+			{
+				::operator delete(_p);
+				return;
+			}
+			GetPool().Free(_p);
+		}
+
+//-----------------------------------------------------------------------------
+// <Msg::GetPool>
+// The pool holding every message
+//-----------------------------------------------------------------------------
+		BlockPool& Msg::GetPool()
+		{
+			// Enough for a full set of queues without going back to the heap
+			static BlockPool* pool = new BlockPool(sizeof(Msg), 128);
+			return *pool;
+		}
+
 //-----------------------------------------------------------------------------
 // <Msg::SetInstance>
 // Used to enable wrapping with MultiInstance/MultiChannel during finalize.
@@ -205,7 +255,7 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 		std::string Msg::GetAsString()
 		{
-			string str = m_logText;
+			string str = GetLogText();
 
 			char byteStr[16];
 			if (m_targetNodeId != 0xff)
@@ -230,13 +280,29 @@ namespace OpenZWave
 			return str;
 		}
 
+//-----------------------------------------------------------------------------
+// <Msg::GetLogText>
+// The text passed to the constructor, noting any encapsulation
+//-----------------------------------------------------------------------------
+		std::string Msg::GetLogText() const
+		{
+			string const& logText = m_logText.empty() ? m_builtLogText : m_logText.str();
+			if (!m_encapsulated)
+			{
+				return logText;
+			}
+
+			char str[256];
+			snprintf(str, sizeof(str), "%s Encapsulated (instance=%d): %s", ((m_flags & m_MultiChannel) != 0) ? "MultiChannel" : "MultiInstance", m_instance, logText.c_str());
+			return str;
+		}
+
 //-----------------------------------------------------------------------------
 // <Msg::MultiEncap>
 // Encapsulate the data inside a MultiInstance/Multicommand message
 //-----------------------------------------------------------------------------
 		void Msg::MultiEncap()
 		{
-			char str[256];
 			if (m_buffer[3] != FUNC_ID_ZW_SEND_DATA)
 			{
 				return;
@@ -246,10 +312,7 @@ namespace OpenZWave
 			if ((m_flags & m_MultiChannel) != 0)
 			{
 				// MultiChannel
-				for (uint32 i = m_length - 1; i >= 6; --i)
-				{
-					m_buffer[i + 4] = m_buffer[i];
-				}
+				memmove(&m_buffer[10], &m_buffer[6], m_length - 6);
 
 				m_buffer[5] += 4;
 				m_buffer[6] = Internal::CC::MultiInstance::StaticGetCommandClassId();
@@ -257,27 +320,19 @@ namespace OpenZWave
 				m_buffer[8] = 1;
 				m_buffer[9] = m_endPoint;
 				m_length += 4;
-
-				snprintf(str, sizeof(str), "MultiChannel Encapsulated (instance=%d): %s", m_instance, m_logText.c_str());
-				m_logText = str;
 			}
 			else
 			{
 				// MultiInstance
-				for (uint32 i = m_length - 1; i >= 6; --i)
-				{
-					m_buffer[i + 3] = m_buffer[i];
-				}
+				memmove(&m_buffer[9], &m_buffer[6], m_length - 6);
 
 				m_buffer[5] += 3;
 				m_buffer[6] = Internal::CC::MultiInstance::StaticGetCommandClassId();
 				m_buffer[7] = Internal::CC::MultiInstance::MultiInstanceCmd_Encap;
 				m_buffer[8] = m_instance;
 				m_length += 3;
-
-				snprintf(str, sizeof(str), "MultiInstance Encapsulated (instance=%d): %s", m_instance, m_logText.c_str());
-				m_logText = str;
 			}
+			m_encapsulated = true;
 		}
 
 //-----------------------------------------------------------------------------
@@ -294,7 +349,7 @@ namespace OpenZWave
 			Log::Write(LogLevel_Info, m_targetNodeId, "Encrypted Flag is %d", m_encrypted);
 			if (m_encrypted == false)
 				return m_buffer;
-			else if (EncryptBuffer(m_buffer, m_length, GetDriver(), GetDriver()->GetControllerNodeId(), m_targetNodeId, m_nonce, e_buffer))
+			else if (EncryptBuffer(m_buffer, m_length, GetDriver(), GetDriver()->GetControllerNodeId(), m_targetNodeId, m_nonce, e_buffer, m_requestNonce))
 			{
 				return e_buffer;
 			}
@@ -32,6 +32,7 @@
 #include <string>
 #include <string.h>
 #include "Defs.h"
+#include "StringPool.h"
 //#include "Driver.h"
 
 namespace OpenZWave
@@ -44,6 +45,7 @@ namespace OpenZWave
 		{
 			class CommandClass;
 		}
+		class BlockPool;
 
 		/** \brief Message object to be passed to and from devices on the Z-Wave network.
 		 */
@@ -56,11 +58,24 @@ namespace OpenZWave
 					m_MultiInstance = 0x02,		// Indicate MultiInstance encapsulation
 				};
 
+				Msg(char const* _logtext, uint8 _targetNodeId, uint8 const _msgType, uint8 const _function, bool const _bCallbackRequired, bool const _bReplyRequired = true, uint8 const _expectedReply = 0, uint8 const _expectedCommandClassId = 0);
+				/**
+				 * For log text built at run time or passed in by the application.  It is kept
+				 * in the message rather than the StringPool, which never frees its strings.
+				 */
 				Msg(string const& _logtext, uint8 _targetNodeId, uint8 const _msgType, uint8 const _function, bool const _bCallbackRequired, bool const _bReplyRequired = true, uint8 const _expectedReply = 0, uint8 const _expectedCommandClassId = 0);
 				~Msg()
 				{
 				}
 
+				/**
+				 * Messages are built and thrown away for every frame sent, so their memory
+				 * comes from a pool.  \see GetPool
+				 */
+				static void* operator new(size_t _size);
+				static void operator delete(void* _p, size_t _size);
+				static BlockPool& GetPool();
+
 				void SetInstance(OpenZWave::Internal::CC::CommandClass * _cc, uint8 const _instance);	// Used to enable wrapping with MultiInstance/MultiChannel during finalize.
 
 				void Append(uint8 const _data);
@@ -129,10 +144,7 @@ namespace OpenZWave
 				 * \brief get the LogText Associated with this message
 				 * \return the LogText used during the constructor
 				 */
-				string GetLogText() const
-				{
-					return m_logText;
-				}
+				string GetLogText() const;
 
 				uint32 GetLength() const
 				{
@@ -180,6 +192,27 @@ namespace OpenZWave
 
 					return false;
 				}
+				/**
+				 * \brief Mark this message as an idempotent Set of a single value.  A newer Set of the same
+				 * value that is queued before this one is sent, with nothing else for the node queued in
+				 * between, will replace it (see Driver::SendMsg).
+				 * \param _commandClassId the command class of the value being set.
+				 * \param _index the index of the value within its command class and instance.
+				 */
+				void SetCoalesceKey(uint8 const _commandClassId, uint16 const _index)
+				{
+					m_coalesceCommandClassId = _commandClassId;
+					m_coalesceIndex = _index;
+				}
+
+				/**
+				 * \brief Test whether this message and another are both Sets of the same value on the same node.
+				 */
+				bool IsSameValueSet(Msg const& _other) const
+				{
+					return ((m_coalesceCommandClassId != 0) && (m_coalesceCommandClassId == _other.m_coalesceCommandClassId) && (m_coalesceIndex == _other.m_coalesceIndex) && (m_targetNodeId == _other.m_targetNodeId) && (m_instance == _other.m_instance) && (m_endPoint == _other.m_endPoint) && (m_encrypted == _other.m_encrypted));
+				}
+
 				uint8 GetSendingCommandClass()
 				{
 					if (m_buffer[3] == 0x13)
@@ -196,6 +229,14 @@ namespace OpenZWave
 				{
 					m_encrypted = true;
 				}
+				/**
+				 * Send as a MessageEncapNonceGet, asking the node for its next nonce
+				 * along with this message.
+				 */
+				void setRequestNonce(bool _request)
+				{
+					m_requestNonce = _request;
+				}
 				bool isNonceRecieved()
 				{
 					return m_noncerecvd;
@@ -231,7 +272,9 @@ namespace OpenZWave
 			private:
 
 				void MultiEncap();						// Encapsulate the data inside a MultiInstance/Multicommand message
-				string m_logText;
+				InternedString m_logText;			// Log texts are nearly all literals, so this saves building a string for each message
+				string m_builtLogText;				// Log text that is not a literal, used when m_logText is empty
+				bool m_encapsulated;				// MultiEncap has wrapped the data, which GetLogText reports
 				bool m_bFinal;
 				bool m_bCallbackRequired;
 
@@ -250,7 +293,11 @@ namespace OpenZWave
 				uint8 m_endPoint;				// Endpoint to use if the message must be wrapped in a multiInstance or multiChannel command class
 				uint8 m_flags;
 
+				uint8 m_coalesceCommandClassId;		// Non-zero if this message is a Set that can be replaced by a newer one
+				uint16 m_coalesceIndex;
+
 				bool m_encrypted;
+				bool m_requestNonce;
 				bool m_noncerecvd;
 				uint8 m_nonce[8];
 				uint32 m_homeId;
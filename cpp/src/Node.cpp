@@ -35,6 +35,7 @@
 #include "Driver.h"
 #include "Localization.h"
 #include "ManufacturerSpecificDB.h"
+#include "ConfigImage.h"
 #include "Notification.h"
 #include "Msg.h"
 #include "ZWSecurity.h"
@@ -91,6 +92,9 @@ map<uint8, Node::DeviceClass*> Node::s_roleDeviceClasses;
 map<uint16, Node::DeviceClass*> Node::s_deviceTypeClasses;
 map<uint8, Node::DeviceClass*> Node::s_nodeTypes;
 
+// Read for every clear text message received for a secured command class
+static OptionHandle<bool> s_enforceSecureReception("EnforceSecureReception", true);
+
 static char const* c_queryStageNames[] =
 { "None", "ProtocolInfo", "Probe", "WakeUp", "NodeInfo", "NodePlusInfo", "SecurityReport", "Versions", "ManufacturerSpecific1", "Instances", "ManufacturerSpecific2", "Static", "CacheLoad", "Associations", "Neighbors", "Session", "Dynamic", "Configuration", "Complete" };
 
@@ -102,11 +106,12 @@ Node::Node(uint32 const _homeId, uint8 const _nodeId) :
 		m_queryStage(QueryStage_None), m_queryPending(false), m_queryConfiguration(false), m_queryRetries(0), m_protocolInfoReceived(false), m_basicprotocolInfoReceived(false), m_nodeInfoReceived(false), m_nodePlusInfoReceived(false), m_manufacturerSpecificClassReceived(false), m_nodeInfoSupported(true), m_refreshonNodeInfoFrame(true), m_nodeAlive(true),	// assome live node
 		m_listening(true),	// assume we start out listening
 		m_frequentListening(false), m_beaming(false), m_routing(false), m_maxBaudRate(0), m_version(0), m_security(false), m_homeId(_homeId), m_nodeId(_nodeId), m_basic(0), m_generic(0), m_specific(0), m_type(""), m_addingNode(false), m_manufacturerName(""), m_productName(""), m_nodeName(""), m_location(""), m_manufacturerId(0), m_productType(0), m_productId(0), m_deviceType(0), m_role(0), m_nodeType(0), m_secured(false), m_nodeCache( NULL), m_Product( NULL), m_fileConfigRevision(0), m_loadedConfigRevision(
-				0), m_latestConfigRevision(0), m_values(new Internal::VC::ValueStore()), m_sentCnt(0), m_sentFailed(0), m_retries(0), m_receivedCnt(0), m_receivedDups(0), m_receivedUnsolicited(0), m_lastRequestRTT(0), m_lastResponseRTT(0), m_averageRequestRTT(0), m_averageResponseRTT(0), m_quality(0), m_lastReceivedMessage(), m_errors(0), m_txStatusReportSupported(false), m_txTime(0), m_hops(0), m_ackChannel(0), m_lastTxChannel(0), m_routeScheme((TXSTATUS_ROUTING_SCHEME) 0), m_routeUsed
-		{ }, m_routeSpeed((TXSTATUS_ROUTE_SPEED) 0), m_routeTries(0), m_lastFailedLinkFrom(0), m_lastFailedLinkTo(0), m_lastnonce(0)
+				0), m_latestConfigRevision(0), m_values(new Internal::VC::ValueStore(GetDriver()->GetNodeLock(_nodeId))), m_sentCnt(0), m_sentFailed(0), m_retries(0), m_receivedCnt(0), m_receivedDups(0), m_receivedUnsolicited(0), m_lastRequestRTT(0), m_lastResponseRTT(0), m_averageRequestRTT(0), m_averageResponseRTT(0), m_requestSRTT(0), m_requestRTTVar(0), m_responseSRTT(0), m_responseRTTVar(0), m_averageQueueTime(0), m_maxQueueTime(0), m_deferredCnt(0), m_backoffCnt(0), m_sendFailures(0), m_quality(0), m_lastReceivedMessage(), m_errors(0), m_txStatusReportSupported(false), m_txTime(0), m_hops(0), m_ackChannel(0), m_lastTxChannel(0), m_routeScheme((TXSTATUS_ROUTING_SCHEME) 0), m_routeUsed
+		{ }, m_routeSpeed((TXSTATUS_ROUTE_SPEED) 0), m_routeTries(0), m_lastFailedLinkFrom(0), m_lastFailedLinkTo(0), m_lastnonce(0), m_hasPrefetchedNonce(false), m_nonceRequested(false)
 {
 	memset(m_neighbors, 0, sizeof(m_neighbors));
 	memset(m_nonces, 0, sizeof(m_nonces));
+	memset(m_usedNonce, 0, sizeof(m_usedNonce));
 	memset(m_rssi_1, 0, sizeof(m_rssi_1));
 	memset(m_rssi_2, 0, sizeof(m_rssi_2));
 	memset(m_rssi_3, 0, sizeof(m_rssi_3));
@@ -1595,7 +1600,10 @@ void Node::SetInstanceLabel(uint8 const _instance, char *label)
 	m_globalInstanceLabel[_instance] = string(label);
 	Driver *driver = GetDriver();
 	if (driver)
-		driver->WriteCache();
+	{
+		driver->MarkNodeDirty(m_nodeId);
+		driver->WriteCacheChanges();
+	}
 }
 
 string Node::GetInstanceLabel(uint8 const _ccid, uint8 const _instance)
@@ -2067,9 +2075,7 @@ void Node::ApplicationCommandHandler(uint8 const* _data, bool encrypted
 		if (pCommandClass->IsSecured() && !encrypted)
 		{
 			Log::Write(LogLevel_Warning, m_nodeId, "Received a Clear Text Message for the CommandClass %s which is Secured", pCommandClass->GetCommandClassName().c_str());
-			bool drop = true;
-			Options::Get()->GetOptionAsBool("EnforceSecureReception", &drop);
-			if (drop)
+			if (s_enforceSecureReception.Get())
 			{
 				Log::Write(LogLevel_Warning, m_nodeId, "   Dropping Message");
 				return;
@@ -3380,7 +3386,7 @@ bool Node::ReadDeviceClasses()
 	string filename = configPath + string("device_classes.xml");
 
 	TiXmlDocument doc;
-	if (!doc.LoadFile(filename.c_str(), TIXML_ENCODING_UTF8))
+	if (!Internal::ConfigImage::LoadFile(filename, &doc))
 	{
 		Log::Write(LogLevel_Warning, "Failed to load device_classes.xml");
 		Log::Write(LogLevel_Warning, "Check that the config path provided when creating the Manager points to the correct location.");
@@ -3477,6 +3483,10 @@ void Node::GetNodeStatistics(NodeData* _data)
 	_data->m_receivedTS = m_receivedTS.GetAsString();
 	_data->m_averageRequestRTT = m_averageRequestRTT;
 	_data->m_averageResponseRTT = m_averageResponseRTT;
+	_data->m_averageQueueTime = m_averageQueueTime;
+	_data->m_maxQueueTime = m_maxQueueTime;
+	_data->m_deferredCnt = m_deferredCnt;
+	_data->m_backoffCnt = m_backoffCnt;
 	_data->m_txStatusReportSupported = m_txStatusReportSupported;
 	_data->m_txTime = m_txTime;
 	_data->m_hops = m_hops;
@@ -3687,6 +3697,68 @@ uint8 *Node::GetNonceKey(uint32 nonceid)
 	return NULL;
 }
 
+//-----------------------------------------------------------------------------
+// <Node::SetNonceRequested>
+// Note whether we have asked this node for a nonce with a MessageEncapNonceGet
+//-----------------------------------------------------------------------------
+void Node::SetNonceRequested(bool _requested)
+{
+	m_nonceRequested = _requested;
+}
+
+//-----------------------------------------------------------------------------
+// <Node::SetPrefetchedNonce>
+// Keep a nonce from this node for the next message we encrypt for it
+//-----------------------------------------------------------------------------
+bool Node::SetPrefetchedNonce(uint8 const* _nonce, int32 _lifetime)
+{
+	if (!m_nonceRequested)
+	{
+		Log::Write(LogLevel_Detail, m_nodeId, "Dropping a NonceReport we did not ask for");
+		return false;
+	}
+	if (!memcmp(_nonce, m_usedNonce, 8))
+	{
+		Log::Write(LogLevel_Detail, m_nodeId, "Dropping a resent NonceReport for a nonce already used");
+		return false;
+	}
+	m_nonceRequested = false;
+	memcpy(m_prefetchedNonce, _nonce, 8);
+	m_prefetchedNonceExpiry.SetTime(_lifetime);
+	m_hasPrefetchedNonce = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Node::TakePrefetchedNonce>
+// Use up the prefetched nonce, if it is still valid
+//-----------------------------------------------------------------------------
+bool Node::TakePrefetchedNonce(uint8* o_nonce)
+{
+	if (!m_hasPrefetchedNonce)
+	{
+		return false;
+	}
+	m_hasPrefetchedNonce = false;
+	if (m_prefetchedNonceExpiry.TimeRemaining() <= 0)
+	{
+		Log::Write(LogLevel_Detail, m_nodeId, "Prefetched nonce has expired");
+		return false;
+	}
+	memcpy(o_nonce, m_prefetchedNonce, 8);
+	memcpy(m_usedNonce, m_prefetchedNonce, 8);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// <Node::SetUsedNonce>
+// Remember the last nonce used, so a resent NonceReport for it is not kept
+//-----------------------------------------------------------------------------
+void Node::SetUsedNonce(uint8 const* _nonce)
+{
+	memcpy(m_usedNonce, _nonce, 8);
+}
+
 //-----------------------------------------------------------------------------
 // <Node::GetDeviceTypeString>
 // Get the ZWave+ DeviceType as a String
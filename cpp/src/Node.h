@@ -29,6 +29,7 @@
 #define _Node_H
 
 #include <string>
+#include <atomic>
 #include <vector>
 #include <list>
 #include <map>
@@ -815,6 +816,10 @@ namespace OpenZWave
 					uint8 m_routeTries;
 					uint8 m_lastFailedLinkFrom;
 					uint8 m_lastFailedLinkTo;
+					uint32 m_averageQueueTime;			// ms a message waits in the send queues before it is sent
+					uint32 m_maxQueueTime;
+					uint32 m_deferredCnt;				// Times messages were passed over for other nodes' because the node was backed off
+					uint32 m_backoffCnt;				// Times the node was backed off after failing to answer
 			};
 
 		private:
@@ -832,6 +837,18 @@ namespace OpenZWave
 			Internal::Platform::TimeStamp m_receivedTS;				// Last message received time
 			uint32 m_averageRequestRTT;			// Average Request round trip time.
 			uint32 m_averageResponseRTT;		// Average Response round trip time.
+			int32 m_requestSRTT;				// Smoothed request and response round trip times and their
+			int32 m_requestRTTVar;				// mean deviations (RFC 6298), used to time out messages to the node
+			int32 m_responseSRTT;
+			int32 m_responseRTTVar;
+			// Updated by the driver thread while choosing the next message, under the send
+			// mutex rather than the node's lock, so GetNodeStatistics may read them at any time
+			std::atomic<uint32> m_averageQueueTime;	// Average time a message waits in the send queues
+			std::atomic<uint32> m_maxQueueTime;		// Longest time a message has waited in the send queues
+			std::atomic<uint32> m_deferredCnt;		// Times messages were passed over for other nodes' because the node was backed off
+			uint32 m_backoffCnt;				// Times the node was backed off after failing to answer
+			uint8 m_sendFailures;				// Failures to answer since it last did
+			Internal::Platform::TimeStamp m_sendBackoffTS;			// Until when other nodes' messages are sent first
 			uint8 m_quality;					// Node quality measure
 			uint8 m_lastReceivedMessage[254];	// Place to hold last received message
 			uint8 m_errors;
@@ -860,9 +877,39 @@ namespace OpenZWave
 			uint8 *GenerateNonceKey();
 			uint8 *GetNonceKey(uint32 nonceid);
 
+			/**
+			 * Note whether the encrypted message just sent to the node was a
+			 * MessageEncapNonceGet, so that a NonceReport is expected without a Nonce_Get.
+			 */
+			void SetNonceRequested(bool _requested);
+			/**
+			 * Keep a nonce the node sent without a Nonce_Get from us, for encrypting the
+			 * next message to it.  It is only kept if it answers a MessageEncapNonceGet
+			 * that is still outstanding, and is not the nonce we used last, as a node
+			 * may resend a NonceReport it has already sent.
+			 * \param _lifetime How long, in milliseconds, the nonce may be used for.
+			 * \return true if the nonce was kept.
+			 */
+			bool SetPrefetchedNonce(uint8 const* _nonce, int32 _lifetime);
+			/**
+			 * Take the prefetched nonce, if there is one and it has not expired.  Each
+			 * nonce can only be used once.
+			 */
+			bool TakePrefetchedNonce(uint8* o_nonce);
+			/**
+			 * Note the nonce from a NonceReport that answered our Nonce_Get, once it has
+			 * been used.
+			 */
+			void SetUsedNonce(uint8 const* _nonce);
+
 		private:
 			uint8 m_lastnonce;
 			uint8 m_nonces[8][8];
+			bool m_hasPrefetchedNonce;
+			bool m_nonceRequested;				// We sent a MessageEncapNonceGet and have not had its NonceReport
+			uint8 m_prefetchedNonce[8];			// The node's nonce, for the next message we encrypt for it
+			uint8 m_usedNonce[8];				// The last of the node's nonces we encrypted a message with
+			Internal::Platform::TimeStamp m_prefetchedNonceExpiry;
 
 			//-----------------------------------------------------------------------------
 			//	MetaData Related
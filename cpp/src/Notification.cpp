@@ -27,11 +27,49 @@
 
 #include "Defs.h"
 #include "Notification.h"
+#include "BlockPool.h"
 #include "Driver.h"
 #include "command_classes/CommandClasses.h"
 
 using namespace OpenZWave;
 
+//-----------------------------------------------------------------------------
+// <GetNotificationPool>
+// The pool holding every notification
+//-----------------------------------------------------------------------------
+static Internal::BlockPool& GetNotificationPool()
+{
+	static Internal::BlockPool* pool = new Internal::BlockPool(sizeof(Notification), 1024);
+	return *pool;
+}
+
+//-----------------------------------------------------------------------------
+// <Notification::operator new>
+// Take the memory for a notification from the pool
+//-----------------------------------------------------------------------------
+void* Notification::operator new(size_t _size)
+{
+	if (_size != sizeof(Notification))
+	{
+		return ::operator new(_size);
+	}
+	return GetNotificationPool().Alloc();
+}
+
+//-----------------------------------------------------------------------------
+// <Notification::operator delete>
+// Return the memory for a notification to the pool
+//-----------------------------------------------------------------------------
+void Notification::operator delete(void* _p, size_t _size)
+{
+	if (_size != sizeof(Notification))
+	{
+		::operator delete(_p);
+		return;
+	}
+	GetNotificationPool().Free(_p);
+}
+
 //-----------------------------------------------------------------------------
 // <Notification::GetAsString>
 // Return a string representation of OZW
@@ -52,6 +52,7 @@ namespace OpenZWave
 			class ValueStore;
 		}
 		class ManufacturerSpecificDB;
+		class NotificationDispatcher;
 	}
 	/** \brief Provides a container for data sent via the notification callback
 	 *    handler installed by a call to Manager::AddWatcher.
@@ -74,6 +75,7 @@ namespace OpenZWave
 			friend class Internal::CC::WakeUp;
 			friend class Internal::CC::ApplicationStatus;
 			friend class Internal::ManufacturerSpecificDB;
+			friend class Internal::NotificationDispatcher;
 			/* allow us to Stream a Notification */
 			//friend std::ostream &operator<<(std::ostream &os, const Notification &dt);
 
@@ -309,6 +311,11 @@ namespace OpenZWave
 			{
 			}
 
+			// Notifications are created and destroyed for every value update, so
+			// their memory is recycled through a BlockPool (see Notification.cpp)
+			static void* operator new(size_t _size);
+			static void operator delete(void* _p, size_t _size);
+
 			void SetHomeAndNodeIds(uint32 const _homeId, uint8 const _nodeId)
 			{
 				m_valueId = ValueID(_homeId, _nodeId);
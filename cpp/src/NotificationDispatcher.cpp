@@ -0,0 +1,256 @@
+//-----------------------------------------------------------------------------
+//
+//	NotificationDispatcher.cpp
+//
+//	Delivers notifications to the watchers from a dedicated thread
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include "NotificationDispatcher.h"
+#include "Notification.h"
+#include "Utils.h"
+#include "platform/Event.h"
+#include "platform/Mutex.h"
+#include "platform/Thread.h"
+#include "platform/WaitSet.h"
+#include "platform/Log.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::NotificationDispatcher>
+// Constructor
+//-----------------------------------------------------------------------------
+		NotificationDispatcher::NotificationDispatcher(uint32 const _capacity, uint32 const _batchSize) :
+				m_capacity(_capacity), m_batchSize(_batchSize), m_overflowing(false), m_queued(0), m_delivered(0), m_dropped(0), m_removed(0), m_batches(0), m_maxDepth(0), m_queueMutex(new Internal::Platform::Mutex()), m_queueEvent(new Internal::Platform::Event()), m_thread(new Internal::Platform::Thread("notification"))
+		{
+			if (m_batchSize == 0)
+			{
+				m_batchSize = 1;
+			}
+			m_batch.reserve(m_batchSize);
+			m_thread->Start(NotificationDispatcher::DispatchThreadEntryPoint, this);
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::~NotificationDispatcher>
+// Destructor
+//-----------------------------------------------------------------------------
+		NotificationDispatcher::~NotificationDispatcher()
+		{
+			m_thread->Stop();
+			m_thread->Release();
+
+			// Deliver whatever the thread did not get to, so the application still
+			// sees the notifications sent while the drivers were shutting down.
+			while (DispatchBatch())
+			{
+			}
+
+			m_queueEvent->Release();
+			m_queueMutex->Release();
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::Queue>
+// Add a notification to the queue, or drop it if the queue is full
+//-----------------------------------------------------------------------------
+		bool NotificationDispatcher::Queue(Notification* _notification)
+		{
+			Internal::LockGuard LG(m_queueMutex);
+			if ((m_queue.size() >= m_capacity) && IsDroppable(_notification))
+			{
+				if (!m_overflowing)
+				{
+					Log::Write(LogLevel_Warning, "Notification queue is full (%d entries).  Dropping notifications until the watchers catch up", m_capacity);
+					m_overflowing = true;
+				}
+				++m_dropped;
+				delete _notification;
+				return false;
+			}
+
+			if (Notification::Type_ValueRemoved == _notification->GetType())
+			{
+				RemoveValueNotifications(_notification->GetValueID());
+			}
+
+			m_queue.push_back(_notification);
+			++m_queued;
+			if (m_queue.size() > m_maxDepth)
+			{
+				m_maxDepth = (uint32) m_queue.size();
+			}
+			m_queueEvent->Set();
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::RemoveValueNotifications>
+// Drop the queued notifications about a value that the driver has removed.
+// Must be called with m_queueMutex held.
+//-----------------------------------------------------------------------------
+		void NotificationDispatcher::RemoveValueNotifications(ValueID const& _valueId)
+		{
+			// The driver only hands over a notification for a value that still exists,
+			// but a watcher that is sent one after the value has gone will fail to read
+			// it.  The ValueAdded is kept, so the watcher still sees the value come and go.
+			for (std::deque<Notification*>::iterator it = m_queue.begin(); it != m_queue.end();)
+			{
+				Notification* notification = *it;
+				if (((Notification::Type_ValueChanged == notification->GetType()) || (Notification::Type_ValueRefreshed == notification->GetType())) && (notification->GetValueID() == _valueId))
+				{
+					if (Log::IsLevelEnabled(LogLevel_Detail))
+					{
+						Log::Write(LogLevel_Detail, notification->GetNodeId(), "Dropping queued Notification as ValueID has been removed: %s", notification->GetAsString().c_str());
+					}
+					++m_removed;
+					delete notification;
+					it = m_queue.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::GetStatistics>
+// Copy the counters
+//-----------------------------------------------------------------------------
+		void NotificationDispatcher::GetStatistics(Manager::NotificationStatistics* _data)
+		{
+			Internal::LockGuard LG(m_queueMutex);
+			_data->m_queued = m_queued;
+			_data->m_delivered = m_delivered;
+			_data->m_dropped = m_dropped;
+			_data->m_removed = m_removed;
+			_data->m_batches = m_batches;
+			_data->m_maxDepth = m_maxDepth;
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::DispatchThreadEntryPoint>
+// Entry point of the dispatcher thread
+//-----------------------------------------------------------------------------
+		void NotificationDispatcher::DispatchThreadEntryPoint(Internal::Platform::Event* _exitEvent, void* _context)
+		{
+			NotificationDispatcher* dispatcher = (NotificationDispatcher*) _context;
+			if (dispatcher)
+			{
+				dispatcher->DispatchThreadProc(_exitEvent);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::DispatchThreadProc>
+// Wait for notifications and deliver them in batches
+//-----------------------------------------------------------------------------
+		void NotificationDispatcher::DispatchThreadProc(Internal::Platform::Event* _exitEvent)
+		{
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);
+			waitObjects.Add(m_queueEvent);
+
+			while (true)
+			{
+				if (waitObjects.Multiple(2) == 0)
+				{
+					// Exit has been signalled.  The destructor delivers anything left over.
+					return;
+				}
+
+				DispatchBatch();
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::DispatchBatch>
+// Take up to m_batchSize notifications off the queue and deliver them
+//-----------------------------------------------------------------------------
+		bool NotificationDispatcher::DispatchBatch()
+		{
+			m_batch.clear();
+			{
+				Internal::LockGuard LG(m_queueMutex);
+				while (!m_queue.empty() && (m_batch.size() < m_batchSize))
+				{
+					m_batch.push_back(m_queue.front());
+					m_queue.pop_front();
+				}
+				if (m_queue.empty())
+				{
+					m_queueEvent->Reset();
+				}
+				if (m_overflowing && (m_queue.size() < m_capacity / 2))
+				{
+					Log::Write(LogLevel_Info, "Notification queue has drained.  %d notifications dropped so far", m_dropped);
+					m_overflowing = false;
+				}
+			}
+
+			if (m_batch.empty())
+			{
+				return false;
+			}
+
+			Manager::Get()->DeliverNotifications(&m_batch[0], (uint32) m_batch.size());
+			for (vector<Notification*>::iterator it = m_batch.begin(); it != m_batch.end(); ++it)
+			{
+				delete *it;
+			}
+
+			Internal::LockGuard LG(m_queueMutex);
+			m_delivered += (uint32) m_batch.size();
+			++m_batches;
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <NotificationDispatcher::IsDroppable>
+// High volume notifications that the application can recover from missing
+//-----------------------------------------------------------------------------
+		bool NotificationDispatcher::IsDroppable(Notification const* _notification)
+		{
+			switch (_notification->GetType())
+			{
+				case Notification::Type_ValueChanged:
+				case Notification::Type_ValueRefreshed:
+				case Notification::Type_NodeEvent:
+				case Notification::Type_Notification:
+				{
+					return true;
+				}
+				default:
+				{
+					return false;
+				}
+			}
+		}
+
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+//
+//	NotificationDispatcher.h
+//
+//	Delivers notifications to the watchers from a dedicated thread
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _NotificationDispatcher_H
+#define _NotificationDispatcher_H
+
+#include <deque>
+#include <vector>
+#include "Defs.h"
+#include "Manager.h"
+
+namespace OpenZWave
+{
+	class Notification;
+
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Event;
+			class Mutex;
+			class Thread;
+		}
+
+		/** \brief Queues notifications from the driver threads and hands them to the
+		 * watchers in batches from its own thread.
+		 *
+		 * Watcher callbacks can take as long as they like without holding up the driver
+		 * threads.  The queue is bounded: once it holds _capacity notifications, high
+		 * volume notifications (value changes and refreshes, node events and
+		 * Type_Notification) are dropped and counted.  Notifications that change the
+		 * structure of the network, such as nodes or drivers being added and removed,
+		 * are always queued so the application never loses track of what exists.
+		 * When the driver removes a value, the changes and refreshes of it that are still
+		 * queued are dropped.  Those already in the batch being delivered are not, so a
+		 * watcher can still be handed a ValueID that has just been removed.
+		 */
+		class NotificationDispatcher
+		{
+			public:
+				NotificationDispatcher(uint32 const _capacity, uint32 const _batchSize);
+
+				/**
+				 * Stops the dispatcher thread, then delivers anything still queued from the
+				 * calling thread.
+				 */
+				~NotificationDispatcher();
+
+				/**
+				 * Queue a notification for delivery.  Takes ownership of the notification.
+				 * \return false if the queue was full and the notification was dropped.
+				 */
+				bool Queue(Notification* _notification);
+
+				void GetStatistics(Manager::NotificationStatistics* _data);
+
+			private:
+				static void DispatchThreadEntryPoint(Internal::Platform::Event* _exitEvent, void* _context);
+				void DispatchThreadProc(Internal::Platform::Event* _exitEvent);
+				bool DispatchBatch();
+				static bool IsDroppable(Notification const* _notification);
+				void RemoveValueNotifications(ValueID const& _valueId);
+
+				std::deque<Notification*> m_queue;
+				std::vector<Notification*> m_batch;			// Only used by the thread that is dispatching
+				uint32 m_capacity;
+				uint32 m_batchSize;
+				bool m_overflowing;							// Set when we start dropping, so we only log once per overflow
+
+				uint32 m_queued;
+				uint32 m_delivered;
+				uint32 m_dropped;
+				uint32 m_removed;
+				uint32 m_batches;
+				uint32 m_maxDepth;
+
+				Internal::Platform::Mutex* m_queueMutex;	// Serialize access to the queue and counters
+				Internal::Platform::Event* m_queueEvent;	// Set while the queue is not empty
+				Internal::Platform::Thread* m_thread;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif
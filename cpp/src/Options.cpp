@@ -39,6 +39,7 @@
 using namespace OpenZWave;
 
 Options* Options::s_instance = NULL;
+OptionHandleBase* OptionHandleBase::s_first = NULL;
 
 //-----------------------------------------------------------------------------
 // <Options::Create>
@@ -105,6 +106,8 @@ Options* Options::Create(string const& _configPath, string const& _userPath, str
 		s_instance->AddOptionInt("SaveLogLevel", LogLevel_Detail);			// Save (to file) log messages equal to or above LogLevel_Detail
 		s_instance->AddOptionInt("QueueLogLevel", LogLevel_Debug);			// Save (in RAM) log messages equal to or above LogLevel_Debug
 		s_instance->AddOptionInt("DumpTriggerLevel", LogLevel_None);			// Default is to never dump RAM-stored log messages
+		s_instance->AddOptionBool("AsyncLogging", false);					// Format and write log messages on a background thread
+		s_instance->AddOptionBool("BinaryLogFile", false);					// Write the log file in binary form (needs AsyncLogging).  Decode it with LogDecode
 
 		s_instance->AddOptionBool("Associate", true);						// Enable automatic association of the controller with group one of every device.
 		s_instance->AddOptionString("Exclude", string(""), true);		// Remove support for the listed command classes.
@@ -112,6 +115,10 @@ Options* Options::Create(string const& _configPath, string const& _userPath, str
 		s_instance->AddOptionBool("NotifyTransactions", false);					// Notifications when transaction complete is reported.
 		s_instance->AddOptionString("Interface", string(""), true);		// Identify the serial port to be accessed (TODO: change the code so more than one serial port can be specified and HID)
 		s_instance->AddOptionBool("SaveConfiguration", true);						// Save the XML configuration upon driver close.
+		s_instance->AddOptionBool("ConfigImage", true);						// Read the config files from ozwconfig.bin in the ConfigPath when it is current
+		s_instance->AddOptionBool("BinaryCache", false);						// Save the network cache in the compact binary format instead of XML
+		s_instance->AddOptionBool("CacheJournal", false);						// Append changed nodes to a journal instead of rewriting the whole cache
+		s_instance->AddOptionInt("CacheJournalInterval", 60);					// Seconds between saving changed nodes to the journal, 0 to only save them when the driver changes a node itself
 		s_instance->AddOptionInt("DriverMaxAttempts", 0);
 
 		s_instance->AddOptionInt("PollInterval", 30000);						// 30 seconds (can easily poll 30 values in this time; ~120 values is the effective limit for 30 seconds)
@@ -122,16 +129,21 @@ Options* Options::Create(string const& _configPath, string const& _userPath, str
 		s_instance->AddOptionString("NetworkKey", string(""), false);
 		s_instance->AddOptionBool("RefreshAllUserCodes", false); 					// if true, during startup, we refresh all the UserCodes the device reports it supports. If False, we stop after we get the first "Available" slot (Some devices have 250+ usercode slots! - That makes our Session Stage Very Long )
 		s_instance->AddOptionInt("RetryTimeout", RETRY_TIMEOUT);				// How long do we wait to timeout messages sent
+		s_instance->AddOptionInt("RetryTimeoutMin", RETRY_TIMEOUT_MIN);			// Shortest timeout, for nodes whose round trip times are known
 		s_instance->AddOptionBool("EnableSIS", true);						// Automatically become a SUC if there is no SUC on the network.
 		s_instance->AddOptionBool("AssumeAwake", true);						// Assume Devices that Support the Wakeup CC are awake when we first query them....
 		s_instance->AddOptionBool("NotifyOnDriverUnload", false);						// Should we send the Node/Value Notifications on Driver Unloading - Read comments in Driver::~Driver() method about possible race conditions
 		s_instance->AddOptionString("SecurityStrategy", "SUPPORTED", false);		// Should we encrypt CC's that are available via both clear text and Security CC?
 		s_instance->AddOptionString("CustomSecuredCC", "0x62,0x4c,0x63", false);	// What List of Custom CC should we always encrypt if SecurityStrategy is CUSTOM
 		s_instance->AddOptionBool("EnforceSecureReception", true);						// if we recieve a clear text message for a CC that is Secured, should we drop the message
+		s_instance->AddOptionBool("SecurityNoncePrefetch", false);						// Ask a secure device for its next nonce while sending it an encrypted message, so the next one needs no Nonce_Get
 		s_instance->AddOptionBool("AutoUpdateConfigFile", true);						// if we should automatically update config files for devices if they are out of date
 		s_instance->AddOptionString("ReloadAfterUpdate", "AWAKE", false);			// Should we automatically Reload Nodes after a update
 		s_instance->AddOptionString("Language", "", false);			// Language we should use
 		s_instance->AddOptionBool("IncludeInstanceLabel", true);						// Should we include the Instance Label in Value Labels on MultiInstance Devices
+		s_instance->AddOptionBool("NotificationThread", false);						// Deliver notifications to the watchers from a dedicated thread instead of the driver threads
+		s_instance->AddOptionInt("NotificationQueueSize", 10000);						// With NotificationThread, drop value notifications once this many are waiting
+		s_instance->AddOptionInt("NotificationBatchSize", 64);						// With NotificationThread, the most notifications handed to a batch watcher in one call
 #if defined WINRT
 				s_instance->AddOptionInt( "ThreadTerminateTimeout", -1);						// Since threads cannot be terminated in WinRT, Thread::Terminate will simply wait for them to exit on there own
 #endif
@@ -153,6 +165,7 @@ bool Options::Destroy()
 		return false;
 	}
 
+	OptionHandleBase::UnbindAll();
 	delete s_instance;
 	s_instance = NULL;
 
@@ -344,6 +357,7 @@ bool Options::Lock()
 	ParseOptionsXML(m_LocalPath + m_xml);
 	ParseOptionsString(m_commandLine);
 	m_locked = true;
+	OptionHandleBase::BindAll();
 
 	/* Log our Configured Options */
 	map<string, Option*>::iterator it;
@@ -590,3 +604,91 @@ bool Options::Option::SetValueFromString(string const& _value)
 
 	return false;
 }
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::OptionHandleBase>
+// Constructor.  Adds the handle to the list that Options::Lock binds
+//-----------------------------------------------------------------------------
+OptionHandleBase::OptionHandleBase(char const* _name) :
+		m_name(_name), m_bound(false), m_prev(NULL), m_next(s_first)
+{
+	if (s_first)
+	{
+		s_first->m_prev = this;
+	}
+	s_first = this;
+}
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::~OptionHandleBase>
+// Destructor
+//-----------------------------------------------------------------------------
+OptionHandleBase::~OptionHandleBase()
+{
+	if (m_prev)
+	{
+		m_prev->m_next = m_next;
+	}
+	else
+	{
+		s_first = m_next;
+	}
+	if (m_next)
+	{
+		m_next->m_prev = m_prev;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::Read>
+// Look up the value of a boolean option
+//-----------------------------------------------------------------------------
+bool OptionHandleBase::Read(bool* o_value) const
+{
+	Options* options = Options::Get();
+	return options && options->GetOptionAsBool(m_name, o_value);
+}
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::Read>
+// Look up the value of an integer option
+//-----------------------------------------------------------------------------
+bool OptionHandleBase::Read(int32* o_value) const
+{
+	Options* options = Options::Get();
+	return options && options->GetOptionAsInt(m_name, o_value);
+}
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::Read>
+// Look up the value of a string option
+//-----------------------------------------------------------------------------
+bool OptionHandleBase::Read(string* o_value) const
+{
+	Options* options = Options::Get();
+	return options && options->GetOptionAsString(m_name, o_value);
+}
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::BindAll>
+// Copy the final option values into every handle
+//-----------------------------------------------------------------------------
+void OptionHandleBase::BindAll()
+{
+	for (OptionHandleBase* handle = s_first; handle; handle = handle->m_next)
+	{
+		handle->Bind();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// <OptionHandleBase::UnbindAll>
+// Return every handle to looking up its value, as the options are going away
+//-----------------------------------------------------------------------------
+void OptionHandleBase::UnbindAll()
+{
+	for (OptionHandleBase* handle = s_first; handle; handle = handle->m_next)
+	{
+		handle->Unbind();
+	}
+}
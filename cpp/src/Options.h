@@ -252,6 +252,101 @@ namespace OpenZWave
 			bool m_locked;										// If true, the options are final and AddOption can no longer be called.
 			static Options* s_instance;
 	};
+
+	/** \brief Base class of OptionHandle.
+	 *
+	 * Keeps a list of every handle so Options::Lock can fill in their values, and
+	 * Options::Destroy can reset them.
+	 */
+	class OPENZWAVE_EXPORT OptionHandleBase
+	{
+			friend class Options;
+
+		protected:
+			OptionHandleBase(char const* _name);
+			virtual ~OptionHandleBase();
+
+			bool Read(bool* o_value) const;
+			bool Read(int32* o_value) const;
+			bool Read(string* o_value) const;
+
+			char const* m_name;
+			bool m_bound;											// True once the value has been copied from the locked options
+
+		private:
+			virtual void Bind() = 0;
+			virtual void Unbind() = 0;
+
+			static void BindAll();
+			static void UnbindAll();
+
+			OptionHandleBase* m_prev;
+			OptionHandleBase* m_next;
+			static OptionHandleBase* s_first;
+	};
+
+	/** \brief A typed reference to an option, for reading it on hot paths.
+	 *
+	 * Options::GetOptionAsBool and friends look the option up by name every time
+	 * they are called.  An OptionHandle instead takes a copy of the value when the
+	 * options are locked (they cannot change after that), so Get is a plain load.
+	 * Before the options are locked, Get falls back to looking the value up.
+	 *
+	 * Handles are meant to be static objects, created before any threads start:
+	 * \code
+	 * static OptionHandle<bool> s_enforceSecureReception("EnforceSecureReception", true);
+	 * ...
+	 * if (s_enforceSecureReception.Get())
+	 * \endcode
+	 * T may be bool, int32 or string.
+	 */
+	template<typename T> class OptionHandle: public OptionHandleBase
+	{
+		public:
+			/**
+			 * \param _name the name of the option.  It must stay valid for the life of the handle.
+			 * \param _default the value used if the option does not exist, or has a different type.
+			 */
+			OptionHandle(char const* _name, T const& _default) :
+					OptionHandleBase(_name), m_default(_default), m_value(_default)
+			{
+				Options* options = Options::Get();
+				if (options && options->AreLocked())
+				{
+					Bind();
+				}
+			}
+
+			/**
+			 * Get the value of the option.
+			 */
+			T const& Get() const
+			{
+				if (!m_bound)
+				{
+					m_value = m_default;
+					Read(&m_value);
+				}
+				return m_value;
+			}
+
+		private:
+			void Bind()
+			{
+				m_value = m_default;
+				Read(&m_value);
+				m_bound = true;
+			}
+
+			void Unbind()
+			{
+				m_bound = false;
+				m_value = m_default;
+			}
+
+			T const m_default;
+			mutable T m_value;
+	};
 } // namespace OpenZWave
 
 #endif // _Options_H
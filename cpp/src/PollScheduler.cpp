@@ -0,0 +1,319 @@
+//-----------------------------------------------------------------------------
+//
+//	PollScheduler.cpp
+//
+//	Deadline ordered scheduling of polled values
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include "PollScheduler.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::PollScheduler>
+// Constructor
+//-----------------------------------------------------------------------------
+		PollScheduler::PollScheduler() :
+				m_seq(0)
+		{
+			for (int i = 0; i < 256; ++i)
+			{
+				m_asleep[i] = false;
+				m_pollRequested[i] = false;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::~PollScheduler>
+// Destructor
+//-----------------------------------------------------------------------------
+		PollScheduler::~PollScheduler()
+		{
+			for (vector<Entry*>::iterator it = m_heap.begin(); it != m_heap.end(); ++it)
+			{
+				delete *it;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::Add>
+// Add a value to the schedule
+//-----------------------------------------------------------------------------
+		bool PollScheduler::Add(ValueID const& _valueId, uint8 _intensity, int32 _interval, uint64 _now)
+		{
+			map<ValueID, Entry*>::iterator it = m_entries.find(_valueId);
+			if (it != m_entries.end())
+			{
+				it->second->m_intensity = _intensity;
+				it->second->m_interval = _interval;
+				return false;
+			}
+
+			// New values are due straight away, after anything else that is already due
+			Entry* entry = new Entry();
+			entry->m_id = _valueId;
+			entry->m_intensity = _intensity;
+			entry->m_interval = _interval;
+			entry->m_due = _now;
+			entry->m_seq = m_seq++;
+			entry->m_heapIndex = m_heap.size();
+			m_heap.push_back(entry);
+			m_entries[_valueId] = entry;
+			SiftUp(entry->m_heapIndex);
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::Remove>
+// Remove a value from the schedule
+//-----------------------------------------------------------------------------
+		bool PollScheduler::Remove(ValueID const& _valueId)
+		{
+			map<ValueID, Entry*>::iterator it = m_entries.find(_valueId);
+			if (it == m_entries.end())
+			{
+				return false;
+			}
+			Entry* entry = it->second;
+			m_entries.erase(it);
+			HeapRemove(entry);
+			delete entry;
+			return true;
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::RemoveNode>
+// Remove all of a node's values from the schedule
+//-----------------------------------------------------------------------------
+		void PollScheduler::RemoveNode(uint8 _nodeId)
+		{
+			map<ValueID, Entry*>::iterator it = m_entries.begin();
+			while (it != m_entries.end())
+			{
+				if (it->first.GetNodeId() == _nodeId)
+				{
+					HeapRemove(it->second);
+					delete it->second;
+					m_entries.erase(it++);
+				}
+				else
+				{
+					++it;
+				}
+			}
+			m_asleep[_nodeId] = false;
+			m_pollRequested[_nodeId] = false;
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::SetIntensity>
+// Change the intensity of a scheduled value
+//-----------------------------------------------------------------------------
+		void PollScheduler::SetIntensity(ValueID const& _valueId, uint8 _intensity)
+		{
+			map<ValueID, Entry*>::iterator it = m_entries.find(_valueId);
+			if (it != m_entries.end())
+			{
+				it->second->m_intensity = _intensity;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::SetInterval>
+// Change the interval of a scheduled value
+//-----------------------------------------------------------------------------
+		void PollScheduler::SetInterval(ValueID const& _valueId, int32 _interval, uint64 _now)
+		{
+			map<ValueID, Entry*>::iterator it = m_entries.find(_valueId);
+			if (it == m_entries.end())
+			{
+				return;
+			}
+			Entry* entry = it->second;
+			entry->m_interval = _interval;
+			if ((_interval > 0) && (entry->m_due > _now + (uint64) _interval))
+			{
+				Reschedule(entry, _now + _interval);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::SetNodeAsleep>
+// Track whether a node is asleep
+//-----------------------------------------------------------------------------
+		void PollScheduler::SetNodeAsleep(uint8 _nodeId, bool _asleep)
+		{
+			m_asleep[_nodeId] = _asleep;
+			if (!_asleep)
+			{
+				m_pollRequested[_nodeId] = false;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::TimeUntilNextDue>
+// Milliseconds until the next value is due
+//-----------------------------------------------------------------------------
+		int32 PollScheduler::TimeUntilNextDue(uint64 _now) const
+		{
+			if (m_heap.empty())
+			{
+				return -1;
+			}
+			uint64 due = m_heap[0]->m_due;
+			if (due <= _now)
+			{
+				return 0;
+			}
+			uint64 remaining = due - _now;
+			return (remaining > 0x7fffffff) ? 0x7fffffff : (int32) remaining;
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::PopDue>
+// Take the next value that is due and schedule its following poll
+//-----------------------------------------------------------------------------
+		bool PollScheduler::PopDue(uint64 _now, int32 _period, ValueID* _valueId, bool* _asleep)
+		{
+			while (!m_heap.empty() && (m_heap[0]->m_due <= _now))
+			{
+				Entry* entry = m_heap[0];
+				int32 period = (entry->m_interval > 0) ? entry->m_interval : (int32) entry->m_intensity * _period;
+				if (period < 0)
+				{
+					period = 0;
+				}
+
+				uint8 nodeId = entry->m_id.GetNodeId();
+				if (m_asleep[nodeId] && m_pollRequested[nodeId].exchange(true))
+				{
+					// The node has already been flagged for a refresh when it wakes, so there
+					// is nothing to do with this value until then.  Always move it into the
+					// future so that this loop terminates.
+					Reschedule(entry, _now + (period > 0 ? period : 1));
+					continue;
+				}
+
+				Reschedule(entry, _now + period);
+				*_valueId = entry->m_id;
+				*_asleep = m_asleep[nodeId];
+				return true;
+			}
+			return false;
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::Reschedule>
+// Move an entry to a new due time
+//-----------------------------------------------------------------------------
+		void PollScheduler::Reschedule(Entry* _entry, uint64 _due)
+		{
+			_entry->m_due = _due;
+			_entry->m_seq = m_seq++;
+			SiftUp(_entry->m_heapIndex);
+			SiftDown(_entry->m_heapIndex);
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::HeapRemove>
+// Remove an entry from the heap
+//-----------------------------------------------------------------------------
+		void PollScheduler::HeapRemove(Entry* _entry)
+		{
+			size_t index = _entry->m_heapIndex;
+			size_t last = m_heap.size() - 1;
+			if (index != last)
+			{
+				HeapSwap(index, last);
+				m_heap.pop_back();
+				SiftUp(index);
+				SiftDown(index);
+			}
+			else
+			{
+				m_heap.pop_back();
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::HeapSwap>
+// Swap two heap slots, keeping the entries' indices up to date
+//-----------------------------------------------------------------------------
+		void PollScheduler::HeapSwap(size_t _a, size_t _b)
+		{
+			Entry* tmp = m_heap[_a];
+			m_heap[_a] = m_heap[_b];
+			m_heap[_b] = tmp;
+			m_heap[_a]->m_heapIndex = _a;
+			m_heap[_b]->m_heapIndex = _b;
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::SiftUp>
+//-----------------------------------------------------------------------------
+		void PollScheduler::SiftUp(size_t _index)
+		{
+			while (_index > 0)
+			{
+				size_t parent = (_index - 1) / 2;
+				if (!Before(m_heap[_index], m_heap[parent]))
+				{
+					break;
+				}
+				HeapSwap(_index, parent);
+				_index = parent;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <PollScheduler::SiftDown>
+//-----------------------------------------------------------------------------
+		void PollScheduler::SiftDown(size_t _index)
+		{
+			size_t size = m_heap.size();
+			while (true)
+			{
+				size_t left = 2 * _index + 1;
+				if (left >= size)
+				{
+					break;
+				}
+				size_t smallest = left;
+				size_t right = left + 1;
+				if ((right < size) && Before(m_heap[right], m_heap[left]))
+				{
+					smallest = right;
+				}
+				if (!Before(m_heap[smallest], m_heap[_index]))
+				{
+					break;
+				}
+				HeapSwap(_index, smallest);
+				_index = smallest;
+			}
+		}
+	} // namespace Internal
+} // namespace OpenZWave
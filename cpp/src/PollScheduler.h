@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+//
+//	PollScheduler.h
+//
+//	Deadline ordered scheduling of polled values
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _PollScheduler_H
+#define _PollScheduler_H
+
+#include <atomic>
+#include <map>
+#include <vector>
+#include "Defs.h"
+#include "value_classes/ValueID.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \brief Keeps the polled values in a min-heap ordered by the time they are next due.
+		 *
+		 * Each entry is polled either every _intensity full poll periods (the classic
+		 * OpenZWave behaviour) or, if it has one, at its own interval in milliseconds.
+		 * Enabling and disabling a value is O(log n), and finding the next value to poll
+		 * is O(1), so entries that are not yet due cost nothing.
+		 *
+		 * Sleeping nodes are tracked by node id.  Once a poll for a sleeping node has been
+		 * handed out (so the caller can flag the node for a refresh on wake up), further
+		 * polls for that node are rescheduled without being returned, so the caller never
+		 * has to lock the node to find out it is asleep.
+		 *
+		 * The class is not thread safe.  The Driver serializes access with m_pollMutex,
+		 * except for SetNodeAsleep, which only touches atomic flags and so can be called
+		 * from the driver thread while it holds the node lock.
+		 */
+		class PollScheduler
+		{
+			public:
+				PollScheduler();
+				~PollScheduler();
+
+				/**
+				 * Add a value to the schedule, or update it if it is already scheduled.
+				 * \param _valueId the value to poll.
+				 * \param _intensity poll every _intensity poll periods.
+				 * \param _interval if non-zero, poll every _interval milliseconds instead.
+				 * \param _now the current time, from GetMonotonicTime.
+				 * \return true if the value was added, false if it was already scheduled.
+				 */
+				bool Add(ValueID const& _valueId, uint8 _intensity, int32 _interval, uint64 _now);
+
+				/**
+				 * Remove a value from the schedule.
+				 * \return true if the value was scheduled.
+				 */
+				bool Remove(ValueID const& _valueId);
+
+				/**
+				 * Remove every scheduled value belonging to a node, and mark the node awake.
+				 * Called when the node is deleted.
+				 */
+				void RemoveNode(uint8 _nodeId);
+
+				bool Contains(ValueID const& _valueId) const
+				{
+					return m_entries.find(_valueId) != m_entries.end();
+				}
+
+				size_t Size() const
+				{
+					return m_heap.size();
+				}
+
+				bool Empty() const
+				{
+					return m_heap.empty();
+				}
+
+				/**
+				 * Change the intensity of a scheduled value.  Takes effect from its next poll.
+				 */
+				void SetIntensity(ValueID const& _valueId, uint8 _intensity);
+
+				/**
+				 * Change the interval (in milliseconds, or zero to use the intensity) of a
+				 * scheduled value.  The next poll is brought forward if the new interval is shorter.
+				 */
+				void SetInterval(ValueID const& _valueId, int32 _interval, uint64 _now);
+
+				/**
+				 * Mark a node as asleep or awake.  Waking a node makes its polls eligible again.
+				 */
+				void SetNodeAsleep(uint8 _nodeId, bool _asleep);
+
+				/**
+				 * Milliseconds until the next value is due, zero if one is due now, or -1 if
+				 * nothing is scheduled.
+				 */
+				int32 TimeUntilNextDue(uint64 _now) const;
+
+				/**
+				 * Take the next value that is due, and schedule its following poll.
+				 * \param _now the current time, from GetMonotonicTime.
+				 * \param _period the length of one poll period in milliseconds, used for values
+				 * that are polled by intensity.
+				 * \param _valueId filled in with the value to poll.
+				 * \param _asleep set to true if the value's node is asleep.  The caller should flag
+				 * the node to be refreshed when it wakes rather than sending a request.
+				 * \return false if no value is due.
+				 */
+				bool PopDue(uint64 _now, int32 _period, ValueID* _valueId, bool* _asleep);
+
+			private:
+				PollScheduler(PollScheduler const&);					// prevent copy
+				PollScheduler& operator =(PollScheduler const&);		// prevent assignment
+
+				struct Entry
+				{
+						ValueID m_id;
+						uint8 m_intensity;
+						int32 m_interval;
+						uint64 m_due;
+						uint64 m_seq;				// Tie breaker, so values due at the same time are polled in the order they were scheduled
+						size_t m_heapIndex;
+				};
+
+				bool Before(Entry const* _a, Entry const* _b) const
+				{
+					return (_a->m_due < _b->m_due) || ((_a->m_due == _b->m_due) && (_a->m_seq < _b->m_seq));
+				}
+
+				void HeapSwap(size_t _a, size_t _b);
+				void SiftUp(size_t _index);
+				void SiftDown(size_t _index);
+				void HeapRemove(Entry* _entry);
+				void Reschedule(Entry* _entry, uint64 _due);
+
+				map<ValueID, Entry*> m_entries;
+				vector<Entry*> m_heap;
+				uint64 m_seq;
+				atomic<bool> m_asleep[256];
+				atomic<bool> m_pollRequested[256];		// A poll has been handed out for this node since it went to sleep
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_PollScheduler_H
@@ -30,6 +30,7 @@
 
 #include "tinyxml.h"
 #include "Options.h"
+#include "ConfigImage.h"
 #include "Utils.h"
 #include "platform/Log.h"
 
@@ -54,7 +55,7 @@ namespace OpenZWave
 
 			string path = configPath + "SensorMultiLevelCCTypes.xml";
 			TiXmlDocument* pDoc = new TiXmlDocument();
-			if (!pDoc->LoadFile(path.c_str(), TIXML_ENCODING_UTF8))
+			if (!ConfigImage::LoadFile(path, pDoc))
 			{
 				delete pDoc;
 				Log::Write(LogLevel_Warning, "Unable to load SensorMultiLevelCCTypes file %s", path.c_str());
@@ -0,0 +1,142 @@
+//-----------------------------------------------------------------------------
+//
+//	StringPool.cpp
+//
+//	Shared, immutable copies of the strings held by values and translations
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+#include <unordered_map>
+
+#include "StringPool.h"
+#include "platform/Mutex.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace
+		{
+			// A view of the characters of a pooled string, or of a string being
+			// looked up, so that a lookup need not build a string.
+			struct Key
+			{
+					char const* m_str;
+					size_t m_length;
+			};
+
+			struct KeyHash
+			{
+					size_t operator()(Key const& _key) const
+					{
+						// FNV-1a
+						size_t hash = 2166136261u;
+						for (size_t i = 0; i < _key.m_length; ++i)
+						{
+							hash = (hash ^ (uint8) _key.m_str[i]) * 16777619u;
+						}
+						return hash;
+					}
+			};
+
+			struct KeyEqual
+			{
+					bool operator()(Key const& _a, Key const& _b) const
+					{
+						return (_a.m_length == _b.m_length) && !memcmp(_a.m_str, _b.m_str, _a.m_length);
+					}
+			};
+
+			typedef std::unordered_map<Key, string const*, KeyHash, KeyEqual> PoolMap;
+
+			// Neither is ever freed, so pooled strings outlive any static
+			// object that might still refer to them during shutdown.
+			PoolMap& Pool()
+			{
+				static PoolMap* pool = new PoolMap();
+				return *pool;
+			}
+
+			Platform::Mutex& PoolMutex()
+			{
+				static Platform::Mutex* mutex = new Platform::Mutex();
+				return *mutex;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <StringPool::Intern>
+// Return the pooled copy of a string
+//-----------------------------------------------------------------------------
+		string const* StringPool::Intern(char const* _str, size_t _length)
+		{
+			if (!_length)
+			{
+				return Empty();
+			}
+			Key key =
+			{ _str, _length };
+			Platform::Mutex& mutex = PoolMutex();
+			mutex.Lock();
+			PoolMap& pool = Pool();
+			PoolMap::const_iterator it = pool.find(key);
+			string const* str;
+			if (it != pool.end())
+			{
+				str = it->second;
+			}
+			else
+			{
+				str = new string(_str, _length);
+				key.m_str = str->data();
+				pool[key] = str;
+			}
+			mutex.Unlock();
+			return str;
+		}
+
+//-----------------------------------------------------------------------------
+// <StringPool::Empty>
+// The pooled empty string
+//-----------------------------------------------------------------------------
+		string const* StringPool::Empty()
+		{
+			static string const* empty = new string();
+			return empty;
+		}
+
+//-----------------------------------------------------------------------------
+// <StringPool::GetCount>
+// Number of distinct strings in the pool
+//-----------------------------------------------------------------------------
+		size_t StringPool::GetCount()
+		{
+			Platform::Mutex& mutex = PoolMutex();
+			mutex.Lock();
+			size_t count = Pool().size();
+			mutex.Unlock();
+			return count;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,177 @@
+//-----------------------------------------------------------------------------
+//
+//	StringPool.h
+//
+//	Shared, immutable copies of the strings held by values and translations
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _StringPool_H
+#define _StringPool_H
+
+#include <string>
+#include <string.h>
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \brief One copy of each label, unit and help string for the whole process.
+		 *
+		 * The same text is held over and over: every node of a model has the same
+		 * configuration parameter labels and help, and every list value has the same
+		 * item labels as its neighbours.  Interning keeps a single copy of each distinct
+		 * string, which lives until the process exits, and lets equal strings be compared
+		 * by address.
+		 */
+		class OPENZWAVE_EXPORT StringPool
+		{
+			public:
+				/**
+				 * Return the pooled copy of a string, adding it if it is new.  The pointer
+				 * stays valid for the life of the process.  Looking up a string that is
+				 * already pooled does not allocate.  Safe to call from any thread.
+				 */
+				static string const* Intern(char const* _str, size_t _length);
+				static string const* Intern(string const& _str)
+				{
+					return Intern(_str.data(), _str.size());
+				}
+				static string const* Intern(char const* _str)
+				{
+					return Intern(_str, strlen(_str));
+				}
+
+				/**
+				 * The pooled empty string.
+				 */
+				static string const* Empty();
+
+				/**
+				 * Number of distinct strings in the pool.
+				 */
+				static size_t GetCount();
+
+			private:
+				StringPool();
+		};
+
+		/** \brief A handle on a string in the StringPool.
+		 *
+		 * Copying a handle copies a pointer, and two handles are equal only if they refer
+		 * to the same pooled string.  It converts to a string const& so it can stand in
+		 * where a plain string member used to be.
+		 */
+		class OPENZWAVE_EXPORT InternedString
+		{
+			public:
+				InternedString() :
+						m_str(StringPool::Empty())
+				{
+				}
+				InternedString(string const& _str) :
+						m_str(StringPool::Intern(_str))
+				{
+				}
+				InternedString(char const* _str) :
+						m_str(StringPool::Intern(_str))
+				{
+				}
+				InternedString& operator =(string const& _str)
+				{
+					m_str = StringPool::Intern(_str);
+					return *this;
+				}
+				InternedString& operator =(char const* _str)
+				{
+					m_str = StringPool::Intern(_str);
+					return *this;
+				}
+
+				operator string const&() const
+				{
+					return *m_str;
+				}
+				string const& str() const
+				{
+					return *m_str;
+				}
+				char const* c_str() const
+				{
+					return m_str->c_str();
+				}
+				size_t size() const
+				{
+					return m_str->size();
+				}
+				size_t length() const
+				{
+					return m_str->length();
+				}
+				bool empty() const
+				{
+					return m_str->empty();
+				}
+
+				bool operator ==(InternedString const& _other) const
+				{
+					return m_str == _other.m_str;
+				}
+				bool operator !=(InternedString const& _other) const
+				{
+					return m_str != _other.m_str;
+				}
+
+			private:
+				string const* m_str;
+		};
+
+		inline bool operator ==(InternedString const& _lhs, string const& _rhs)
+		{
+			return _lhs.str() == _rhs;
+		}
+		inline bool operator ==(string const& _lhs, InternedString const& _rhs)
+		{
+			return _lhs == _rhs.str();
+		}
+		inline bool operator ==(InternedString const& _lhs, char const* _rhs)
+		{
+			return _lhs.str() == _rhs;
+		}
+		inline bool operator !=(InternedString const& _lhs, string const& _rhs)
+		{
+			return _lhs.str() != _rhs;
+		}
+		inline bool operator !=(string const& _lhs, InternedString const& _rhs)
+		{
+			return _lhs != _rhs.str();
+		}
+		inline bool operator !=(InternedString const& _lhs, char const* _rhs)
+		{
+			return _lhs.str() != _rhs;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_StringPool_H
@@ -26,8 +26,10 @@
 //-----------------------------------------------------------------------------
 
 #include "TimerThread.h"
+#include "BlockPool.h"
 #include "Utils.h"
 #include "platform/Log.h"
+#include "platform/WaitSet.h"
 #include "Driver.h"
 
 namespace OpenZWave
@@ -48,13 +50,45 @@ namespace OpenZWave
 			}
 		}
 
+//-----------------------------------------------------------------------------
+// <GetEventPool>
+// The pool holding every timer event
+//-----------------------------------------------------------------------------
+		static BlockPool& GetEventPool()
+		{
+			static BlockPool* pool = new BlockPool(sizeof(TimerThread::TimerEventEntry), 256);
+			return *pool;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::TimerEventEntry::operator new>
+// Take the memory for an event from the pool
+//-----------------------------------------------------------------------------
+		void* TimerThread::TimerEventEntry::operator new(size_t _size)
+		{
+			if (_size != sizeof(TimerEventEntry))
+			{
+				return ::operator new(_size);
+			}
+			return GetEventPool().Alloc();
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::TimerEventEntry::operator delete>
+// Return the memory for an event to the pool
+//-----------------------------------------------------------------------------
+		void TimerThread::TimerEventEntry::operator delete(void* _p)
+		{
+			GetEventPool().Free(_p);
+		}
+
 //-----------------------------------------------------------------------------
 // <TimerThread::TimerThread>
 // Constructor.
 //-----------------------------------------------------------------------------
 		TimerThread::TimerThread(Driver *_driver) :
 //m_driver( _driver ),
-				m_timerEvent(new Internal::Platform::Event()), m_timerMutex(new Internal::Platform::Mutex()), m_timerTimeout(Internal::Platform::Wait::Timeout_Infinite)
+				m_timerEvent(new Internal::Platform::Event()), m_timerMutex(new Internal::Platform::Mutex()), m_timerTimeout(Internal::Platform::Wait::Timeout_Infinite), m_timerWheel(Internal::GetMonotonicTime()), m_firing(NULL)
 		{
 		}
 
@@ -66,9 +100,14 @@ namespace OpenZWave
 		{
 			{
 				LockGuard LG(m_timerMutex);
-				for (list<TimerEventEntry *>::iterator it = m_timerEventList.begin(); it != m_timerEventList.end(); ++it)
+				TimerWheel::Entry pending;
+				m_timerWheel.RemoveAll(&pending);
+				while (pending.m_next != &pending)
 				{
-					delete (*it);
+					TimerEventEntry* te = static_cast<TimerEventEntry*>(pending.m_next);
+					TimerWheel::Unlink(te);
+					te->instance->m_timerEvents = NULL;
+					delete te;
 				}
 			}
 			m_timerMutex->Release();
@@ -83,9 +122,9 @@ namespace OpenZWave
 		{
 			Log::Write(LogLevel_Info, "Timer: thread starting");
 
-			Internal::Platform::Wait* waitObjects[2];
-			waitObjects[0] = _exitEvent;
-			waitObjects[1] = m_timerEvent;
+			Internal::Platform::WaitSet waitObjects;
+			waitObjects.Add(_exitEvent);
+			waitObjects.Add(m_timerEvent);
 			uint32 count = 2;
 
 			// Initially no timer events so infinite timeout.
@@ -94,7 +133,7 @@ namespace OpenZWave
 			while (1)
 			{
 				Log::Write(LogLevel_Detail, "Timer: waiting with timeout %d ms", m_timerTimeout);
-				int32 res = Internal::Platform::Wait::Multiple(waitObjects, count, m_timerTimeout);
+				int32 res = waitObjects.Multiple(count, m_timerTimeout);
 
 				if (res == 0)
 				{
@@ -105,28 +144,25 @@ namespace OpenZWave
 				else
 				{
 					// Timeout or new entry to timer list.
-					m_timerTimeout = Internal::Platform::Wait::Timeout_Infinite;
-
-					// Go through all waiting actions, and see if any need to be performed.
 					LockGuard LG(m_timerMutex);
-					list<TimerEventEntry *>::iterator it = m_timerEventList.begin();
-					while (it != m_timerEventList.end())
+					TimerWheel::Entry expired;
+					m_timerWheel.Advance(Internal::GetMonotonicTime(), &expired);
+
+					// A callback may cancel events that are still on the expired list, so
+					// take them off one at a time
+					while (expired.m_next != &expired)
 					{
-						int32 tr = (*it)->timestamp.TimeRemaining();
-						if (tr <= 0)
-						{
-							// Expired so perform action and remove from list.
-							Log::Write(LogLevel_Info, "Timer: delayed event");
-							TimerEventEntry *te = *(it++);
-							te->instance->TimerFireEvent(te);
-						}
-						else
-						{
-							// Time remaining.
-							m_timerTimeout = (m_timerTimeout == Internal::Platform::Wait::Timeout_Infinite) ? tr : std::min(m_timerTimeout, tr);
-							++it;
-						}
+						Log::Write(LogLevel_Info, "Timer: delayed event");
+						TimerEventEntry *te = static_cast<TimerEventEntry*>(expired.m_next);
+						m_timerWheel.Remove(te);
+						UnlinkInstance(te);
+						m_firing = te;
+						te->instance->TimerFireEvent(te);
+						m_firing = NULL;
+						delete te;
 					}
+
+					m_timerTimeout = m_timerWheel.GetTimeout(Internal::GetMonotonicTime());
 					m_timerEvent->Reset();
 				}
 			} // while( 1 )
@@ -139,17 +175,45 @@ namespace OpenZWave
 		{
 			Log::Write(LogLevel_Info, "Timer: adding event in %d ms", _milliseconds);
 			TimerEventEntry *te = new TimerEventEntry();
-			te->timestamp.SetTime(_milliseconds);
+			te->m_expiry = Internal::GetMonotonicTime() + ((_milliseconds > 0) ? _milliseconds : 0);
 			te->callback = _callback;
 			te->instance = _instance;
 			te->id = id;
 			// Don't want driver thread and timer thread accessing list at the same time.
 			LockGuard LG(m_timerMutex);
-			m_timerEventList.push_back(te);
+			m_timerWheel.Insert(te);
+			te->instanceNext = _instance->m_timerEvents;
+			if (te->instanceNext)
+			{
+				te->instanceNext->instancePrev = te;
+			}
+			_instance->m_timerEvents = te;
 			m_timerEvent->Set();
 			return te;
 		}
 
+//-----------------------------------------------------------------------------
+// <TimerThread::UnlinkInstance>
+// Remove an event from the list of its Timer
+//-----------------------------------------------------------------------------
+		void TimerThread::UnlinkInstance(TimerEventEntry *te)
+		{
+			if (te->instancePrev)
+			{
+				te->instancePrev->instanceNext = te->instanceNext;
+			}
+			else
+			{
+				te->instance->m_timerEvents = te->instanceNext;
+			}
+			if (te->instanceNext)
+			{
+				te->instanceNext->instancePrev = te->instancePrev;
+			}
+			te->instancePrev = NULL;
+			te->instanceNext = NULL;
+		}
+
 //-----------------------------------------------------------------------------
 // <TimerThread::TimerDelEvent>
 // Delete the Specific Timer
@@ -158,15 +222,67 @@ namespace OpenZWave
 		void TimerThread::TimerDelEvent(TimerEventEntry *te)
 		{
 			LockGuard LG(m_timerMutex);
-			list<TimerEventEntry *>::iterator it = find(m_timerEventList.begin(), m_timerEventList.end(), te);
-			if (it != m_timerEventList.end())
+			if (te == m_firing)
 			{
-				delete ((*it));
-				m_timerEventList.erase(it);
+				// Deleted once its callback returns
+				return;
 			}
-			else
+			m_timerWheel.Remove(te);
+			UnlinkInstance(te);
+			delete te;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::TimerDelEvent>
+// Delete a Timer's event, if it is still pending
+//-----------------------------------------------------------------------------
+		bool TimerThread::TimerDelEvent(Timer *_instance, TimerEventEntry *te)
+		{
+			LockGuard LG(m_timerMutex);
+			if (te == m_firing)
+			{
+				return true;
+			}
+			for (TimerEventEntry* it = _instance->m_timerEvents; it != NULL; it = it->instanceNext)
+			{
+				if (it == te)
+				{
+					TimerDelEvent(te);
+					return true;
+				}
+			}
+			return false;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::TimerDelEvent>
+// Delete a Timer's event by its ID, if it is still pending
+//-----------------------------------------------------------------------------
+		bool TimerThread::TimerDelEvent(Timer *_instance, uint32 id)
+		{
+			LockGuard LG(m_timerMutex);
+			for (TimerEventEntry* it = _instance->m_timerEvents; it != NULL; it = it->instanceNext)
+			{
+				if (it->id == id)
+				{
+					TimerDelEvent(it);
+					return true;
+				}
+			}
+			// Cancelling the event whose callback is running is not an error
+			return (m_firing != NULL) && (m_firing->instance == _instance) && (m_firing->id == id);
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerThread::TimerDelEvents>
+// Delete every event of a Timer
+//-----------------------------------------------------------------------------
+		void TimerThread::TimerDelEvents(Timer *_instance)
+		{
+			LockGuard LG(m_timerMutex);
+			while (_instance->m_timerEvents != NULL)
 			{
-				Log::Write(LogLevel_Warning, "Cant Find TimerEvent to Delete in TimerDelEvent");
+				TimerDelEvent(_instance->m_timerEvents);
 			}
 		}
 
@@ -175,7 +291,7 @@ namespace OpenZWave
 // Constuctor for Timer SubClass with Driver passed in
 //-----------------------------------------------------------------------------
 		Timer::Timer(Driver *_driver) :
-				m_driver(_driver)
+				m_driver(_driver), m_timerEvents(NULL)
 		{
 		}
 		;
@@ -185,7 +301,7 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 
 		Timer::Timer() :
-				m_driver(NULL)
+				m_driver(NULL), m_timerEvents(NULL)
 		{
 
 		}
@@ -211,7 +327,6 @@ namespace OpenZWave
 				TimerThread::TimerEventEntry *te = m_driver->GetTimer()->TimerSetEvent(_milliseconds, _callback, this, id);
 				if (te)
 				{
-					m_timerEventList.push_back(te);
 					return te;
 				}
 				Log::Write(LogLevel_Warning, "Could Not Register Timer Callback");
@@ -232,12 +347,7 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				list<TimerThread::TimerEventEntry *>::iterator it = m_timerEventList.begin();
-				while (it != m_timerEventList.end())
-				{
-					m_driver->GetTimer()->TimerDelEvent((*it));
-					it = m_timerEventList.erase(it);
-				}
+				m_driver->GetTimer()->TimerDelEvents(this);
 			}
 			else
 			{
@@ -261,13 +371,7 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				list<TimerThread::TimerEventEntry *>::iterator it = find(m_timerEventList.begin(), m_timerEventList.end(), te);
-				if (it != m_timerEventList.end())
-				{
-					m_driver->GetTimer()->TimerDelEvent((*it));
-					m_timerEventList.erase(it);
-				}
-				else
+				if (!m_driver->GetTimer()->TimerDelEvent(this, te))
 				{
 					Log::Write(LogLevel_Warning, "Cant Find TimerEvent to Delete in TimerDelEvent");
 				}
@@ -288,16 +392,10 @@ namespace OpenZWave
 		{
 			if (m_driver)
 			{
-				for (list<TimerThread::TimerEventEntry *>::iterator it = m_timerEventList.begin(); it != m_timerEventList.end(); it++)
+				if (!m_driver->GetTimer()->TimerDelEvent(this, id))
 				{
-					if ((*it)->id == id)
-					{
-						m_driver->GetTimer()->TimerDelEvent((*it));
-						m_timerEventList.erase(it);
-						return;
-					}
+					Log::Write(LogLevel_Warning, "Cant Find TimerEvent %d to Delete in TimerDelEvent", id);
 				}
-				Log::Write(LogLevel_Warning, "Cant Find TimerEvent %d to Delete in TimerDelEvent", id);
 				return;
 			}
 			else
@@ -315,7 +413,6 @@ namespace OpenZWave
 		void Timer::TimerFireEvent(TimerThread::TimerEventEntry *te)
 		{
 			te->callback(te->id);
-			TimerDelEvent(te);
 		}
 	} // namespace Internal
 } // namespace OpenZWave
@@ -42,6 +42,7 @@ using std::tr1::function;
 #include "platform/Event.h"
 #include "platform/Mutex.h"
 #include "platform/TimeStamp.h"
+#include "TimerWheel.h"
 
 namespace OpenZWave
 {
@@ -72,12 +73,25 @@ namespace OpenZWave
 				 */
 				~TimerThread();
 
-				struct TimerEventEntry
+				/** A pending event.  It is linked into the timer wheel, and into the list of
+				 * events set by its Timer, so either can drop it without a search.
+				 */
+				struct TimerEventEntry: public TimerWheel::Entry
 				{
+						TimerEventEntry() :
+								instance(NULL), id(0), instancePrev(NULL), instanceNext(NULL)
+						{
+						}
+
+						// Entries come from a pool, so setting a timer does not allocate
+						static void* operator new(size_t _size);
+						static void operator delete(void* _p);
+
 						Timer *instance;
-						Internal::Platform::TimeStamp timestamp;
 						TimerCallback callback;
 						uint32 id;
+						TimerEventEntry* instancePrev;
+						TimerEventEntry* instanceNext;
 				};
 
 				/**
@@ -104,18 +118,33 @@ namespace OpenZWave
 				 */
 				void TimerDelEvent(TimerEventEntry *);
 
+				/**
+				 * Remove an event set by a Timer, if it is still pending.
+				 * \return false if the Timer has no such event.
+				 */
+				bool TimerDelEvent(Timer *_instance, TimerEventEntry *te);
+				bool TimerDelEvent(Timer *_instance, uint32 id);
+
+				/**
+				 * Remove every event set by a Timer.
+				 */
+				void TimerDelEvents(Timer *_instance);
+
+				void UnlinkInstance(TimerEventEntry *te);					// Remove an event from its Timer's list
+
 				/**
 				 * Main class entry point for the timer thread. Contains the main timer loop.
 				 * \param _exitEvent Exit event indicating the thread should exit
 				 */
 				void TimerThreadProc(Internal::Platform::Event* _exitEvent);
 
-				/** A list of upcoming timer events */
-				list<TimerEventEntry *> m_timerEventList;
-
 				Internal::Platform::Event* m_timerEvent;   // Event to signal new timed action requested
 				Internal::Platform::Mutex* m_timerMutex;   // Serialize access to class members
 				int32 m_timerTimeout; // Time in milliseconds to wait until next event
+
+				/** The upcoming timer events, on the monotonic clock */
+				TimerWheel m_timerWheel;
+				TimerEventEntry* m_firing;					// The event whose callback is running
 		};
 
 		/**
@@ -126,6 +155,7 @@ namespace OpenZWave
 
 		class OPENZWAVE_EXPORT Timer
 		{
+				friend class TimerThread;
 			public:
 				/**
 				 * \brief Constructor with the _driver this instance is associated with
@@ -175,7 +205,7 @@ namespace OpenZWave
 				void TimerFireEvent(TimerThread::TimerEventEntry *te);
 			private:
 				Driver* m_driver;
-				list<TimerThread::TimerEventEntry *> m_timerEventList;
+				TimerThread::TimerEventEntry* m_timerEvents;	// The pending events set by this instance
 
 		};
 	} // namespace Internal
@@ -0,0 +1,289 @@
+//-----------------------------------------------------------------------------
+//
+//	TimerWheel.cpp
+//
+//	Hierarchical timing wheel for the TimerThread
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include "TimerWheel.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::TimerWheel>
+// Constructor
+//-----------------------------------------------------------------------------
+		TimerWheel::TimerWheel(uint64 _now) :
+				m_time(_now), m_count(0)
+		{
+			for (int level = 0; level < c_levels; ++level)
+			{
+				m_occupied[level] = 0;
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Unlink>
+// Remove an entry from whatever list it is in
+//-----------------------------------------------------------------------------
+		void TimerWheel::Unlink(Entry* _entry)
+		{
+			_entry->m_prev->m_next = _entry->m_next;
+			_entry->m_next->m_prev = _entry->m_prev;
+			_entry->m_prev = _entry;
+			_entry->m_next = _entry;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Append>
+// Add an entry to the end of a list
+//-----------------------------------------------------------------------------
+		void TimerWheel::Append(Entry* _head, Entry* _entry)
+		{
+			_entry->m_prev = _head->m_prev;
+			_entry->m_next = _head;
+			_head->m_prev->m_next = _entry;
+			_head->m_prev = _entry;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Insert>
+// Add a timer
+//-----------------------------------------------------------------------------
+		void TimerWheel::Insert(Entry* _entry)
+		{
+			++m_count;
+
+			// The current slot has already been handled, so anything due goes in the next
+			Place(_entry, m_time + 1);
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Place>
+// Put a timer in the slot for its expiry, or for _earliest if that is later
+//-----------------------------------------------------------------------------
+		void TimerWheel::Place(Entry* _entry, uint64 _earliest)
+		{
+			uint64 expiry = (_entry->m_expiry > _earliest) ? _entry->m_expiry : _earliest;
+			uint64 delta = expiry - m_time;
+
+			int level = 0;
+			while ((level < c_levels - 1) && (delta >= ((uint64) 1 << (c_bits * (level + 1)))))
+			{
+				++level;
+			}
+			if (delta >= ((uint64) 1 << (c_bits * c_levels)))
+			{
+				// Too far ahead for the outermost wheel.  Wait in its last slot, and be
+				// placed again when that comes round.
+				expiry = m_time + ((uint64) 1 << (c_bits * c_levels)) - 1;
+			}
+
+			int slot = (int) (expiry >> (c_bits * level)) & (c_slots - 1);
+			_entry->m_level = (uint8) level;
+			_entry->m_slot = (uint8) slot;
+			Append(&m_wheel[level][slot], _entry);
+			m_occupied[level] |= (uint64) 1 << slot;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Remove>
+// Cancel a timer
+//-----------------------------------------------------------------------------
+		void TimerWheel::Remove(Entry* _entry)
+		{
+			if (!_entry->IsQueued())
+			{
+				return;
+			}
+			if (_entry->m_level < c_levels)
+			{
+				Entry* head = &m_wheel[_entry->m_level][_entry->m_slot];
+				Unlink(_entry);
+				if (head->m_next == head)
+				{
+					m_occupied[_entry->m_level] &= ~((uint64) 1 << _entry->m_slot);
+				}
+				--m_count;
+			}
+			else
+			{
+				Unlink(_entry);
+			}
+			_entry->m_level = c_notQueued;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Cascade>
+// Redistribute the timers in a slot of an outer wheel
+//-----------------------------------------------------------------------------
+		void TimerWheel::Cascade(int _level, int _slot)
+		{
+			Entry* head = &m_wheel[_level][_slot];
+			m_occupied[_level] &= ~((uint64) 1 << _slot);
+			while (head->m_next != head)
+			{
+				Entry* entry = head->m_next;
+				Unlink(entry);
+				Place(entry, m_time);
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::Advance>
+// Move the wheel forward, collecting the timers that are due
+//-----------------------------------------------------------------------------
+		void TimerWheel::Advance(uint64 _now, Entry* o_expired)
+		{
+			while (m_time < _now)
+			{
+				// With the inner wheels empty, nothing happens until the next turn of the
+				// first one that is not, so skip straight there
+				uint64 mask = 0;
+				for (int level = 0; (level < c_levels - 1) && !m_occupied[level]; ++level)
+				{
+					mask = (mask << c_bits) | (c_slots - 1);
+				}
+				if (mask)
+				{
+					if ((m_time | mask) >= _now)
+					{
+						m_time = _now;
+						break;
+					}
+					m_time |= mask;
+				}
+				++m_time;
+
+				// At the turn of a wheel, redistribute the next slot of the one outside it,
+				// working inwards so that timers can move down more than one level
+				int top = 0;
+				while ((top < c_levels - 1) && !(m_time & (((uint64) 1 << (c_bits * (top + 1))) - 1)))
+				{
+					++top;
+				}
+				for (int level = top; level > 0; --level)
+				{
+					Cascade(level, (int) (m_time >> (c_bits * level)) & (c_slots - 1));
+				}
+
+				int slot = (int) m_time & (c_slots - 1);
+				Entry* head = &m_wheel[0][slot];
+				if (head->m_next != head)
+				{
+					m_occupied[0] &= ~((uint64) 1 << slot);
+					while (head->m_next != head)
+					{
+						Entry* entry = head->m_next;
+						Unlink(entry);
+						entry->m_level = c_expired;
+						Append(o_expired, entry);
+						--m_count;
+					}
+				}
+			}
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::NextSlot>
+// How many slots after _from the next occupied one is (1 to 64), or 0 if none
+//-----------------------------------------------------------------------------
+		int TimerWheel::NextSlot(uint64 _occupied, int _from)
+		{
+			if (!_occupied)
+			{
+				return 0;
+			}
+			for (int i = 1; i <= c_slots; ++i)
+			{
+				if (_occupied & ((uint64) 1 << ((_from + i) & (c_slots - 1))))
+				{
+					return i;
+				}
+			}
+			return 0;
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::GetTimeout>
+// How long until Advance next needs to be called
+//-----------------------------------------------------------------------------
+		int32 TimerWheel::GetTimeout(uint64 _now) const
+		{
+			if (!m_count)
+			{
+				return -1;
+			}
+
+			// The first timer on the inner wheel expires, or the next occupied slot of an
+			// outer wheel has to be redistributed, whichever is sooner
+			uint64 next = 0;
+			for (int level = 0; level < c_levels; ++level)
+			{
+				int shift = c_bits * level;
+				int distance = NextSlot(m_occupied[level], (int) (m_time >> shift) & (c_slots - 1));
+				if (distance)
+				{
+					uint64 when = ((m_time >> shift) + distance) << shift;
+					if (!next || (when < next))
+					{
+						next = when;
+					}
+				}
+			}
+			if (next <= _now)
+			{
+				return 0;
+			}
+			return (next - _now > 0x7fffffff) ? 0x7fffffff : (int32) (next - _now);
+		}
+
+//-----------------------------------------------------------------------------
+// <TimerWheel::RemoveAll>
+// Move every pending timer to a list
+//-----------------------------------------------------------------------------
+		void TimerWheel::RemoveAll(Entry* o_list)
+		{
+			for (int level = 0; level < c_levels; ++level)
+			{
+				for (int slot = 0; slot < c_slots; ++slot)
+				{
+					Entry* head = &m_wheel[level][slot];
+					while (head->m_next != head)
+					{
+						Entry* entry = head->m_next;
+						Unlink(entry);
+						entry->m_level = c_expired;
+						Append(o_list, entry);
+					}
+				}
+				m_occupied[level] = 0;
+			}
+			m_count = 0;
+		}
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+//
+//	TimerWheel.h
+//
+//	Hierarchical timing wheel for the TimerThread
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _TimerWheel_H
+#define _TimerWheel_H
+
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		/** \brief Pending timers, arranged so that adding, cancelling and expiring one
+		 * take constant time however many there are.
+		 *
+		 * Times are in milliseconds, on the clock of Internal::GetMonotonicTime.
+		 * There are four wheels of 64 slots: the first holds timers due in the next 64 ms,
+		 * one slot per millisecond; each of the others holds timers due further ahead,
+		 * one slot for each turn of the wheel below it.  As time reaches a slot of an
+		 * outer wheel, its timers are redistributed into the inner ones.  Timers beyond
+		 * the outermost wheel (about 4.6 hours) wait in its last slot and are redistributed
+		 * as they come round.
+		 *
+		 * The wheel does not lock or allocate; entries are embedded in the caller's
+		 * objects.
+		 */
+		class OPENZWAVE_EXPORT TimerWheel
+		{
+			public:
+				/** \brief A timer in the wheel, or the head of a list of them. */
+				struct Entry
+				{
+						Entry() :
+								m_prev(this), m_next(this), m_expiry(0), m_level(c_notQueued), m_slot(0)
+						{
+						}
+
+						bool IsQueued() const
+						{
+							return m_level != c_notQueued;
+						}
+
+						Entry* m_prev;
+						Entry* m_next;
+						uint64 m_expiry;			// When the timer is due
+						uint8 m_level;				// Where it is: a wheel, c_expired or c_notQueued
+						uint8 m_slot;
+				};
+
+				/**
+				 * \param _now The current time, from which the wheel starts.
+				 */
+				TimerWheel(uint64 _now);
+
+				/**
+				 * Add a timer.  Timers that are already due expire at the next Advance.
+				 * \param _entry An entry that is not queued, with m_expiry set.
+				 */
+				void Insert(Entry* _entry);
+
+				/**
+				 * Cancel a timer, whether still pending or already moved to an expired list.
+				 */
+				void Remove(Entry* _entry);
+
+				/**
+				 * Move the wheel forward to _now.
+				 * \param o_expired The head of a list to which every timer that is now due
+				 * is appended, in order of expiry.  They may still be passed to Remove.
+				 */
+				void Advance(uint64 _now, Entry* o_expired);
+
+				/**
+				 * How long until Advance next needs to be called.
+				 * \return The time in ms, or -1 if there are no timers.
+				 */
+				int32 GetTimeout(uint64 _now) const;
+
+				/**
+				 * Move every pending timer to a list, leaving the wheel empty.
+				 */
+				void RemoveAll(Entry* o_list);
+
+				uint32 GetCount() const
+				{
+					return m_count;
+				}
+
+				/**
+				 * Remove an entry from whatever list it is in.
+				 */
+				static void Unlink(Entry* _entry);
+				static void Append(Entry* _head, Entry* _entry);
+
+				static uint8 const c_expired = 0xfe;
+				static uint8 const c_notQueued = 0xff;
+
+			private:
+				TimerWheel(TimerWheel const&);					// prevent copy
+				TimerWheel& operator =(TimerWheel const&);		// prevent assignment
+
+				static int const c_bits = 6;
+				static int const c_slots = 1 << c_bits;
+				static int const c_levels = 4;
+
+				void Place(Entry* _entry, uint64 _earliest);
+				void Cascade(int _level, int _slot);
+				static int NextSlot(uint64 _occupied, int _from);
+
+				Entry m_wheel[c_levels][c_slots];
+				uint64 m_occupied[c_levels];		// Bit for each slot that holds any timers
+				uint64 m_time;						// Everything due at or before this has expired
+				uint32 m_count;
+		};
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_TimerWheel_H
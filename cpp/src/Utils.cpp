@@ -28,6 +28,7 @@
 #include "Defs.h"
 #include "Utils.h"
 #include <functional>
+#include <chrono>
 
 namespace OpenZWave
 {
@@ -204,6 +205,15 @@ namespace OpenZWave
 					}
 			}
 		}
+
+//-----------------------------------------------------------------------------
+// <OpenZWave::GetMonotonicTime>
+// Milliseconds from a monotonic clock
+//-----------------------------------------------------------------------------
+		uint64 GetMonotonicTime()
+		{
+			return (uint64) std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
 	} // namespace Internal
 } // namespace OpenZWave
 
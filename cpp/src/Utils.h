@@ -29,6 +29,7 @@
 #define _Utils_H
 
 #include "platform/Mutex.h"
+#include "platform/SharedMutex.h"
 #include "platform/Log.h"
 
 #include <string>
@@ -150,12 +151,61 @@ namespace OpenZWave
 				Internal::Platform::Mutex* _ref;
 		};
 
+		/** \brief Holds a SharedMutex in shared mode for the lifetime of the guard.
+		 */
+		struct SharedLockGuard
+		{
+				SharedLockGuard(Internal::Platform::SharedMutex* mutex) :
+						_ref(mutex)
+				{
+					_ref->LockShared();
+				}
+
+				~SharedLockGuard()
+				{
+					_ref->UnlockShared();
+				}
+			private:
+				SharedLockGuard(const SharedLockGuard&);
+				SharedLockGuard& operator =(SharedLockGuard const&);
+
+				Internal::Platform::SharedMutex* _ref;
+		};
+
+		/** \brief Holds a SharedMutex in exclusive mode for the lifetime of the guard.
+		 */
+		struct ExclusiveLockGuard
+		{
+				ExclusiveLockGuard(Internal::Platform::SharedMutex* mutex) :
+						_ref(mutex)
+				{
+					_ref->Lock();
+				}
+
+				~ExclusiveLockGuard()
+				{
+					_ref->Unlock();
+				}
+			private:
+				ExclusiveLockGuard(const ExclusiveLockGuard&);
+				ExclusiveLockGuard& operator =(ExclusiveLockGuard const&);
+
+				Internal::Platform::SharedMutex* _ref;
+		};
+
 		string ozwdirname(string);
 
 		string intToString(int x);
 
 		const char* rssi_to_string(uint8 _data);
 
+		/**
+		 * Milliseconds from a monotonic clock.  Use this for deadlines and intervals,
+		 * as it does not jump when the wall clock is changed.
+		 * \return milliseconds since an arbitrary fixed point.
+		 */
+		uint64 GetMonotonicTime();
+
 #ifndef WIN32
 #ifndef WINRT
 #ifdef DEBUG
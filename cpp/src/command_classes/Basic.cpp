@@ -253,6 +253,7 @@ namespace OpenZWave
 					Log::Write(LogLevel_Info, GetNodeId(), "Basic::Set - Setting node %d to level %d", GetNodeId(), value->GetValue());
 					Msg* msg = new Msg("BasicCmd_Set", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
 					msg->SetInstance(this, _value.GetID().GetInstance());
+					msg->SetCoalesceKey(GetCommandClassId(), ValueID_Index_Basic::Set);
 					msg->Append(GetNodeId());
 					msg->Append(3);
 					msg->Append(GetCommandClassId());
@@ -260,6 +260,7 @@ namespace OpenZWave
 				Log::Write(LogLevel_Info, GetNodeId(), "Configuration::Set - Parameter=%d, Value=%d Size=%d", _parameter, _value, _size);
 
 				Msg* msg = new Msg("ConfigurationCmd_Set", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
+				msg->SetCoalesceKey(GetCommandClassId(), _parameter);
 				msg->Append(GetNodeId());
 				msg->Append(4 + _size);
 				msg->Append(GetCommandClassId());
@@ -267,45 +267,30 @@ namespace OpenZWave
 				if (GetNodeUnsafe()->getConfigPath().size() == 0)
 					return false;
 
-				string configPath;
-				Options::Get()->GetOptionAsString("ConfigPath", &configPath);
-
-				string filename = configPath + GetNodeUnsafe()->getConfigPath();
-
-				TiXmlDocument* doc = new TiXmlDocument();
-				Log::Write(LogLevel_Info, GetNodeId(), "  Opening config param file %s", filename.c_str());
-				if (!doc->LoadFile(filename.c_str(), TIXML_ENCODING_UTF8))
-				{
-					delete doc;
-					Log::Write(LogLevel_Info, GetNodeId(), "Unable to find or load Config Param file %s", filename.c_str());
-					return false;
-				}
-				doc->SetUserData((void *) filename.c_str());
-				/* make sure it has the right xmlns */
-				TiXmlElement *product = doc->RootElement();
-				char const *xmlns = product->Attribute("xmlns");
-				if (xmlns && strcmp(xmlns, "https://github.com/OpenZWave/open-zwave"))
+				ManufacturerSpecificDB* mfs = GetDriver()->GetManufacturerSpecificDB();
+				Log::Write(LogLevel_Info, GetNodeId(), "  Opening config param file %s", GetNodeUnsafe()->getConfigPath().c_str());
+				DeviceConfig* config = mfs->GetDeviceConfig(GetNodeUnsafe()->getConfigPath());
+				if (!config)
 				{
-					delete doc;
-					Log::Write(LogLevel_Warning, GetNodeId(), "Invalid XML Namespace in %s - Ignoring", filename.c_str());
 					return false;
 				}
 
+				TiXmlElement const* product = config->GetRoot();
 				Node::QueryStage qs = GetNodeUnsafe()->GetCurrentQueryStage();
 				if (qs == Node::QueryStage_ManufacturerSpecific1)
 				{
-					GetNodeUnsafe()->ReadDeviceProtocolXML(doc->RootElement());
+					GetNodeUnsafe()->ReadDeviceProtocolXML(product);
 				}
 				else
 				{
 					if (!GetNodeUnsafe()->m_manufacturerSpecificClassReceived)
 					{
-						GetNodeUnsafe()->ReadDeviceProtocolXML(doc->RootElement());
+						GetNodeUnsafe()->ReadDeviceProtocolXML(product);
 					}
 				}
-				GetNodeUnsafe()->ReadCommandClassesXML(doc->RootElement());
-				GetNodeUnsafe()->ReadMetaDataFromXML(doc->RootElement());
-				delete doc;
+				GetNodeUnsafe()->ReadCommandClassesXML(product);
+				GetNodeUnsafe()->ReadMetaDataFromXML(product);
+				mfs->ReleaseDeviceConfig(config);
 				return true;
 			}
 
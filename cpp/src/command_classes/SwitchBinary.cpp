@@ -216,6 +216,7 @@ namespace OpenZWave
 				Log::Write(LogLevel_Info, nodeId, "SwitchBinary::Set - Setting to %s", _state ? "On" : "Off");
 				Msg* msg = new Msg("SwitchBinaryCmd_Set", nodeId, REQUEST, FUNC_ID_ZW_SEND_DATA, true);
 				msg->SetInstance(this, _instance);
+				msg->SetCoalesceKey(GetCommandClassId(), ValueID_Index_SwitchBinary::Level);
 				msg->Append(nodeId);
 
 				if (GetVersion() >= 2)
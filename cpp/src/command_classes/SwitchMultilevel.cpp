@@ -397,6 +397,7 @@ namespace OpenZWave
 				Log::Write(LogLevel_Info, GetNodeId(), "SwitchMultilevel::Set - Setting to level %d", _level);
 				Msg* msg = new Msg("SwitchMultilevelCmd_Set", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
 				msg->SetInstance(this, _instance);
+				msg->SetCoalesceKey(GetCommandClassId(), ValueID_Index_SwitchMultiLevel::Level);
 				msg->Append(GetNodeId());
 
 				if (GetVersion() >= 2)
@@ -356,6 +356,7 @@ namespace OpenZWave
 
 					Msg* msg = new Msg("ThermostatModeCmd_Set", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
 					msg->SetInstance(this, _value.GetID().GetInstance());
+					msg->SetCoalesceKey(GetCommandClassId(), ValueID_Index_ThermostatMode::Mode);
 					msg->Append(GetNodeId());
 					msg->Append(3);
 					msg->Append(GetCommandClassId());
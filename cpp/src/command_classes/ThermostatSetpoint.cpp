@@ -293,6 +293,7 @@ namespace OpenZWave
 
 					Msg* msg = new Msg("ThermostatSetpointCmd_Set", GetNodeId(), REQUEST, FUNC_ID_ZW_SEND_DATA, true);
 					msg->SetInstance(this, _value.GetID().GetInstance());
+					msg->SetCoalesceKey(GetCommandClassId(), _value.GetID().GetIndex());
 					msg->Append(GetNodeId());
 					msg->Append(4 + GetAppendValueSize(value->GetValue(), setpointminsize, setpointprecision));
 					msg->Append(GetCommandClassId());
@@ -328,6 +328,7 @@ namespace OpenZWave
 					}
 
 					m_awake = _state;
+					GetDriver()->SetNodeAsleepForPolling(GetNodeId(), !m_awake);
 					Log::Write(LogLevel_Info, GetNodeId(), "  Node %d has been marked as %s", GetNodeId(), m_awake ? "awake" : "asleep");
 					Notification* notification = new Notification(Notification::Type_Notification);
 					notification->SetHomeAndNodeIds(GetHomeId(), GetNodeId());
@@ -366,13 +367,19 @@ namespace OpenZWave
 				// we delete it.  This is to prevent duplicates building up if the
 				// device does not wake up very often.  Deleting the original and
 				// adding the copy to the end avoids problems with the order of
-				// commands such as on and off.
-				list<Driver::MsgQueueItem>::iterator it = m_pendingQueue.begin();
+				// commands such as on and off.  An older Set of the same value is
+				// superseded by the new one, so it is removed in the same way.
+				Driver::MsgQueueList::iterator it = m_pendingQueue.begin();
 				while (it != m_pendingQueue.end())
 				{
 					Driver::MsgQueueItem const& item = *it;
-					if (item == _item)
+					bool supersededSet = (Driver::MsgQueueCmd_SendMsg == item.m_command) && (Driver::MsgQueueCmd_SendMsg == _item.m_command) && item.m_msg->IsSameValueSet(*_item.m_msg);
+					if (supersededSet || (item == _item))
 					{
+						if (supersededSet)
+						{
+							GetDriver()->m_coalescedSets++;
+						}
 						// Duplicate found
 						if (Driver::MsgQueueCmd_SendMsg == item.m_command)
 						{
@@ -406,7 +413,7 @@ namespace OpenZWave
 				m_awake = true;
 				bool reloading = false;
 				m_mutex->Lock();
-				list<Driver::MsgQueueItem>::iterator it = m_pendingQueue.begin();
+				Driver::MsgQueueList::iterator it = m_pendingQueue.begin();
 				while (it != m_pendingQueue.end())
 				{
 					Driver::MsgQueueItem const& item = *it;
@@ -114,7 +114,7 @@ namespace OpenZWave
 					WakeUp(uint32 const _homeId, uint8 const _nodeId);
 
 					Internal::Platform::Mutex* m_mutex;			// Serialize access to the pending queue
-					list<Driver::MsgQueueItem> m_pendingQueue;		// Messages waiting to be sent when the device wakes up
+					Driver::MsgQueueList m_pendingQueue;		// Messages waiting to be sent when the device wakes up
 					bool m_awake;
 					bool m_pollRequired;
 					uint32 m_interval;
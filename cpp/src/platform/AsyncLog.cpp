@@ -0,0 +1,822 @@
+//-----------------------------------------------------------------------------
+//
+//	AsyncLog.cpp
+//
+//	Log backend that formats and writes messages on its own thread
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include "platform/AsyncLog.h"
+#include "platform/LogFormatter.h"
+#include "platform/Event.h"
+#include "platform/Mutex.h"
+#include "platform/Thread.h"
+#include "platform/WaitSet.h"
+#include "Utils.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			namespace
+			{
+				uint32 const c_ringSize = 256 * 1024;		// Bytes in each thread's ring.  Must be a power of two
+				uint32 const c_maxRings = 64;				// Threads beyond this many lose their messages
+				uint32 const c_maxText = 1024;				// Longest format (or preformatted line) we keep
+				uint32 const c_maxArgs = 2048;				// Most bytes of encoded arguments we keep
+				uint32 const c_queueSize = 500;				// Messages kept for a dump, as in the standard log
+				int32 const c_flushInterval = 25;			// Milliseconds between passes of the log thread
+				uint32 const c_maxWait = 200;				// Milliseconds a serious message waits for room in a full ring
+
+				enum RecordKind
+				{
+					Kind_Pad = 0,							// Unused space at the end of the ring
+					Kind_Message,							// Format and encoded arguments
+					Kind_Text,								// Line formatted by the caller
+					Kind_Dump,
+					Kind_Clear,
+					Kind_FileName
+				};
+			}
+
+			// Every record in a ring starts with one of these, and is padded to a multiple of 8 bytes
+			struct AsyncLog::RecordHeader
+			{
+					uint32 m_size;							// Bytes the record takes in the ring
+					uint8 m_kind;
+					uint8 m_level;
+					uint8 m_nodeId;
+					uint8 m_reserved;
+					uint64 m_sequence;
+					uint64 m_time;
+					uint64 m_threadId;
+					uint32 m_textLength;					// Including the terminating NUL
+					uint32 m_argsLength;
+			};
+
+			/** Single producer, single consumer byte ring.  Only the thread that claimed it
+			 * writes records and moves m_head; only the log thread reads records and moves
+			 * m_tail.  Records never wrap around the end of the buffer.
+			 */
+			class AsyncLog::Ring
+			{
+				public:
+					Ring() :
+							m_head(0), m_tail(0), m_dropped(0), m_inUse(false)
+					{
+					}
+
+					bool Push(RecordHeader* _header, char const* _text, uint32 const _textLength, uint8 const* _args, uint32 const _argsLength)
+					{
+						uint32 size = (uint32) ((sizeof(RecordHeader) + _textLength + _argsLength + 7) & ~7);
+						uint64 head = m_head.load(std::memory_order_relaxed);
+						uint64 tail = m_tail.load(std::memory_order_acquire);
+						uint32 offset = (uint32) (head & (c_ringSize - 1));
+						uint32 toEnd = c_ringSize - offset;
+						uint32 needed = (size > toEnd) ? (size + toEnd) : size;
+						if ((head - tail) + needed > c_ringSize)
+						{
+							return false;
+						}
+
+						uint8* buffer = (uint8*) m_buffer;
+						if (size > toEnd)
+						{
+							// Skip to the start of the buffer.  There are always at least 8 bytes
+							// left, which is enough for the size and kind.
+							RecordHeader* pad = (RecordHeader*) &buffer[offset];
+							pad->m_size = toEnd;
+							pad->m_kind = Kind_Pad;
+							head += toEnd;
+							offset = 0;
+						}
+
+						_header->m_size = size;
+						_header->m_textLength = _textLength;
+						_header->m_argsLength = _argsLength;
+						memcpy(&buffer[offset], _header, sizeof(RecordHeader));
+						memcpy(&buffer[offset + sizeof(RecordHeader)], _text, _textLength);
+						if (_argsLength > 0)
+						{
+							memcpy(&buffer[offset + sizeof(RecordHeader) + _textLength], _args, _argsLength);
+						}
+						m_head.store(head + size, std::memory_order_release);
+						return true;
+					}
+
+					RecordHeader const* At(uint64 const _position) const
+					{
+						return (RecordHeader const*) &((uint8 const*) m_buffer)[_position & (c_ringSize - 1)];
+					}
+
+					uint64 GetUsed() const
+					{
+						return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed);
+					}
+
+					std::atomic<uint64> m_head;
+					uint8 m_padding[64];					// Keep the producer and consumer positions on separate cache lines
+					std::atomic<uint64> m_tail;
+					std::atomic<uint32> m_dropped;
+					std::atomic<bool> m_inUse;
+					uint64 m_buffer[c_ringSize / sizeof(uint64)];
+			};
+
+			std::atomic<uint32> AsyncLog::s_generation(0);
+			thread_local AsyncLog::RingHandle AsyncLog::s_ringHandle;
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::RingHandle::RingHandle>
+//	Constructor
+//-----------------------------------------------------------------------------
+			AsyncLog::RingHandle::RingHandle() :
+					m_log( NULL), m_generation(0), m_ring( NULL), m_threadId(0)
+			{
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::RingHandle::~RingHandle>
+//	Give the ring back when the thread exits, unless the log it came from has
+//	been destroyed
+//-----------------------------------------------------------------------------
+			AsyncLog::RingHandle::~RingHandle()
+			{
+				if (m_ring && (m_generation == s_generation.load(std::memory_order_acquire)))
+				{
+					m_ring->m_inUse.store(false, std::memory_order_release);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::AsyncLog>
+//	Constructor
+//-----------------------------------------------------------------------------
+			AsyncLog::AsyncLog(string const& _filename, bool const _bAppendLog, bool const _bConsoleOutput, bool const _bBinary, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger) :
+					m_sequence(0), m_ringCount(0), m_dropped(0), m_rings(c_maxRings, (Ring*) NULL), m_ringMutex(new Internal::Platform::Mutex()), m_wakeEvent(new Internal::Platform::Event()), m_thread(new Internal::Platform::Thread("log")), m_filename(_filename), m_bConsoleOutput(_bConsoleOutput), m_bAppendLog(_bAppendLog), m_bBinary(_bBinary), m_file( NULL)
+			{
+				m_generation = s_generation.fetch_add(1) + 1;
+				SetLoggingState(_saveLevel, _queueLevel, _dumpTrigger);
+				OpenFile(m_bAppendLog);
+				m_thread->Start(AsyncLog::LogThreadEntryPoint, this);
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::~AsyncLog>
+//	Destructor
+//-----------------------------------------------------------------------------
+			AsyncLog::~AsyncLog()
+			{
+				m_thread->Stop();
+				m_thread->Release();
+
+				// Write out whatever was logged while the thread was stopping
+				Drain();
+
+				s_generation.fetch_add(1);
+				uint32 count = m_ringCount.load(std::memory_order_acquire);
+				for (uint32 i = 0; i < count; ++i)
+				{
+					delete m_rings[i];
+				}
+
+				if (m_file)
+				{
+					fclose(m_file);
+				}
+				m_wakeEvent->Release();
+				m_ringMutex->Release();
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Write>
+//	Capture a message into the calling thread's ring
+//-----------------------------------------------------------------------------
+			void AsyncLog::Write(LogLevel _logLevel, uint8 const _nodeId, char const* _format, va_list _args)
+			{
+				if ((_logLevel > m_maxLevel.load(std::memory_order_relaxed)) && (_logLevel != LogLevel_Internal))
+				{
+					return;
+				}
+
+				Ring* ring = GetRing();
+				if (!ring)
+				{
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				RecordHeader header;
+				header.m_kind = Kind_Message;
+				header.m_level = (uint8) _logLevel;
+				header.m_nodeId = _nodeId;
+				header.m_reserved = 0;
+				header.m_sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+				header.m_time = LogFormatter::GetTime();
+				header.m_threadId = s_ringHandle.m_threadId;
+
+				char const* format = (_format != NULL) ? _format : "";
+				size_t formatLength = strlen(format) + 1;
+				uint8 args[c_maxArgs];
+				uint32 argsLength = 0;
+
+				va_list saveargs;
+				va_copy(saveargs, _args);
+				bool encoded = (formatLength <= c_maxText) && LogFormatter::EncodeArgs(format, saveargs, args, sizeof(args), &argsLength);
+				va_end(saveargs);
+
+				if (encoded)
+				{
+					Push(ring, &header, format, (uint32) formatLength, args, argsLength);
+				}
+				else
+				{
+					// Fall back to formatting the message here, as the standard log does
+					char lineBuf[c_maxText] =
+					{ 0 };
+					vsnprintf(lineBuf, sizeof(lineBuf), format, _args);
+					header.m_kind = Kind_Text;
+					Push(ring, &header, lineBuf, (uint32) strlen(lineBuf) + 1, NULL, 0);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::QueueDump>
+//	Ask the log thread to dump the queued messages
+//-----------------------------------------------------------------------------
+			void AsyncLog::QueueDump()
+			{
+				Control(Kind_Dump, "");
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::QueueClear>
+//	Ask the log thread to clear the queued messages
+//-----------------------------------------------------------------------------
+			void AsyncLog::QueueClear()
+			{
+				Control(Kind_Clear, "");
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::SetLoggingState>
+//	Sets the various log state variables
+//-----------------------------------------------------------------------------
+			void AsyncLog::SetLoggingState(LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _dumpTrigger)
+			{
+				m_saveLevel.store(_saveLevel, std::memory_order_relaxed);
+				m_queueLevel.store(_queueLevel, std::memory_order_relaxed);
+				m_dumpTrigger.store(_dumpTrigger, std::memory_order_relaxed);
+				m_maxLevel.store((_saveLevel > _queueLevel) ? _saveLevel : _queueLevel, std::memory_order_relaxed);
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::SetLogFileName>
+//	Ask the log thread to switch to a new log file
+//-----------------------------------------------------------------------------
+			void AsyncLog::SetLogFileName(const string &_filename)
+			{
+				Control(Kind_FileName, _filename);
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::GetRing>
+//	Return the calling thread's ring, claiming one on its first message
+//-----------------------------------------------------------------------------
+			AsyncLog::Ring* AsyncLog::GetRing()
+			{
+				RingHandle& handle = s_ringHandle;
+				if ((handle.m_log == this) && (handle.m_generation == m_generation))
+				{
+					return handle.m_ring;
+				}
+
+				// Reuse a ring given up by a thread that has exited, or create a new one
+				Ring* ring = NULL;
+				uint32 count = m_ringCount.load(std::memory_order_acquire);
+				for (uint32 i = 0; (i < count) && !ring; ++i)
+				{
+					bool expected = false;
+					if (m_rings[i]->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					{
+						ring = m_rings[i];
+					}
+				}
+				if (!ring)
+				{
+					Internal::LockGuard LG(m_ringMutex);
+					count = m_ringCount.load(std::memory_order_relaxed);
+					if (count < m_rings.size())
+					{
+						ring = new Ring();
+						ring->m_inUse.store(true, std::memory_order_relaxed);
+						m_rings[count] = ring;
+						m_ringCount.store(count + 1, std::memory_order_release);
+					}
+				}
+
+				if (ring)
+				{
+					handle.m_log = this;
+					handle.m_generation = m_generation;
+					handle.m_ring = ring;
+					handle.m_threadId = (uint64) std::hash<std::thread::id>()(std::this_thread::get_id());
+				}
+				return ring;
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Push>
+//	Add a record to a ring, waiting for room only for serious messages
+//-----------------------------------------------------------------------------
+			void AsyncLog::Push(Ring* _ring, RecordHeader* _header, char const* _text, uint32 const _textLength, uint8 const* _args, uint32 const _argsLength)
+			{
+				bool important = (_header->m_level <= LogLevel_Info) || (_header->m_kind >= Kind_Dump);
+				uint32 waited = 0;
+				while (!_ring->Push(_header, _text, _textLength, _args, _argsLength))
+				{
+					if (!important || (waited >= c_maxWait))
+					{
+						_ring->m_dropped.fetch_add(1, std::memory_order_relaxed);
+						return;
+					}
+					m_wakeEvent->Set();
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					++waited;
+				}
+
+				// The log thread flushes on a timer; only wake it early when it matters
+				if ((_header->m_level <= LogLevel_Warning) || (_header->m_kind >= Kind_Dump) || (_ring->GetUsed() > c_ringSize / 4))
+				{
+					m_wakeEvent->Set();
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Control>
+//	Pass a request to the log thread, in order with the messages around it
+//-----------------------------------------------------------------------------
+			void AsyncLog::Control(uint8 const _kind, string const& _text)
+			{
+				Ring* ring = GetRing();
+				if (!ring)
+				{
+					return;
+				}
+
+				RecordHeader header;
+				header.m_kind = _kind;
+				header.m_level = LogLevel_Always;
+				header.m_nodeId = 0;
+				header.m_reserved = 0;
+				header.m_sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+				header.m_time = LogFormatter::GetTime();
+				header.m_threadId = s_ringHandle.m_threadId;
+				Push(ring, &header, _text.c_str(), (uint32) _text.size() + 1, NULL, 0);
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::LogThreadEntryPoint>
+//	Entry point of the log thread
+//-----------------------------------------------------------------------------
+			void AsyncLog::LogThreadEntryPoint(Internal::Platform::Event* _exitEvent, void* _context)
+			{
+				AsyncLog* log = (AsyncLog*) _context;
+				if (log)
+				{
+					log->LogThreadProc(_exitEvent);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::LogThreadProc>
+//	Write out the rings every c_flushInterval, or sooner when woken
+//-----------------------------------------------------------------------------
+			void AsyncLog::LogThreadProc(Internal::Platform::Event* _exitEvent)
+			{
+				Internal::Platform::WaitSet waitObjects;
+				waitObjects.Add(_exitEvent);
+				waitObjects.Add(m_wakeEvent);
+
+				while (true)
+				{
+					int32 result = waitObjects.Multiple(2, c_flushInterval);
+					if (result == 0)
+					{
+						// Exit has been signalled.  The destructor writes anything left over.
+						return;
+					}
+					if (result == 1)
+					{
+						m_wakeEvent->Reset();
+					}
+					Drain();
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Drain>
+//	Process everything in the rings, merging them back into the order the
+//	messages were logged
+//-----------------------------------------------------------------------------
+			void AsyncLog::Drain()
+			{
+				struct Cursor
+				{
+						Ring* m_ring;
+						uint64 m_position;
+						uint64 m_end;
+				};
+
+				std::vector<Cursor> cursors;
+				uint32 count = m_ringCount.load(std::memory_order_acquire);
+				for (uint32 i = 0; i < count; ++i)
+				{
+					Cursor cursor;
+					cursor.m_ring = m_rings[i];
+					cursor.m_position = cursor.m_ring->m_tail.load(std::memory_order_relaxed);
+					cursor.m_end = cursor.m_ring->m_head.load(std::memory_order_acquire);
+					if (cursor.m_position != cursor.m_end)
+					{
+						cursors.push_back(cursor);
+					}
+				}
+
+				while (true)
+				{
+					// Skip padding, then pick the oldest record at the front of any ring
+					Cursor* next = NULL;
+					for (std::vector<Cursor>::iterator it = cursors.begin(); it != cursors.end(); ++it)
+					{
+						while ((it->m_position != it->m_end) && (it->m_ring->At(it->m_position)->m_kind == Kind_Pad))
+						{
+							it->m_position += it->m_ring->At(it->m_position)->m_size;
+							it->m_ring->m_tail.store(it->m_position, std::memory_order_release);
+						}
+						if ((it->m_position != it->m_end) && (!next || (it->m_ring->At(it->m_position)->m_sequence < next->m_ring->At(next->m_position)->m_sequence)))
+						{
+							next = &(*it);
+						}
+					}
+					if (!next)
+					{
+						break;
+					}
+
+					RecordHeader const* header = next->m_ring->At(next->m_position);
+					uint32 size = header->m_size;
+					Process(header);
+					next->m_position += size;
+					next->m_ring->m_tail.store(next->m_position, std::memory_order_release);
+				}
+
+				uint32 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+				for (uint32 i = 0; i < count; ++i)
+				{
+					dropped += m_rings[i]->m_dropped.exchange(0, std::memory_order_relaxed);
+				}
+				if (dropped > 0)
+				{
+					ReportDropped(dropped);
+				}
+
+				if (m_file)
+				{
+					fflush(m_file);
+				}
+				if (m_bConsoleOutput)
+				{
+					fflush(stdout);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Process>
+//	Handle one record from a ring
+//-----------------------------------------------------------------------------
+			void AsyncLog::Process(RecordHeader const* _header)
+			{
+				char const* text = (char const*) (_header + 1);
+				switch (_header->m_kind)
+				{
+					case Kind_Message:
+					case Kind_Text:
+					{
+						Entry entry;
+						entry.m_sequence = _header->m_sequence;
+						entry.m_time = _header->m_time;
+						entry.m_threadId = _header->m_threadId;
+						entry.m_level = (LogLevel) _header->m_level;
+						entry.m_nodeId = _header->m_nodeId;
+						entry.m_isText = (_header->m_kind == Kind_Text);
+						entry.m_format.assign(text, _header->m_textLength - 1);
+						entry.m_args.assign(text + _header->m_textLength, _header->m_argsLength);
+
+						LogLevel level = entry.m_level;
+						if ((level <= m_saveLevel.load(std::memory_order_relaxed)) || (level == LogLevel_Internal))
+						{
+							Output(entry, false);
+						}
+						if ((level <= m_queueLevel.load(std::memory_order_relaxed)) && (level != LogLevel_Internal))
+						{
+							m_logQueue.push_back(entry);
+							if (m_logQueue.size() > c_queueSize)
+							{
+								m_logQueue.pop_front();
+							}
+						}
+						if ((level <= m_dumpTrigger.load(std::memory_order_relaxed)) && (level != LogLevel_Internal) && (level != LogLevel_Always))
+						{
+							Dump();
+						}
+						break;
+					}
+					case Kind_Dump:
+					{
+						Dump();
+						break;
+					}
+					case Kind_Clear:
+					{
+						m_logQueue.clear();
+						break;
+					}
+					case Kind_FileName:
+					{
+						m_filename = text;
+						OpenFile(m_bAppendLog);
+						break;
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Output>
+//	Write a message to the file and the console
+//-----------------------------------------------------------------------------
+			void AsyncLog::Output(Entry const& _entry, bool const _queued)
+			{
+				if (m_bBinary && m_file)
+				{
+					uint32 formatId = BinaryLog::c_textFormat;
+					if (!_entry.m_isText)
+					{
+						std::map<string, uint32>::iterator it = m_formatIds.find(_entry.m_format);
+						if (it != m_formatIds.end())
+						{
+							formatId = it->second;
+						}
+						else
+						{
+							formatId = (uint32) m_formatIds.size();
+							m_formatIds[_entry.m_format] = formatId;
+
+							uint16 length = (uint16) _entry.m_format.size();
+							m_record.resize(sizeof(formatId) + sizeof(length) + length);
+							memcpy(&m_record[0], &formatId, sizeof(formatId));
+							memcpy(&m_record[4], &length, sizeof(length));
+							memcpy(&m_record[6], _entry.m_format.data(), length);
+							WriteRecord(BinaryLog::Record_Format, &m_record[0], m_record.size());
+						}
+					}
+
+					string const& payload = _entry.m_isText ? _entry.m_format : _entry.m_args;
+					uint16 length = (uint16) payload.size();
+					uint8 level = (uint8) _entry.m_level;
+					uint8 flags = _queued ? BinaryLog::c_flagQueued : 0;
+					m_record.resize(33 + length);
+					memcpy(&m_record[0], &_entry.m_sequence, 8);
+					memcpy(&m_record[8], &_entry.m_time, 8);
+					memcpy(&m_record[16], &_entry.m_threadId, 8);
+					memcpy(&m_record[24], &formatId, 4);
+					m_record[28] = level;
+					m_record[29] = _entry.m_nodeId;
+					m_record[30] = flags;
+					memcpy(&m_record[31], &length, 2);
+					if (length > 0)
+					{
+						memcpy(&m_record[33], payload.data(), length);
+					}
+					WriteRecord(BinaryLog::Record_Message, &m_record[0], m_record.size());
+				}
+
+				if ((!m_bBinary && m_file) || m_bConsoleOutput)
+				{
+					string line = LogFormatter::GetLine(_entry.m_time, _entry.m_threadId, _entry.m_level, _entry.m_nodeId, GetMessage(_entry), _queued);
+					if (!m_bBinary && m_file)
+					{
+						fputs(line.c_str(), m_file);
+					}
+					if (m_bConsoleOutput)
+					{
+						WriteConsole(_entry.m_level, line);
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::OutputText>
+//	Write a message generated by the log itself
+//-----------------------------------------------------------------------------
+			void AsyncLog::OutputText(LogLevel const _level, string const& _text)
+			{
+				Entry entry;
+				entry.m_sequence = 0;
+				entry.m_time = LogFormatter::GetTime();
+				entry.m_threadId = 0;
+				entry.m_level = _level;
+				entry.m_nodeId = 0;
+				entry.m_isText = true;
+				entry.m_format = _text;
+				Output(entry, false);
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::Dump>
+//	Write out the queued messages and empty the queue
+//-----------------------------------------------------------------------------
+			void AsyncLog::Dump()
+			{
+				OutputText(LogLevel_Always, "");
+				OutputText(LogLevel_Always, "Dumping queued log messages");
+				OutputText(LogLevel_Always, "");
+				for (std::deque<Entry>::const_iterator it = m_logQueue.begin(); it != m_logQueue.end(); ++it)
+				{
+					Output(*it, true);
+				}
+				m_logQueue.clear();
+				OutputText(LogLevel_Always, "");
+				OutputText(LogLevel_Always, "End of queued log message dump");
+				OutputText(LogLevel_Always, "");
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::ReportDropped>
+//	Record that messages were lost
+//-----------------------------------------------------------------------------
+			void AsyncLog::ReportDropped(uint32 const _count)
+			{
+				if (m_bBinary && m_file)
+				{
+					uint64 time = LogFormatter::GetTime();
+					uint8 data[12];
+					memcpy(&data[0], &time, sizeof(time));
+					memcpy(&data[8], &_count, sizeof(_count));
+					WriteRecord(BinaryLog::Record_Dropped, data, sizeof(data));
+				}
+
+				char buf[100];
+				snprintf(buf, sizeof(buf), "Log could not keep up.  %d messages were dropped", _count);
+				if (!m_bBinary)
+				{
+					OutputText(LogLevel_Warning, buf);
+				}
+				else if (m_bConsoleOutput)
+				{
+					WriteConsole(LogLevel_Warning, LogFormatter::GetLine(LogFormatter::GetTime(), 0, LogLevel_Warning, 0, buf, false));
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::OpenFile>
+//	Open the log file, writing the header for a new binary log
+//-----------------------------------------------------------------------------
+			void AsyncLog::OpenFile(bool const _bAppend)
+			{
+				if (m_file)
+				{
+					fclose(m_file);
+					m_file = NULL;
+				}
+				if (m_filename.empty())
+				{
+					return;
+				}
+
+				if (m_bBinary)
+				{
+					m_file = fopen(m_filename.c_str(), _bAppend ? "ab" : "wb");
+				}
+				else
+				{
+					m_file = fopen(m_filename.c_str(), _bAppend ? "a" : "w");
+				}
+				if (m_file == NULL)
+				{
+					std::cerr << "Could Not Open OZW Log File." << std::endl;
+					return;
+				}
+
+				if (m_bBinary)
+				{
+					m_formatIds.clear();
+					fseek(m_file, 0, SEEK_END);
+					if (ftell(m_file) == 0)
+					{
+						fwrite(BinaryLog::c_magic, sizeof(BinaryLog::c_magic), 1, m_file);
+						fwrite(&BinaryLog::c_byteOrder, sizeof(BinaryLog::c_byteOrder), 1, m_file);
+						fwrite(&BinaryLog::c_version, sizeof(BinaryLog::c_version), 1, m_file);
+					}
+					uint64 time = LogFormatter::GetTime();
+					WriteRecord(BinaryLog::Record_Session, &time, sizeof(time));
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::WriteRecord>
+//	Write one record to the binary log
+//-----------------------------------------------------------------------------
+			void AsyncLog::WriteRecord(uint8 const _type, void const* _data, size_t const _size)
+			{
+				fputc(_type, m_file);
+				fwrite(_data, _size, 1, m_file);
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::WriteConsole>
+//	Write a line to the console, coloured by level where the terminal allows
+//-----------------------------------------------------------------------------
+			void AsyncLog::WriteConsole(LogLevel const _level, string const& _line)
+			{
+#ifdef _WIN32
+				fputs(_line.c_str(), stdout);
+#else
+				unsigned int code = 39;
+				switch (_level)
+				{
+					case LogLevel_Internal:
+					case LogLevel_StreamDetail:
+						code = 97;
+						break;	// 97=bright white
+					case LogLevel_Debug:
+						code = 36;
+						break;	// 36=cyan
+					case LogLevel_Detail:
+						code = 94;
+						break;	// 94=bright blue
+					case LogLevel_Alert:
+						code = 93;
+						break;	// 93=bright yellow
+					case LogLevel_Warning:
+						code = 33;
+						break;	// 33=yellow
+					case LogLevel_Error:
+						code = 31;
+						break;	// 31=red
+					case LogLevel_Fatal:
+						code = 95;
+						break;	// 95=bright magenta
+					case LogLevel_Always:
+						code = 32;
+						break;	// 32=green
+					default:
+						code = 39;
+						break;	// 39=white
+				}
+				fprintf(stdout, "\x1B[%02um%s\x1b[39m", code, _line.c_str());
+#endif
+			}
+
+//-----------------------------------------------------------------------------
+//	<AsyncLog::GetMessage>
+//	Format the text of a message
+//-----------------------------------------------------------------------------
+			string AsyncLog::GetMessage(Entry const& _entry)
+			{
+				if (_entry.m_isText)
+				{
+					return _entry.m_format;
+				}
+				string text;
+				LogFormatter::FormatArgs(_entry.m_format.c_str(), (uint8 const*) _entry.m_args.data(), (uint32) _entry.m_args.size(), &text);
+				return text;
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------------------
+//
+//	AsyncLog.h
+//
+//	Log backend that formats and writes messages on its own thread
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _AsyncLog_H
+#define _AsyncLog_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "Defs.h"
+#include "platform/Log.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Event;
+			class Mutex;
+			class Thread;
+
+			/** \brief Log backend that keeps formatting and file output off the threads that log.
+			 * \ingroup Platform
+			 *
+			 * Write only captures the format string and the raw arguments (see LogFormatter) and
+			 * copies them into a ring buffer owned by the calling thread, so it never takes a lock
+			 * or touches the disk.  A background thread collects the messages from every ring in
+			 * the order they were logged, and formats and writes them, or just writes them as
+			 * binary records to be decoded later by the LogDecode tool.  The queue of messages kept
+			 * for a dump is also held by the background thread, and those messages are only
+			 * formatted if they are dumped.
+			 *
+			 * When a ring is full, LogLevel_Detail and less severe messages are dropped and
+			 * counted, and more severe ones wait (for a while) for the background thread to
+			 * make room.
+			 *
+			 * The format string is copied along with the arguments rather than referenced, as
+			 * some callers pass a buffer on their stack as the format.
+			 */
+			class AsyncLog: public i_LogImpl
+			{
+				private:
+					friend class OpenZWave::Log;
+
+					AsyncLog(string const& _filename, bool const _bAppendLog, bool const _bConsoleOutput, bool const _bBinary, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger);
+					~AsyncLog();
+
+					void Write(LogLevel _level, uint8 const _nodeId, char const* _format, va_list _args);
+					void QueueDump();
+					void QueueClear();
+					void SetLoggingState(LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _dumpTrigger);
+					void SetLogFileName(const string &_filename);
+
+					class Ring;
+					struct RecordHeader;
+
+					// The ring claimed by the current thread
+					struct RingHandle
+					{
+							RingHandle();
+							~RingHandle();
+
+							AsyncLog* m_log;
+							uint32 m_generation;
+							Ring* m_ring;
+							uint64 m_threadId;
+					};
+
+					// A message held in the queue until it is dumped or pushed out
+					struct Entry
+					{
+							uint64 m_sequence;
+							uint64 m_time;
+							uint64 m_threadId;
+							LogLevel m_level;
+							uint8 m_nodeId;
+							bool m_isText;				// m_format holds the finished text
+							string m_format;
+							string m_args;
+					};
+
+					Ring* GetRing();
+					void Push(Ring* _ring, RecordHeader* _header, char const* _text, uint32 const _textLength, uint8 const* _args, uint32 const _argsLength);
+					void Control(uint8 const _kind, string const& _text);
+
+					static void LogThreadEntryPoint(Internal::Platform::Event* _exitEvent, void* _context);
+					void LogThreadProc(Internal::Platform::Event* _exitEvent);
+					void Drain();
+					void Process(RecordHeader const* _header);
+					void Output(Entry const& _entry, bool const _queued);
+					void OutputText(LogLevel const _level, string const& _text);
+					void Dump();
+					void ReportDropped(uint32 const _count);
+					void OpenFile(bool const _bAppend);
+					void WriteRecord(uint8 const _type, void const* _data, size_t const _size);
+					void WriteConsole(LogLevel const _level, string const& _line);
+					static string GetMessage(Entry const& _entry);
+
+					// Shared with the threads that log
+					std::atomic<int> m_saveLevel;
+					std::atomic<int> m_queueLevel;
+					std::atomic<int> m_dumpTrigger;
+					std::atomic<int> m_maxLevel;				// Messages above this level are thrown away by Write
+					std::atomic<uint64> m_sequence;
+					std::atomic<uint32> m_ringCount;
+					std::atomic<uint32> m_dropped;				// Messages from threads that could not get a ring
+					std::vector<Ring*> m_rings;					// Sized once; entries up to m_ringCount are valid
+					uint32 m_generation;
+					Internal::Platform::Mutex* m_ringMutex;		// Serializes creating rings
+					Internal::Platform::Event* m_wakeEvent;		// Wakes the log thread before its next timed flush
+					Internal::Platform::Thread* m_thread;
+
+					// Only used by the log thread
+					string m_filename;
+					bool m_bConsoleOutput;
+					bool m_bAppendLog;
+					bool m_bBinary;
+					FILE* m_file;
+					std::deque<Entry> m_logQueue;
+					std::map<string, uint32> m_formatIds;		// Formats already written to the binary log
+					std::vector<uint8> m_record;				// Scratch space for building binary records
+
+					static std::atomic<uint32> s_generation;
+					static thread_local RingHandle s_ringHandle;
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_AsyncLog_H
@@ -53,6 +53,8 @@ namespace OpenZWave
 			 * Controller is derived from Stream rather than containing one, so that
 			 * we can use its Wait abilities without having to duplicate them here.
 			 * The stream is used for input.  Buffering of output is handled by the OS.
+			 * The read thread is the only producer and the driver thread the only
+			 * consumer, so the stream runs in its lock-free single-producer/single-consumer mode.
 			 */
 
 			class Controller: public Stream
@@ -64,7 +66,7 @@ namespace OpenZWave
 					 * Creates the controller object.
 					 */
 					Controller() :
-							Stream(2048)
+							Stream(2048, true)
 					{
 					}
 
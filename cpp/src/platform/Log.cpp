@@ -30,6 +30,7 @@
 #include "Defs.h"
 #include "platform/Mutex.h"
 #include "platform/Log.h"
+#include "platform/AsyncLog.h"
 
 #ifdef WIN32
 #include "platform/windows/LogImpl.h"	// Platform-specific implementation of a log
@@ -58,27 +59,37 @@ char const *OpenZWave::LogLevelString[] =
 };
 
 Log* Log::s_instance = NULL;
+i_LogImpl* Log::s_asyncLog = NULL;
+std::atomic<int> Log::s_maxLevel(LogLevel_None);
 std::vector<i_LogImpl*> Log::m_pImpls;
 static bool s_dologging;
+static LogLevel s_saveLevel = LogLevel_None;
+static LogLevel s_queueLevel = LogLevel_None;
+static LogLevel s_dumpTrigger = LogLevel_None;
 
 //-----------------------------------------------------------------------------
 //	<Log::Create>
 //	Static creation of the singleton
 //-----------------------------------------------------------------------------
-Log* Log::Create(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger)
+Log* Log::Create(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger, bool const _bAsync, bool const _bBinary)
 {
 	if ( NULL == s_instance)
 	{
-		s_instance = new Log(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger);
+		s_instance = new Log(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger, _bAsync, _bBinary);
 		s_dologging = true; // default logging to true so no change to what people experience now
 	}
 	else
 	{
 		Log::Destroy();
-		s_instance = new Log(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger);
+		s_instance = new Log(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger, _bAsync, _bBinary);
 		s_dologging = true; // default logging to true so no change to what people experience now
 	}
 
+	s_saveLevel = _saveLevel;
+	s_queueLevel = _queueLevel;
+	s_dumpTrigger = _dumpTrigger;
+	UpdateMaxLevel();
+
 	return s_instance;
 }
 
@@ -109,6 +120,7 @@ Log* Log::Create(string const& _filename, bool const _bAppend, bool const _bCons
 //-----------------------------------------------------------------------------
 void Log::Destroy()
 {
+	s_maxLevel = LogLevel_None;
 	delete s_instance;
 	s_instance = NULL;
 }
@@ -122,6 +134,8 @@ bool Log::SetLoggingClass(i_LogImpl *LogClass, bool Append)
 	if (!Append) {
 		for (std::vector<i_LogImpl*>::iterator it = s_instance->m_pImpls.begin(); it != s_instance->m_pImpls.end();) {
 			i_LogImpl *lc = *it;
+			if (lc == s_asyncLog)
+				s_asyncLog = NULL;
 			delete lc;
 			it = s_instance->m_pImpls.erase(it);
 		}
@@ -144,6 +158,7 @@ void Log::SetLoggingState(bool _dologging)
 {
 	bool prevLogging = s_dologging;
 	s_dologging = _dologging;
+	UpdateMaxLevel();
 
 	if (!prevLogging && s_dologging)
 		Log::Write(LogLevel_Always, "Logging started\n\n");
@@ -181,6 +196,10 @@ void Log::SetLoggingState(LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _d
 			(*it)->SetLoggingState(_saveLevel, _queueLevel, _dumpTrigger);
 		s_instance->m_logMutex->Unlock();
 	}
+	s_saveLevel = _saveLevel;
+	s_queueLevel = _queueLevel;
+	s_dumpTrigger = _dumpTrigger;
+	UpdateMaxLevel();
 
 	if (!prevLogging && s_dologging)
 		Log::Write(LogLevel_Always, "Logging started\n\n");
@@ -195,14 +214,57 @@ bool Log::GetLoggingState()
 	return s_dologging;
 }
 
+//-----------------------------------------------------------------------------
+//	<Log::GetLoggingState>
+//	Return the current logging levels
+//-----------------------------------------------------------------------------
+void Log::GetLoggingState(LogLevel* _saveLevel, LogLevel* _queueLevel, LogLevel* _dumpTrigger)
+{
+	*_saveLevel = s_saveLevel;
+	*_queueLevel = s_queueLevel;
+	*_dumpTrigger = s_dumpTrigger;
+}
+
+//-----------------------------------------------------------------------------
+//	<Log::UpdateMaxLevel>
+//	Recalculate the level checked by IsLevelEnabled and Write before they do
+//	any other work
+//-----------------------------------------------------------------------------
+void Log::UpdateMaxLevel()
+{
+	int maxLevel = LogLevel_None;
+	if (s_instance && s_dologging)
+	{
+		maxLevel = s_saveLevel;
+		if (s_queueLevel > maxLevel)
+			maxLevel = s_queueLevel;
+		if (s_dumpTrigger > maxLevel)
+			maxLevel = s_dumpTrigger;
+	}
+	s_maxLevel = maxLevel;
+}
+
 //-----------------------------------------------------------------------------
 //	<Log::Write>
 //	Write to the log
 //-----------------------------------------------------------------------------
 void Log::Write(LogLevel _level, char const* _format, ...)
 {
+	// Nothing at this level is saved or queued, so skip the lock and the formatting
+	if (!IsLevelEnabled(_level) && (_level != LogLevel_Internal))
+		return;
+
 	if (s_instance && s_dologging && (s_instance->m_pImpls.size() > 0))
 	{
+		if (s_asyncLog && (s_instance->m_pImpls.size() == 1))
+		{
+			// The asynchronous log is safe to call from any thread
+			va_list args;
+			va_start(args, _format);
+			s_asyncLog->Write(_level, 0, _format, args);
+			va_end(args);
+			return;
+		}
 		s_instance->m_logMutex->Lock(); // double locks if recursive
 		va_list args;
 		va_start(args, _format);
@@ -219,8 +281,21 @@ void Log::Write(LogLevel _level, char const* _format, ...)
 //-----------------------------------------------------------------------------
 void Log::Write(LogLevel _level, uint8 const _nodeId, char const* _format, ...)
 {
+	// Nothing at this level is saved or queued, so skip the lock and the formatting
+	if (!IsLevelEnabled(_level) && (_level != LogLevel_Internal))
+		return;
+
 	if (s_instance && s_dologging && (s_instance->m_pImpls.size() > 0))
 	{
+		if (s_asyncLog && (s_instance->m_pImpls.size() == 1))
+		{
+			// The asynchronous log is safe to call from any thread
+			va_list args;
+			va_start(args, _format);
+			s_asyncLog->Write(_level, _nodeId, _format, args);
+			va_end(args);
+			return;
+		}
 		if (_level != LogLevel_Internal)
 			s_instance->m_logMutex->Lock();
 		va_list args;
@@ -282,12 +357,20 @@ void Log::SetLogFileName(const string &_filename)
 //	<Log::Log>
 //	Constructor
 //-----------------------------------------------------------------------------
-Log::Log(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger) :
+Log::Log(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger, bool const _bAsync, bool const _bBinary) :
 		m_logMutex(new Internal::Platform::Mutex())
 {
 	if (m_pImpls.size() == 0)
 	{
-		m_pImpls.push_back(new Internal::Platform::LogImpl(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger));
+		if (_bAsync)
+		{
+			s_asyncLog = new Internal::Platform::AsyncLog(_filename, _bAppend, _bConsoleOutput, _bBinary, _saveLevel, _queueLevel, _dumpTrigger);
+			m_pImpls.push_back(s_asyncLog);
+		}
+		else
+		{
+			m_pImpls.push_back(new Internal::Platform::LogImpl(_filename, _bAppend, _bConsoleOutput, _saveLevel, _queueLevel, _dumpTrigger));
+		}
 	}
 }
 
@@ -298,6 +381,7 @@ Log::Log(string const& _filename, bool const _bAppend, bool const _bConsoleOutpu
 Log::~Log()
 {
 	m_logMutex->Release();
+	s_asyncLog = NULL;
 	for (std::vector<i_LogImpl*>::iterator it = s_instance->m_pImpls.begin(); it != s_instance->m_pImpls.end();) {
 		i_LogImpl *lc = *it;
 		delete lc;
@@ -29,6 +29,7 @@
 #define _Log_H
 
 #include <stdarg.h>
+#include <atomic>
 #include <string>
 #include <vector>
 #include "Defs.h"
@@ -66,6 +67,17 @@ namespace OpenZWave
 		LogLevel_Internal /**< Used only within the log class (uses existing timestamp, etc.) */
 	};
 
+	/** \brief The least severe LogLevel compiled into the library.
+	 *
+	 * Build with OPENZWAVE_LOG_MAX_LEVEL defined (for example LOG_MAX_LEVEL=Info on the
+	 * make command line) to compile out less severe messages.  Statements guarded by
+	 * Log::IsLevelEnabled are removed entirely, and the rest return from Log::Write
+	 * straight away.
+	 */
+#ifndef OPENZWAVE_LOG_MAX_LEVEL
+#define OPENZWAVE_LOG_MAX_LEVEL LogLevel_Internal
+#endif
+
 	/** \brief A Abstract class to create a Custom Logging Method
 	 * \ingroup Platform
 	 *
@@ -100,10 +112,14 @@ namespace OpenZWave
 			 *
 			 * Creates the cross-platform logging singleton.
 			 * Any previous log will be cleared.
+			 * \param _bAsync if true, messages are formatted and written by a background thread,
+			 * so logging does not hold up the thread that logs.
+			 * \param _bBinary if true (and _bAsync is true), the log file is written in a compact
+			 * binary form that can be turned back into text with the LogDecode tool.
 			 * \return a pointer to the logging object.
 			 * \see Destroy, Write
 			 */
-			static Log* Create(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger);
+			static Log* Create(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel const _saveLevel, LogLevel const _queueLevel, LogLevel const _dumpTrigger, bool const _bAsync = false, bool const _bBinary = false);
 
 			/** \brief Create a log.
 			 *
@@ -164,6 +180,19 @@ namespace OpenZWave
 			 */
 			static void GetLoggingState(LogLevel* _saveLevel, LogLevel* _queueLevel, LogLevel* _dumpTrigger);
 
+			/**\brief Determine whether a message at a given level would be written or queued.
+			 *
+			 * Use this to skip building expensive log arguments that would be thrown away.
+			 * It takes no lock, and levels above OPENZWAVE_LOG_MAX_LEVEL are rejected at
+			 * compile time, so the guarded statement is removed from the build.
+			 * \param _level	LogLevel of the message
+			 * \return true if the message would be written to the log or the queue
+			 */
+			static bool IsLevelEnabled(LogLevel _level)
+			{
+				return (_level <= OPENZWAVE_LOG_MAX_LEVEL) && ((int) _level <= s_maxLevel.load(std::memory_order_relaxed));
+			}
+
 			/** \brief Change the log file name.
 			 *
 			 * This will start a new log file (or potentially start appending
@@ -204,11 +233,15 @@ namespace OpenZWave
 			static void QueueClear();
 
 		private:
-			Log(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _dumpTrigger);
+			Log(string const& _filename, bool const _bAppend, bool const _bConsoleOutput, LogLevel _saveLevel, LogLevel _queueLevel, LogLevel _dumpTrigger, bool const _bAsync, bool const _bBinary);
 			~Log();
 
+			static void UpdateMaxLevel();
+
 			static std::vector<i_LogImpl*> m_pImpls; /**< Pointer to an object that encapsulates the platform-specific logging implementation. */
 			static Log* s_instance;
+			static i_LogImpl* s_asyncLog; /**< The built in asynchronous log, if it is in use.  It does its own locking. */
+			static std::atomic<int> s_maxLevel; /**< Least severe level that is saved, queued or triggers a dump.  LogLevel_None while logging is off. */
 			Internal::Platform::Mutex* m_logMutex;
 	};
 } // namespace OpenZWave
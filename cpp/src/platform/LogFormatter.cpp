@@ -0,0 +1,870 @@
+//-----------------------------------------------------------------------------
+//
+//	LogFormatter.cpp
+//
+//	Deferred formatting of log messages, shared by the asynchronous log and
+//	the binary log decoder
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <wchar.h>
+#include <chrono>
+#include <vector>
+#include "platform/LogFormatter.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			namespace
+			{
+				enum LengthModifier
+				{
+					Length_None,
+					Length_hh,
+					Length_h,
+					Length_l,
+					Length_ll,
+					Length_L,
+					Length_z,
+					Length_j,
+					Length_t
+				};
+
+				// One conversion specification from a format string
+				struct Conversion
+				{
+						uint32 m_length;						// From the '%' up to and including the conversion character
+						uint32 m_stars;							// Number of '*' widths and precisions
+						bool m_starPrecision;					// The precision is the last '*' argument
+						int32 m_precision;						// Literal precision, or -1 if there is none
+						LengthModifier m_lengthModifier;
+						char m_type;
+				};
+
+				// Argument tags
+				uint8 const c_tagInt = 'i';
+				uint8 const c_tagDouble = 'f';
+				uint8 const c_tagString = 's';
+				uint8 const c_tagWideString = 'w';
+				uint8 const c_tagPointer = 'p';
+
+//-----------------------------------------------------------------------------
+// <ParseConversion>
+// Parse the conversion starting at the '%' in _p.  Returns false if it is
+// one we cannot capture
+//-----------------------------------------------------------------------------
+				bool ParseConversion(char const* _p, Conversion* o_conv)
+				{
+					o_conv->m_stars = 0;
+					o_conv->m_starPrecision = false;
+					o_conv->m_precision = -1;
+					o_conv->m_lengthModifier = Length_None;
+
+					char const* p = _p + 1;
+					while ((*p != '\0') && (strchr("-+ #0'", *p) != NULL))
+					{
+						++p;
+					}
+					if (*p == '*')
+					{
+						++o_conv->m_stars;
+						++p;
+					}
+					else
+					{
+						while ((*p >= '0') && (*p <= '9'))
+						{
+							++p;
+						}
+					}
+					if (*p == '.')
+					{
+						++p;
+						if (*p == '*')
+						{
+							++o_conv->m_stars;
+							o_conv->m_starPrecision = true;
+							++p;
+						}
+						else
+						{
+							o_conv->m_precision = 0;
+							while ((*p >= '0') && (*p <= '9'))
+							{
+								o_conv->m_precision = o_conv->m_precision * 10 + (*p - '0');
+								++p;
+							}
+						}
+					}
+
+					switch (*p)
+					{
+						case 'h':
+						{
+							++p;
+							if (*p == 'h')
+							{
+								++p;
+								o_conv->m_lengthModifier = Length_hh;
+							}
+							else
+							{
+								o_conv->m_lengthModifier = Length_h;
+							}
+							break;
+						}
+						case 'l':
+						{
+							++p;
+							if (*p == 'l')
+							{
+								++p;
+								o_conv->m_lengthModifier = Length_ll;
+							}
+							else
+							{
+								o_conv->m_lengthModifier = Length_l;
+							}
+							break;
+						}
+						case 'q':
+						{
+							++p;
+							o_conv->m_lengthModifier = Length_ll;
+							break;
+						}
+						case 'L':
+						{
+							++p;
+							o_conv->m_lengthModifier = Length_L;
+							break;
+						}
+						case 'z':
+						{
+							++p;
+							o_conv->m_lengthModifier = Length_z;
+							break;
+						}
+						case 'j':
+						{
+							++p;
+							o_conv->m_lengthModifier = Length_j;
+							break;
+						}
+						case 't':
+						{
+							++p;
+							o_conv->m_lengthModifier = Length_t;
+							break;
+						}
+						default:
+						{
+							break;
+						}
+					}
+
+					o_conv->m_type = *p;
+					if (*p == '\0')
+					{
+						return false;
+					}
+					o_conv->m_length = (uint32) (p - _p + 1);
+
+					// Positional arguments ("%1$d") end up here, as '$' is not a conversion
+					return (strchr("diouxXcCeEfFgGaAsSpn%", *p) != NULL);
+				}
+
+				// Appends tagged values to the encoding buffer
+				class ArgWriter
+				{
+					public:
+						ArgWriter(uint8* _buffer, uint32 const _size) :
+								m_buffer(_buffer), m_size(_size), m_length(0), m_overflow(false)
+						{
+						}
+
+						void PutInt(int64 const _value)
+						{
+							Put(c_tagInt, &_value, sizeof(_value));
+						}
+						void PutDouble(double const _value)
+						{
+							Put(c_tagDouble, &_value, sizeof(_value));
+						}
+						void PutPointer(void const* _value)
+						{
+							uint64 value = (uint64) (uintptr_t) _value;
+							Put(c_tagPointer, &value, sizeof(value));
+						}
+						void PutString(char const* _value, int32 const _precision)
+						{
+							if (_value == NULL)
+							{
+								_value = "(null)";
+							}
+							size_t length = 0;
+							while ((_value[length] != '\0') && ((_precision < 0) || (length < (size_t) _precision)) && (length < 0xffff))
+							{
+								++length;
+							}
+							uint16 length16 = (uint16) length;
+							Put(c_tagString, &length16, sizeof(length16));
+							Append(_value, length);
+						}
+						void PutWideString(wchar_t const* _value, int32 const _precision)
+						{
+							if (_value == NULL)
+							{
+								_value = L"(null)";
+							}
+							size_t length = 0;
+							while ((_value[length] != L'\0') && ((_precision < 0) || (length < (size_t) _precision)) && (length < 0xffff))
+							{
+								++length;
+							}
+							uint16 length16 = (uint16) length;
+							Put(c_tagWideString, &length16, sizeof(length16));
+							for (size_t i = 0; i < length; ++i)
+							{
+								uint32 unit = (uint32) _value[i];
+								Append(&unit, sizeof(unit));
+							}
+						}
+
+						uint32 GetLength() const
+						{
+							return m_length;
+						}
+						bool Overflowed() const
+						{
+							return m_overflow;
+						}
+
+					private:
+						void Put(uint8 const _tag, void const* _data, size_t const _size)
+						{
+							Append(&_tag, 1);
+							Append(_data, _size);
+						}
+						void Append(void const* _data, size_t const _size)
+						{
+							if (m_overflow || (m_length + _size > m_size))
+							{
+								m_overflow = true;
+								return;
+							}
+							memcpy(m_buffer + m_length, _data, _size);
+							m_length += (uint32) _size;
+						}
+
+						uint8* m_buffer;
+						uint32 m_size;
+						uint32 m_length;
+						bool m_overflow;
+				};
+
+				// Reads tagged values back out of an encoding
+				class ArgReader
+				{
+					public:
+						ArgReader(uint8 const* _args, uint32 const _length) :
+								m_args(_args), m_length(_length), m_position(0), m_failed(false)
+						{
+						}
+
+						int64 GetInt()
+						{
+							int64 value = 0;
+							Get(c_tagInt, &value, sizeof(value));
+							return value;
+						}
+						double GetDouble()
+						{
+							double value = 0.0;
+							Get(c_tagDouble, &value, sizeof(value));
+							return value;
+						}
+						void* GetPointer()
+						{
+							uint64 value = 0;
+							Get(c_tagPointer, &value, sizeof(value));
+							return (void*) (uintptr_t) value;
+						}
+						string GetString()
+						{
+							uint16 length = 0;
+							if (!Get(c_tagString, &length, sizeof(length)) || !Available(length))
+							{
+								return "";
+							}
+							string value((char const*) m_args + m_position, length);
+							m_position += length;
+							return value;
+						}
+						std::wstring GetWideString()
+						{
+							uint16 length = 0;
+							if (!Get(c_tagWideString, &length, sizeof(length)) || !Available(length * sizeof(uint32)))
+							{
+								return L"";
+							}
+							std::wstring value;
+							value.reserve(length);
+							for (uint16 i = 0; i < length; ++i)
+							{
+								uint32 unit;
+								memcpy(&unit, m_args + m_position, sizeof(unit));
+								m_position += sizeof(unit);
+								value.push_back((wchar_t) unit);
+							}
+							return value;
+						}
+
+						bool Failed() const
+						{
+							return m_failed;
+						}
+
+					private:
+						bool Get(uint8 const _tag, void* _data, size_t const _size)
+						{
+							if (m_failed || !Available(1 + _size) || (m_args[m_position] != _tag))
+							{
+								m_failed = true;
+								return false;
+							}
+							memcpy(_data, m_args + m_position + 1, _size);
+							m_position += (uint32) (1 + _size);
+							return true;
+						}
+						bool Available(size_t const _size)
+						{
+							if (m_position + _size > m_length)
+							{
+								m_failed = true;
+								return false;
+							}
+							return true;
+						}
+
+						uint8 const* m_args;
+						uint32 m_length;
+						uint32 m_position;
+						bool m_failed;
+				};
+
+//-----------------------------------------------------------------------------
+// <Print>
+// snprintf a single conversion, passing any '*' arguments first
+//-----------------------------------------------------------------------------
+				template<typename T> int Print(char* _buffer, size_t const _size, char const* _spec, int const* _stars, uint32 const _numStars, T _value)
+				{
+					switch (_numStars)
+					{
+						case 0:
+						{
+							return snprintf(_buffer, _size, _spec, _value);
+						}
+						case 1:
+						{
+							return snprintf(_buffer, _size, _spec, _stars[0], _value);
+						}
+						default:
+						{
+							return snprintf(_buffer, _size, _spec, _stars[0], _stars[1], _value);
+						}
+					}
+				}
+
+//-----------------------------------------------------------------------------
+// <AppendFormatted>
+// Format a single conversion and append it to the text
+//-----------------------------------------------------------------------------
+				template<typename T> void AppendFormatted(string* o_text, string const& _spec, int const* _stars, uint32 const _numStars, T _value)
+				{
+					char buffer[256];
+					int length = Print(buffer, sizeof(buffer), _spec.c_str(), _stars, _numStars, _value);
+					if (length < 0)
+					{
+						return;
+					}
+					if ((size_t) length < sizeof(buffer))
+					{
+						o_text->append(buffer, length);
+						return;
+					}
+
+					std::vector<char> large(length + 1);
+					Print(&large[0], large.size(), _spec.c_str(), _stars, _numStars, _value);
+					o_text->append(&large[0], length);
+				}
+
+//-----------------------------------------------------------------------------
+// <AppendInteger>
+// Convert an encoded integer back to the type the conversion expects
+//-----------------------------------------------------------------------------
+				void AppendInteger(string* o_text, Conversion const& _conv, string const& _spec, int const* _stars, int64 const _value)
+				{
+					if ((_conv.m_type == 'd') || (_conv.m_type == 'i'))
+					{
+						switch (_conv.m_lengthModifier)
+						{
+							case Length_l:
+								AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (long) _value);
+								return;
+							case Length_ll:
+								AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (long long) _value);
+								return;
+							case Length_z:
+								AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (size_t) _value);
+								return;
+							case Length_j:
+								AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (intmax_t) _value);
+								return;
+							case Length_t:
+								AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (ptrdiff_t) _value);
+								return;
+							default:
+								AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (int) _value);
+								return;
+						}
+					}
+
+					switch (_conv.m_lengthModifier)
+					{
+						case Length_l:
+							AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (unsigned long) _value);
+							return;
+						case Length_ll:
+							AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (unsigned long long) _value);
+							return;
+						case Length_z:
+							AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (size_t) _value);
+							return;
+						case Length_j:
+							AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (uintmax_t) _value);
+							return;
+						case Length_t:
+							AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (ptrdiff_t) _value);
+							return;
+						default:
+							AppendFormatted(o_text, _spec, _stars, _conv.m_stars, (unsigned int) _value);
+							return;
+					}
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::EncodeArgs>
+// Capture the arguments consumed by a format string
+//-----------------------------------------------------------------------------
+			bool LogFormatter::EncodeArgs(char const* _format, va_list _args, uint8* _buffer, uint32 const _bufferSize, uint32* o_length)
+			{
+				ArgWriter writer(_buffer, _bufferSize);
+				for (char const* p = _format; *p != '\0'; ++p)
+				{
+					if (*p != '%')
+					{
+						continue;
+					}
+
+					Conversion conv;
+					if (!ParseConversion(p, &conv))
+					{
+						return false;
+					}
+					p += conv.m_length - 1;
+					if (conv.m_type == '%')
+					{
+						continue;
+					}
+
+					int32 precision = conv.m_precision;
+					for (uint32 i = 0; i < conv.m_stars; ++i)
+					{
+						int star = va_arg(_args, int);
+						writer.PutInt(star);
+						if (conv.m_starPrecision && (i == conv.m_stars - 1))
+						{
+							precision = star;
+						}
+					}
+
+					switch (conv.m_type)
+					{
+						case 'd':
+						case 'i':
+						{
+							switch (conv.m_lengthModifier)
+							{
+								case Length_l:
+									writer.PutInt(va_arg(_args, long));
+									break;
+								case Length_ll:
+									writer.PutInt(va_arg(_args, long long));
+									break;
+								case Length_z:
+									writer.PutInt((int64) va_arg(_args, size_t));
+									break;
+								case Length_j:
+									writer.PutInt(va_arg(_args, intmax_t));
+									break;
+								case Length_t:
+									writer.PutInt(va_arg(_args, ptrdiff_t));
+									break;
+								default:
+									writer.PutInt(va_arg(_args, int));
+									break;
+							}
+							break;
+						}
+						case 'o':
+						case 'u':
+						case 'x':
+						case 'X':
+						{
+							switch (conv.m_lengthModifier)
+							{
+								case Length_l:
+									writer.PutInt((int64) va_arg(_args, unsigned long));
+									break;
+								case Length_ll:
+									writer.PutInt((int64) va_arg(_args, unsigned long long));
+									break;
+								case Length_z:
+									writer.PutInt((int64) va_arg(_args, size_t));
+									break;
+								case Length_j:
+									writer.PutInt((int64) va_arg(_args, uintmax_t));
+									break;
+								case Length_t:
+									writer.PutInt(va_arg(_args, ptrdiff_t));
+									break;
+								default:
+									writer.PutInt(va_arg(_args, unsigned int));
+									break;
+							}
+							break;
+						}
+						case 'c':
+						case 'C':
+						{
+							if ((conv.m_type == 'C') || (conv.m_lengthModifier == Length_l))
+							{
+								writer.PutInt(va_arg(_args, unsigned int));		// wint_t after promotion
+							}
+							else
+							{
+								writer.PutInt(va_arg(_args, int));
+							}
+							break;
+						}
+						case 'e':
+						case 'E':
+						case 'f':
+						case 'F':
+						case 'g':
+						case 'G':
+						case 'a':
+						case 'A':
+						{
+							if (conv.m_lengthModifier == Length_L)
+							{
+								writer.PutDouble((double) va_arg(_args, long double));
+							}
+							else
+							{
+								writer.PutDouble(va_arg(_args, double));
+							}
+							break;
+						}
+						case 's':
+						case 'S':
+						{
+							if ((conv.m_type == 'S') || (conv.m_lengthModifier == Length_l))
+							{
+								writer.PutWideString(va_arg(_args, wchar_t const*), precision);
+							}
+							else
+							{
+								writer.PutString(va_arg(_args, char const*), precision);
+							}
+							break;
+						}
+						case 'p':
+						{
+							writer.PutPointer(va_arg(_args, void const*));
+							break;
+						}
+						case 'n':
+						{
+							// Never written to, and produces no output
+							(void) va_arg(_args, void*);
+							break;
+						}
+					}
+
+					if (writer.Overflowed())
+					{
+						return false;
+					}
+				}
+
+				*o_length = writer.GetLength();
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::FormatArgs>
+// Format a message from a format string and its encoded arguments
+//-----------------------------------------------------------------------------
+			bool LogFormatter::FormatArgs(char const* _format, uint8 const* _args, uint32 const _argsLength, string* o_text)
+			{
+				ArgReader reader(_args, _argsLength);
+				char const* literal = _format;
+				char const* p = _format;
+				while (*p != '\0')
+				{
+					if (*p != '%')
+					{
+						++p;
+						continue;
+					}
+
+					o_text->append(literal, p - literal);
+					Conversion conv;
+					if (!ParseConversion(p, &conv))
+					{
+						o_text->append(p);
+						return false;
+					}
+					string spec(p, conv.m_length);
+					p += conv.m_length;
+					literal = p;
+
+					int stars[2] =
+					{ 0, 0 };
+					for (uint32 i = 0; i < conv.m_stars; ++i)
+					{
+						stars[i] = (int) reader.GetInt();
+					}
+
+					switch (conv.m_type)
+					{
+						case '%':
+						{
+							o_text->append("%");
+							break;
+						}
+						case 'd':
+						case 'i':
+						case 'o':
+						case 'u':
+						case 'x':
+						case 'X':
+						{
+							AppendInteger(o_text, conv, spec, stars, reader.GetInt());
+							break;
+						}
+						case 'c':
+						case 'C':
+						{
+							if ((conv.m_type == 'C') || (conv.m_lengthModifier == Length_l))
+							{
+								AppendFormatted(o_text, spec, stars, conv.m_stars, (wint_t) reader.GetInt());
+							}
+							else
+							{
+								AppendFormatted(o_text, spec, stars, conv.m_stars, (int) reader.GetInt());
+							}
+							break;
+						}
+						case 'e':
+						case 'E':
+						case 'f':
+						case 'F':
+						case 'g':
+						case 'G':
+						case 'a':
+						case 'A':
+						{
+							if (conv.m_lengthModifier == Length_L)
+							{
+								AppendFormatted(o_text, spec, stars, conv.m_stars, (long double) reader.GetDouble());
+							}
+							else
+							{
+								AppendFormatted(o_text, spec, stars, conv.m_stars, reader.GetDouble());
+							}
+							break;
+						}
+						case 's':
+						case 'S':
+						{
+							if ((conv.m_type == 'S') || (conv.m_lengthModifier == Length_l))
+							{
+								std::wstring value = reader.GetWideString();
+								AppendFormatted(o_text, spec, stars, conv.m_stars, value.c_str());
+							}
+							else
+							{
+								string value = reader.GetString();
+								AppendFormatted(o_text, spec, stars, conv.m_stars, value.c_str());
+							}
+							break;
+						}
+						case 'p':
+						{
+							AppendFormatted(o_text, spec, stars, conv.m_stars, reader.GetPointer());
+							break;
+						}
+						default:
+						{
+							// %n
+							break;
+						}
+					}
+
+					if (reader.Failed())
+					{
+						o_text->append(literal);
+						return false;
+					}
+				}
+				o_text->append(literal, p - literal);
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::GetTime>
+// Current time in microseconds since the epoch
+//-----------------------------------------------------------------------------
+			uint64 LogFormatter::GetTime()
+			{
+				return (uint64) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::GetLine>
+// Build a complete log line
+//-----------------------------------------------------------------------------
+			string LogFormatter::GetLine(uint64 const _time, uint64 const _threadId, LogLevel const _level, uint8 const _nodeId, string const& _message, bool const _queued)
+			{
+				string line;
+				if (_level != LogLevel_Internal)
+				{
+					line.append(GetTimeStampString(_time));
+					if (_queued)
+					{
+						line.append(GetThreadIdString(_threadId));
+					}
+					else
+					{
+						line.append(GetLogLevelString(_level));
+						line.append(GetNodeString(_nodeId));
+					}
+				}
+				line.append(_message);
+				line.append("\n");
+				return line;
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::GetTimeStampString>
+// Generate a string with formatted time
+//-----------------------------------------------------------------------------
+			string LogFormatter::GetTimeStampString(uint64 const _time)
+			{
+				time_t seconds = (time_t) (_time / 1000000);
+				int milliseconds = (int) ((_time / 1000) % 1000);
+				struct tm tm;
+				memset(&tm, 0, sizeof(tm));
+#ifdef _WIN32
+				localtime_s(&tm, &seconds);
+#else
+				localtime_r(&seconds, &tm);
+#endif
+
+				char buf[100];
+				snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d.%03d ", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, milliseconds);
+				return buf;
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::GetNodeString>
+// Generate a string with formatted node id
+//-----------------------------------------------------------------------------
+			string LogFormatter::GetNodeString(uint8 const _nodeId)
+			{
+				if (_nodeId == 0)
+				{
+					return "";
+				}
+				else if (_nodeId == 255)
+				{
+					return "contrlr, ";
+				}
+				else
+				{
+					char buf[20];
+					snprintf(buf, sizeof(buf), "Node%03d, ", _nodeId);
+					return buf;
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::GetThreadIdString>
+// Generate a string with formatted thread id
+//-----------------------------------------------------------------------------
+			string LogFormatter::GetThreadIdString(uint64 const _threadId)
+			{
+				char buf[24];
+				snprintf(buf, sizeof(buf), "%08llx ", (unsigned long long) _threadId);
+				return buf;
+			}
+
+//-----------------------------------------------------------------------------
+// <LogFormatter::GetLogLevelString>
+// Generate a string with the name of a log level
+//-----------------------------------------------------------------------------
+			string LogFormatter::GetLogLevelString(LogLevel const _level)
+			{
+				if ((_level >= LogLevel_None) && (_level <= LogLevel_Internal))
+				{
+					char buf[20];
+					snprintf(buf, sizeof(buf), "%s, ", LogLevelString[_level]);
+					return buf;
+				}
+				return "Unknown, ";
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+//
+//	LogFormatter.h
+//
+//	Deferred formatting of log messages, shared by the asynchronous log and
+//	the binary log decoder
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _LogFormatter_H
+#define _LogFormatter_H
+
+#include <stdarg.h>
+#include <string>
+#include "Defs.h"
+#include "platform/Log.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			/** \brief Captures the arguments of a printf style log call so the message can be
+			 * formatted later, possibly on another thread or in another process.
+			 * \ingroup Platform
+			 *
+			 * The encoded arguments are a sequence of tagged values, one for every argument the
+			 * format consumes (including '*' widths and precisions).  Strings are copied, so the
+			 * encoding stays valid after the caller has returned.  Integers and pointers are
+			 * widened to 64 bits and wide strings to 32 bit code units, so the encoding does not
+			 * depend on the size of long or wchar_t.
+			 *
+			 * The line layout helpers produce the same text as the standard log.
+			 */
+			class LogFormatter
+			{
+				public:
+					/**
+					 * Encode the arguments consumed by _format.
+					 * \return false if the format uses a conversion that cannot be captured (such
+					 * as positional arguments), or the arguments do not fit in _bufferSize bytes.
+					 */
+					static bool EncodeArgs(char const* _format, va_list _args, uint8* _buffer, uint32 const _bufferSize, uint32* o_length);
+
+					/**
+					 * Append the message described by _format and arguments produced by EncodeArgs
+					 * to o_text.
+					 * \return false if the arguments do not match the format.  Whatever could be
+					 * formatted is still appended.
+					 */
+					static bool FormatArgs(char const* _format, uint8 const* _args, uint32 const _argsLength, string* o_text);
+
+					/**
+					 * Current wall clock time, in microseconds since the epoch.
+					 */
+					static uint64 GetTime();
+
+					/**
+					 * Build a complete log line, with the timestamp, level and node prefix the
+					 * standard log uses.  Queued messages that are being dumped are prefixed with
+					 * the timestamp and thread id instead, and LogLevel_Internal messages have no
+					 * prefix at all.
+					 */
+					static string GetLine(uint64 const _time, uint64 const _threadId, LogLevel const _level, uint8 const _nodeId, string const& _message, bool const _queued);
+
+					static string GetTimeStampString(uint64 const _time);
+					static string GetNodeString(uint8 const _nodeId);
+					static string GetThreadIdString(uint64 const _threadId);
+					static string GetLogLevelString(LogLevel const _level);
+			};
+
+			/** \brief Layout of the binary log file written by AsyncLog.
+			 * \ingroup Platform
+			 *
+			 * The file starts with the magic string, the byte order marker and the version.
+			 * Every record then starts with a one byte RecordType.  All values are written
+			 * in the byte order of the machine that wrote the log.
+			 *
+			 * - Record_Session: uint64 time.  Format ids are reset, as a log that is appended
+			 *   to holds several sessions.
+			 * - Record_Format: uint32 id, uint16 length, then the format string (no NUL).
+			 * - Record_Message: uint64 sequence, uint64 time, uint64 thread id, uint32 format
+			 *   id, uint8 level, uint8 node id, uint8 flags, uint16 length, then the arguments
+			 *   from LogFormatter::EncodeArgs, or the finished text if the format id is
+			 *   c_textFormat.
+			 * - Record_Dropped: uint64 time, uint32 number of messages lost because the
+			 *   log could not keep up.
+			 */
+			namespace BinaryLog
+			{
+				static char const c_magic[8] =
+				{ 'O', 'Z', 'W', 'B', 'L', 'O', 'G', '\0' };
+				static uint32 const c_byteOrder = 0x01020304;
+				static uint32 const c_version = 1;
+
+				enum RecordType
+				{
+					Record_Session = 1,
+					Record_Format,
+					Record_Message,
+					Record_Dropped
+				};
+
+				static uint32 const c_textFormat = 0xffffffff;		// The message was formatted when it was logged
+				static uint8 const c_flagQueued = 0x01;				// The message was held in the queue and written by a dump
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_LogFormatter_H
@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+//
+//	SharedMutex.cpp
+//
+//	Cross-platform reader/writer lock
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include "Defs.h"
+#include "platform/SharedMutex.h"
+
+#ifdef WIN32
+#include "platform/windows/SharedMutexImpl.h"	// Platform-specific implementation of a reader/writer lock
+#elif defined WINRT
+#include "platform/winRT/SharedMutexImpl.h"	// Platform-specific implementation of a reader/writer lock
+#else
+#include "platform/unix/SharedMutexImpl.h"	// Platform-specific implementation of a reader/writer lock
+#endif
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<SharedMutex::SharedMutex>
+//	Constructor
+//-----------------------------------------------------------------------------
+			SharedMutex::SharedMutex() :
+					m_pImpl(new SharedMutexImpl()), m_owner(std::thread::id()), m_depth(0)
+			{
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutex::~SharedMutex>
+//	Destructor
+//-----------------------------------------------------------------------------
+			SharedMutex::~SharedMutex()
+			{
+				delete m_pImpl;
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutex::LockShared>
+//	Lock the mutex in shared mode
+//-----------------------------------------------------------------------------
+			void SharedMutex::LockShared()
+			{
+				if (m_owner == std::this_thread::get_id())
+				{
+					// We already hold it exclusively, which covers the shared access
+					++m_depth;
+					return;
+				}
+				m_pImpl->LockShared();
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutex::UnlockShared>
+//	Release a shared lock
+//-----------------------------------------------------------------------------
+			void SharedMutex::UnlockShared()
+			{
+				if (m_owner == std::this_thread::get_id())
+				{
+					Unlock();
+					return;
+				}
+				m_pImpl->UnlockShared();
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutex::Lock>
+//	Lock the mutex in exclusive mode
+//-----------------------------------------------------------------------------
+			void SharedMutex::Lock()
+			{
+				if (m_owner == std::this_thread::get_id())
+				{
+					++m_depth;
+					return;
+				}
+				m_pImpl->Lock();
+				m_owner = std::this_thread::get_id();
+				m_depth = 1;
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutex::Unlock>
+//	Release an exclusive lock
+//-----------------------------------------------------------------------------
+			void SharedMutex::Unlock()
+			{
+				if (--m_depth == 0)
+				{
+					m_owner = std::thread::id();
+					m_pImpl->Unlock();
+				}
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+//
+//	SharedMutex.h
+//
+//	Cross-platform reader/writer lock
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _SharedMutex_H
+#define _SharedMutex_H
+
+#include <atomic>
+#include <thread>
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class SharedMutexImpl;
+
+			/** \brief Implements a platform-independent reader/writer lock.
+			 *
+			 * Any number of threads can hold the lock in shared mode at once, or one
+			 * thread can hold it in exclusive mode.  The thread that holds it in
+			 * exclusive mode may take it again, in either mode, and must release it
+			 * the same number of times.  A thread that holds it only in shared mode
+			 * must not take it again in either mode.
+			 * \ingroup Platform
+			 */
+			class SharedMutex
+			{
+				public:
+					SharedMutex();
+					~SharedMutex();
+
+					/**
+					 * Lock the mutex in shared mode, waiting for any exclusive owner to release it.
+					 * \see UnlockShared
+					 */
+					void LockShared();
+
+					/**
+					 * Release a shared lock.
+					 * \see LockShared
+					 */
+					void UnlockShared();
+
+					/**
+					 * Lock the mutex in exclusive mode, waiting for every other owner to release it.
+					 * \see Unlock
+					 */
+					void Lock();
+
+					/**
+					 * Release an exclusive lock.
+					 * \see Lock
+					 */
+					void Unlock();
+
+				private:
+					SharedMutex(SharedMutex const&);					// prevent copy
+					SharedMutex& operator =(SharedMutex const&);		// prevent assignment
+
+					SharedMutexImpl* m_pImpl;			// Pointer to an object that encapsulates the platform-specific implementation of a reader/writer lock.
+					atomic<std::thread::id> m_owner;	// Thread holding the lock in exclusive mode, if any
+					uint32 m_depth;						// Number of times the exclusive owner has taken the lock
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_SharedMutex_H
+
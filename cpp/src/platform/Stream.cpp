@@ -44,11 +44,20 @@ namespace OpenZWave
 //	<Stream::Stream>
 //	Constructor
 //-----------------------------------------------------------------------------
-			Stream::Stream(uint32 _bufferSize) :
-					m_bufferSize(_bufferSize), m_signalSize(1), m_dataSize(0), m_head(0), m_tail(0), m_mutex(new Mutex())
+			Stream::Stream(uint32 _bufferSize, bool _singleProducerConsumer // = false
+					) :
+					m_bufferSize(_bufferSize), m_bufferMask(0), m_signalSize(1), m_head(0), m_tail(0), m_notified(false), m_mutex(_singleProducerConsumer ? NULL : new Mutex())
 			{
-				m_buffer = new uint8[m_bufferSize];
-				memset(m_buffer, 0x00, m_bufferSize);
+				// Allocate a power of two so that the free-running head and tail
+				// counters can be turned into buffer offsets with a mask.
+				uint32 allocSize = 1;
+				while (allocSize < m_bufferSize)
+				{
+					allocSize <<= 1;
+				}
+				m_bufferMask = allocSize - 1;
+				m_buffer = new uint8[allocSize];
+				memset(m_buffer, 0x00, allocSize);
 			}
 
 //-----------------------------------------------------------------------------
@@ -57,7 +66,10 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			Stream::~Stream()
 			{
-				m_mutex->Release();
+				if (m_mutex)
+				{
+					m_mutex->Release();
+				}
 				delete[] m_buffer;
 			}
 
@@ -68,9 +80,11 @@ namespace OpenZWave
 			void Stream::SetSignalThreshold(uint32 _size)
 			{
 				m_signalSize = _size;
+				m_notified = false;
 				if (IsSignalled())
 				{
 					// We have more data than we are waiting for, so notify the watchers
+					m_notified = true;
 					Notify();
 				}
 			}
@@ -81,35 +95,40 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool Stream::Get(uint8* _buffer, uint32 _size)
 			{
-				if (m_dataSize < _size)
+				if (m_mutex)
+				{
+					m_mutex->Lock();
+				}
+
+				uint32 tail = m_tail.load(std::memory_order_relaxed);
+				if ((m_head - tail) < _size)
 				{
 					// There is not enough data in the buffer to fulfill the request
+					if (m_mutex)
+					{
+						m_mutex->Unlock();
+					}
 					Log::Write(LogLevel_Error, "ERROR: Not enough data in stream buffer");
 					return false;
 				}
 
-				m_mutex->Lock();
-				if ((m_tail + _size) > m_bufferSize)
-				{
-					// We will have to wrap around
-					uint32 block1 = m_bufferSize - m_tail;
-					uint32 block2 = _size - block1;
+				CopyOut(_buffer, tail, _size);
+				LogData(_buffer, _size, "      Read (buffer->application): ");
 
-					memcpy(_buffer, &m_buffer[m_tail], block1);
-					memcpy(&_buffer[block1], m_buffer, block2);
-					m_tail = block2;
-				}
-				else
+				// Publish the space to the producer only once the data has been copied out
+				m_tail = tail + _size;
+
+				if (!IsSignalled())
 				{
-					// Requested data is in a contiguous block
-					memcpy(_buffer, &m_buffer[m_tail], _size);
-					m_tail += _size;
+					// We have dropped below the threshold, so the next time it is reached
+					// the watchers need to be told about it again.
+					m_notified = false;
 				}
 
-				LogData(_buffer, _size, "      Read (buffer->application): ");
-
-				m_dataSize -= _size;
-				m_mutex->Unlock();
+				if (m_mutex)
+				{
+					m_mutex->Unlock();
+				}
 				return true;
 			}
 
@@ -119,44 +138,40 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool Stream::Put(uint8* _buffer, uint32 _size)
 			{
-				if ((m_bufferSize - m_dataSize) < _size)
+				if (m_mutex)
+				{
+					m_mutex->Lock();
+				}
+
+				uint32 head = m_head.load(std::memory_order_relaxed);
+				if ((m_bufferSize - (head - m_tail)) < _size)
 				{
 					// There is not enough space left in the buffer for the data
+					if (m_mutex)
+					{
+						m_mutex->Unlock();
+					}
 					Log::Write(LogLevel_Error, "ERROR: Not enough space in stream buffer");
 					return false;
 				}
 
-				m_mutex->Lock();
-				if ((m_head + _size) > m_bufferSize)
-				{
-					// We will have to wrap around
-					uint32 block1 = m_bufferSize - m_head;
-					uint32 block2 = _size - block1;
-
-					memcpy(&m_buffer[m_head], _buffer, block1);
-					memcpy(m_buffer, &_buffer[block1], block2);
-					uint8 * logpos = m_buffer + m_head;
-					m_head = block2;
-					LogData(logpos, block1, "      Read (controller->buffer):  ");
-					LogData(m_buffer, block2, "      Read (controller->buffer):  ");
-				}
-				else
-				{
-					// There is enough space before we reach the end of the buffer
-					memcpy(&m_buffer[m_head], _buffer, _size);
-					m_head += _size;
-					LogData(m_buffer + m_head - _size, _size, "      Read (controller->buffer):  ");
-				}
+				CopyIn(_buffer, head, _size);
 
-				m_dataSize += _size;
+				// Publish the data to the consumer only once it has been copied in
+				m_head = head + _size;
 
-				if (IsSignalled())
+				if (IsSignalled() && !m_notified.exchange(true))
 				{
-					// We now have more data than we are waiting for, so notify the watchers
+					// We now have more data than we are waiting for, so notify the watchers.
+					// If they have already been told and the consumer has not yet drained
+					// the stream below the threshold, there is nothing new to say.
 					Notify();
 				}
 
-				m_mutex->Unlock();
+				if (m_mutex)
+				{
+					m_mutex->Unlock();
+				}
 				return true;
 			}
 
@@ -166,9 +181,16 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void Stream::Purge()
 			{
-				m_tail = 0;
-				m_head = 0;
-				m_dataSize = 0;
+				if (m_mutex)
+				{
+					m_mutex->Lock();
+				}
+				m_tail = m_head.load();
+				m_notified = false;
+				if (m_mutex)
+				{
+					m_mutex->Unlock();
+				}
 			}
 
 //-----------------------------------------------------------------------------
@@ -177,7 +199,52 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool Stream::IsSignalled()
 			{
-				return (m_dataSize >= m_signalSize);
+				return (GetDataSize() >= m_signalSize);
+			}
+
+//-----------------------------------------------------------------------------
+//	<Stream::CopyOut>
+//	Copy data out of the ring, starting at the free-running position _pos
+//-----------------------------------------------------------------------------
+			void Stream::CopyOut(uint8* _buffer, uint32 _pos, uint32 _size)
+			{
+				uint32 offset = _pos & m_bufferMask;
+				uint32 block1 = m_bufferMask + 1 - offset;
+				if (block1 >= _size)
+				{
+					// Requested data is in a contiguous block
+					memcpy(_buffer, &m_buffer[offset], _size);
+				}
+				else
+				{
+					// We will have to wrap around
+					memcpy(_buffer, &m_buffer[offset], block1);
+					memcpy(&_buffer[block1], m_buffer, _size - block1);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<Stream::CopyIn>
+//	Copy data into the ring, starting at the free-running position _pos
+//-----------------------------------------------------------------------------
+			void Stream::CopyIn(uint8* _buffer, uint32 _pos, uint32 _size)
+			{
+				uint32 offset = _pos & m_bufferMask;
+				uint32 block1 = m_bufferMask + 1 - offset;
+				if (block1 >= _size)
+				{
+					// There is enough space before we reach the end of the buffer
+					memcpy(&m_buffer[offset], _buffer, _size);
+					LogData(&m_buffer[offset], _size, "      Read (controller->buffer):  ");
+				}
+				else
+				{
+					// We will have to wrap around
+					memcpy(&m_buffer[offset], _buffer, block1);
+					memcpy(m_buffer, &_buffer[block1], _size - block1);
+					LogData(&m_buffer[offset], block1, "      Read (controller->buffer):  ");
+					LogData(m_buffer, _size - block1, "      Read (controller->buffer):  ");
+				}
 			}
 
 //-----------------------------------------------------------------------------
@@ -186,7 +253,7 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void Stream::LogData(uint8* _buffer, uint32 _length, const string &_function)
 			{
-				if (!_length)
+				if (!_length || !Log::IsLevelEnabled(LogLevel_StreamDetail))
 					return;
 
 				string str = "";
@@ -32,6 +32,7 @@
 #include "platform/Wait.h"
 
 #include <string>
+#include <atomic>
 
 namespace OpenZWave
 {
@@ -43,6 +44,12 @@ namespace OpenZWave
 
 			/** \brief Platform-independent definition of a circular buffer.
 			 * \ingroup Platform
+			 *
+			 * When created with _singleProducerConsumer set, the stream takes no locks.
+			 * Exactly one thread may call Put, and exactly one other thread may call Get,
+			 * Purge and SetSignalThreshold.  The head and tail are published with atomics,
+			 * and the watchers are only notified when the stream becomes signalled, rather
+			 * than on every Put.
 			 */
 			class Stream: public Wait
 			{
@@ -52,8 +59,10 @@ namespace OpenZWave
 					/**
 					 * Constructor.
 					 * Creates a cross-platform ring buffer object
+					 * \param _bufferSize the capacity of the buffer in bytes.
+					 * \param _singleProducerConsumer true to use the lock-free single-producer/single-consumer mode.
 					 */
-					Stream(uint32 _bufferSize);
+					Stream(uint32 _bufferSize, bool _singleProducerConsumer = false);
 
 					/**
 					 * Set the number of bytes the buffer must contain before it becomes signalled.
@@ -93,7 +102,7 @@ namespace OpenZWave
 					 */
 					uint32 GetDataSize() const
 					{
-						return m_dataSize;
+						return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
 					}
 
 					/**
@@ -127,13 +136,17 @@ namespace OpenZWave
 					Stream(Stream const&);					// prevent copy
 					Stream& operator =(Stream const&);		// prevent assignment
 
+					void CopyOut(uint8* _buffer, uint32 _pos, uint32 _size);
+					void CopyIn(uint8* _buffer, uint32 _pos, uint32 _size);
+
 					uint8* m_buffer;
-					uint32 m_bufferSize;
-					uint32 m_signalSize;
-					uint32 m_dataSize;
-					uint32 m_head;
-					uint32 m_tail;
-					Mutex* m_mutex;
+					uint32 m_bufferSize;				// Capacity requested by the owner
+					uint32 m_bufferMask;				// Allocated size (a power of two) minus one
+					std::atomic<uint32> m_signalSize;
+					std::atomic<uint32> m_head;			// Free-running count of bytes written.  Only modified by the producer.
+					std::atomic<uint32> m_tail;			// Free-running count of bytes read.  Only modified by the consumer.
+					std::atomic<bool> m_notified;		// Watchers have been notified since the stream was last below the threshold
+					Mutex* m_mutex;						// NULL in single-producer/single-consumer mode
 			};
 		} // namespace Platform
 	} // namespace Internal
@@ -115,6 +115,20 @@ namespace OpenZWave
 			{
 				uint32 i;
 
+				// If an object is already signalled there is nothing to wait for, so
+				// skip creating the event and adding the watchers.
+				for (i = 0; i < _numObjects; ++i)
+				{
+					if (_objects[i]->IsSignalled())
+					{
+						return (int32) i;
+					}
+				}
+				if (_timeout == 0)
+				{
+					return -1;
+				}
+
 				// Create an event that will be set when any of the objects in the list becomes signalled.
 				Event* waitEvent = new Event();
 
@@ -46,6 +46,7 @@ namespace OpenZWave
 			class Wait: public Ref
 			{
 					friend class WaitImpl;
+					friend class WaitSet;
 					friend class ThreadImpl;
 
 				public:
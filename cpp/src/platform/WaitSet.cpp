@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+//
+//	WaitSet.cpp
+//
+//	Cross-platform set of wait objects with persistent registration
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include "Defs.h"
+#include "platform/WaitSet.h"
+
+#ifdef WIN32
+#include "platform/windows/WaitSetImpl.h"	// Platform-specific implementation of a WaitSet wakeup
+#elif defined WINRT
+#include "platform/winRT/WaitSetImpl.h"	// Platform-specific implementation of a WaitSet wakeup
+#else
+#include "platform/unix/WaitSetImpl.h"	// Platform-specific implementation of a WaitSet wakeup
+#endif
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::WaitSet>
+//	Constructor
+//-----------------------------------------------------------------------------
+			WaitSet::WaitSet() :
+					m_pImpl(new WaitSetImpl())
+			{
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::~WaitSet>
+//	Destructor
+//-----------------------------------------------------------------------------
+			WaitSet::~WaitSet()
+			{
+				for (std::vector<Wait*>::iterator it = m_objects.begin(); it != m_objects.end(); ++it)
+				{
+					(*it)->RemoveWatcher(WaitSetCallback, this);
+					(*it)->Release();
+				}
+				delete m_pImpl;
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::Add>
+//	Add an object to the set and register our watcher on it
+//-----------------------------------------------------------------------------
+			uint32 WaitSet::Add(Wait* _object)
+			{
+				_object->AddRef();
+				m_objects.push_back(_object);
+				_object->AddWatcher(WaitSetCallback, this);
+				return (uint32) (m_objects.size() - 1);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::FindSignalled>
+//	Return the index of the first signalled object, or -1
+//-----------------------------------------------------------------------------
+			int32 WaitSet::FindSignalled(uint32 _numObjects)
+			{
+				if (_numObjects > m_objects.size())
+				{
+					_numObjects = (uint32) m_objects.size();
+				}
+				for (uint32 i = 0; i < _numObjects; ++i)
+				{
+					if (m_objects[i]->IsSignalled())
+					{
+						return (int32) i;
+					}
+				}
+				return -1;
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::Multiple>
+//	Wait for one of the first _numObjects objects to become signalled
+//-----------------------------------------------------------------------------
+			int32 WaitSet::Multiple(uint32 _numObjects, int32 _timeout // = -1
+					)
+			{
+				if (_timeout > 0)
+				{
+					m_deadline.SetTime(_timeout);
+				}
+
+				while (true)
+				{
+					// Consume any pending wakeup before scanning.  A watcher that fires
+					// after this point leaves the wakeup set, so the wait below returns
+					// immediately and we rescan rather than missing the signal.
+					m_pImpl->Reset();
+
+					int32 res = FindSignalled(_numObjects);
+					if (res >= 0)
+					{
+						return res;
+					}
+
+					int32 remaining = _timeout;
+					if (_timeout > 0)
+					{
+						remaining = m_deadline.TimeRemaining();
+						if (remaining <= 0)
+						{
+							return -1;
+						}
+					}
+					else if (_timeout == 0)
+					{
+						return -1;
+					}
+
+					if (!m_pImpl->Wait(remaining))
+					{
+						// Timed out
+						return -1;
+					}
+
+					// Something in the set was signalled, although it may be an object beyond
+					// _numObjects.  Go round again and find out.
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSet::WaitSetCallback>
+//	Watcher callback, called by the objects in the set when they are signalled
+//-----------------------------------------------------------------------------
+			void WaitSet::WaitSetCallback(void* _context)
+			{
+				WaitSet* waitSet = (WaitSet*) _context;
+				waitSet->m_pImpl->Set();
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------
+//
+//	WaitSet.h
+//
+//	Cross-platform set of wait objects with persistent registration
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _WaitSet_H
+#define _WaitSet_H
+
+#include <vector>
+#include "Defs.h"
+#include "platform/Wait.h"
+#include "platform/TimeStamp.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class WaitSetImpl;
+
+			/** \brief A reusable set of Wait objects.
+			 *
+			 * Wait::Multiple creates an Event and adds and removes a watcher on every
+			 * object each time it is called.  A WaitSet registers its watcher once, when
+			 * the object is added, and keeps it for its lifetime.  Waiting on the set
+			 * only blocks on a single platform wakeup primitive (an eventfd on Linux)
+			 * and then scans the objects in order, so threads that wait in a loop do
+			 * no allocation and no watcher list manipulation per iteration.
+			 * \ingroup Platform
+			 */
+			class WaitSet
+			{
+				public:
+					WaitSet();
+					~WaitSet();
+
+					/**
+					 * Add an object to the set.  The set holds a reference on the object
+					 * until the set is destroyed.
+					 * \param _object pointer to the object to wait on.
+					 * \return the index of the object in the set.
+					 */
+					uint32 Add(Wait* _object);
+
+					/**
+					 * Wait for one of the first _numObjects objects in the set to become
+					 * signalled.  If more than one object is in a signalled state, the lowest
+					 * index will be returned.
+					 * \param _numObjects number of objects (counted from index zero) to consider.
+					 * \param _timeout optional maximum time to wait.  Defaults to -1, which means wait forever.
+					 * \return index of the object that was signalled, -1 if the wait timed out.
+					 */
+					int32 Multiple(uint32 _numObjects, int32 _timeout = -1);
+
+					/**
+					 * Return the number of objects in the set.
+					 */
+					uint32 Size() const
+					{
+						return (uint32) m_objects.size();
+					}
+
+				private:
+					WaitSet(WaitSet const&);					// prevent copy
+					WaitSet& operator =(WaitSet const&);		// prevent assignment
+
+					int32 FindSignalled(uint32 _numObjects);
+					static void WaitSetCallback(void* _context);
+
+					std::vector<Wait*> m_objects;
+					TimeStamp m_deadline;
+					WaitSetImpl* m_pImpl;				// Pointer to an object that encapsulates the platform-specific wakeup primitive.
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_WaitSet_H
+
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+//
+//	SharedMutexImpl.cpp
+//
+//	POSIX implementation of the cross-platform reader/writer lock
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include "Defs.h"
+#include "platform/Log.h"
+#include "SharedMutexImpl.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::SharedMutexImpl>
+//	Constructor
+//-----------------------------------------------------------------------------
+			SharedMutexImpl::SharedMutexImpl()
+			{
+				int err = pthread_rwlock_init(&m_lock, NULL);
+				if (err != 0)
+				{
+					Log::Write(LogLevel_Error, "SharedMutexImpl::SharedMutexImpl error %d", err);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::~SharedMutexImpl>
+//	Destructor
+//-----------------------------------------------------------------------------
+			SharedMutexImpl::~SharedMutexImpl()
+			{
+				pthread_rwlock_destroy(&m_lock);
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::LockShared>
+//	Lock the mutex in shared mode
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::LockShared()
+			{
+				int err = pthread_rwlock_rdlock(&m_lock);
+				if (err != 0)
+				{
+					Log::Write(LogLevel_Error, "SharedMutexImpl::LockShared error %d", err);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::UnlockShared>
+//	Release a shared lock
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::UnlockShared()
+			{
+				pthread_rwlock_unlock(&m_lock);
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::Lock>
+//	Lock the mutex in exclusive mode
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::Lock()
+			{
+				int err = pthread_rwlock_wrlock(&m_lock);
+				if (err != 0)
+				{
+					Log::Write(LogLevel_Error, "SharedMutexImpl::Lock error %d", err);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::Unlock>
+//	Release an exclusive lock
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::Unlock()
+			{
+				pthread_rwlock_unlock(&m_lock);
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------
+//
+//	WaitSetImpl.cpp
+//
+//	POSIX implementation of the WaitSet wakeup primitive
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include "Defs.h"
+#include "WaitSetImpl.h"
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::WaitSetImpl>
+//	Constructor
+//-----------------------------------------------------------------------------
+			WaitSetImpl::WaitSetImpl() :
+					m_readFd(-1), m_writeFd(-1), m_pending(false)
+			{
+#ifdef __linux__
+				m_readFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+				if (m_readFd < 0)
+				{
+					fprintf(stderr, "WaitSetImpl eventfd error %s\n", strerror(errno));
+					assert(0);
+				}
+				m_writeFd = m_readFd;
+#else
+				int fds[2];
+				if (pipe(fds) != 0)
+				{
+					fprintf(stderr, "WaitSetImpl pipe error %s\n", strerror(errno));
+					assert(0);
+				}
+				for (int i = 0; i < 2; ++i)
+				{
+					fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+					fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+				}
+				m_readFd = fds[0];
+				m_writeFd = fds[1];
+#endif
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::~WaitSetImpl>
+//	Destructor
+//-----------------------------------------------------------------------------
+			WaitSetImpl::~WaitSetImpl()
+			{
+				if (m_writeFd != m_readFd)
+				{
+					close(m_writeFd);
+				}
+				close(m_readFd);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::Set>
+//	Wake the waiting thread.  Called from the watcher callbacks, so it may run
+//	on any thread and must not block.
+//-----------------------------------------------------------------------------
+			void WaitSetImpl::Set()
+			{
+				if (m_pending.exchange(true))
+				{
+					// A wakeup is already pending
+					return;
+				}
+#ifdef __linux__
+				uint64_t one = 1;
+				ssize_t res = write(m_writeFd, &one, sizeof(one));
+#else
+				char one = 1;
+				ssize_t res = write(m_writeFd, &one, sizeof(one));
+#endif
+				if (res < 0 && errno != EAGAIN)
+				{
+					fprintf(stderr, "WaitSetImpl::Set write error %s\n", strerror(errno));
+				}
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::Reset>
+//	Consume any pending wakeup
+//-----------------------------------------------------------------------------
+			void WaitSetImpl::Reset()
+			{
+				if (!m_pending.load())
+				{
+					return;
+				}
+				// Drain before clearing the flag.  A Set that lands in between skips
+				// its write, but its object is already signalled and the caller scans
+				// the set right after this returns.
+				char buf[64];
+				while (read(m_readFd, buf, sizeof(buf)) > 0)
+				{
+				}
+				m_pending.store(false);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::Wait>
+//	Block until Set is called or the timeout expires
+//-----------------------------------------------------------------------------
+			bool WaitSetImpl::Wait(int32 _timeout)
+			{
+				struct pollfd pfd;
+				pfd.fd = m_readFd;
+				pfd.events = POLLIN;
+				pfd.revents = 0;
+
+				int oldstate;
+				pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &oldstate);
+				int res;
+				do
+				{
+					res = poll(&pfd, 1, _timeout < 0 ? -1 : _timeout);
+				} while (res < 0 && errno == EINTR);
+				pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldstate);
+
+				if (res < 0)
+				{
+					fprintf(stderr, "WaitSetImpl::Wait poll error %s\n", strerror(errno));
+					assert(0);
+					return false;
+				}
+				return (res > 0);
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
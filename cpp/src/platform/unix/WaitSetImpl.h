@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+//
+//	WaitSetImpl.h
+//
+//	POSIX implementation of the WaitSet wakeup primitive
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _WaitSetImpl_H
+#define _WaitSetImpl_H
+
+#include <atomic>
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			/** \brief POSIX specific implementation of the WaitSet wakeup.
+			 *
+			 * On Linux this is a single eventfd.  Other unix platforms use a
+			 * non-blocking self-pipe.  Either way the waiting thread sleeps in
+			 * poll() on one descriptor, and signalling it is one write() that is
+			 * skipped entirely while a wakeup is already pending.
+			 */
+			class WaitSetImpl
+			{
+				private:
+					friend class WaitSet;
+
+					WaitSetImpl();
+					~WaitSetImpl();
+
+					void Set();
+					void Reset();
+					bool Wait(int32 _timeout);
+
+					WaitSetImpl(WaitSetImpl const&);					// prevent copy
+					WaitSetImpl& operator =(WaitSetImpl const&);		// prevent assignment
+
+					int m_readFd;
+					int m_writeFd;
+					std::atomic<bool> m_pending;
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_WaitSetImpl_H
+
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+//
+//	SharedMutexImpl.cpp
+//
+//	WinRT implementation of the cross-platform reader/writer lock
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include <windows.h>
+
+#include "Defs.h"
+#include "SharedMutexImpl.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::SharedMutexImpl>
+//	Constructor
+//-----------------------------------------------------------------------------
+			SharedMutexImpl::SharedMutexImpl()
+			{
+				::InitializeSRWLock(&m_lock);
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::~SharedMutexImpl>
+//	Destructor
+//-----------------------------------------------------------------------------
+			SharedMutexImpl::~SharedMutexImpl()
+			{
+				// Slim reader/writer locks do not need to be destroyed
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::LockShared>
+//	Lock the mutex in shared mode
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::LockShared()
+			{
+				::AcquireSRWLockShared(&m_lock);
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::UnlockShared>
+//	Release a shared lock
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::UnlockShared()
+			{
+				::ReleaseSRWLockShared(&m_lock);
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::Lock>
+//	Lock the mutex in exclusive mode
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::Lock()
+			{
+				::AcquireSRWLockExclusive(&m_lock);
+			}
+
+//-----------------------------------------------------------------------------
+//	<SharedMutexImpl::Unlock>
+//	Release an exclusive lock
+//-----------------------------------------------------------------------------
+			void SharedMutexImpl::Unlock()
+			{
+				::ReleaseSRWLockExclusive(&m_lock);
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,65 @@
+//-----------------------------------------------------------------------------
+//
+//	SharedMutexImpl.h
+//
+//	Windows implementation of the cross-platform reader/writer lock
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _SharedMutexImpl_H
+#define _SharedMutexImpl_H
+
+#include <windows.h>
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			/** \brief Windows specific implementation of the SharedMutex class (a slim reader/writer lock).
+			 */
+			class SharedMutexImpl
+			{
+				private:
+					friend class SharedMutex;
+
+					SharedMutexImpl();
+					~SharedMutexImpl();
+
+					void LockShared();
+					void UnlockShared();
+					void Lock();
+					void Unlock();
+
+					SharedMutexImpl(SharedMutexImpl const&);					// prevent copy
+					SharedMutexImpl& operator =(SharedMutexImpl const&);		// prevent assignment
+
+					SRWLOCK m_lock;
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_SharedMutexImpl_H
+
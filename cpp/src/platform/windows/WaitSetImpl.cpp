@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+//
+//	WaitSetImpl.cpp
+//
+//	Windows implementation of the WaitSet wakeup primitive
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#include <windows.h>
+
+#include "Defs.h"
+#include "WaitSetImpl.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::WaitSetImpl>
+//	Constructor
+//-----------------------------------------------------------------------------
+			WaitSetImpl::WaitSetImpl()
+			{
+				// Create an auto reset event
+				m_hEvent = ::CreateEvent( NULL, FALSE, FALSE, NULL);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::~WaitSetImpl>
+//	Destructor
+//-----------------------------------------------------------------------------
+			WaitSetImpl::~WaitSetImpl()
+			{
+				::CloseHandle(m_hEvent);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::Set>
+//	Wake the waiting thread
+//-----------------------------------------------------------------------------
+			void WaitSetImpl::Set()
+			{
+				::SetEvent(m_hEvent);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::Reset>
+//	Consume any pending wakeup
+//-----------------------------------------------------------------------------
+			void WaitSetImpl::Reset()
+			{
+				::ResetEvent(m_hEvent);
+			}
+
+//-----------------------------------------------------------------------------
+//	<WaitSetImpl::Wait>
+//	Block until Set is called or the timeout expires
+//-----------------------------------------------------------------------------
+			bool WaitSetImpl::Wait(int32 const _timeout)
+			{
+				return (WAIT_TIMEOUT != ::WaitForSingleObject(m_hEvent, (_timeout < 0) ? INFINITE : (DWORD) _timeout));
+			}
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
@@ -0,0 +1,64 @@
+//-----------------------------------------------------------------------------
+//
+//	WaitSetImpl.h
+//
+//	Windows implementation of the WaitSet wakeup primitive
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+#ifndef _WaitSetImpl_H
+#define _WaitSetImpl_H
+
+#include <windows.h>
+#include "Defs.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			/** \brief Windows specific implementation of the WaitSet wakeup (an auto-reset event).
+			 */
+			class WaitSetImpl
+			{
+				private:
+					friend class WaitSet;
+
+					WaitSetImpl();
+					~WaitSetImpl();
+
+					void Set();
+					void Reset();
+					bool Wait(int32 _timeout);
+
+					WaitSetImpl(WaitSetImpl const&);					// prevent copy
+					WaitSetImpl& operator =(WaitSetImpl const&);		// prevent assignment
+
+					HANDLE m_hEvent;
+			};
+		} // namespace Platform
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif //_WaitSetImpl_H
+
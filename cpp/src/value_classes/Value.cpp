@@ -34,6 +34,7 @@
 #include "Msg.h"
 #include "Bitfield.h"
 #include "value_classes/Value.h"
+#include "value_classes/ValueSnapshotTable.h"
 #include "platform/Log.h"
 #include "command_classes/CommandClass.h"
 #include <ctime>
@@ -46,6 +47,8 @@ namespace OpenZWave
 		namespace VC
 		{
 
+			static OptionHandle<bool> s_suppressValueRefresh("SuppressValueRefresh", false);
+
 			static char const* c_genreName[] =
 			{ "basic", "user", "config", "system", "invalid" };
 
@@ -57,7 +60,7 @@ namespace OpenZWave
 // Constructor
 //-----------------------------------------------------------------------------
 			Value::Value(uint32 const _homeId, uint8 const _nodeId, ValueID::ValueGenre const _genre, uint8 const _commandClassId, uint8 const _instance, uint16 const _index, ValueID::ValueType const _type, string const& _label, string const& _units, bool const _readOnly, bool const _writeOnly, bool const _isSet, uint8 const _pollIntensity) :
-					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_id(_homeId, _nodeId, _genre, _commandClassId, _instance, _index, _type), m_targetValueSet(false), m_duration(0), m_units(_units), m_readOnly(_readOnly), m_writeOnly(_writeOnly), m_isSet(_isSet), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(_pollIntensity)
+					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_id(_homeId, _nodeId, _genre, _commandClassId, _instance, _index, _type), m_targetValueSet(false), m_duration(0), m_units(_units), m_readOnly(_readOnly), m_writeOnly(_writeOnly), m_isSet(_isSet), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(_pollIntensity), m_pollInterval(0)
 			{
 				SetLabel(_label);
 				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
@@ -71,7 +74,7 @@ namespace OpenZWave
 // Constructor (from XML)
 //-----------------------------------------------------------------------------
 			Value::Value() :
-					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_targetValueSet(false), m_duration(0), m_readOnly(false), m_writeOnly(false), m_isSet(false), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(0)
+					m_min(0), m_max(0), m_refreshTime(0), m_verifyChanges(false), m_refreshAfterSet(true), m_targetValueSet(false), m_duration(0), m_readOnly(false), m_writeOnly(false), m_isSet(false), m_affectsLength(0), m_affects(), m_affectsAll(false), m_checkChange(false), m_pollIntensity(0), m_pollInterval(0)
 			{
 			}
 
@@ -151,6 +154,11 @@ namespace OpenZWave
 					m_pollIntensity = (uint8) intVal;
 				}
 
+				if (TIXML_SUCCESS == _valueElement->QueryIntAttribute("poll_interval", &intVal))
+				{
+					m_pollInterval = intVal;
+				}
+
 				char const* affects = _valueElement->Attribute("affects");
 				if (affects)
 				{
@@ -254,6 +262,12 @@ namespace OpenZWave
 				snprintf(str, sizeof(str), "%d", m_pollIntensity);
 				_valueElement->SetAttribute("poll_intensity", str);
 
+				if (m_pollInterval)
+				{
+					snprintf(str, sizeof(str), "%d", m_pollInterval);
+					_valueElement->SetAttribute("poll_interval", str);
+				}
+
 				snprintf(str, sizeof(str), "%d", m_min);
 				_valueElement->SetAttribute("min", str);
 
@@ -359,9 +373,7 @@ namespace OpenZWave
 				{
 					m_isSet = true;
 
-					bool bSuppress;
-					Options::Get()->GetOptionAsBool("SuppressValueRefresh", &bSuppress);
-					if (!bSuppress)
+					if (!s_suppressValueRefresh.Get())
 					{
 						// Notify the watchers
 						Notification* notification = new Notification(Notification::Type_ValueRefreshed);
@@ -410,6 +422,28 @@ namespace OpenZWave
 
 			}
 
+//-----------------------------------------------------------------------------
+// <Value::PublishSnapshot>
+// Copy the current state of the value into the driver's snapshot table
+//-----------------------------------------------------------------------------
+			void Value::PublishSnapshot()
+			{
+				ValueSnapshot snapshot;
+				snapshot.m_bitSet = 0;
+				if (!GetSnapshot(&snapshot))
+				{
+					return;
+				}
+				snapshot.m_type = m_id.GetType();
+				snapshot.m_isSet = m_isSet;
+				snapshot.m_version = 0;
+
+				if (Driver* driver = Manager::Get()->GetDriver(m_id.GetHomeId()))
+				{
+					driver->GetValueSnapshots()->Publish(m_id, snapshot);
+				}
+			}
+
 //-----------------------------------------------------------------------------
 // <Value::GetGenreEnumFromName>
 // Static helper to get a genre enum from a string
@@ -33,6 +33,7 @@
 #include <time.h>
 #endif
 #include "Defs.h"
+#include "StringPool.h"
 #include "TimerThread.h"
 #include "platform/Ref.h"
 #include "value_classes/ValueID.h"
@@ -43,6 +44,7 @@ class TiXmlElement;
 namespace OpenZWave
 {
 	class Driver;
+	struct ValueSnapshot;
 	namespace Internal
 	{
 		namespace VC
@@ -107,6 +109,14 @@ namespace OpenZWave
 					{
 						m_pollIntensity = _intensity;
 					}
+					int32 GetPollInterval() const
+					{
+						return m_pollInterval;
+					}
+					void SetPollInterval(int32 _milliseconds)
+					{
+						m_pollInterval = _milliseconds;
+					}
 
 					int32 GetMin() const
 					{
@@ -143,6 +153,12 @@ namespace OpenZWave
 					{
 						return false;
 					}
+					// Fill in the primitive state of the value.  Returns false for types that have no snapshot
+					virtual bool GetSnapshot(ValueSnapshot*) const
+					{
+						return false;
+					}
+					void PublishSnapshot();				// Copy the current state into the driver's snapshot table
 
 					bool Set();							// For the user to change a value in a device
 
@@ -197,7 +213,7 @@ namespace OpenZWave
 					uint32 m_duration;			// The Duration, if the CC supports it
 
 				private:
-					string m_units;
+					InternedString m_units;		// Shared with every other value in the same units
 					bool m_readOnly;
 					bool m_writeOnly;
 					bool m_isSet;
@@ -206,6 +222,7 @@ namespace OpenZWave
 					bool m_affectsAll;
 					bool m_checkChange;
 					uint8 m_pollIntensity;
+					int32 m_pollInterval;		// Milliseconds between polls of this value, or zero to use m_pollIntensity
 			};
 		} // namespace VC
 	} // namespace Internal
@@ -27,6 +27,7 @@
 
 #include "tinyxml.h"
 #include "value_classes/ValueBitSet.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Driver.h"
 #include "Node.h"
 #include "platform/Log.h"
@@ -88,6 +89,17 @@ namespace OpenZWave
 
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueBitSet::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueBitSet::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				// Only the bits in the mask are valid, as with GetBit
+				o_snapshot->m_bitSet = m_value.GetValue() & m_BitMask;
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueBitSet::ReadXML>
 // Apply settings from XML
@@ -275,6 +287,7 @@ namespace OpenZWave
 			bool ValueBitSet::SetBitMask(uint32 _bitMask)
 			{
 				m_BitMask = _bitMask;
+				PublishSnapshot();
 				return true;
 			}
 
@@ -367,6 +380,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_value.SetValue(_value);
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
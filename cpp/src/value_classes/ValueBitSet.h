@@ -75,6 +75,7 @@ namespace OpenZWave
 					virtual string const GetAsString() const;
 					virtual string const GetAsBinaryString() const;
 					virtual bool SetFromString(string const& _value);
+					virtual bool GetSnapshot(ValueSnapshot* o_snapshot) const;
 					virtual void ReadXML(uint32 const _homeId, uint8 const _nodeId, uint8 const _commandClassId, TiXmlElement const* _valueElement);
 					virtual void WriteXML(TiXmlElement* _valueElement);
 
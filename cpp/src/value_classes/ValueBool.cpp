@@ -27,6 +27,7 @@
 
 #include "tinyxml.h"
 #include "value_classes/ValueBool.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Driver.h"
 #include "Node.h"
 #include "platform/Log.h"
@@ -62,6 +63,16 @@ namespace OpenZWave
 				return false;
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueBool::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueBool::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				o_snapshot->m_bool = m_value;
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueBool::ReadXML>
 // Apply settings from XML
@@ -136,6 +147,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_value = _value;
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
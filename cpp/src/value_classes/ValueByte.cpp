@@ -28,6 +28,7 @@
 #include <sstream>
 #include "tinyxml.h"
 #include "value_classes/ValueByte.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Msg.h"
 #include "platform/Log.h"
 #include "Manager.h"
@@ -78,6 +79,16 @@ namespace OpenZWave
 				return false;
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueByte::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueByte::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				o_snapshot->m_byte = m_value;
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueByte::ReadXML>
 // Apply settings from XML
@@ -155,6 +166,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_value = _value;
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
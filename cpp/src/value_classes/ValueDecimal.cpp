@@ -27,6 +27,7 @@
 
 #include "tinyxml.h"
 #include "value_classes/ValueDecimal.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Msg.h"
 #include "platform/Log.h"
 #include "Manager.h"
@@ -48,6 +49,16 @@ namespace OpenZWave
 			{
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueDecimal::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueDecimal::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				o_snapshot->m_float = (float) atof(m_value.c_str());
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueDecimal::ReadXML>
 // Apply settings from XML
@@ -123,6 +134,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_value = _value;
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
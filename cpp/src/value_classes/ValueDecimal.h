@@ -70,6 +70,7 @@ namespace OpenZWave
 					{
 						return Set(_value);
 					}
+					virtual bool GetSnapshot(ValueSnapshot* o_snapshot) const;
 					virtual void ReadXML(uint32 const _homeId, uint8 const _nodeId, uint8 const _commandClassId, TiXmlElement const* _valueElement);
 					virtual void WriteXML(TiXmlElement* _valueElement);
 
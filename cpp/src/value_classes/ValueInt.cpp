@@ -29,6 +29,7 @@
 #include <limits.h>
 #include "tinyxml.h"
 #include "value_classes/ValueInt.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Msg.h"
 #include "platform/Log.h"
 #include "Manager.h"
@@ -77,6 +78,16 @@ namespace OpenZWave
 				return Set(val);
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueInt::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueInt::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				o_snapshot->m_int = m_value;
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueInt::ReadXML>
 // Apply settings from XML
@@ -154,6 +165,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_value = _value;
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
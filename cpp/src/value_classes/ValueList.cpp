@@ -27,6 +27,7 @@
 
 #include "tinyxml.h"
 #include "value_classes/ValueList.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Msg.h"
 #include "platform/Log.h"
 #include "Manager.h"
@@ -67,6 +68,21 @@ namespace OpenZWave
 
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueList::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueList::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				// Lists report the value of the selected item, not its index
+				if ((m_valueIdx < 0) || ((uint32) m_valueIdx >= m_items.size()))
+				{
+					return false;
+				}
+				o_snapshot->m_int = m_items[m_valueIdx].m_value;
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueList::ReadXML>
 // Apply settings from XML
@@ -291,6 +307,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_valueIdx = index;
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
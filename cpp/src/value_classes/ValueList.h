@@ -52,7 +52,7 @@ namespace OpenZWave
 					 */
 					struct Item
 					{
-							string m_label;
+							InternedString m_label;		// Shared with the same item of every other list
 							int32 m_value;
 					};
 
@@ -78,6 +78,7 @@ namespace OpenZWave
 					}
 					void SetTargetValue(int32 const _target, uint32 _duration = 0);
 
+					virtual bool GetSnapshot(ValueSnapshot* o_snapshot) const;
 					virtual void ReadXML(uint32 const _homeId, uint8 const _nodeId, uint8 const _commandClassId, TiXmlElement const* _valueElement);
 					virtual void WriteXML(TiXmlElement* _valueElement);
 
@@ -29,6 +29,7 @@
 #include <limits.h>
 #include "tinyxml.h"
 #include "value_classes/ValueShort.h"
+#include "value_classes/ValueSnapshot.h"
 #include "Msg.h"
 #include "platform/Log.h"
 #include "Manager.h"
@@ -80,6 +81,16 @@ namespace OpenZWave
 				return false;
 			}
 
+//-----------------------------------------------------------------------------
+// <ValueShort::GetSnapshot>
+// Fill in the primitive state of the value for the snapshot table
+//-----------------------------------------------------------------------------
+			bool ValueShort::GetSnapshot(ValueSnapshot* o_snapshot) const
+			{
+				o_snapshot->m_short = m_value;
+				return true;
+			}
+
 //-----------------------------------------------------------------------------
 // <ValueShort::ReadXML>
 // Apply settings from XML
@@ -157,6 +168,7 @@ namespace OpenZWave
 						break;
 					case 2:		// value has changed (confirmed), save _value in m_value
 						m_value = _value;
+						PublishSnapshot();
 						break;
 					case 3:		// all three values are different, so wait for next refresh to try again
 						break;
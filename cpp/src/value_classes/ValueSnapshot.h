@@ -0,0 +1,64 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueSnapshot.h
+//
+//	Copy of the current state of a primitive value
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ValueSnapshot_H
+#define _ValueSnapshot_H
+
+#include "Defs.h"
+#include "value_classes/ValueID.h"
+
+namespace OpenZWave
+{
+	/** \brief A copy of the current state of a value, as returned by Manager::GetValueSnapshot.
+	 *
+	 * Snapshots are only kept for values with a primitive representation:
+	 * ValueType_Bool, ValueType_Byte, ValueType_Decimal, ValueType_Int, ValueType_List,
+	 * ValueType_Short and ValueType_BitSet.  Only the union member matching m_type
+	 * is valid.  A List value reports the value (not the index) of its selected item
+	 * in m_int, a BitSet value has the bits outside its bit mask cleared, and a Decimal
+	 * value is converted to a float as GetValueAsFloat does.
+	 * \ingroup ValueID
+	 */
+	struct ValueSnapshot
+	{
+			ValueID::ValueType m_type;
+			bool m_isSet;				// The value has been read from the device (or the cache) at least once
+			uint32 m_version;			// Incremented every time the value is updated, so it can be used to detect changes between two reads.  Never zero for a value that was read
+			union
+			{
+					bool m_bool;
+					uint8 m_byte;
+					int16 m_short;
+					int32 m_int;
+					uint32 m_bitSet;
+					float m_float;
+			};
+	};
+} // namespace OpenZWave
+
+#endif
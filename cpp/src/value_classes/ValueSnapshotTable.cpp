@@ -0,0 +1,276 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueSnapshotTable.cpp
+//
+//	Lock free table of the current state of every primitive value
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <string.h>
+#include "value_classes/ValueSnapshotTable.h"
+#include "platform/Mutex.h"
+#include "Utils.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace VC
+		{
+			// m_state layout
+			static uint32 const c_stateTypeMask = 0x000000ff;
+			static uint32 const c_stateSet = 0x00000100;
+			static uint32 const c_statePresent = 0x00000200;
+
+			static uint32 const c_initialSize = 256;
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::ValueSnapshotTable>
+// Constructor
+//-----------------------------------------------------------------------------
+			ValueSnapshotTable::ValueSnapshotTable() :
+					m_table(CreateTable(c_initialSize)), m_used(0), m_mutex(new Internal::Platform::Mutex())
+			{
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::~ValueSnapshotTable>
+// Destructor
+//-----------------------------------------------------------------------------
+			ValueSnapshotTable::~ValueSnapshotTable()
+			{
+				m_retired.push_back(m_table.load());
+				for (vector<Table*>::iterator it = m_retired.begin(); it != m_retired.end(); ++it)
+				{
+					delete[] (*it)->m_slots;
+					delete *it;
+				}
+				m_mutex->Release();
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::Publish>
+// Store the current state of a value
+//-----------------------------------------------------------------------------
+			void ValueSnapshotTable::Publish(ValueID const& _id, ValueSnapshot const& _snapshot)
+			{
+				uint32 payload;
+				memcpy(&payload, &_snapshot.m_bitSet, sizeof(payload));
+				uint32 state = ((uint32) _snapshot.m_type & c_stateTypeMask) | c_statePresent | (_snapshot.m_isSet ? c_stateSet : 0);
+
+				Internal::LockGuard LG(m_mutex);
+				Slot* slot = FindOrAddSlot(_id.GetId());
+
+				uint32 sequence = slot->m_sequence.load(std::memory_order_relaxed);
+				slot->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				slot->m_state.store(state, std::memory_order_relaxed);
+				slot->m_payload.store(payload, std::memory_order_relaxed);
+				slot->m_sequence.store(sequence + 2, std::memory_order_release);
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::Remove>
+// Mark a value as no longer present
+//-----------------------------------------------------------------------------
+			void ValueSnapshotTable::Remove(ValueID const& _id)
+			{
+				Internal::LockGuard LG(m_mutex);
+				if (Slot* slot = FindSlot(m_table.load(std::memory_order_relaxed), _id.GetId()))
+				{
+					uint32 sequence = slot->m_sequence.load(std::memory_order_relaxed);
+					slot->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_release);
+					slot->m_state.store(0, std::memory_order_relaxed);
+					slot->m_sequence.store(sequence + 2, std::memory_order_release);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::Read>
+// Copy the current state of a value without taking a lock
+//-----------------------------------------------------------------------------
+			bool ValueSnapshotTable::Read(ValueID const& _id, ValueSnapshot* o_snapshot) const
+			{
+				Slot const* slot = FindSlot(m_table.load(std::memory_order_acquire), _id.GetId());
+				if (!slot)
+				{
+					return false;
+				}
+
+				uint32 sequence;
+				uint32 state;
+				uint32 payload;
+				while (true)
+				{
+					sequence = slot->m_sequence.load(std::memory_order_acquire);
+					if (sequence & 1)
+					{
+						// A write is in progress
+						continue;
+					}
+					state = slot->m_state.load(std::memory_order_relaxed);
+					payload = slot->m_payload.load(std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (slot->m_sequence.load(std::memory_order_relaxed) == sequence)
+					{
+						break;
+					}
+				}
+
+				if (!(state & c_statePresent))
+				{
+					return false;
+				}
+
+				o_snapshot->m_type = (ValueID::ValueType) (state & c_stateTypeMask);
+				o_snapshot->m_isSet = ((state & c_stateSet) != 0);
+				o_snapshot->m_version = sequence >> 1;
+				memcpy(&o_snapshot->m_bitSet, &payload, sizeof(payload));
+				return true;
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::CreateTable>
+// Allocate an empty table.  _size must be a power of two
+//-----------------------------------------------------------------------------
+			ValueSnapshotTable::Table* ValueSnapshotTable::CreateTable(uint32 const _size)
+			{
+				Table* table = new Table();
+				table->m_mask = _size - 1;
+				table->m_slots = new Slot[_size];
+				for (uint32 i = 0; i < _size; ++i)
+				{
+					table->m_slots[i].m_key.store(0, std::memory_order_relaxed);
+					table->m_slots[i].m_sequence.store(0, std::memory_order_relaxed);
+					table->m_slots[i].m_state.store(0, std::memory_order_relaxed);
+					table->m_slots[i].m_payload.store(0, std::memory_order_relaxed);
+				}
+				return table;
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::Hash>
+// Fibonacci hash of a ValueID key
+//-----------------------------------------------------------------------------
+			uint32 ValueSnapshotTable::Hash(uint64 const _key, uint32 const _mask)
+			{
+				return ((uint32) ((_key * 0x9E3779B97F4A7C15ULL) >> 32)) & _mask;
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::FindSlot>
+// Find the slot holding a key, or NULL if it is not in the table
+//-----------------------------------------------------------------------------
+			ValueSnapshotTable::Slot* ValueSnapshotTable::FindSlot(Table const* _table, uint64 const _key) const
+			{
+				uint32 index = Hash(_key, _table->m_mask);
+				while (true)
+				{
+					Slot* slot = &_table->m_slots[index];
+					uint64 key = slot->m_key.load(std::memory_order_acquire);
+					if (key == _key)
+					{
+						return slot;
+					}
+					if (key == 0)
+					{
+						return NULL;
+					}
+					index = (index + 1) & _table->m_mask;
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::FindOrAddSlot>
+// Find the slot holding a key, claiming an empty one if needed.  Called with
+// m_mutex held
+//-----------------------------------------------------------------------------
+			ValueSnapshotTable::Slot* ValueSnapshotTable::FindOrAddSlot(uint64 const _key)
+			{
+				if (Slot* slot = FindSlot(m_table.load(std::memory_order_relaxed), _key))
+				{
+					return slot;
+				}
+
+				// Keep the load factor at or below one half so probe chains stay short
+				Table* table = m_table.load(std::memory_order_relaxed);
+				if ((m_used + 1) * 2 > table->m_mask + 1)
+				{
+					Grow();
+					table = m_table.load(std::memory_order_relaxed);
+				}
+
+				uint32 index = Hash(_key, table->m_mask);
+				while (table->m_slots[index].m_key.load(std::memory_order_relaxed) != 0)
+				{
+					index = (index + 1) & table->m_mask;
+				}
+
+				// The slot is still marked absent, so readers that find the key before the
+				// first Publish completes will just report the value as missing.
+				Slot* slot = &table->m_slots[index];
+				slot->m_key.store(_key, std::memory_order_release);
+				++m_used;
+				return slot;
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueSnapshotTable::Grow>
+// Double the size of the table.  Called with m_mutex held
+//-----------------------------------------------------------------------------
+			void ValueSnapshotTable::Grow()
+			{
+				Table* oldTable = m_table.load(std::memory_order_relaxed);
+				uint32 oldSize = oldTable->m_mask + 1;
+				Table* newTable = CreateTable(oldSize * 2);
+
+				for (uint32 i = 0; i < oldSize; ++i)
+				{
+					Slot& oldSlot = oldTable->m_slots[i];
+					uint64 key = oldSlot.m_key.load(std::memory_order_relaxed);
+					if (key == 0)
+					{
+						continue;
+					}
+
+					uint32 index = Hash(key, newTable->m_mask);
+					while (newTable->m_slots[index].m_key.load(std::memory_order_relaxed) != 0)
+					{
+						index = (index + 1) & newTable->m_mask;
+					}
+
+					// We are the only writer, so the old slot is stable while we copy it
+					Slot& newSlot = newTable->m_slots[index];
+					newSlot.m_key.store(key, std::memory_order_relaxed);
+					newSlot.m_sequence.store(oldSlot.m_sequence.load(std::memory_order_relaxed), std::memory_order_relaxed);
+					newSlot.m_state.store(oldSlot.m_state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+					newSlot.m_payload.store(oldSlot.m_payload.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				}
+
+				m_table.store(newTable, std::memory_order_release);
+				m_retired.push_back(oldTable);
+			}
+		} // namespace VC
+	} // namespace Internal
+} // namespace OpenZWave
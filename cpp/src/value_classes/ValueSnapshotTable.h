@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+//
+//	ValueSnapshotTable.h
+//
+//	Lock free table of the current state of every primitive value
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _ValueSnapshotTable_H
+#define _ValueSnapshotTable_H
+
+#include <atomic>
+#include <vector>
+#include "Defs.h"
+#include "value_classes/ValueID.h"
+#include "value_classes/ValueSnapshot.h"
+
+namespace OpenZWave
+{
+	namespace Internal
+	{
+		namespace Platform
+		{
+			class Mutex;
+		}
+		namespace VC
+		{
+			/** \brief Holds a ValueSnapshot for every primitive value known to a driver.
+			 *
+			 * Readers never take a lock.  The table is an open addressed hash keyed on
+			 * ValueID::GetId, and each slot is protected by a sequence lock: the writer makes
+			 * the sequence odd while it updates the slot, and a reader retries if the
+			 * sequence was odd or changed while it copied the slot.
+			 *
+			 * Writers are serialized by an internal mutex.  Slots are never freed; a removed
+			 * value just marks its slot as absent, so probe chains stay intact.  When the table
+			 * grows, the old array is kept until the table is destroyed, so a reader that
+			 * loaded the old array pointer can always finish its read.
+			 * \ingroup ValueID
+			 */
+			class ValueSnapshotTable
+			{
+				public:
+					ValueSnapshotTable();
+					~ValueSnapshotTable();
+
+					/**
+					 * Store the current state of a value, adding it to the table if needed.
+					 */
+					void Publish(ValueID const& _id, ValueSnapshot const& _snapshot);
+
+					/**
+					 * Mark a value as no longer present.
+					 */
+					void Remove(ValueID const& _id);
+
+					/**
+					 * Copy the current state of a value.
+					 * \return false if the value is not in the table.
+					 */
+					bool Read(ValueID const& _id, ValueSnapshot* o_snapshot) const;
+
+				private:
+					struct Slot
+					{
+							std::atomic<uint64> m_key;			// ValueID::GetId, or 0 if the slot is empty
+							std::atomic<uint32> m_sequence;		// Odd while the slot is being written
+							std::atomic<uint32> m_state;		// Value type, and the set and present flags
+							std::atomic<uint32> m_payload;		// The union from ValueSnapshot
+					};
+
+					struct Table
+					{
+							uint32 m_mask;
+							Slot* m_slots;
+					};
+
+					static Table* CreateTable(uint32 const _size);
+					static uint32 Hash(uint64 const _key, uint32 const _mask);
+					Slot* FindSlot(Table const* _table, uint64 const _key) const;
+					Slot* FindOrAddSlot(uint64 const _key);
+					void Grow();
+
+					std::atomic<Table*> m_table;
+					vector<Table*> m_retired;			// Previous tables, kept alive for readers that may still hold them
+					uint32 m_used;
+					Internal::Platform::Mutex* m_mutex;
+			};
+		} // namespace VC
+	} // namespace Internal
+} // namespace OpenZWave
+
+#endif
@@ -25,11 +25,14 @@
 //
 //-----------------------------------------------------------------------------
 
+#include <algorithm>
 #include "value_classes/ValueStore.h"
 #include "value_classes/Value.h"
+#include "value_classes/ValueSnapshotTable.h"
 #include "Manager.h"
 #include "Notification.h"
 #include "Localization.h"
+#include "Utils.h"
 #include "platform/Log.h"
 
 namespace OpenZWave
@@ -38,6 +41,11 @@ namespace OpenZWave
 	{
 		namespace VC
 		{
+			// Orders store entries by key, for lower_bound
+			static bool CompareKeys(pair<uint32, Value*> const& _a, pair<uint32, Value*> const& _b)
+			{
+				return _a.first < _b.first;
+			}
 
 //-----------------------------------------------------------------------------
 // <ValueStore::ValueStore>
@@ -45,13 +53,36 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			ValueStore::~ValueStore()
 			{
-				map<uint32, Value*>::iterator it = m_values.begin();
+				ExclusiveLockGuard ELG(m_lock);
+				// Remove from the back, so the vector never has to shift
 				while (!m_values.empty())
 				{
-					ValueID const& valueId = it->second->GetID();
-					RemoveValue(valueId.GetValueStoreKey());
-					it = m_values.begin();
+					RemoveValue(m_values.back().first);
+				}
+			}
+
+//-----------------------------------------------------------------------------
+// <ValueStore::Find>
+// Find the position of a key, or End() if it is not in the store
+//-----------------------------------------------------------------------------
+			ValueStore::ValueVector::iterator ValueStore::Find(uint32 const _key)
+			{
+				ValueVector::iterator it = lower_bound(m_values.begin(), m_values.end(), ValueVector::value_type(_key, (Value*) NULL), CompareKeys);
+				if ((it != m_values.end()) && (it->first == _key))
+				{
+					return it;
 				}
+				return m_values.end();
+			}
+
+			ValueStore::ValueVector::const_iterator ValueStore::Find(uint32 const _key) const
+			{
+				ValueVector::const_iterator it = lower_bound(m_values.begin(), m_values.end(), ValueVector::value_type(_key, (Value*) NULL), CompareKeys);
+				if ((it != m_values.end()) && (it->first == _key))
+				{
+					return it;
+				}
+				return m_values.end();
 			}
 
 //-----------------------------------------------------------------------------
@@ -65,15 +96,17 @@ namespace OpenZWave
 					return false;
 				}
 
+				ExclusiveLockGuard ELG(m_lock);
 				uint32 key = _value->GetID().GetValueStoreKey();
-				map<uint32, Value*>::iterator it = m_values.find(key);
-				if (it != m_values.end())
+				ValueVector::value_type entry(key, _value);
+				ValueVector::iterator it = lower_bound(m_values.begin(), m_values.end(), entry, CompareKeys);
+				if ((it != m_values.end()) && (it->first == key))
 				{
 					// There is already a value in the store with this key, so we give up.
 					return false;
 				}
 
-				m_values[key] = _value;
+				m_values.insert(it, entry);
 				_value->AddRef();
 
 				// Notify the watchers of the new value and Check our GetChangeVerified Flag
@@ -93,6 +126,8 @@ namespace OpenZWave
 							}
 						}
 					}
+					_value->PublishSnapshot();
+
 					Notification* notification = new Notification(Notification::Type_ValueAdded);
 					notification->SetValueId(_value->GetID());
 					driver->QueueNotification(notification);
@@ -107,7 +142,8 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			bool ValueStore::RemoveValue(uint32 const& _key)
 			{
-				map<uint32, Value*>::iterator it = m_values.find(_key);
+				ExclusiveLockGuard ELG(m_lock);
+				ValueVector::iterator it = Find(_key);
 				if (it != m_values.end())
 				{
 					Value* value = it->second;
@@ -116,6 +152,8 @@ namespace OpenZWave
 					// First notify the watchers
 					if (Driver* driver = Manager::Get()->GetDriver(valueId.GetHomeId()))
 					{
+						driver->GetValueSnapshots()->Remove(valueId);
+
 						Notification* notification = new Notification(Notification::Type_ValueRemoved);
 						notification->SetValueId(valueId);
 						driver->QueueNotification(notification);
@@ -151,8 +189,10 @@ namespace OpenZWave
 //-----------------------------------------------------------------------------
 			void ValueStore::RemoveCommandClassValues(uint8 const _commandClassId)
 			{
-				map<uint32, Value*>::iterator it = m_values.begin();
-				while (it != m_values.end())
+				ExclusiveLockGuard ELG(m_lock);
+				// Compact the surviving values towards the front as we go
+				ValueVector::iterator out = m_values.begin();
+				for (ValueVector::iterator it = m_values.begin(); it != m_values.end(); ++it)
 				{
 					Value* value = it->second;
 					ValueID const& valueId = value->GetID();
@@ -163,20 +203,22 @@ namespace OpenZWave
 						// First notify the watchers
 						if (Driver* driver = Manager::Get()->GetDriver(valueId.GetHomeId()))
 						{
+							driver->GetValueSnapshots()->Remove(valueId);
+
 							Notification* notification = new Notification(Notification::Type_ValueRemoved);
 							notification->SetValueId(valueId);
 							driver->QueueNotification(notification);
 						}
 
-						// Now release and remove the value from the store
+						// Now release the value.  It is dropped from the store when we compact below.
 						value->Release();
-						m_values.erase(it++);
 					}
 					else
 					{
-						++it;
+						*out++ = *it;
 					}
 				}
+				m_values.erase(out, m_values.end());
 			}
 
 //-----------------------------------------------------------------------------
@@ -187,7 +229,7 @@ namespace OpenZWave
 			{
 				Value* value = NULL;
 
-				map<uint32, Value*>::const_iterator it = m_values.find(_key);
+				ValueVector::const_iterator it = Find(_key);
 				if (it != m_values.end())
 				{
 					value = it->second;
@@ -28,7 +28,8 @@
 #ifndef _ValueStore_H
 #define _ValueStore_H
 
-#include <map>
+#include <vector>
+#include <utility>
 #include "Defs.h"
 #include "value_classes/ValueID.h"
 
@@ -38,6 +39,10 @@ namespace OpenZWave
 {
 	namespace Internal
 	{
+		namespace Platform
+		{
+			class SharedMutex;
+		}
 		namespace VC
 		{
 
@@ -50,7 +55,9 @@ namespace OpenZWave
 			{
 				public:
 
-					typedef map<uint32, Value*>::const_iterator Iterator;
+					// Values are kept in a vector sorted by GetValueStoreKey, so lookups are a
+					// binary search over contiguous memory and iteration stays in key order.
+					typedef vector<pair<uint32, Value*> >::const_iterator Iterator;
 
 					Iterator Begin()
 					{
@@ -61,7 +68,13 @@ namespace OpenZWave
 						return m_values.end();
 					}
 
-					ValueStore()
+					/**
+					 * \param _lock the owning node's lock (see Driver::GetNodeLock).  It is held
+					 * exclusively while values are added or removed, so that readers holding it in
+					 * shared mode never see the vector being reallocated under them.
+					 */
+					ValueStore(Platform::SharedMutex* _lock) :
+							m_lock(_lock)
 					{
 					}
 					~ValueStore();
@@ -73,7 +86,13 @@ namespace OpenZWave
 					void RemoveCommandClassValues(uint8 const _commandClassId);		// Remove all the values associated with a command class
 
 				private:
-					map<uint32, Value*> m_values;
+					typedef vector<pair<uint32, Value*> > ValueVector;
+
+					ValueVector::iterator Find(uint32 const _key);
+					ValueVector::const_iterator Find(uint32 const _key) const;
+
+					ValueVector m_values;
+					Platform::SharedMutex* m_lock;
 			};
 		} // namespace VC
 	} // namespace Internal
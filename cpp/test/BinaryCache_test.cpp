@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------------------
+//
+//	BinaryCache_test.cpp
+//
+//	Tests for the binary network cache format
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BinaryCache.h"
+#include "tinyxml.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal;
+
+static char const* const s_cacheXml = "<Driver xmlns=\"https://github.com/OpenZWave/open-zwave\" version=\"5\" home_id=\"0xe1f2a3b4\" node_id=\"1\">"
+		"<Node id=\"1\" name=\"\" location=\"\" basic=\"2\" generic=\"2\" specific=\"1\" type=\"Static PC Controller\" listening=\"true\">"
+		"<Manufacturer id=\"0086\" name=\"AEON Labs\"><Product type=\"0001\" id=\"005a\" name=\"Z-Stick Gen5\" /></Manufacturer>"
+		"<CommandClasses><CommandClass id=\"32\" name=\"COMMAND_CLASS_BASIC\" version=\"1\">"
+		"<Value type=\"byte\" genre=\"basic\" instance=\"1\" index=\"0\" label=\"Basic\" units=\"\" min=\"0\" max=\"255\" value=\"0\">"
+		"<Help>Basic status &amp; control &lt;of&gt; the node</Help></Value>"
+		"</CommandClass></CommandClasses></Node>"
+		"<Node id=\"2\" name=\"Kitchen\" location=\"Ground floor\" listening=\"false\"><Neighbors>1,3</Neighbors></Node>"
+		"<Node id=\"3\" name=\"Kitchen\" location=\"Ground floor\" listening=\"false\" />"
+		"</Driver>";
+
+// The header is the magic, then five uint32s, the last of which is the CRC-32
+static size_t const c_headerSize = 28;
+
+static std::string Print(TiXmlNode const* _node)
+{
+	TiXmlPrinter printer;
+	printer.SetStreamPrinting();
+	_node->Accept(&printer);
+	return printer.CStr();
+}
+
+static void Encode(std::vector<uint8>* o_data)
+{
+	TiXmlDocument doc;
+	doc.Parse(s_cacheXml, NULL, TIXML_ENCODING_UTF8);
+	ASSERT_FALSE(doc.Error());
+	BinaryCache::Encode(doc.RootElement(), o_data);
+}
+
+static void PutUInt32(uint8* _buffer, uint32 const _value)
+{
+	_buffer[0] = (uint8) (_value & 0xff);
+	_buffer[1] = (uint8) ((_value >> 8) & 0xff);
+	_buffer[2] = (uint8) ((_value >> 16) & 0xff);
+	_buffer[3] = (uint8) ((_value >> 24) & 0xff);
+}
+
+// Make the CRC-32 match after a change, so only the structure is checked
+static void FixChecksum(std::vector<uint8>* io_data)
+{
+	PutUInt32(&(*io_data)[24], BinaryCache::Crc32(0, &(*io_data)[c_headerSize], io_data->size() - c_headerSize));
+}
+
+TEST(BinaryCache, Crc32)
+{
+	uint8 const check[] = "123456789";
+	EXPECT_EQ(0xcbf43926u, BinaryCache::Crc32(0, check, 9));
+	// Continuing a CRC over a second block gives the CRC of both
+	EXPECT_EQ(0xcbf43926u, BinaryCache::Crc32(BinaryCache::Crc32(0, check, 4), &check[4], 5));
+	EXPECT_EQ(0u, BinaryCache::Crc32(0, check, 0));
+}
+
+TEST(BinaryCache, RoundTrip)
+{
+	TiXmlDocument doc;
+	doc.Parse(s_cacheXml, NULL, TIXML_ENCODING_UTF8);
+	ASSERT_FALSE(doc.Error());
+
+	std::vector<uint8> data;
+	BinaryCache::Encode(doc.RootElement(), &data);
+	ASSERT_GT(data.size(), c_headerSize);
+	EXPECT_EQ(0, memcmp(&data[0], "OZWCACHE", 8));
+	// Each distinct string is stored once, so repeated names and values make it smaller
+	EXPECT_LT(data.size(), strlen(s_cacheXml));
+
+	TiXmlDocument decoded;
+	ASSERT_TRUE(BinaryCache::Decode(&data[0], data.size(), "test", &decoded));
+	EXPECT_EQ(Print(doc.RootElement()), Print(decoded.RootElement()));
+
+	// Encoding is deterministic
+	std::vector<uint8> again;
+	BinaryCache::Encode(decoded.RootElement(), &again);
+	EXPECT_EQ(data, again);
+}
+
+TEST(BinaryCache, SaveAndLoad)
+{
+	char const* const filename = "BinaryCache_test.bin";
+	TiXmlDocument doc;
+	doc.Parse(s_cacheXml, NULL, TIXML_ENCODING_UTF8);
+	ASSERT_TRUE(BinaryCache::Save(doc, filename));
+	EXPECT_TRUE(BinaryCache::IsBinaryCache(filename));
+
+	TiXmlDocument loaded;
+	ASSERT_TRUE(BinaryCache::Load(filename, &loaded));
+	EXPECT_EQ(Print(doc.RootElement()), Print(loaded.RootElement()));
+
+	// The loader hands out the children of the root one at a time
+	BinaryCache::Loader loader;
+	ASSERT_TRUE(loader.Open(filename));
+	TiXmlElement* root = loader.ReadRoot();
+	ASSERT_TRUE(root != NULL);
+	EXPECT_STREQ("Driver", root->Value());
+	EXPECT_STREQ("0xe1f2a3b4", root->Attribute("home_id"));
+	EXPECT_TRUE(root->FirstChild() == NULL);
+	int count = 0;
+	TiXmlElement const* expected = doc.RootElement()->FirstChildElement();
+	while (TiXmlElement* child = loader.ReadChild())
+	{
+		ASSERT_TRUE(expected != NULL);
+		EXPECT_EQ(Print(expected), Print(child));
+		expected = expected->NextSiblingElement();
+		delete child;
+		++count;
+	}
+	EXPECT_EQ(3, count);
+	EXPECT_FALSE(loader.Failed());
+	delete root;
+
+	remove(filename);
+	EXPECT_FALSE(BinaryCache::IsBinaryCache(filename));
+	TiXmlDocument missing;
+	EXPECT_FALSE(BinaryCache::Load(filename, &missing));
+}
+
+TEST(BinaryCache, Truncated)
+{
+	std::vector<uint8> data;
+	Encode(&data);
+
+	// Every prefix of the file is rejected
+	for (size_t size = 0; size < data.size(); ++size)
+	{
+		TiXmlDocument doc;
+		EXPECT_FALSE(BinaryCache::Decode(&data[0], size, "test", &doc)) << "size " << size;
+		EXPECT_TRUE(doc.RootElement() == NULL);
+	}
+}
+
+TEST(BinaryCache, Corrupt)
+{
+	std::vector<uint8> data;
+	Encode(&data);
+
+	// Any changed byte after the magic fails the version, size or checksum check
+	for (size_t i = 8; i < data.size(); ++i)
+	{
+		std::vector<uint8> corrupt = data;
+		corrupt[i] ^= 0x20;
+		TiXmlDocument doc;
+		EXPECT_FALSE(BinaryCache::Decode(&corrupt[0], corrupt.size(), "test", &doc)) << "byte " << i;
+	}
+
+	// A checksum that matches does not save a tree that refers to a string that is
+	// not in the table
+	std::vector<uint8> badIndex = data;
+	size_t tree = badIndex.size() - (badIndex[20] | (badIndex[21] << 8));
+	ASSERT_EQ('E', badIndex[tree]);
+	badIndex[tree + 1] = 0x7f;
+	FixChecksum(&badIndex);
+	TiXmlDocument doc;
+	EXPECT_FALSE(BinaryCache::Decode(&badIndex[0], badIndex.size(), "test", &doc));
+
+	// Nor one with bytes left over after the root element
+	std::vector<uint8> trailing = data;
+	trailing.push_back('E');
+	PutUInt32(&trailing[20], (trailing[20] | (trailing[21] << 8)) + 1);
+	FixChecksum(&trailing);
+	EXPECT_FALSE(BinaryCache::Decode(&trailing[0], trailing.size(), "test", &doc));
+
+	// Nor one that is cut short, with the sizes adjusted to match
+	std::vector<uint8> shortTree = data;
+	shortTree.resize(shortTree.size() - 1);
+	PutUInt32(&shortTree[20], (shortTree[20] | (shortTree[21] << 8)) - 1);
+	FixChecksum(&shortTree);
+	EXPECT_FALSE(BinaryCache::Decode(&shortTree[0], shortTree.size(), "test", &doc));
+	EXPECT_TRUE(doc.RootElement() == NULL);
+}
+
+} // namespace Testing
+} // namespace OpenZWave
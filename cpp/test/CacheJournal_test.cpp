@@ -0,0 +1,243 @@
+//-----------------------------------------------------------------------------
+//
+//	CacheJournal_test.cpp
+//
+//	Tests for applying the network cache journal
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "CacheJournal.h"
+#include "tinyxml.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal;
+
+static char const* const s_journal = "CacheJournal_test.jnl";
+
+static TiXmlElement MakeNode(int _id, char const* _name)
+{
+	TiXmlElement node("Node");
+	node.SetAttribute("id", _id);
+	node.SetAttribute("name", _name);
+	return node;
+}
+
+// The name of the Node element for _id, or "" if there is none
+static std::string NodeName(TiXmlElement* _driverElement, int _id)
+{
+	for (TiXmlElement* element = _driverElement->FirstChildElement("Node"); element; element = element->NextSiblingElement("Node"))
+	{
+		int id;
+		if ((TIXML_SUCCESS == element->QueryIntAttribute("id", &id)) && (id == _id))
+		{
+			char const* name = element->Attribute("name");
+			return name ? name : "";
+		}
+	}
+	return "";
+}
+
+static std::vector<uint8> ReadFile(char const* _filename)
+{
+	std::vector<uint8> data;
+	if (FILE* file = fopen(_filename, "rb"))
+	{
+		uint8 buffer[256];
+		size_t count;
+		while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		{
+			data.insert(data.end(), buffer, buffer + count);
+		}
+		fclose(file);
+	}
+	return data;
+}
+
+static void WriteFile(char const* _filename, std::vector<uint8> const& _data)
+{
+	FILE* file = fopen(_filename, "wb");
+	ASSERT_TRUE(file != NULL);
+	if (!_data.empty())
+	{
+		fwrite(&_data[0], _data.size(), 1, file);
+	}
+	fclose(file);
+}
+
+// Journal two nodes in one commit, then a change to the first and the removal of
+// the second in another.  Returns the size of the journal after the first commit.
+static uint32 WriteJournal(uint32 _generation)
+{
+	CacheJournal::Discard(s_journal);
+	uint32 size = 0;
+	CacheJournal first(s_journal, _generation);
+	TiXmlElement node2 = MakeNode(2, "kitchen");
+	TiXmlElement node3 = MakeNode(3, "hall");
+	first.AddNode(2, &node2);
+	first.AddNode(3, &node3);
+	EXPECT_EQ(2u, first.GetCount());
+	EXPECT_TRUE(first.Commit(&size));
+	uint32 firstSize = size;
+
+	CacheJournal second(s_journal, _generation);
+	TiXmlElement renamed = MakeNode(2, "pantry");
+	second.AddNode(2, &renamed);
+	second.AddNode(3, NULL);
+	EXPECT_TRUE(second.Commit(&size));
+	EXPECT_EQ(0u, second.GetCount());
+	EXPECT_EQ(ReadFile(s_journal).size(), size);
+	return firstSize;
+}
+
+TEST(CacheJournal, Apply)
+{
+	WriteJournal(7);
+
+	TiXmlElement driver("Driver");
+	driver.InsertEndChild(MakeNode(2, "old"));
+	driver.InsertEndChild(MakeNode(3, "old"));
+	driver.InsertEndChild(MakeNode(4, "untouched"));
+	uint32 size = 0;
+	bool nodes[256] = { false };
+	EXPECT_TRUE(CacheJournal::Apply(s_journal, 7, &driver, &size, nodes));
+	EXPECT_EQ(ReadFile(s_journal).size(), size);
+
+	// The last record for a node wins
+	EXPECT_EQ("pantry", NodeName(&driver, 2));
+	EXPECT_EQ("", NodeName(&driver, 3));
+	EXPECT_EQ("untouched", NodeName(&driver, 4));
+	EXPECT_TRUE(nodes[2]);
+	EXPECT_TRUE(nodes[3]);
+	EXPECT_FALSE(nodes[4]);
+
+	CacheJournal::Discard(s_journal);
+}
+
+TEST(CacheJournal, NoJournal)
+{
+	CacheJournal::Discard(s_journal);
+	TiXmlElement driver("Driver");
+	driver.InsertEndChild(MakeNode(2, "old"));
+	uint32 size = 1;
+	EXPECT_TRUE(CacheJournal::Apply(s_journal, 7, &driver, &size));
+	EXPECT_EQ(0u, size);
+	EXPECT_EQ("old", NodeName(&driver, 2));
+}
+
+TEST(CacheJournal, GenerationMismatch)
+{
+	WriteJournal(7);
+
+	// A journal left behind from before the cache was last saved is ignored
+	TiXmlElement driver("Driver");
+	driver.InsertEndChild(MakeNode(2, "old"));
+	driver.InsertEndChild(MakeNode(3, "old"));
+	uint32 size = 1;
+	bool nodes[256] = { false };
+	EXPECT_TRUE(CacheJournal::Apply(s_journal, 8, &driver, &size, nodes));
+	EXPECT_EQ(0u, size);
+	EXPECT_EQ("old", NodeName(&driver, 2));
+	EXPECT_EQ("old", NodeName(&driver, 3));
+	EXPECT_FALSE(nodes[2]);
+	EXPECT_FALSE(nodes[3]);
+
+	CacheJournal::Discard(s_journal);
+}
+
+TEST(CacheJournal, TruncatedTail)
+{
+	uint32 firstSize = WriteJournal(7);
+
+	// Cut the last record short, as a crash while appending would.  The records
+	// before it are applied, and the size is where the next record can go.
+	std::vector<uint8> data = ReadFile(s_journal);
+	data.resize(data.size() - 3);
+	WriteFile(s_journal, data);
+
+	TiXmlElement driver("Driver");
+	driver.InsertEndChild(MakeNode(3, "old"));
+	uint32 size = 0;
+	EXPECT_FALSE(CacheJournal::Apply(s_journal, 7, &driver, &size));
+	EXPECT_GT(size, firstSize);
+	EXPECT_LT(size, (uint32) data.size());
+	EXPECT_EQ("pantry", NodeName(&driver, 2));
+	EXPECT_EQ("hall", NodeName(&driver, 3));
+
+	// Only part of a record header
+	data.resize(firstSize + 5);
+	WriteFile(s_journal, data);
+	TiXmlElement driver2("Driver");
+	EXPECT_FALSE(CacheJournal::Apply(s_journal, 7, &driver2, &size));
+	EXPECT_EQ(firstSize, size);
+	EXPECT_EQ("kitchen", NodeName(&driver2, 2));
+	EXPECT_EQ("hall", NodeName(&driver2, 3));
+
+	CacheJournal::Discard(s_journal);
+}
+
+TEST(CacheJournal, CorruptRecord)
+{
+	uint32 firstSize = WriteJournal(7);
+
+	// Damage the payload of the first record of the second commit, so its CRC-32
+	// no longer matches.  Nothing from that record on is applied.
+	std::vector<uint8> data = ReadFile(s_journal);
+	data[firstSize + 20] ^= 0x55;
+	WriteFile(s_journal, data);
+
+	TiXmlElement driver("Driver");
+	uint32 size = 0;
+	bool nodes[256] = { false };
+	EXPECT_FALSE(CacheJournal::Apply(s_journal, 7, &driver, &size, nodes));
+	EXPECT_EQ(firstSize, size);
+	EXPECT_EQ("kitchen", NodeName(&driver, 2));
+	EXPECT_EQ("hall", NodeName(&driver, 3));
+
+	CacheJournal::Discard(s_journal);
+}
+
+TEST(CacheJournal, NotAJournal)
+{
+	std::vector<uint8> data(32, 'x');
+	WriteFile(s_journal, data);
+
+	TiXmlElement driver("Driver");
+	driver.InsertEndChild(MakeNode(2, "old"));
+	uint32 size = 1;
+	EXPECT_TRUE(CacheJournal::Apply(s_journal, 7, &driver, &size));
+	EXPECT_EQ(0u, size);
+	EXPECT_EQ("old", NodeName(&driver, 2));
+
+	CacheJournal::Discard(s_journal);
+}
+
+} // namespace Testing
+} // namespace OpenZWave
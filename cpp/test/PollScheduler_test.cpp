@@ -0,0 +1,266 @@
+//-----------------------------------------------------------------------------
+//
+//	PollScheduler_test.cpp
+//
+//	Tests for the driver's poll scheduler
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "PollScheduler.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal;
+
+static ValueID MakeValue(uint8 _nodeId, uint16 _index)
+{
+	return ValueID(0xFFFFu, _nodeId, ValueID::ValueGenre_User, 0x25, 0x01, _index, ValueID::ValueType_Bool);
+}
+
+// Pop everything due at _now, returning the values in the order they came out
+static std::vector<ValueID> PopAll(PollScheduler* _scheduler, uint64 _now, int32 _period)
+{
+	std::vector<ValueID> popped;
+	ValueID valueId;
+	bool asleep;
+	while (_scheduler->PopDue(_now, _period, &valueId, &asleep))
+	{
+		popped.push_back(valueId);
+	}
+	return popped;
+}
+
+TEST(PollScheduler, AddAndRemove)
+{
+	PollScheduler scheduler;
+	EXPECT_TRUE(scheduler.Empty());
+	EXPECT_EQ(-1, scheduler.TimeUntilNextDue(1000));
+
+	EXPECT_TRUE(scheduler.Add(MakeValue(2, 0), 1, 0, 1000));
+	EXPECT_TRUE(scheduler.Add(MakeValue(2, 1), 1, 0, 1000));
+	EXPECT_TRUE(scheduler.Add(MakeValue(3, 0), 1, 0, 1000));
+	// Adding a value twice only updates it
+	EXPECT_FALSE(scheduler.Add(MakeValue(2, 0), 2, 0, 1000));
+	EXPECT_EQ(3u, scheduler.Size());
+	EXPECT_TRUE(scheduler.Contains(MakeValue(2, 1)));
+
+	EXPECT_TRUE(scheduler.Remove(MakeValue(2, 1)));
+	EXPECT_FALSE(scheduler.Remove(MakeValue(2, 1)));
+	EXPECT_FALSE(scheduler.Contains(MakeValue(2, 1)));
+	EXPECT_EQ(2u, scheduler.Size());
+
+	scheduler.RemoveNode(2);
+	EXPECT_EQ(1u, scheduler.Size());
+	EXPECT_FALSE(scheduler.Contains(MakeValue(2, 0)));
+	EXPECT_TRUE(scheduler.Contains(MakeValue(3, 0)));
+}
+
+TEST(PollScheduler, Ordering)
+{
+	PollScheduler scheduler;
+	int32 const period = 1000;
+
+	// New values are due straight away, in the order they were added
+	for (uint16 i = 0; i < 5; ++i)
+	{
+		scheduler.Add(MakeValue(2, i), 1, 0, 0);
+	}
+	EXPECT_EQ(0, scheduler.TimeUntilNextDue(0));
+	std::vector<ValueID> popped = PopAll(&scheduler, 0, period);
+	ASSERT_EQ(5u, popped.size());
+	for (uint16 i = 0; i < 5; ++i)
+	{
+		EXPECT_EQ(MakeValue(2, i), popped[i]);
+	}
+
+	// Each is then due one period later, and nothing is due before that
+	EXPECT_EQ(period, scheduler.TimeUntilNextDue(0));
+	EXPECT_TRUE(PopAll(&scheduler, period - 1, period).empty());
+	EXPECT_EQ(1, scheduler.TimeUntilNextDue(period - 1));
+	EXPECT_EQ(5u, PopAll(&scheduler, period, period).size());
+}
+
+TEST(PollScheduler, IntensityAndInterval)
+{
+	PollScheduler scheduler;
+	int32 const period = 1000;
+	ValueID everyPeriod = MakeValue(2, 0);
+	ValueID everyThird = MakeValue(2, 1);
+	ValueID fast = MakeValue(3, 0);
+	scheduler.Add(everyPeriod, 1, 0, 0);
+	scheduler.Add(everyThird, 3, 0, 0);
+	scheduler.Add(fast, 1, 250, 0);
+
+	// Count the polls over ten periods, stepping a quarter period at a time
+	int polls[3] = { 0, 0, 0 };
+	for (uint64 now = 0; now < 10 * period; now += 250)
+	{
+		std::vector<ValueID> popped = PopAll(&scheduler, now, period);
+		for (size_t i = 0; i < popped.size(); ++i)
+		{
+			polls[(popped[i] == everyPeriod) ? 0 : (popped[i] == everyThird) ? 1 : 2]++;
+		}
+	}
+	EXPECT_EQ(10, polls[0]);
+	EXPECT_EQ(4, polls[1]);
+	EXPECT_EQ(40, polls[2]);
+
+	// A new intensity takes effect from the next poll, but a shorter interval
+	// brings the next poll forward
+	scheduler.Remove(everyPeriod);
+	scheduler.Remove(fast);
+	scheduler.SetIntensity(everyThird, 1);
+	EXPECT_EQ(2 * period, scheduler.TimeUntilNextDue(10 * period));
+	scheduler.SetInterval(everyThird, 100, 10 * period);
+	EXPECT_EQ(100, scheduler.TimeUntilNextDue(10 * period));
+}
+
+TEST(PollScheduler, SleepingNode)
+{
+	PollScheduler scheduler;
+	int32 const period = 1000;
+	scheduler.Add(MakeValue(2, 0), 1, 0, 0);
+	scheduler.Add(MakeValue(2, 1), 1, 0, 0);
+	scheduler.Add(MakeValue(3, 0), 1, 0, 0);
+	scheduler.SetNodeAsleep(2, true);
+
+	// Only the first poll for a sleeping node is handed out, flagged as asleep, so
+	// the node can be marked for a refresh when it wakes
+	ValueID valueId;
+	bool asleep;
+	int sleeping = 0;
+	int awake = 0;
+	while (scheduler.PopDue(0, period, &valueId, &asleep))
+	{
+		if (valueId.GetNodeId() == 2)
+		{
+			EXPECT_TRUE(asleep);
+			++sleeping;
+		}
+		else
+		{
+			EXPECT_FALSE(asleep);
+			++awake;
+		}
+	}
+	EXPECT_EQ(1, sleeping);
+	EXPECT_EQ(1, awake);
+
+	// The suppressed polls stay scheduled, and are not handed out while it sleeps
+	EXPECT_EQ(3u, scheduler.Size());
+	std::vector<ValueID> popped = PopAll(&scheduler, period, period);
+	ASSERT_EQ(1u, popped.size());
+	EXPECT_EQ(3, popped[0].GetNodeId());
+
+	// Once the node wakes, its values are polled again
+	scheduler.SetNodeAsleep(2, false);
+	popped = PopAll(&scheduler, 2 * period, period);
+	EXPECT_EQ(3u, popped.size());
+
+	// And it gets one flagged poll the next time it falls asleep
+	scheduler.SetNodeAsleep(2, true);
+	sleeping = 0;
+	while (scheduler.PopDue(3 * period, period, &valueId, &asleep))
+	{
+		if (valueId.GetNodeId() == 2)
+		{
+			++sleeping;
+		}
+	}
+	EXPECT_EQ(1, sleeping);
+
+	// Removing the node forgets that it was asleep
+	scheduler.RemoveNode(2);
+	scheduler.Add(MakeValue(2, 0), 1, 0, 3 * period);
+	ASSERT_TRUE(scheduler.PopDue(3 * period, period, &valueId, &asleep));
+	EXPECT_EQ(MakeValue(2, 0), valueId);
+	EXPECT_FALSE(asleep);
+}
+
+TEST(PollScheduler, RandomOperations)
+{
+	// Compare against a plain list of due times, checking every value is handed out
+	// at its due time and never early
+	PollScheduler scheduler;
+	int32 const period = 100;
+	srand(5);
+	std::vector<uint64> due(64, 0);
+	std::vector<bool> scheduled(64, false);
+	uint64 now = 0;
+	for (int step = 0; step < 5000; ++step)
+	{
+		uint16 index = (uint16) (rand() % 64);
+		switch (rand() % 4)
+		{
+			case 0:
+			{
+				if (scheduler.Add(MakeValue(2, index), 1, 0, now))
+				{
+					due[index] = now;
+				}
+				scheduled[index] = true;
+				break;
+			}
+			case 1:
+			{
+				EXPECT_EQ(scheduled[index], scheduler.Remove(MakeValue(2, index)));
+				scheduled[index] = false;
+				break;
+			}
+			default:
+			{
+				now += rand() % 50;
+				ValueID valueId;
+				bool asleep;
+				while (scheduler.PopDue(now, period, &valueId, &asleep))
+				{
+					uint16 popped = valueId.GetIndex();
+					ASSERT_TRUE(scheduled[popped]);
+					EXPECT_LE(due[popped], now);
+					due[popped] = now + period;
+				}
+				for (uint16 i = 0; i < 64; ++i)
+				{
+					// Everything that is due has been handed out
+					EXPECT_TRUE(!scheduled[i] || (due[i] > now));
+				}
+				break;
+			}
+		}
+		size_t count = 0;
+		for (uint16 i = 0; i < 64; ++i)
+		{
+			count += scheduled[i] ? 1 : 0;
+		}
+		ASSERT_EQ(count, scheduler.Size());
+	}
+}
+
+} // namespace Testing
+} // namespace OpenZWave
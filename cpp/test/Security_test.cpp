@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+//
+//	Security_test.cpp
+//
+//	Known answer tests for the AES modes used by Security
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include "gtest/gtest.h"
+#include "AesModes.h"
+#include "platform/TimeStamp.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal;
+
+static uint8 const s_key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static uint8 const s_iv[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+// NIST SP 800-38A F.4.1 (OFB) and F.2.1 (CBC), first two blocks
+static uint8 const s_plain[32] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51 };
+static uint8 const s_ofb[32] = { 0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a, 0x77, 0x89, 0x50, 0x8d, 0x16, 0x91, 0x8f, 0x03, 0xf5, 0x3c, 0x52, 0xda, 0xc5, 0x4e, 0xd8, 0x25 };
+static uint8 const s_cbc2[16] = { 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2 };
+
+// Each test runs on the portable code, then on the hardware if there is any
+static int PathCount()
+{
+	return AesHardwareAvailable() ? 2 : 1;
+}
+
+static void SetKey(uint8 const* _key, aes_encrypt_ctx* o_ctx)
+{
+	aes_init();
+	aes_encrypt_key128(_key, o_ctx);
+}
+
+TEST(Security, AesBlock)
+{
+	// FIPS-197 C.1
+	uint8 const key[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+	uint8 const plain[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+	uint8 const cipher[16] = { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+	aes_encrypt_ctx ctx;
+	SetKey(key, &ctx);
+	for (int use = 0; use < PathCount(); ++use)
+	{
+		AesUseHardware(use != 0);
+		uint8 out[16];
+		AesEncryptBlock(&ctx, plain, out);
+		EXPECT_EQ(memcmp(out, cipher, 16), 0) << "hardware " << use;
+	}
+	AesUseHardware(true);
+}
+
+TEST(Security, AesOfb)
+{
+	aes_encrypt_ctx ctx;
+	SetKey(s_key, &ctx);
+	for (int use = 0; use < PathCount(); ++use)
+	{
+		AesUseHardware(use != 0);
+		uint8 out[32];
+		AesOfb(&ctx, s_iv, s_plain, out, 32);
+		EXPECT_EQ(memcmp(out, s_ofb, 32), 0) << "hardware " << use;
+
+		// Security messages are rarely a whole number of blocks
+		memset(out, 0, sizeof(out));
+		AesOfb(&ctx, s_iv, s_plain, out, 21);
+		EXPECT_EQ(memcmp(out, s_ofb, 21), 0) << "hardware " << use;
+		EXPECT_EQ(out[21], 0) << "hardware " << use;
+
+		// and decrypting is the same operation
+		uint8 back[32];
+		AesOfb(&ctx, s_iv, out, back, 21);
+		EXPECT_EQ(memcmp(back, s_plain, 21), 0) << "hardware " << use;
+	}
+	AesUseHardware(true);
+}
+
+TEST(Security, AesCbcMac)
+{
+	// The MAC encrypts the IV first, so with an IV of (IV ^ P1) it matches the
+	// second block of CBC encryption
+	uint8 iv[16];
+	for (int i = 0; i < 16; ++i)
+	{
+		iv[i] = s_iv[i] ^ s_plain[i];
+	}
+	aes_encrypt_ctx ctx;
+	SetKey(s_key, &ctx);
+	for (int use = 0; use < PathCount(); ++use)
+	{
+		AesUseHardware(use != 0);
+		uint8 mac[16];
+		AesCbcMac(&ctx, iv, &s_plain[16], 16, mac);
+		EXPECT_EQ(memcmp(mac, s_cbc2, 16), 0) << "hardware " << use;
+	}
+	AesUseHardware(true);
+}
+
+TEST(Security, AesPathsAgree)
+{
+	if (!AesHardwareAvailable())
+	{
+		return;
+	}
+	aes_encrypt_ctx ctx;
+	SetKey(s_key, &ctx);
+	srand(1);
+	for (int n = 0; n < 200; ++n)
+	{
+		uint8 iv[16], data[64], out[2][64], mac[2][16];
+		for (int i = 0; i < 16; ++i)
+		{
+			iv[i] = (uint8) rand();
+		}
+		for (int i = 0; i < 64; ++i)
+		{
+			data[i] = (uint8) rand();
+		}
+		uint32 length = n % 65;
+		for (int use = 0; use < 2; ++use)
+		{
+			AesUseHardware(use != 0);
+			AesOfb(&ctx, iv, data, out[use], length);
+			AesCbcMac(&ctx, iv, data, length, mac[use]);
+		}
+		EXPECT_EQ(memcmp(out[0], out[1], length), 0) << "length " << length;
+		EXPECT_EQ(memcmp(mac[0], mac[1], 16), 0) << "length " << length;
+	}
+	AesUseHardware(true);
+}
+
+// Encrypt and authenticate a typical Security message payload on each path.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=Security.*
+TEST(Security, DISABLED_AesBenchmark)
+{
+	aes_encrypt_ctx ctx;
+	SetKey(s_key, &ctx);
+	uint8 data[32], out[32], mac[16];
+	memcpy(data, s_plain, 32);
+	int const count = 200000;
+	for (int use = 0; use < PathCount(); ++use)
+	{
+		AesUseHardware(use != 0);
+		Internal::Platform::TimeStamp start;
+		for (int i = 0; i < count; ++i)
+		{
+			AesOfb(&ctx, s_iv, data, out, 24);
+			AesCbcMac(&ctx, s_iv, out, 28, mac);
+			data[0] ^= mac[0];
+		}
+		int32 elapsed = -start.TimeRemaining();
+		printf("%s: %d messages in %d ms, %.0f ns each\n", use ? "AES-NI" : "portable", count, elapsed, elapsed * 1000000.0 / count);
+	}
+	AesUseHardware(true);
+}
+
+} // namespace Testing
+} // namespace OpenZWave
@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+//
+//	SendQueue_test.cpp
+//
+//	Tests for merging messages in the driver's send queues
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "Driver.h"
+#include "Msg.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal;
+
+uint8 const c_switchMultilevel = 0x26;
+
+// A Driver friend, so the queue rules can be run on a queue of their own
+class SendQueueTest: public ::testing::Test
+{
+	protected:
+		virtual void TearDown()
+		{
+			for (Driver::MsgQueueList::iterator it = m_queue.begin(); it != m_queue.end(); ++it)
+			{
+				delete it->m_msg;
+			}
+			m_queue.clear();
+		}
+
+		// A Set of a node's level, which a newer Set of the level may replace
+		static Msg* MakeSet(uint8 _nodeId, uint8 _level, uint16 _index = 0)
+		{
+			Msg* msg = new Msg("SwitchMultilevelCmd_Set", _nodeId, REQUEST, FUNC_ID_ZW_SEND_DATA, true);
+			msg->Append(_nodeId);
+			msg->Append(3);
+			msg->Append(c_switchMultilevel);
+			msg->Append(0x01);
+			msg->Append(_level);
+			msg->SetCoalesceKey(c_switchMultilevel, _index);
+			return msg;
+		}
+
+		static Msg* MakeStartLevelChange(uint8 _nodeId)
+		{
+			Msg* msg = new Msg("SwitchMultilevelCmd_StartLevelChange", _nodeId, REQUEST, FUNC_ID_ZW_SEND_DATA, true);
+			msg->Append(_nodeId);
+			msg->Append(3);
+			msg->Append(c_switchMultilevel);
+			msg->Append(0x04);
+			msg->Append(0x00);
+			return msg;
+		}
+
+		// Queue a message, unless it replaces a queued Set
+		bool Queue(Msg* _msg)
+		{
+			if (Driver::ReplaceQueuedSet(m_queue, _msg))
+			{
+				return false;
+			}
+			Driver::MsgQueueItem item;
+			item.m_command = Driver::MsgQueueCmd_SendMsg;
+			item.m_msg = _msg;
+			m_queue.push_back(item);
+			return true;
+		}
+
+		// Queue a query stage for a node, which is not a message
+		void QueueQueryStage(uint8 _nodeId)
+		{
+			Driver::MsgQueueItem item;
+			item.m_command = Driver::MsgQueueCmd_QueryStageComplete;
+			item.m_nodeId = _nodeId;
+			item.m_queryStage = Node::QueryStage_Static;
+			m_queue.push_back(item);
+		}
+
+		std::vector<Msg*> Messages()
+		{
+			std::vector<Msg*> messages;
+			for (Driver::MsgQueueList::iterator it = m_queue.begin(); it != m_queue.end(); ++it)
+			{
+				messages.push_back((Driver::MsgQueueCmd_SendMsg == it->m_command) ? it->m_msg : NULL);
+			}
+			return messages;
+		}
+
+		Driver::MsgQueueList m_queue;
+};
+
+TEST_F(SendQueueTest, ReplacesLastSet)
+{
+	Msg* first = MakeSet(2, 50);
+	EXPECT_TRUE(Queue(first));
+	Msg* second = MakeSet(2, 0);
+	EXPECT_FALSE(Queue(second));
+
+	// The newer Set has taken the older one's place
+	std::vector<Msg*> messages = Messages();
+	ASSERT_EQ(1u, messages.size());
+	EXPECT_EQ(second, messages[0]);
+}
+
+TEST_F(SendQueueTest, OtherNodesInBetween)
+{
+	// Messages to other nodes do not stop the Set being replaced
+	Queue(MakeSet(2, 50));
+	Msg* other = MakeSet(3, 50);
+	Queue(other);
+	QueueQueryStage(3);
+	Msg* newer = MakeSet(2, 0);
+	EXPECT_FALSE(Queue(newer));
+
+	std::vector<Msg*> messages = Messages();
+	ASSERT_EQ(3u, messages.size());
+	EXPECT_EQ(newer, messages[0]);
+	EXPECT_EQ(other, messages[1]);
+	EXPECT_TRUE(messages[2] == NULL);
+}
+
+TEST_F(SendQueueTest, InterleavedCommand)
+{
+	// Set(50), StartLevelChange, Set(0) must stay in that order, or the dimmer
+	// would end up changing level rather than off
+	Msg* set50 = MakeSet(2, 50);
+	Msg* change = MakeStartLevelChange(2);
+	Msg* set0 = MakeSet(2, 0);
+	EXPECT_TRUE(Queue(set50));
+	EXPECT_TRUE(Queue(change));
+	EXPECT_TRUE(Queue(set0));
+
+	std::vector<Msg*> messages = Messages();
+	ASSERT_EQ(3u, messages.size());
+	EXPECT_EQ(set50, messages[0]);
+	EXPECT_EQ(change, messages[1]);
+	EXPECT_EQ(set0, messages[2]);
+
+	// Something other than a message for the node, such as a query stage, also
+	// keeps the Sets apart
+	QueueQueryStage(2);
+	EXPECT_TRUE(Queue(MakeSet(2, 99)));
+	EXPECT_EQ(5u, Messages().size());
+}
+
+TEST_F(SendQueueTest, DifferentValue)
+{
+	// A Set of another value, or a message that is not a coalescable Set, is queued
+	Queue(MakeSet(2, 50));
+	EXPECT_TRUE(Queue(MakeSet(2, 50, 1)));
+	EXPECT_TRUE(Queue(MakeSet(3, 50)));
+	EXPECT_TRUE(Queue(MakeStartLevelChange(2)));
+	EXPECT_TRUE(Queue(MakeStartLevelChange(2)));
+	EXPECT_EQ(5u, Messages().size());
+}
+
+} // namespace Testing
+} // namespace OpenZWave
@@ -0,0 +1,209 @@
+//-----------------------------------------------------------------------------
+//
+//	Stream_test.cpp
+//
+//	Tests for the serial ring buffer
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include "gtest/gtest.h"
+#include "platform/Stream.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal::Platform;
+
+// Byte _n of the test sequence.  Not a multiple of any buffer size, so data read
+// from the wrong offset shows up.
+static uint8 SequenceByte(uint32 _n)
+{
+	return (uint8) ((_n * 7 + (_n >> 8)) % 251);
+}
+
+TEST(Stream, Wraparound)
+{
+	for (int mode = 0; mode < 2; ++mode)
+	{
+		// A capacity that is not a power of two, so the buffer is bigger than the
+		// stream may hold
+		Stream* stream = new Stream(10, mode == 1);
+		uint32 written = 0;
+		uint32 read = 0;
+		srand(3);
+		for (int i = 0; i < 2000; ++i)
+		{
+			uint8 buffer[10];
+			uint32 size = 1 + rand() % 10;
+			for (uint32 j = 0; j < size; ++j)
+			{
+				buffer[j] = SequenceByte(written + j);
+			}
+			bool fits = (written - read + size) <= 10;
+			ASSERT_EQ(fits, stream->Put(buffer, size));
+			if (fits)
+			{
+				written += size;
+			}
+			ASSERT_EQ(written - read, stream->GetDataSize());
+
+			size = 1 + rand() % 10;
+			bool available = (written - read) >= size;
+			ASSERT_EQ(available, stream->Get(buffer, size));
+			if (available)
+			{
+				for (uint32 j = 0; j < size; ++j)
+				{
+					ASSERT_EQ(SequenceByte(read + j), buffer[j]) << "byte " << (read + j);
+				}
+				read += size;
+			}
+			ASSERT_EQ(written - read, stream->GetDataSize());
+		}
+		// The data has gone round the buffer many times
+		EXPECT_GT(read, 1000u);
+
+		stream->Purge();
+		EXPECT_EQ(0u, stream->GetDataSize());
+		stream->Release();
+	}
+}
+
+TEST(Stream, Full)
+{
+	Stream* stream = new Stream(16, true);
+	uint8 buffer[17] = { 0 };
+	EXPECT_FALSE(stream->Put(buffer, 17));
+	EXPECT_TRUE(stream->Put(buffer, 16));
+	EXPECT_FALSE(stream->Put(buffer, 1));
+	EXPECT_FALSE(stream->Get(buffer, 17));
+	EXPECT_TRUE(stream->Get(buffer, 1));
+	EXPECT_TRUE(stream->Put(buffer, 1));
+	EXPECT_EQ(16u, stream->GetDataSize());
+	stream->Release();
+}
+
+TEST(Stream, SignalThreshold)
+{
+	Stream* stream = new Stream(16, true);
+	uint8 buffer[4] = { 1, 2, 3, 4 };
+	stream->SetSignalThreshold(4);
+	EXPECT_EQ(-1, Wait::Single(stream, 0));
+	stream->Put(buffer, 3);
+	EXPECT_EQ(-1, Wait::Single(stream, 0));
+	stream->Put(buffer, 1);
+	EXPECT_EQ(0, Wait::Single(stream, 0));
+
+	// Dropping below the threshold clears the signal, and reaching it again sets it
+	stream->Get(buffer, 1);
+	EXPECT_EQ(-1, Wait::Single(stream, 0));
+	stream->Put(buffer, 1);
+	EXPECT_EQ(0, Wait::Single(stream, 0));
+
+	// Lowering the threshold below what is already there signals straight away
+	stream->Get(buffer, 4);
+	stream->Put(buffer, 2);
+	EXPECT_EQ(-1, Wait::Single(stream, 0));
+	stream->SetSignalThreshold(2);
+	EXPECT_EQ(0, Wait::Single(stream, 0));
+	stream->Release();
+}
+
+TEST(Stream, ProducerConsumer)
+{
+	// One thread puts the sequence in chunks of random sizes, as the serial thread
+	// does, while this one waits for it and reads whatever has arrived, as the
+	// driver thread does.  A lost wakeup shows up as a timed out wait.
+	Stream* stream = new Stream(100, true);
+	uint32 const total = 2000000;
+	std::atomic<bool> stop(false);
+	std::thread producer([stream, total, &stop]()
+	{
+		uint32 written = 0;
+		uint32 seed = 7;
+		while ((written < total) && !stop)
+		{
+			uint8 buffer[64];
+			seed = seed * 1103515245 + 12345;
+			uint32 size = 1 + (seed >> 16) % 64;
+			if (size > total - written)
+			{
+				size = total - written;
+			}
+			for (uint32 j = 0; j < size; ++j)
+			{
+				buffer[j] = SequenceByte(written + j);
+			}
+			if (stream->Put(buffer, size))
+			{
+				written += size;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32 read = 0;
+	bool ok = true;
+	while (ok && (read < total))
+	{
+		stream->SetSignalThreshold(1);
+		if (Wait::Single(stream, 5000) < 0)
+		{
+			ADD_FAILURE() << "Timed out waiting for data after " << read << " bytes";
+			break;
+		}
+		uint8 buffer[100];
+		// No ASSERTs here, as the producer thread must be joined
+		uint32 size = stream->GetDataSize();
+		if ((size == 0) || !stream->Get(buffer, size))
+		{
+			ADD_FAILURE() << "Signalled with no data after " << read << " bytes";
+			break;
+		}
+		for (uint32 j = 0; j < size; ++j)
+		{
+			if (buffer[j] != SequenceByte(read + j))
+			{
+				ADD_FAILURE() << "Wrong data at byte " << (read + j);
+				ok = false;
+				break;
+			}
+		}
+		read += size;
+	}
+	stop = true;
+	producer.join();
+	EXPECT_EQ(total, read);
+	stream->Release();
+}
+
+} // namespace Testing
+} // namespace OpenZWave
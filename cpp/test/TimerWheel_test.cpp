@@ -0,0 +1,271 @@
+//-----------------------------------------------------------------------------
+//
+//	TimerWheel_test.cpp
+//
+//	Tests and a stress benchmark for the TimerThread's timing wheel
+//
+//	Copyright (c) 2026 OpenZWave Developers
+//	All rights reserved.
+//
+//	SOFTWARE NOTICE AND LICENSE
+//
+//	This file is part of OpenZWave.
+//
+//	OpenZWave is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published
+//	by the Free Software Foundation, either version 3 of the License,
+//	or (at your option) any later version.
+//
+//	OpenZWave is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with OpenZWave.  If not, see <http://www.gnu.org/licenses/>.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <list>
+#include <vector>
+#include "gtest/gtest.h"
+#include "TimerWheel.h"
+#include "Utils.h"
+#include "platform/TimeStamp.h"
+
+namespace OpenZWave
+{
+
+namespace Testing
+{
+using namespace OpenZWave::Internal;
+
+struct TestTimer: public TimerWheel::Entry
+{
+	TestTimer() :
+			m_fired(0), m_firedAt(0)
+	{
+	}
+	int m_fired;
+	uint64 m_firedAt;
+};
+
+// Advance to _now, noting when each timer fires
+static void Fire(TimerWheel* _wheel, uint64 _now)
+{
+	TimerWheel::Entry expired;
+	_wheel->Advance(_now, &expired);
+	while (expired.m_next != &expired)
+	{
+		TestTimer* timer = static_cast<TestTimer*>(expired.m_next);
+		_wheel->Remove(timer);
+		timer->m_fired++;
+		timer->m_firedAt = _now;
+	}
+}
+
+static uint64 RandomDelay()
+{
+	// Spread over every level of the wheel, and beyond it
+	switch (rand() % 5)
+	{
+		case 0:
+			return rand() % 64;
+		case 1:
+			return rand() % 4096;
+		case 2:
+			return rand() % 262144;
+		case 3:
+			return rand() % 16777216;
+		default:
+			return 16777216 + (uint64) (rand() % 16777216) * 4;
+	}
+}
+
+TEST(TimerWheel, FiresOnTime)
+{
+	// Following GetTimeout from one wake-up to the next, every timer must fire
+	// exactly when it is due
+	srand(2);
+	uint64 const start = 1000000007;
+	TimerWheel wheel(start);
+	std::vector<TestTimer> timers(5000);
+	for (size_t i = 0; i < timers.size(); ++i)
+	{
+		timers[i].m_expiry = start + RandomDelay();
+		wheel.Insert(&timers[i]);
+	}
+	EXPECT_EQ(wheel.GetCount(), timers.size());
+
+	uint64 now = start;
+	int wakeups = 0;
+	while (wheel.GetCount())
+	{
+		int32 timeout = wheel.GetTimeout(now);
+		ASSERT_GE(timeout, 0);
+		now += timeout;
+		Fire(&wheel, now);
+		++wakeups;
+	}
+	EXPECT_EQ(wheel.GetTimeout(now), -1);
+	for (size_t i = 0; i < timers.size(); ++i)
+	{
+		EXPECT_EQ(timers[i].m_fired, 1);
+		EXPECT_EQ(timers[i].m_firedAt, std::max(timers[i].m_expiry, start + 1)) << "timer " << i;
+	}
+	// Far fewer wake-ups than timers: each one fires everything due at that moment
+	EXPECT_LE(wakeups, (int) timers.size() * 2);
+}
+
+TEST(TimerWheel, LateAdvance)
+{
+	// When the thread wakes late, everything overdue fires at once
+	srand(3);
+	uint64 const start = 5;
+	TimerWheel wheel(start);
+	std::vector<TestTimer> timers(2000);
+	for (size_t i = 0; i < timers.size(); ++i)
+	{
+		timers[i].m_expiry = start + RandomDelay();
+		wheel.Insert(&timers[i]);
+	}
+	uint64 now = start;
+	while (wheel.GetCount())
+	{
+		now += 1 + rand() % 3000000;
+		Fire(&wheel, now);
+		for (size_t i = 0; i < timers.size(); ++i)
+		{
+			ASSERT_EQ(timers[i].m_fired, (timers[i].m_expiry <= now) ? 1 : 0) << "timer " << i << " at " << now;
+		}
+	}
+}
+
+TEST(TimerWheel, Remove)
+{
+	TimerWheel wheel(0);
+	std::vector<TestTimer> timers(1000);
+	for (size_t i = 0; i < timers.size(); ++i)
+	{
+		timers[i].m_expiry = i * 37;
+		wheel.Insert(&timers[i]);
+	}
+	for (size_t i = 0; i < timers.size(); i += 2)
+	{
+		wheel.Remove(&timers[i]);
+		EXPECT_FALSE(timers[i].IsQueued());
+	}
+	EXPECT_EQ(wheel.GetCount(), timers.size() / 2);
+
+	// Cancelling a timer that has expired but not yet been handled
+	TimerWheel::Entry expired;
+	wheel.Advance(37 * 11, &expired);
+	wheel.Remove(&timers[11]);
+	for (TimerWheel::Entry* entry = expired.m_next; entry != &expired; entry = entry->m_next)
+	{
+		EXPECT_NE(entry, &timers[11]);
+	}
+	while (expired.m_next != &expired)
+	{
+		wheel.Remove(expired.m_next);
+	}
+
+	Fire(&wheel, 37 * 1000);
+	EXPECT_EQ(wheel.GetCount(), 0u);
+	for (size_t i = 12; i < timers.size(); ++i)
+	{
+		EXPECT_EQ(timers[i].m_fired, (i & 1) ? 1 : 0) << "timer " << i;
+	}
+}
+
+TEST(TimerWheel, MonotonicTime)
+{
+	uint64 a = Internal::GetMonotonicTime();
+	uint64 b = Internal::GetMonotonicTime();
+	EXPECT_GE(b, a);
+}
+
+// Tens of thousands of pending timers, as on a large network with per-node
+// wake-up and refresh timers, against the sorted list the TimerThread used to
+// scan.  Run with --gtest_also_run_disabled_tests --gtest_filter=TimerWheel.*
+TEST(TimerWheel, DISABLED_Stress)
+{
+	int const count = 50000;
+	srand(4);
+	std::vector<uint64> delays(count);
+	for (int i = 0; i < count; ++i)
+	{
+		delays[i] = 1 + rand() % 600000;
+	}
+
+	{
+		std::vector<TestTimer> timers(count);
+		Internal::Platform::TimeStamp started;
+		TimerWheel wheel(0);
+		for (int i = 0; i < count; ++i)
+		{
+			timers[i].m_expiry = delays[i];
+			wheel.Insert(&timers[i]);
+		}
+		int32 inserted = -started.TimeRemaining();
+		for (int i = 0; i < count; i += 2)
+		{
+			wheel.Remove(&timers[i]);
+		}
+		int32 removed = -started.TimeRemaining();
+		uint64 now = 0;
+		while (wheel.GetCount())
+		{
+			now += wheel.GetTimeout(now);
+			Fire(&wheel, now);
+		}
+		int32 fired = -started.TimeRemaining();
+		printf("wheel: insert %d in %d ms, cancel half in %d ms, expire the rest in %d ms\n", count, inserted, removed - inserted, fired - removed);
+	}
+
+	{
+		// What the TimerThread did before: push_back, find to cancel, and scan
+		// everything at each wake-up for expired events and the next timeout
+		std::vector<TestTimer> timers(count);
+		Internal::Platform::TimeStamp started;
+		std::list<TestTimer*> pending;
+		for (int i = 0; i < count; ++i)
+		{
+			timers[i].m_expiry = delays[i];
+			pending.push_back(&timers[i]);
+		}
+		int32 inserted = -started.TimeRemaining();
+		for (int i = 0; i < count; i += 2)
+		{
+			pending.erase(std::find(pending.begin(), pending.end(), &timers[i]));
+		}
+		int32 removed = -started.TimeRemaining();
+		uint64 now = 0;
+		while (!pending.empty())
+		{
+			uint64 next = 0;
+			for (std::list<TestTimer*>::iterator it = pending.begin(); it != pending.end();)
+			{
+				if ((*it)->m_expiry <= now)
+				{
+					(*it)->m_fired++;
+					it = pending.erase(it);
+				}
+				else
+				{
+					next = next ? std::min(next, (*it)->m_expiry) : (*it)->m_expiry;
+					++it;
+				}
+			}
+			now = next;
+		}
+		int32 fired = -started.TimeRemaining();
+		printf("list:  insert %d in %d ms, cancel half in %d ms, expire the rest in %d ms\n", count, inserted, removed - inserted, fired - removed);
+	}
+}
+
+} // namespace Testing
+} // namespace OpenZWave
@@ -1385,6 +1385,15 @@ DISTFILES =	.gitignore \
 	cpp/build/windows/vs2010/OpenZWave.vcxproj \
 	cpp/build/windows/vs2010/OpenZWave.vcxproj.filters \
 	cpp/build/windows/winversion.tmpl \
+	cpp/examples/CacheConvert/CacheConvert.in \
+	cpp/examples/CacheConvert/Main.cpp \
+	cpp/examples/CacheConvert/Makefile \
+	cpp/examples/ConfigCompile/ConfigCompile.in \
+	cpp/examples/ConfigCompile/Main.cpp \
+	cpp/examples/ConfigCompile/Makefile \
+	cpp/examples/LogDecode/LogDecode.in \
+	cpp/examples/LogDecode/Main.cpp \
+	cpp/examples/LogDecode/Makefile \
 	cpp/examples/MinOZW/Main.cpp \
 	cpp/examples/MinOZW/Makefile \
 	cpp/examples/MinOZW/MinOZW.in \
@@ -1436,10 +1445,20 @@ DISTFILES =	.gitignore \
 	cpp/hidapi/windows/hidapi.sln \
 	cpp/hidapi/windows/hidapi.vcproj \
 	cpp/hidapi/windows/hidtest.vcproj \
+	cpp/src/AesModes.cpp \
+	cpp/src/AesModes.h \
+	cpp/src/BinaryCache.cpp \
+	cpp/src/BinaryCache.h \
 	cpp/src/Bitfield.cpp \
 	cpp/src/Bitfield.h \
+	cpp/src/BlockPool.cpp \
+	cpp/src/BlockPool.h \
+	cpp/src/CacheJournal.cpp \
+	cpp/src/CacheJournal.h \
 	cpp/src/CompatOptionManager.cpp \
 	cpp/src/CompatOptionManager.h \
+	cpp/src/ConfigImage.cpp \
+	cpp/src/ConfigImage.h \
 	cpp/src/DNSThread.cpp \
 	cpp/src/DNSThread.h \
 	cpp/src/Defs.h \
@@ -1464,15 +1483,23 @@ DISTFILES =	.gitignore \
 	cpp/src/Notification.h \
 	cpp/src/NotificationCCTypes.cpp \
 	cpp/src/NotificationCCTypes.h \
+	cpp/src/NotificationDispatcher.cpp \
+	cpp/src/NotificationDispatcher.h \
 	cpp/src/OZWException.h \
 	cpp/src/Options.cpp \
 	cpp/src/Options.h \
+	cpp/src/PollScheduler.cpp \
+	cpp/src/PollScheduler.h \
 	cpp/src/Scene.cpp \
 	cpp/src/Scene.h \
 	cpp/src/SensorMultiLevelCCTypes.cpp \
 	cpp/src/SensorMultiLevelCCTypes.h \
+	cpp/src/StringPool.cpp \
+	cpp/src/StringPool.h \
 	cpp/src/TimerThread.cpp \
 	cpp/src/TimerThread.h \
+	cpp/src/TimerWheel.cpp \
+	cpp/src/TimerWheel.h \
 	cpp/src/Utils.cpp \
 	cpp/src/Utils.h \
 	cpp/src/ValueIDIndexes.h \
@@ -1611,6 +1638,8 @@ DISTFILES =	.gitignore \
 	cpp/src/command_classes/WakeUp.h \
 	cpp/src/command_classes/ZWavePlusInfo.cpp \
 	cpp/src/command_classes/ZWavePlusInfo.h \
+	cpp/src/platform/AsyncLog.cpp \
+	cpp/src/platform/AsyncLog.h \
 	cpp/src/platform/Controller.cpp \
 	cpp/src/platform/Controller.h \
 	cpp/src/platform/DNS.cpp \
@@ -1625,11 +1654,15 @@ DISTFILES =	.gitignore \
 	cpp/src/platform/HttpClient.h \
 	cpp/src/platform/Log.cpp \
 	cpp/src/platform/Log.h \
+	cpp/src/platform/LogFormatter.cpp \
+	cpp/src/platform/LogFormatter.h \
 	cpp/src/platform/Mutex.cpp \
 	cpp/src/platform/Mutex.h \
 	cpp/src/platform/Ref.h \
 	cpp/src/platform/SerialController.cpp \
 	cpp/src/platform/SerialController.h \
+	cpp/src/platform/SharedMutex.cpp \
+	cpp/src/platform/SharedMutex.h \
 	cpp/src/platform/Stream.cpp \
 	cpp/src/platform/Stream.h \
 	cpp/src/platform/Thread.cpp \
@@ -1638,6 +1671,8 @@ DISTFILES =	.gitignore \
 	cpp/src/platform/TimeStamp.h \
 	cpp/src/platform/Wait.cpp \
 	cpp/src/platform/Wait.h \
+	cpp/src/platform/WaitSet.cpp \
+	cpp/src/platform/WaitSet.h \
 	cpp/src/platform/unix/DNSImpl.cpp \
 	cpp/src/platform/unix/DNSImpl.h \
 	cpp/src/platform/unix/EventImpl.cpp \
@@ -1650,12 +1685,16 @@ DISTFILES =	.gitignore \
 	cpp/src/platform/unix/MutexImpl.h \
 	cpp/src/platform/unix/SerialControllerImpl.cpp \
 	cpp/src/platform/unix/SerialControllerImpl.h \
+	cpp/src/platform/unix/SharedMutexImpl.cpp \
+	cpp/src/platform/unix/SharedMutexImpl.h \
 	cpp/src/platform/unix/ThreadImpl.cpp \
 	cpp/src/platform/unix/ThreadImpl.h \
 	cpp/src/platform/unix/TimeStampImpl.cpp \
 	cpp/src/platform/unix/TimeStampImpl.h \
 	cpp/src/platform/unix/WaitImpl.cpp \
 	cpp/src/platform/unix/WaitImpl.h \
+	cpp/src/platform/unix/WaitSetImpl.cpp \
+	cpp/src/platform/unix/WaitSetImpl.h \
 	cpp/src/platform/unix/android.h \
 	cpp/src/platform/winRT/DNSImpl.cpp \
 	cpp/src/platform/winRT/DNSImpl.h \
@@ -1671,12 +1710,16 @@ DISTFILES =	.gitignore \
 	cpp/src/platform/winRT/MutexImpl.h \
 	cpp/src/platform/winRT/SerialControllerImpl.cpp \
 	cpp/src/platform/winRT/SerialControllerImpl.h \
+	cpp/src/platform/winRT/SharedMutexImpl.cpp \
+	cpp/src/platform/winRT/SharedMutexImpl.h \
 	cpp/src/platform/winRT/ThreadImpl.cpp \
 	cpp/src/platform/winRT/ThreadImpl.h \
 	cpp/src/platform/winRT/TimeStampImpl.cpp \
 	cpp/src/platform/winRT/TimeStampImpl.h \
 	cpp/src/platform/winRT/WaitImpl.cpp \
 	cpp/src/platform/winRT/WaitImpl.h \
+	cpp/src/platform/winRT/WaitSetImpl.cpp \
+	cpp/src/platform/winRT/WaitSetImpl.h \
 	cpp/src/platform/windows/DNSImpl.cpp \
 	cpp/src/platform/windows/DNSImpl.h \
 	cpp/src/platform/windows/EventImpl.cpp \
@@ -1689,12 +1732,16 @@ DISTFILES =	.gitignore \
 	cpp/src/platform/windows/MutexImpl.h \
 	cpp/src/platform/windows/SerialControllerImpl.cpp \
 	cpp/src/platform/windows/SerialControllerImpl.h \
+	cpp/src/platform/windows/SharedMutexImpl.cpp \
+	cpp/src/platform/windows/SharedMutexImpl.h \
 	cpp/src/platform/windows/ThreadImpl.cpp \
 	cpp/src/platform/windows/ThreadImpl.h \
 	cpp/src/platform/windows/TimeStampImpl.cpp \
 	cpp/src/platform/windows/TimeStampImpl.h \
 	cpp/src/platform/windows/WaitImpl.cpp \
 	cpp/src/platform/windows/WaitImpl.h \
+	cpp/src/platform/windows/WaitSetImpl.cpp \
+	cpp/src/platform/windows/WaitSetImpl.h \
 	cpp/src/value_classes/Value.cpp \
 	cpp/src/value_classes/Value.h \
 	cpp/src/value_classes/ValueBitSet.cpp \
@@ -1719,11 +1766,21 @@ DISTFILES =	.gitignore \
 	cpp/src/value_classes/ValueSchedule.h \
 	cpp/src/value_classes/ValueShort.cpp \
 	cpp/src/value_classes/ValueShort.h \
+	cpp/src/value_classes/ValueSnapshot.h \
+	cpp/src/value_classes/ValueSnapshotTable.cpp \
+	cpp/src/value_classes/ValueSnapshotTable.h \
 	cpp/src/value_classes/ValueStore.cpp \
 	cpp/src/value_classes/ValueStore.h \
 	cpp/src/value_classes/ValueString.cpp \
 	cpp/src/value_classes/ValueString.h \
+	cpp/test/BinaryCache_test.cpp \
+	cpp/test/CacheJournal_test.cpp \
 	cpp/test/Makefile \
+	cpp/test/PollScheduler_test.cpp \
+	cpp/test/Security_test.cpp \
+	cpp/test/SendQueue_test.cpp \
+	cpp/test/Stream_test.cpp \
+	cpp/test/TimerWheel_test.cpp \
 	cpp/test/ValueID_test.cpp \
 	cpp/test/include/gtest/gtest-death-test.h \
 	cpp/test/include/gtest/gtest-matchers.h \